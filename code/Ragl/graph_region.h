@@ -124,7 +124,7 @@ namespace ragl
 		////////////////////////////////////////////////////////////////////////////////////
 		int get_node_region(int Node)
 		{
-			return mRegions[mGraph.node_index(Node)];
+			return mRegions[Node];
 		}
 
 		////////////////////////////////////////////////////////////////////////////////////
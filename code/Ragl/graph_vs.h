@@ -1459,13 +1459,21 @@ namespace ragl
 
 		////////////////////////////////////////////////////////////////////////////////////
 		// A* Search
+		//
+		// Any nodes set in closedNodes are never opened, which keeps the search inside the
+		// rest of the graph (the start node must not be one of them).
 		////////////////////////////////////////////////////////////////////////////////////
-		void		astar(search& sdata, const user& suser)
+		void		astar(search& sdata, const user& suser, const TNodeState* closedNodes = nullptr)
 		{
 			// Make Sure The Nodes We Are Searching For Exist
 			//------------------------------------------------
 			assert(MAXEDGES > 1);
 			sdata.setup(&mNodes);
+			if (closedNodes)
+			{
+				assert(!closedNodes->get_bit(sdata.mStart));
+				sdata.close(*closedNodes);
+			}
 
 			// Allocate Our Data Structures
 			//------------------------------
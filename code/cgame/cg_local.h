@@ -634,6 +634,7 @@ extern vmCvar_t cg_debugEvents;
 extern vmCvar_t cg_errorDecay;
 extern vmCvar_t cg_footsteps;
 extern vmCvar_t cg_addMarks;
+extern vmCvar_t cg_deferMarks;
 extern vmCvar_t cg_drawGun;
 extern vmCvar_t cg_autoswitch;
 extern vmCvar_t cg_simpleItems;
@@ -323,6 +323,7 @@ vmCvar_t cg_debugSaber;
 vmCvar_t cg_debugEvents;
 vmCvar_t cg_errorDecay;
 vmCvar_t cg_addMarks;
+vmCvar_t cg_deferMarks;
 vmCvar_t cg_drawGun;
 vmCvar_t cg_autoswitch;
 vmCvar_t cg_simpleItems;
@@ -536,6 +537,7 @@ static cvarTable_t cvarTable[] = {
 	{&cg_simpleItems, "cg_simpleItems", "0", CVAR_ARCHIVE},
 	// NOTE : I also create this in UI_Init()
 	{&cg_addMarks, "cg_marks", "1", CVAR_ARCHIVE},
+	{&cg_deferMarks, "cg_deferMarks", "0", CVAR_ARCHIVE},
 	// NOTE : I also create these weapon sway cvars in UI_Init()
 	{&cg_runpitch, "cg_runpitch", "0.002", CVAR_ARCHIVE},
 	{&cg_runroll, "cg_runroll", "0.005", CVAR_ARCHIVE},
@@ -37,6 +37,40 @@ markPoly_t cg_activeMarkPolys; // double linked list
 markPoly_t* cg_freeMarkPolys; // single linked list
 markPoly_t cg_markPolys[MAX_MARK_POLYS];
 
+/*
+=================
+Deferred impact marks
+
+With cg_deferMarks set, persistent marks are queued and projected at the
+start of the next CG_AddMarks, at most cg_deferMarks of them per frame, so
+a burst of impacts doesn't stall the frame that caused it. Temporary marks
+are always projected immediately since they only live for one frame.
+=================
+*/
+constexpr auto MAX_DEFERRED_MARKS = 64;
+
+using deferredMark_t = struct
+{
+	qhandle_t markShader;
+	vec3_t origin;
+	vec3_t dir;
+	float orientation;
+	float color[4];
+	qboolean alphaFade;
+	float radius;
+	int time;
+};
+
+static deferredMark_t cg_deferredMarks[MAX_DEFERRED_MARKS];
+static int cg_deferredMarkHead;
+static int cg_numDeferredMarks;
+
+static void CG_ClearDeferredMarks()
+{
+	cg_deferredMarkHead = 0;
+	cg_numDeferredMarks = 0;
+}
+
 /*
 ===================
 CG_InitMarkPolys
@@ -55,6 +89,7 @@ void CG_InitMarkPolys()
 	{
 		cg_markPolys[i].nextMark = &cg_markPolys[i + 1];
 	}
+	CG_ClearDeferredMarks();
 }
 
 /*
@@ -125,19 +160,29 @@ passed to the renderer.
 constexpr auto MAX_MARK_FRAGMENTS = 128;
 constexpr auto MAX_MARK_POINTS = 384;
 
+static void CG_ProjectMark(qhandle_t mark_shader, const vec3_t origin, const vec3_t dir, float orientation,
+	float r, float g, float b, float a, qboolean alpha_fade, float radius, qboolean temporary, int time);
+
+static void CG_FlushDeferredMarks(int budget)
+{
+	while (cg_numDeferredMarks && budget--)
+	{
+		const deferredMark_t* dm = &cg_deferredMarks[cg_deferredMarkHead];
+
+		cg_deferredMarkHead = (cg_deferredMarkHead + 1) % MAX_DEFERRED_MARKS;
+		cg_numDeferredMarks--;
+
+		CG_ProjectMark(dm->markShader, dm->origin, dm->dir, dm->orientation,
+			dm->color[0], dm->color[1], dm->color[2], dm->color[3],
+			dm->alphaFade, dm->radius, qfalse, dm->time);
+	}
+}
+
 void CG_ImpactMark(const qhandle_t mark_shader, const vec3_t origin, const vec3_t dir, const float orientation,
 	const float r,
 	const float g, const float b, const float a, const qboolean alpha_fade, const float radius,
 	const qboolean temporary)
 {
-	vec3_t axis[3]{};
-	vec3_t original_points[4]{};
-	byte colors[4]{};
-	int i, j;
-	markFragment_t mark_fragments[MAX_MARK_FRAGMENTS], * mf;
-	vec3_t mark_points[MAX_MARK_POINTS]{};
-	vec3_t projection;
-
 	if (!cg_addMarks.integer)
 	{
 		return;
@@ -148,6 +193,47 @@ void CG_ImpactMark(const qhandle_t mark_shader, const vec3_t origin, const vec3_
 		CG_Error("CG_ImpactMark called with <= 0 radius");
 	}
 
+	if (temporary || cg_deferMarks.integer <= 0)
+	{
+		CG_ProjectMark(mark_shader, origin, dir, orientation, r, g, b, a, alpha_fade, radius, temporary, cg.time);
+		return;
+	}
+
+	if (cg_numDeferredMarks == MAX_DEFERRED_MARKS)
+	{
+		// queue is full, make room by projecting the oldest one now
+		CG_FlushDeferredMarks(1);
+	}
+
+	deferredMark_t* dm = &cg_deferredMarks[(cg_deferredMarkHead + cg_numDeferredMarks) % MAX_DEFERRED_MARKS];
+	cg_numDeferredMarks++;
+
+	dm->markShader = mark_shader;
+	VectorCopy(origin, dm->origin);
+	VectorCopy(dir, dm->dir);
+	dm->orientation = orientation;
+	dm->color[0] = r;
+	dm->color[1] = g;
+	dm->color[2] = b;
+	dm->color[3] = a;
+	dm->alphaFade = alpha_fade;
+	dm->radius = radius;
+	dm->time = cg.time;
+}
+
+static void CG_ProjectMark(const qhandle_t mark_shader, const vec3_t origin, const vec3_t dir, const float orientation,
+	const float r,
+	const float g, const float b, const float a, const qboolean alpha_fade, const float radius,
+	const qboolean temporary, const int time)
+{
+	vec3_t axis[3]{};
+	vec3_t original_points[4]{};
+	byte colors[4]{};
+	int i, j;
+	markFragment_t mark_fragments[MAX_MARK_FRAGMENTS], * mf;
+	vec3_t mark_points[MAX_MARK_POINTS]{};
+	vec3_t projection;
+
 	// create the texture axis
 	VectorNormalize2(dir, axis[0]);
 	PerpendicularVector(axis[1], axis[0]);
@@ -211,7 +297,7 @@ void CG_ImpactMark(const qhandle_t mark_shader, const vec3_t origin, const vec3_
 
 		// otherwise save it persistently
 		markPoly_t* mark = CG_AllocMark();
-		mark->time = cg.time;
+		mark->time = time;
 		mark->alphaFade = alpha_fade;
 		mark->markShader = mark_shader;
 		mark->poly.numVerts = mf->numPoints;
@@ -238,9 +324,13 @@ void CG_AddMarks()
 
 	if (!cg_addMarks.integer)
 	{
+		CG_ClearDeferredMarks();
 		return;
 	}
 
+	// once deferring is switched off, whatever is still queued goes out now
+	CG_FlushDeferredMarks(cg_deferMarks.integer > 0 ? cg_deferMarks.integer : MAX_DEFERRED_MARKS);
+
 	for (markPoly_t* mp = cg_activeMarkPolys.nextMark; mp != &cg_activeMarkPolys; mp = next)
 	{
 		// grab next now, so if the local entity is freed we
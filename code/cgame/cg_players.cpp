@@ -4802,75 +4802,45 @@ static void CG_ForceDeadlySightBlur(const vec3_t org)
 static void CG_ForcePushBodyBlur(const centity_t* cent, const vec3_t origin, vec3_t temp_angles)
 {
 	vec3_t fx_org;
-	mdxaBone_t bolt_matrix;
+	int bolts[7];
+	mdxaBone_t bolt_matrices[7];
+	int num_bolts = 0;
 
 	// Head blur
 	CG_ForcePushBlur(cent->gent->client->renderInfo.eyePoint);
 
-	// Do a torso based blur
-	if (cent->gent->torsoBolt >= 0)
-	{
-		gi.G2API_GetBoltMatrix(cent->gent->ghoul2, cent->gent->playerModel, cent->gent->torsoBolt,
-			&bolt_matrix, temp_angles, origin, cg.time,
-			cgs.model_draw, cent->currentState.modelScale);
-		gi.G2API_GiveMeVectorFromMatrix(bolt_matrix, ORIGIN, fx_org);
-		CG_ForcePushBlur(fx_org);
-	}
+	// Do a torso, hands, knees and elbows based blur
+	const int body_bolts[] = {
+		cent->gent->torsoBolt,
+		cent->gent->handRBolt,
+		cent->gent->handLBolt,
+		cent->gent->kneeLBolt,
+		cent->gent->kneeRBolt,
+		cent->gent->elbowLBolt,
+		cent->gent->elbowRBolt
+	};
 
-	if (cent->gent->handRBolt >= 0)
+	for (const int bolt : body_bolts)
 	{
-		// Do a right-hand based blur
-		gi.G2API_GetBoltMatrix(cent->gent->ghoul2, cent->gent->playerModel, cent->gent->handRBolt,
-			&bolt_matrix, temp_angles, origin, cg.time,
-			cgs.model_draw, cent->currentState.modelScale);
-		gi.G2API_GiveMeVectorFromMatrix(bolt_matrix, ORIGIN, fx_org);
-		CG_ForcePushBlur(fx_org);
-	}
-
-	if (cent->gent->handLBolt >= 0)
-	{
-		// Do a left-hand based blur
-		gi.G2API_GetBoltMatrix(cent->gent->ghoul2, cent->gent->playerModel, cent->gent->handLBolt,
-			&bolt_matrix, temp_angles, origin, cg.time,
-			cgs.model_draw, cent->currentState.modelScale);
-		gi.G2API_GiveMeVectorFromMatrix(bolt_matrix, ORIGIN, fx_org);
-		CG_ForcePushBlur(fx_org);
+		if (bolt >= 0)
+		{
+			bolts[num_bolts++] = bolt;
+		}
 	}
 
-	// Do the knees
-	if (cent->gent->kneeLBolt >= 0)
+	if (!num_bolts)
 	{
-		gi.G2API_GetBoltMatrix(cent->gent->ghoul2, cent->gent->playerModel, cent->gent->kneeLBolt,
-			&bolt_matrix, temp_angles, origin, cg.time,
-			cgs.model_draw, cent->currentState.modelScale);
-		gi.G2API_GiveMeVectorFromMatrix(bolt_matrix, ORIGIN, fx_org);
-		CG_ForcePushBlur(fx_org);
+		return;
 	}
 
-	if (cent->gent->kneeRBolt >= 0)
-	{
-		gi.G2API_GetBoltMatrix(cent->gent->ghoul2, cent->gent->playerModel, cent->gent->kneeRBolt,
-			&bolt_matrix, temp_angles, origin, cg.time,
-			cgs.model_draw, cent->currentState.modelScale);
-		gi.G2API_GiveMeVectorFromMatrix(bolt_matrix, ORIGIN, fx_org);
-		CG_ForcePushBlur(fx_org);
-	}
+	// all of these come off the same skeleton, so fetch them in one go
+	gi.G2API_GetBoltMatrices(cent->gent->ghoul2, cent->gent->playerModel, num_bolts, bolts,
+		bolt_matrices, temp_angles, origin, cg.time,
+		cgs.model_draw, cent->currentState.modelScale);
 
-	if (cent->gent->elbowLBolt >= 0)
-	{
-		// Do the elbows
-		gi.G2API_GetBoltMatrix(cent->gent->ghoul2, cent->gent->playerModel, cent->gent->elbowLBolt,
-			&bolt_matrix, temp_angles, origin, cg.time,
-			cgs.model_draw, cent->currentState.modelScale);
-		gi.G2API_GiveMeVectorFromMatrix(bolt_matrix, ORIGIN, fx_org);
-		CG_ForcePushBlur(fx_org);
-	}
-	if (cent->gent->elbowRBolt >= 0)
+	for (int i = 0; i < num_bolts; i++)
 	{
-		gi.G2API_GetBoltMatrix(cent->gent->ghoul2, cent->gent->playerModel, cent->gent->elbowRBolt,
-			&bolt_matrix, temp_angles, origin, cg.time,
-			cgs.model_draw, cent->currentState.modelScale);
-		gi.G2API_GiveMeVectorFromMatrix(bolt_matrix, ORIGIN, fx_org);
+		gi.G2API_GiveMeVectorFromMatrix(bolt_matrices[i], ORIGIN, fx_org);
 		CG_ForcePushBlur(fx_org);
 	}
 }
@@ -195,15 +195,24 @@ qboolean CL_GetSnapshot(const int snapshotNumber, snapshot_t* snapshot)
 		return qfalse;
 	}
 
+	// loopback frames keep their entities in the server's snapshot ring
+	const qboolean loopback = static_cast<qboolean>((clSnap->snapFlags & SNAPFLAG_LOOPBACK) != 0);
+	if (loopback)
+	{
+		if (!SV_GetLoopbackSnapshot(clSnap->messageNum))
+		{
+			return qfalse;
+		}
+	}
 	// if the entities in the frame have fallen out of their
 	// circular buffer, we can't return it
-	if (cl.parseEntitiesNum - clSnap->parseEntitiesNum >= MAX_PARSE_ENTITIES)
+	else if (cl.parseEntitiesNum - clSnap->parseEntitiesNum >= MAX_PARSE_ENTITIES)
 	{
 		return qfalse;
 	}
 
 	// write the snapshot
-	snapshot->snapFlags = clSnap->snapFlags;
+	snapshot->snapFlags = clSnap->snapFlags & ~SNAPFLAG_LOOPBACK;
 	snapshot->serverCommandSequence = clSnap->serverCommandNum;
 	snapshot->serverTime = clSnap->serverTime;
 	memcpy(snapshot->areamask, clSnap->areamask, sizeof(snapshot->areamask));
@@ -219,10 +228,21 @@ qboolean CL_GetSnapshot(const int snapshotNumber, snapshot_t* snapshot)
 	/*
 	Ghoul2 Insert Start
 	*/
-	for (int i = 0; i < count; i++)
+	if (loopback)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			const int entNum = (clSnap->parseEntitiesNum + i) % svs.numSnapshotEntities;
+			snapshot->entities[i] = svs.snapshotEntities[entNum];
+		}
+	}
+	else
 	{
-		const int entNum = (clSnap->parseEntitiesNum + i) & (MAX_PARSE_ENTITIES - 1);
-		snapshot->entities[i] = cl.parseEntities[entNum];
+		for (int i = 0; i < count; i++)
+		{
+			const int entNum = (clSnap->parseEntitiesNum + i) & (MAX_PARSE_ENTITIES - 1);
+			snapshot->entities[i] = cl.parseEntities[entNum];
+		}
 	}
 	/*
 	Ghoul2 Insert End
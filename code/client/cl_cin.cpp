@@ -43,6 +43,7 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #include "client_ui.h"	// CHC
 #include "snd_local.h"
 #include "qcommon/stringed_ingame.h"
+#include "cl_cin_kernels.h"
 
 constexpr auto MAXSIZE = 8;
 constexpr auto MINSIZE = 4;
@@ -74,11 +75,8 @@ static void RoQ_init();
 *
 ******************************************************************************/
 
-static long ROQ_YY_tab[256];
-static long ROQ_UB_tab[256];
-static long ROQ_UG_tab[256];
-static long ROQ_VG_tab[256];
-static long ROQ_VR_tab[256];
+static roqYUVTables_t roqYUV;
+static const roqKernels_t* roqKernels = &roqKernelsScalar;
 static unsigned short vq2[256 * 16 * 4];
 static unsigned short vq4[256 * 64 * 4];
 static unsigned short vq8[256 * 256 * 4];
@@ -514,32 +512,6 @@ static void blitVQQuad32fs(byte** status, unsigned char* data)
 	} while (status[index] != nullptr);
 }
 
-/******************************************************************************
-*
-* Function:
-*
-* Description:
-*
-******************************************************************************/
-
-static void ROQ_GenYUVTables()
-{
-	constexpr float t_ub = 1.77200f / 2.0f * static_cast<float>(1 << 6) + 0.5f;
-	constexpr float t_vr = 1.40200f / 2.0f * static_cast<float>(1 << 6) + 0.5f;
-	constexpr float t_ug = 0.34414f / 2.0f * static_cast<float>(1 << 6) + 0.5f;
-	constexpr float t_vg = 0.71414f / 2.0f * static_cast<float>(1 << 6) + 0.5f;
-	for (long i = 0; i < 256; i++)
-	{
-		const float x = static_cast<float>(2 * i - 255);
-
-		ROQ_UB_tab[i] = static_cast<long>(t_ub * x + (1 << 5));
-		ROQ_VR_tab[i] = static_cast<long>(t_vr * x + (1 << 5));
-		ROQ_UG_tab[i] = static_cast<long>((-t_ug * x));
-		ROQ_VG_tab[i] = static_cast<long>(-t_vg * x + (1 << 5));
-		ROQ_YY_tab[i] = i << 6 | i >> 2;
-	}
-}
-
 #define VQ2TO4(a,b,c,d) { \
     	*c++ = a[0];	\
 	*d++ = a[0];	\
@@ -586,11 +558,11 @@ static void ROQ_GenYUVTables()
 
 static unsigned short yuv_to_rgb(const long y, const long u, const long v)
 {
-	const long yy = ROQ_YY_tab[y];
+	const long yy = roqYUV.YY[y];
 
-	long r = (yy + ROQ_VR_tab[v]) >> 9;
-	long g = (yy + ROQ_UG_tab[u] + ROQ_VG_tab[v]) >> 8;
-	long b = (yy + ROQ_UB_tab[u]) >> 9;
+	long r = (yy + roqYUV.VR[v]) >> 9;
+	long g = (yy + roqYUV.UG[u] + roqYUV.VG[v]) >> 8;
+	long b = (yy + roqYUV.UB[u]) >> 9;
 
 	if (r < 0)
 		r = 0;
@@ -618,26 +590,12 @@ static unsigned short yuv_to_rgb(const long y, const long u, const long v)
 
 static unsigned int yuv_to_rgb24(const long y, const long u, const long v)
 {
-	const long yy = ROQ_YY_tab[y];
-
-	long r = (yy + ROQ_VR_tab[v]) >> 6;
-	long g = (yy + ROQ_UG_tab[u] + ROQ_VG_tab[v]) >> 6;
-	long b = (yy + ROQ_UB_tab[u]) >> 6;
+	byte rgba[4];
+	unsigned int pixel;
 
-	if (r < 0)
-		r = 0;
-	if (g < 0)
-		g = 0;
-	if (b < 0)
-		b = 0;
-	if (r > 255)
-		r = 255;
-	if (g > 255)
-		g = 255;
-	if (b > 255)
-		b = 255;
-
-	return LittleLong r | g << 8 | b << 16 | 255 << 24;
+	ROQ_YUVToRGBA(roqYUV, y, u, v, rgba);
+	memcpy(&pixel, rgba, sizeof(pixel));
+	return pixel;
 }
 
 /******************************************************************************
@@ -713,33 +671,11 @@ static void decodeCodeBook(byte* input, unsigned short roq_flags)
 			}
 			else if (cinTable[currentHandle].samplesPerPixel == 4)
 			{
-				ibptr.s = bptr;
-				for (i = 0; i < two; i++)
-				{
-					y0 = static_cast<long>(*input++);
-					y1 = static_cast<long>(*input++);
-					y2 = static_cast<long>(*input++);
-					y3 = static_cast<long>(*input++);
-					cr = static_cast<long>(*input++);
-					cb = static_cast<long>(*input++);
-					*ibptr.i++ = yuv_to_rgb24(y0, cr, cb);
-					*ibptr.i++ = yuv_to_rgb24(y1, cr, cb);
-					*ibptr.i++ = yuv_to_rgb24(y2, cr, cb);
-					*ibptr.i++ = yuv_to_rgb24(y3, cr, cb);
-				}
-
-				icptr.s = vq4;
-				idptr.s = vq8;
-
-				for (i = 0; i < four; i++)
-				{
-					iaptr.s = vq2;
-					iaptr.i += *input++ * 4;
-					ibptr.s = vq2;
-					ibptr.i += *input++ * 4;
-					for (j = 0; j < 2; j++)
-						VQ2TO4(iaptr.i, ibptr.i, icptr.i, idptr.i);
-				}
+				// the common case, every cinematic we play comes through here
+				roqKernels->decodeCells2(roqYUV, input, two, reinterpret_cast<byte*>(vq2));
+				input += two * 6;
+				roqKernels->expandCells4(reinterpret_cast<byte*>(vq2), input, four / 2,
+					reinterpret_cast<byte*>(vq4), reinterpret_cast<byte*>(vq8));
 			}
 			else if (cinTable[currentHandle].samplesPerPixel == 1)
 			{
@@ -1150,7 +1086,14 @@ static void initRoQ()
 	cinTable[currentHandle].VQNormal = reinterpret_cast<void (*)(byte*, void*)>(blitVQQuad32fs);
 	cinTable[currentHandle].VQBuffer = reinterpret_cast<void (*)(byte*, void*)>(blitVQQuad32fs);
 	cinTable[currentHandle].samplesPerPixel = 4;
-	ROQ_GenYUVTables();
+	ROQ_GenYUVTables(roqYUV);
+	roqKernels = &roqKernelsScalar;
+#ifdef ROQ_SIMD_KERNELS
+	if (cl_simdCinematics->integer)
+	{
+		roqKernels = &roqKernelsSSE2;
+	}
+#endif
 	RllSetupTable();
 }
 
@@ -2155,6 +2098,64 @@ void CL_PlayInGameCinematic_f()
 	}
 }
 
+/*
+==================
+CL_CinematicBenchmark_f
+
+cinbench <video> [passes]
+
+Decodes every frame of a RoQ into the cinematic buffers as fast as it can, with no
+sound, texture upload or frame pacing, and reports the decode rate.  Works with the
+headless renderer, e.g. "+set r_headless 1 +cinbench <video> +quit".
+==================
+*/
+void CL_CinematicBenchmark_f()
+{
+	if (Cmd_Argc() < 2)
+	{
+		Com_Printf("usage: cinbench <video> [passes]\n");
+		return;
+	}
+	if (cls.state == CA_CINEMATIC || CL_IsRunningInGameCinematic())
+	{
+		Com_Printf("cinbench: can't run while a cinematic is playing\n");
+		return;
+	}
+
+	const int passes = Cmd_Argc() > 2 ? Q_max(1, atoi(Cmd_Argv(2))) : 1;
+	int frames = 0;
+	int64_t usec = 0;
+
+	for (int pass = 0; pass < passes; pass++)
+	{
+		const int handle = CIN_PlayCinematic(Cmd_Argv(1), 0, 0, DEFAULT_CIN_WIDTH, DEFAULT_CIN_HEIGHT, CIN_silent, nullptr);
+		if (handle < 0)
+		{
+			return;
+		}
+
+		currentHandle = handle;
+		const int64_t start = Com_Microseconds();
+		while (cinTable[handle].status == FMV_PLAY)
+		{
+			const long numQuads = cinTable[handle].numQuads;
+			RoQInterrupt();
+			if (cinTable[handle].numQuads > numQuads)
+			{
+				frames++;
+			}
+		}
+		usec += Com_Microseconds() - start;
+
+		currentHandle = handle;
+		RoQShutdown();
+	}
+
+	const double msec = static_cast<double>(usec) / 1000.0;
+	Com_Printf("cinbench: %i frames in %.1f msec, %.1f fps (%s codebook kernels)\n",
+		frames, msec, msec > 0.0 ? frames * 1000.0 / msec : 0.0, roqKernels->name);
+}
+
 // Externally-called only, and only if cls.state == CA_CINEMATIC (or CL_IsRunningInGameCinematic() == true now)
 //
 void SCR_DrawCinematic()
@@ -0,0 +1,230 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// cl_cin_kernels.h -- RoQ codebook decoding for the 32 bit cinematic path
+//
+// A ROQ_CODEBOOK chunk holds up to 256 2x2 cells as four lumas plus one
+// chroma pair, followed by up to 256 4x4 cells given as four 2x2 cell
+// indices.  The kernels turn the 2x2 cells into RGBA (vq2) and build the
+// 4x4 cells and their pixel-doubled 8x8 versions (vq4, vq8) from them.
+// The scalar set is the original code; the SSE2 set does a whole cell per
+// step and produces the same bytes, which the unit tests check.
+// Nothing in here touches client state so the tests can run without it.
+
+#pragma once
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ROQ_SIMD_KERNELS
+#include <emmintrin.h>
+#endif
+
+struct roqYUVTables_t
+{
+	int YY[256];
+	int UB[256];
+	int UG[256];
+	int VG[256];
+	int VR[256];
+};
+
+struct roqKernels_t
+{
+	const char* name;
+
+	// numCells 2x2 cells of 6 bytes (y0 y1 y2 y3 cr cb) to 4 RGBA pixels each
+	void (*decodeCells2)(const roqYUVTables_t& tables, const unsigned char* input, int numCells, unsigned char* vq2);
+
+	// numCells 4x4 cells of 4 vq2 indices (top left, top right, bottom left, bottom right) to 16 RGBA
+	//	pixels in vq4 and 64 in vq8
+	void (*expandCells4)(const unsigned char* vq2, const unsigned char* input, int numCells, unsigned char* vq4, unsigned char* vq8);
+};
+
+inline void ROQ_GenYUVTables(roqYUVTables_t& tables)
+{
+	constexpr float t_ub = 1.77200f / 2.0f * static_cast<float>(1 << 6) + 0.5f;
+	constexpr float t_vr = 1.40200f / 2.0f * static_cast<float>(1 << 6) + 0.5f;
+	constexpr float t_ug = 0.34414f / 2.0f * static_cast<float>(1 << 6) + 0.5f;
+	constexpr float t_vg = 0.71414f / 2.0f * static_cast<float>(1 << 6) + 0.5f;
+	for (int i = 0; i < 256; i++)
+	{
+		const float x = static_cast<float>(2 * i - 255);
+
+		tables.UB[i] = static_cast<int>(t_ub * x + (1 << 5));
+		tables.VR[i] = static_cast<int>(t_vr * x + (1 << 5));
+		tables.UG[i] = static_cast<int>((-t_ug * x));
+		tables.VG[i] = static_cast<int>(-t_vg * x + (1 << 5));
+		tables.YY[i] = i << 6 | i >> 2;
+	}
+}
+
+/*
+====================================================================
+
+SCALAR KERNELS
+
+====================================================================
+*/
+
+inline void ROQ_YUVToRGBA(const roqYUVTables_t& tables, const int y, const int u, const int v, unsigned char* out)
+{
+	const int yy = tables.YY[y];
+
+	int r = (yy + tables.VR[v]) >> 6;
+	int g = (yy + tables.UG[u] + tables.VG[v]) >> 6;
+	int b = (yy + tables.UB[u]) >> 6;
+
+	if (r < 0)
+		r = 0;
+	if (g < 0)
+		g = 0;
+	if (b < 0)
+		b = 0;
+	if (r > 255)
+		r = 255;
+	if (g > 255)
+		g = 255;
+	if (b > 255)
+		b = 255;
+
+	out[0] = static_cast<unsigned char>(r);
+	out[1] = static_cast<unsigned char>(g);
+	out[2] = static_cast<unsigned char>(b);
+	out[3] = 255;
+}
+
+inline void ROQ_DecodeCells2(const roqYUVTables_t& tables, const unsigned char* input, const int numCells, unsigned char* vq2)
+{
+	for (int i = 0; i < numCells; i++, input += 6, vq2 += 16)
+	{
+		const int cr = input[4];
+		const int cb = input[5];
+		ROQ_YUVToRGBA(tables, input[0], cr, cb, vq2);
+		ROQ_YUVToRGBA(tables, input[1], cr, cb, vq2 + 4);
+		ROQ_YUVToRGBA(tables, input[2], cr, cb, vq2 + 8);
+		ROQ_YUVToRGBA(tables, input[3], cr, cb, vq2 + 12);
+	}
+}
+
+inline void ROQ_ExpandCells4(const unsigned char* vq2, const unsigned char* input, const int numCells, unsigned char* vq4, unsigned char* vq8)
+{
+	unsigned int* c = reinterpret_cast<unsigned int*>(vq4);
+	unsigned int* d = reinterpret_cast<unsigned int*>(vq8);
+
+	// each half of a 4x4 cell is a pair of 2x2 cells side by side
+	for (int i = 0; i < numCells * 2; i++, input += 2)
+	{
+		const unsigned int* a = reinterpret_cast<const unsigned int*>(vq2) + input[0] * 4;
+		const unsigned int* b = reinterpret_cast<const unsigned int*>(vq2) + input[1] * 4;
+
+		// one row of each 2x2 cell makes a 4 pixel row here and two 8 pixel rows in vq8
+		for (int j = 0; j < 2; j++, a += 2, b += 2)
+		{
+			*c++ = a[0];
+			*c++ = a[1];
+			*c++ = b[0];
+			*c++ = b[1];
+			for (int k = 0; k < 2; k++)
+			{
+				*d++ = a[0];
+				*d++ = a[0];
+				*d++ = a[1];
+				*d++ = a[1];
+				*d++ = b[0];
+				*d++ = b[0];
+				*d++ = b[1];
+				*d++ = b[1];
+			}
+		}
+	}
+}
+
+static const roqKernels_t roqKernelsScalar = {
+	"scalar",
+	ROQ_DecodeCells2,
+	ROQ_ExpandCells4,
+};
+
+#ifdef ROQ_SIMD_KERNELS
+/*
+====================================================================
+
+SSE2 KERNELS
+
+The four lumas of a cell share their chroma terms, so a cell is one
+vector of luma table entries plus three broadcast chroma terms.  The
+signed then unsigned saturating packs do the 0..255 clamp.
+
+====================================================================
+*/
+
+inline void ROQ_DecodeCells2SSE2(const roqYUVTables_t& tables, const unsigned char* input, const int numCells, unsigned char* vq2)
+{
+	const __m128i alpha = _mm_set1_epi32(255);
+
+	for (int i = 0; i < numCells; i++, input += 6, vq2 += 16)
+	{
+		const int cr = input[4];
+		const int cb = input[5];
+		const __m128i yy = _mm_set_epi32(tables.YY[input[3]], tables.YY[input[2]], tables.YY[input[1]], tables.YY[input[0]]);
+
+		const __m128i r = _mm_srai_epi32(_mm_add_epi32(yy, _mm_set1_epi32(tables.VR[cb])), 6);
+		const __m128i g = _mm_srai_epi32(_mm_add_epi32(yy, _mm_set1_epi32(tables.UG[cr] + tables.VG[cb])), 6);
+		const __m128i b = _mm_srai_epi32(_mm_add_epi32(yy, _mm_set1_epi32(tables.UB[cr])), 6);
+
+		// r0..r3 b0..b3 g0..g3 a0..a3, then interleave twice to r0 g0 b0 a0 r1 ...
+		const __m128i planar = _mm_packus_epi16(_mm_packs_epi32(r, b), _mm_packs_epi32(g, alpha));
+		const __m128i rgrg = _mm_unpacklo_epi8(planar, _mm_srli_si128(planar, 8));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(vq2), _mm_unpacklo_epi16(rgrg, _mm_srli_si128(rgrg, 8)));
+	}
+}
+
+inline void ROQ_ExpandCells4SSE2(const unsigned char* vq2, const unsigned char* input, const int numCells, unsigned char* vq4, unsigned char* vq8)
+{
+	for (int i = 0; i < numCells * 2; i++, input += 2, vq4 += 32, vq8 += 128)
+	{
+		const unsigned char* a = vq2 + input[0] * 16;
+		const unsigned char* b = vq2 + input[1] * 16;
+
+		for (int j = 0; j < 2; j++)
+		{
+			const __m128i row = _mm_unpacklo_epi64(
+				_mm_loadl_epi64(reinterpret_cast<const __m128i*>(a + j * 8)),
+				_mm_loadl_epi64(reinterpret_cast<const __m128i*>(b + j * 8)));
+			const __m128i left = _mm_unpacklo_epi32(row, row);
+			const __m128i right = _mm_unpackhi_epi32(row, row);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(vq4 + j * 16), row);
+			__m128i* d = reinterpret_cast<__m128i*>(vq8 + j * 64);
+			_mm_storeu_si128(d, left);
+			_mm_storeu_si128(d + 1, right);
+			_mm_storeu_si128(d + 2, left);
+			_mm_storeu_si128(d + 3, right);
+		}
+	}
+}
+
+static const roqKernels_t roqKernelsSSE2 = {
+	"SSE2",
+	ROQ_DecodeCells2SSE2,
+	ROQ_ExpandCells4SSE2,
+};
+#endif // ROQ_SIMD_KERNELS
@@ -0,0 +1,434 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// cl_cmdstream.cpp -- user command recording and replay
+//
+// A command stream holds what a single player session needs to be run
+// again frame for frame: the map, the random seed handed to the game, and
+// per engine frame the msec fed to SV_Frame/CL_Frame, the usercmd_t the
+// client generated (if any) and a checksum of the server entities after
+// the frame.  Replaying substitutes the recorded msec and commands and
+// reports the first frame whose entity checksum differs.
+//
+//	cmdrecord <name> <map>	start <map> and record into cmdstreams/<name>.ucs
+//	cmdplay <name>			start the recorded map and replay the stream
+//	cmdstop					stop recording or playback
+
+#include "../server/exe_headers.h"
+
+#include "client.h"
+
+#include <cstdlib>
+
+constexpr int CMDSTREAM_VERSION = 1;
+static constexpr char CMDSTREAM_MAGIC[4] = { 'U', 'C', 'S', '1' };
+
+// per frame flags
+constexpr byte CSF_CMD = 1;			// a usercmd_t was generated this frame
+constexpr byte CSF_SAMECMD = 2;		// ...and it matches the previous one apart from serverTime
+
+using cmdStreamState_t = enum
+{
+	CS_IDLE,
+	CS_RECORDING,
+	CS_PLAYING
+};
+
+static struct
+{
+	cmdStreamState_t state;
+	fileHandle_t file;
+	char name[MAX_QPATH];
+	int seed;
+	int frameNum;
+
+	// frame being recorded or replayed
+	int msec;
+	qboolean haveCmd;
+	usercmd_t cmd;
+	int checksum;
+
+	usercmd_t lastCmd;
+	int divergedFrame;
+	int numDiverged;
+} cmdStream;
+
+static void CL_CmdStreamWriteInt(const int value)
+{
+	const int le = LittleLong(value);
+	FS_Write(&le, sizeof(le), cmdStream.file);
+}
+
+static qboolean CL_CmdStreamReadInt(int& value)
+{
+	if (FS_Read(&value, sizeof(value), cmdStream.file) != sizeof(value))
+	{
+		return qfalse;
+	}
+	value = LittleLong(value);
+	return qtrue;
+}
+
+static qboolean CL_CmdStreamSameMove(const usercmd_t& a, const usercmd_t& b)
+{
+	return static_cast<qboolean>(a.buttons == b.buttons && a.weapon == b.weapon
+		&& a.angles[0] == b.angles[0] && a.angles[1] == b.angles[1] && a.angles[2] == b.angles[2]
+		&& a.generic_cmd == b.generic_cmd && a.forwardmove == b.forwardmove
+		&& a.rightmove == b.rightmove && a.upmove == b.upmove);
+}
+
+static void CL_CmdStreamWriteFrame()
+{
+	byte flags = 0;
+	if (cmdStream.haveCmd)
+	{
+		flags |= CSF_CMD;
+		if (cmdStream.frameNum > 0 && CL_CmdStreamSameMove(cmdStream.cmd, cmdStream.lastCmd))
+		{
+			flags |= CSF_SAMECMD;
+		}
+	}
+
+	const short msec = LittleShort(static_cast<short>(cmdStream.msec));
+	FS_Write(&flags, 1, cmdStream.file);
+	FS_Write(&msec, sizeof(msec), cmdStream.file);
+	CL_CmdStreamWriteInt(cmdStream.checksum);
+
+	if (flags & CSF_CMD)
+	{
+		const usercmd_t& cmd = cmdStream.cmd;
+		CL_CmdStreamWriteInt(cmd.serverTime);
+		if (!(flags & CSF_SAMECMD))
+		{
+			const signed char moves[3] = { cmd.forwardmove, cmd.rightmove, cmd.upmove };
+
+			CL_CmdStreamWriteInt(cmd.buttons);
+			CL_CmdStreamWriteInt(cmd.angles[0]);
+			CL_CmdStreamWriteInt(cmd.angles[1]);
+			CL_CmdStreamWriteInt(cmd.angles[2]);
+			FS_Write(&cmd.weapon, 1, cmdStream.file);
+			FS_Write(&cmd.generic_cmd, 1, cmdStream.file);
+			FS_Write(moves, sizeof(moves), cmdStream.file);
+		}
+		cmdStream.lastCmd = cmd;
+	}
+}
+
+static qboolean CL_CmdStreamReadFrame()
+{
+	byte flags;
+	short msec;
+
+	if (FS_Read(&flags, 1, cmdStream.file) != 1
+		|| FS_Read(&msec, sizeof(msec), cmdStream.file) != sizeof(msec)
+		|| !CL_CmdStreamReadInt(cmdStream.checksum))
+	{
+		return qfalse;
+	}
+	cmdStream.msec = LittleShort(msec);
+	cmdStream.haveCmd = static_cast<qboolean>((flags & CSF_CMD) != 0);
+
+	if (cmdStream.haveCmd)
+	{
+		usercmd_t& cmd = cmdStream.cmd;
+		if (flags & CSF_SAMECMD)
+		{
+			cmd = cmdStream.lastCmd;
+		}
+		else
+		{
+			signed char moves[3];
+
+			memset(&cmd, 0, sizeof(cmd));
+			if (!CL_CmdStreamReadInt(cmd.buttons)
+				|| !CL_CmdStreamReadInt(cmd.angles[0])
+				|| !CL_CmdStreamReadInt(cmd.angles[1])
+				|| !CL_CmdStreamReadInt(cmd.angles[2])
+				|| FS_Read(&cmd.weapon, 1, cmdStream.file) != 1
+				|| FS_Read(&cmd.generic_cmd, 1, cmdStream.file) != 1
+				|| FS_Read(moves, sizeof(moves), cmdStream.file) != sizeof(moves))
+			{
+				return qfalse;
+			}
+			cmd.forwardmove = moves[0];
+			cmd.rightmove = moves[1];
+			cmd.upmove = moves[2];
+		}
+		if (!CL_CmdStreamReadInt(cmd.serverTime))
+		{
+			return qfalse;
+		}
+		cmdStream.lastCmd = cmd;
+	}
+	return qtrue;
+}
+
+static void CL_CmdStreamStart(const int seed)
+{
+	// the engine and the game both draw from rand(), the engine from Q_irand/Q_flrand
+	// as well; the game seeds its own copy from the seed passed to its Init
+	cmdStream.seed = seed;
+	cmdStream.frameNum = 0;
+	cmdStream.divergedFrame = -1;
+	cmdStream.numDiverged = 0;
+	cmdStream.haveCmd = qfalse;
+	memset(&cmdStream.lastCmd, 0, sizeof(cmdStream.lastCmd));
+	Rand_Init(seed);
+	srand(seed);
+}
+
+/*
+===============
+CL_CmdStreamStop
+===============
+*/
+void CL_CmdStreamStop()
+{
+	switch (cmdStream.state)
+	{
+	case CS_RECORDING:
+		Com_Printf("Stopped recording %s: %i frames\n", cmdStream.name, cmdStream.frameNum);
+		break;
+	case CS_PLAYING:
+		Com_Printf("Finished playing %s: %i frames", cmdStream.name, cmdStream.frameNum);
+		if (cmdStream.numDiverged)
+		{
+			Com_Printf(", " S_COLOR_YELLOW "%i diverged, first at frame %i\n", cmdStream.numDiverged, cmdStream.divergedFrame);
+		}
+		else
+		{
+			Com_Printf(", no divergence\n");
+		}
+		Com_BenchmarkFinish();
+		break;
+	case CS_IDLE:
+	default:
+		return;
+	}
+
+	FS_FCloseFile(cmdStream.file);
+	cmdStream.file = 0;
+	cmdStream.state = CS_IDLE;
+}
+
+// the map name ends up in a devmap command, so nothing that could end it early
+static qboolean CL_CmdStreamValidMapName(const char* mapname)
+{
+	return static_cast<qboolean>(mapname[0] && !strpbrk(mapname, ";\n\r\""));
+}
+
+static void CL_CmdStreamRecord_f()
+{
+	if (Cmd_Argc() != 3)
+	{
+		Com_Printf("usage: cmdrecord <name> <map>\n");
+		return;
+	}
+	if (!CL_CmdStreamValidMapName(Cmd_Argv(2)))
+	{
+		Com_Printf(S_COLOR_RED "Bad map name %s\n", Cmd_Argv(2));
+		return;
+	}
+	CL_CmdStreamStop();
+
+	Q_strncpyz(cmdStream.name, va("cmdstreams/%s.ucs", Cmd_Argv(1)), sizeof(cmdStream.name));
+	cmdStream.file = FS_FOpenFileWrite(cmdStream.name);
+	if (!cmdStream.file)
+	{
+		Com_Printf(S_COLOR_RED "Couldn't open %s for writing\n", cmdStream.name);
+		return;
+	}
+
+	char mapname[MAX_QPATH];
+	Q_strncpyz(mapname, Cmd_Argv(2), sizeof(mapname));
+
+	const int seed = Com_Milliseconds();
+	FS_Write(CMDSTREAM_MAGIC, sizeof(CMDSTREAM_MAGIC), cmdStream.file);
+	CL_CmdStreamWriteInt(CMDSTREAM_VERSION);
+	CL_CmdStreamWriteInt(seed);
+	FS_Write(mapname, sizeof(mapname), cmdStream.file);
+
+	CL_CmdStreamStart(seed);
+	cmdStream.state = CS_RECORDING;
+	Com_Printf("Recording %s\n", cmdStream.name);
+
+	// runs before this frame's msec is taken, so the first recorded frame is the first one after the load
+	Cbuf_AddText(va("devmap %s\n", mapname));
+}
+
+static void CL_CmdStreamPlay_f()
+{
+	if (Cmd_Argc() != 2)
+	{
+		Com_Printf("usage: cmdplay <name>\n");
+		return;
+	}
+	CL_CmdStreamStop();
+
+	Q_strncpyz(cmdStream.name, va("cmdstreams/%s.ucs", Cmd_Argv(1)), sizeof(cmdStream.name));
+	FS_FOpenFileRead(cmdStream.name, &cmdStream.file, qtrue);
+	if (!cmdStream.file)
+	{
+		Com_Printf(S_COLOR_RED "Couldn't open %s\n", cmdStream.name);
+		return;
+	}
+
+	char magic[4];
+	int version = 0, seed = 0;
+	char mapname[MAX_QPATH];
+	if (FS_Read(magic, sizeof(magic), cmdStream.file) != sizeof(magic) || memcmp(magic, CMDSTREAM_MAGIC, sizeof(magic))
+		|| !CL_CmdStreamReadInt(version) || version != CMDSTREAM_VERSION
+		|| !CL_CmdStreamReadInt(seed)
+		|| FS_Read(mapname, sizeof(mapname), cmdStream.file) != sizeof(mapname))
+	{
+		Com_Printf(S_COLOR_RED "%s is not a version %i command stream\n", cmdStream.name, CMDSTREAM_VERSION);
+		FS_FCloseFile(cmdStream.file);
+		cmdStream.file = 0;
+		return;
+	}
+	mapname[sizeof(mapname) - 1] = '\0';
+	if (!CL_CmdStreamValidMapName(mapname))
+	{
+		Com_Printf(S_COLOR_RED "%s has a bad map name\n", cmdStream.name);
+		FS_FCloseFile(cmdStream.file);
+		cmdStream.file = 0;
+		return;
+	}
+
+	CL_CmdStreamStart(seed);
+	cmdStream.state = CS_PLAYING;
+	Com_Printf("Playing %s on %s\n", cmdStream.name, mapname);
+
+	Cbuf_AddText(va("devmap %s\n", mapname));
+}
+
+/*
+===============
+CL_CmdStreamSeed
+
+Seed handed to the game when it initializes
+===============
+*/
+int CL_CmdStreamSeed(const int seed)
+{
+	return cmdStream.state == CS_IDLE ? seed : cmdStream.seed;
+}
+
+/*
+===============
+CL_CmdStreamFrameMsec
+
+Called once per engine frame with the msec about to be run; returns the
+msec to actually run.
+===============
+*/
+int CL_CmdStreamFrameMsec(const int msec)
+{
+	switch (cmdStream.state)
+	{
+	case CS_RECORDING:
+		cmdStream.msec = msec;
+		cmdStream.haveCmd = qfalse;
+		return msec;
+	case CS_PLAYING:
+		if (!CL_CmdStreamReadFrame())
+		{
+			CL_CmdStreamStop();
+			return msec;
+		}
+		return cmdStream.msec;
+	case CS_IDLE:
+	default:
+		return msec;
+	}
+}
+
+/*
+===============
+CL_CmdStreamUsercmd
+
+Records the command the client just generated, or replaces it with the
+recorded one.
+===============
+*/
+void CL_CmdStreamUsercmd(usercmd_t* cmd)
+{
+	switch (cmdStream.state)
+	{
+	case CS_RECORDING:
+		cmdStream.cmd = *cmd;
+		cmdStream.haveCmd = qtrue;
+		break;
+	case CS_PLAYING:
+		if (cmdStream.haveCmd)
+		{
+			*cmd = cmdStream.cmd;
+		}
+		break;
+	case CS_IDLE:
+	default:
+		break;
+	}
+}
+
+/*
+===============
+CL_CmdStreamEndFrame
+===============
+*/
+void CL_CmdStreamEndFrame()
+{
+	if (cmdStream.state == CS_IDLE)
+	{
+		return;
+	}
+
+	const int checksum = SV_EntityChecksum();
+	if (cmdStream.state == CS_RECORDING)
+	{
+		cmdStream.checksum = checksum;
+		CL_CmdStreamWriteFrame();
+	}
+	else if (checksum != cmdStream.checksum)
+	{
+		if (!cmdStream.numDiverged)
+		{
+			cmdStream.divergedFrame = cmdStream.frameNum;
+			Com_Printf(S_COLOR_YELLOW "%s: entity state diverged at frame %i\n", cmdStream.name, cmdStream.frameNum);
+		}
+		cmdStream.numDiverged++;
+	}
+	cmdStream.frameNum++;
+}
+
+void CL_CmdStreamInit()
+{
+	Cmd_AddCommand("cmdrecord", CL_CmdStreamRecord_f);
+	Cmd_AddCommand("cmdplay", CL_CmdStreamPlay_f);
+	Cmd_AddCommand("cmdstop", CL_CmdStreamStop);
+}
+
+void CL_CmdStreamShutdown()
+{
+	CL_CmdStreamStop();
+	Cmd_RemoveCommand("cmdrecord");
+	Cmd_RemoveCommand("cmdplay");
+	Cmd_RemoveCommand("cmdstop");
+}
@@ -926,6 +926,7 @@ void CL_CreateNewCommands()
 	cl.cmdNumber++;
 	const int cmdNum = cl.cmdNumber & CMD_MASK;
 	cl.cmds[cmdNum] = CL_CreateCmd();
+	CL_CmdStreamUsercmd(&cl.cmds[cmdNum]);
 }
 
 /*
@@ -75,6 +75,7 @@ cvar_t* cl_activeAction;
 cvar_t* cl_allowAltEnter;
 
 cvar_t* cl_inGameVideo;
+cvar_t* cl_simdCinematics;
 
 cvar_t* cl_consoleKeys;
 cvar_t* cl_consoleUseScanCode;
@@ -1225,6 +1226,7 @@ void CL_InitRef()
 	RIT(FS_FreeFile);
 	RIT(FS_FreeFileList);
 	RIT(FS_ListFiles);
+	RIT(FS_LoadedPakHash);
 	RIT(FS_Read);
 	RIT(FS_ReadFile);
 	RIT(FS_Write);
@@ -1233,6 +1235,7 @@ void CL_InitRef()
 	RIT(SND_RegisterAudio_LevelLoadEnd);
 	//RIT(SV_PointContents);
 	RIT(SV_Trace);
+	RIT(SV_TraceBatch);
 	RIT(S_RestartMusic);
 	RIT(Z_Free);
 	RIT(Z_Malloc);
@@ -1349,6 +1352,7 @@ void CL_Init()
 
 	cl_allowAltEnter = Cvar_Get("cl_allowAltEnter", "1", CVAR_ARCHIVE_ND);
 	cl_inGameVideo = Cvar_Get("cl_inGameVideo", "1", CVAR_ARCHIVE_ND);
+	cl_simdCinematics = Cvar_Get("cl_simdCinematics", "1", CVAR_ARCHIVE_ND);
 	cl_framerate = Cvar_Get("cl_framerate", "0", CVAR_TEMP);
 
 	// init autoswitch so the ui will have it correctly even
@@ -1400,9 +1404,12 @@ void CL_Init()
 	Cmd_AddCommand("cinematic", CL_PlayCinematic_f);
 	Cmd_SetCommandCompletionFunc("cinematic", CL_CompleteCinematic);
 	Cmd_AddCommand("ingamecinematic", CL_PlayInGameCinematic_f);
+	Cmd_AddCommand("cinbench", CL_CinematicBenchmark_f);
+	Cmd_SetCommandCompletionFunc("cinbench", CL_CompleteCinematic);
 	Cmd_AddCommand("uimenu", CL_GenericMenu_f);
 	Cmd_AddCommand("datapad", CL_DataPad_f);
 	Cmd_AddCommand("endscreendissolve", CL_EndScreenDissolve_f);
+	CL_CmdStreamInit();
 
 	CL_InitRef();
 
@@ -1455,9 +1462,11 @@ void CL_Shutdown()
 	Cmd_RemoveCommand("disconnect");
 	Cmd_RemoveCommand("cinematic");
 	Cmd_RemoveCommand("ingamecinematic");
+	Cmd_RemoveCommand("cinbench");
 	Cmd_RemoveCommand("uimenu");
 	Cmd_RemoveCommand("datapad");
 	Cmd_RemoveCommand("endscreendissolve");
+	CL_CmdStreamShutdown();
 
 	Cvar_Set("cl_running", "0");
 
@@ -28,6 +28,7 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #include "client.h"
 #include "cl_mp3.h"					// only included directly by a few snd_xxxx.cpp files plus this one
 #include "../mp3code/mp3struct.h"	// keep this rather awful file secret from the rest of the program
+#include "../mp3code/csimd.h"
 
 // expects data already loaded, filename arg is for error printing only
 //
@@ -238,10 +239,14 @@ constexpr auto FUZZY_AMOUNT = (5 * 1024); // so it has to be significantly over,
 // the xtra CPU time versus memory saving
 
 cvar_t* cv_MP3overhead = nullptr;
+cvar_t* cv_MP3simd = nullptr;
 
 void MP3_InitCvars()
 {
 	cv_MP3overhead = Cvar_Get("s_mp3overhead", va("%d", sizeof(MP3STREAM) + FUZZY_AMOUNT), CVAR_ARCHIVE);
+	cv_MP3simd = Cvar_Get("s_mp3simd", "1", CVAR_ARCHIVE_ND | CVAR_LATCH);
+
+	Com_DPrintf("MP3 synthesis: %s\n", mp3_simd_init(cv_MP3simd->integer));
 }
 
 // a file has been loaded in memory, see if we want to keep it as MP3, else as normal WAV...
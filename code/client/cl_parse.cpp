@@ -253,58 +253,84 @@ void CL_ParseSnapshot(msg_t* msg)
 	new_snap.cmdNum = MSG_ReadLong(msg);
 	new_snap.snapFlags = MSG_ReadByte(msg);
 
-	// If the frame is delta compressed from data that we
-	// no longer have available, we must suck up the rest of
-	// the frame, but not use it, then ask for a non-compressed
-	// message
-	if (new_snap.deltaNum <= 0)
+	// the local server left the body of this snapshot in its own ring,
+	// so pick it up from there instead of parsing it
+	if (new_snap.snapFlags & SNAPFLAG_LOOPBACK)
 	{
-		new_snap.valid = qtrue; // uncompressed frame
+		const clientSnapshot_t* frame = SV_GetLoopbackSnapshot(new_snap.messageNum);
+		if (!frame)
+		{
+			Com_DPrintf("Loopback snapshot %i no longer available.\n", new_snap.messageNum);
+			return;
+		}
+
+		memcpy(new_snap.areamask, frame->areabits, frame->areabytes);
+		new_snap.ps = frame->ps;
+		new_snap.parseEntitiesNum = frame->first_entity;
+		new_snap.numEntities = frame->num_entities;
+		new_snap.valid = qtrue;
 		old = nullptr;
 	}
 	else
 	{
-		old = &cl.frames[new_snap.deltaNum & PACKET_MASK];
-		if (!old->valid)
+		// If the frame is delta compressed from data that we
+		// no longer have available, we must suck up the rest of
+		// the frame, but not use it, then ask for a non-compressed
+		// message
+		if (new_snap.deltaNum <= 0)
 		{
-			// should never happen
-			Com_Printf("Delta from invalid frame (not supposed to happen!).\n");
+			new_snap.valid = qtrue; // uncompressed frame
+			old = nullptr;
 		}
-		else if (old->messageNum != new_snap.deltaNum)
+		else
 		{
-			// The frame that the server did the delta from
-			// is too old, so we can't reconstruct it properly.
-			Com_Printf("Delta frame too old.\n");
+			old = &cl.frames[new_snap.deltaNum & PACKET_MASK];
+			if (!old->valid)
+			{
+				// should never happen
+				Com_Printf("Delta from invalid frame (not supposed to happen!).\n");
+			}
+			else if (old->messageNum != new_snap.deltaNum)
+			{
+				// The frame that the server did the delta from
+				// is too old, so we can't reconstruct it properly.
+				Com_Printf("Delta frame too old.\n");
+			}
+			else if (old->snapFlags & SNAPFLAG_LOOPBACK)
+			{
+				// its entities live in the server's ring, not ours
+				Com_Printf("Delta from loopback frame.\n");
+			}
+			else if (cl.parseEntitiesNum - old->parseEntitiesNum > MAX_PARSE_ENTITIES)
+			{
+				Com_Printf("Delta parseEntitiesNum too old.\n");
+			}
+			else
+			{
+				new_snap.valid = qtrue; // valid delta parse
+			}
 		}
-		else if (cl.parseEntitiesNum - old->parseEntitiesNum > MAX_PARSE_ENTITIES)
+
+		// read areamask
+		const int len = MSG_ReadByte(msg);
+		MSG_ReadData(msg, &new_snap.areamask, len);
+
+		// read playerinfo
+		SHOWNET(msg, "playerstate");
+		if (old)
 		{
-			Com_Printf("Delta parseEntitiesNum too old.\n");
+			MSG_ReadDeltaPlayerstate(msg, &old->ps, &new_snap.ps);
 		}
 		else
 		{
-			new_snap.valid = qtrue; // valid delta parse
+			MSG_ReadDeltaPlayerstate(msg, nullptr, &new_snap.ps);
 		}
-	}
 
-	// read areamask
-	const int len = MSG_ReadByte(msg);
-	MSG_ReadData(msg, &new_snap.areamask, len);
-
-	// read playerinfo
-	SHOWNET(msg, "playerstate");
-	if (old)
-	{
-		MSG_ReadDeltaPlayerstate(msg, &old->ps, &new_snap.ps);
-	}
-	else
-	{
-		MSG_ReadDeltaPlayerstate(msg, nullptr, &new_snap.ps);
+		// read packet entities
+		SHOWNET(msg, "packet entities");
+		CL_ParsePacketEntities(msg, old, &new_snap);
 	}
 
-	// read packet entities
-	SHOWNET(msg, "packet entities");
-	CL_ParsePacketEntities(msg, old, &new_snap);
-
 	// if not valid, dump the entire thing now that it has
 	// been properly read
 	if (!new_snap.valid)
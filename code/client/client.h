@@ -270,6 +270,7 @@ extern cvar_t* cl_showMouseRate;
 extern cvar_t* cl_allowAltEnter;
 
 extern cvar_t* cl_inGameVideo;
+extern cvar_t* cl_simdCinematics;
 
 extern cvar_t* m_pitch;
 extern cvar_t* m_yaw;
@@ -386,6 +387,7 @@ void	SCR_PrecacheScreenshot();
 //
 void CL_PlayCinematic_f();
 void CL_PlayInGameCinematic_f();
+void CL_CinematicBenchmark_f();
 qboolean CL_CheckPendingCinematic();
 qboolean CL_IsRunningInGameCinematic();
 qboolean CL_InGameCinematicOnStandBy();
@@ -402,6 +404,12 @@ void CIN_SetLooping(int handle, qboolean loop);
 void CIN_UploadCinematic(int handle);
 void CIN_CloseAllVideos();
 
+//
+// cl_cmdstream.cpp
+//
+void CL_CmdStreamInit();
+void CL_CmdStreamShutdown();
+
 //
 // cl_cgame.c
 //
@@ -192,6 +192,8 @@ cvar_t* s_lip_threshold_4;
 cvar_t* s_language; // note that this is distinct from "g_language"
 cvar_t* s_dynamix;
 cvar_t* s_debugdynamic;
+cvar_t* s_loadThreads;
+cvar_t* s_showLoadTimes;
 
 using loopSound_t = struct
 {
@@ -463,6 +465,8 @@ void S_Init()
 	s_show = Cvar_Get("s_show", "0", CVAR_CHEAT);
 	s_testsound = Cvar_Get("s_testsound", "0", CVAR_CHEAT);
 	s_debugdynamic = Cvar_Get("s_debugdynamic", "0", 0);
+	s_loadThreads = Cvar_Get("s_loadThreads", "2", CVAR_ARCHIVE_ND | CVAR_LATCH);
+	s_showLoadTimes = Cvar_Get("s_showLoadTimes", "0", 0);
 	s_lip_threshold_1 = Cvar_Get("s_threshold1", "0.3", 0);
 	s_lip_threshold_2 = Cvar_Get("s_threshold2", "4", 0);
 	s_lip_threshold_3 = Cvar_Get("s_threshold3", "6", 0);
@@ -489,6 +493,7 @@ void S_Init()
 	Cmd_AddCommand("soundinfo", S_SoundInfo_f);
 	Cmd_AddCommand("soundstop", S_StopAllSounds);
 	Cmd_AddCommand("mp3_calcvols", S_MP3_CalcVols_f);
+	Cmd_AddCommand("mp3bench", S_MP3_Bench_f);
 	Cmd_AddCommand("s_dynamic", S_SetDynamicMusic_f);
 	Cmd_AddCommand("menumusic", S_MenuMusic_f);
 	Cmd_AddCommand("totgmapmusic", S_totgmapmusic_f);
@@ -662,7 +667,7 @@ void S_ReloadAllUsedSounds()
 
 			if (!sfx->bInMemory && !sfx->bDefaultSound && sfx->iLastLevelUsedOn == re.RegisterMedia_GetLevel())
 			{
-				S_memoryLoad(sfx);
+				S_memoryLoad(sfx, qtrue);
 			}
 		}
 	}
@@ -679,6 +684,7 @@ void S_Shutdown()
 		return;
 	}
 
+	S_StopLoadThreads();
 	S_FreeAllSFXMem();
 	S_UnCacheDynamicMusic();
 
@@ -740,6 +746,7 @@ void S_Shutdown()
 	Cmd_RemoveCommand("soundinfo");
 	Cmd_RemoveCommand("soundstop");
 	Cmd_RemoveCommand("mp3_calcvols");
+	Cmd_RemoveCommand("mp3bench");
 	Cmd_RemoveCommand("s_dynamic");
 	AS_Free();
 }
@@ -1051,7 +1058,7 @@ sfxHandle_t S_RegisterSound(const char* name)
 
 	sfx->bInMemory = false;
 
-	S_memoryLoad(sfx);
+	S_memoryLoad(sfx, qtrue);
 
 	if (sfx->bDefaultSound)
 	{
@@ -1064,11 +1071,11 @@ sfxHandle_t S_RegisterSound(const char* name)
 	return sfx - s_knownSfx;
 }
 
-void S_memoryLoad(sfx_t* sfx)
+void S_memoryLoad(sfx_t* sfx, const qboolean b_may_defer /* = qfalse */)
 {
 	// load the sound file...
 	//
-	if (!S_LoadSound(sfx))
+	if (!S_LoadSound(sfx, b_may_defer))
 	{
 		//		Com_Printf( S_COLOR_YELLOW "WARNING: couldn't load sound: %s\n", sfx->sSoundName );
 		sfx->bDefaultSound = true;
@@ -2757,6 +2764,10 @@ Called once each time through the main loop
 */
 void S_Update()
 {
+	// anything S_RegisterSound() left with the load workers has to be finished before it can be mixed...
+	//
+	S_FinishPendingLoads();
+
 	if (!s_soundStarted || s_soundMuted)
 	{
 		return;
@@ -5285,6 +5296,8 @@ static int SND_FreeSFXMem(sfx_t* sfx)
 {
 	int iBytesFreed = 0;
 
+	S_FinishPendingLoads();	// in case a load worker is still writing to it
+
 #ifdef USE_OPENAL
 	if (s_UseOpenAL)
 	{
@@ -5450,6 +5463,8 @@ qboolean SND_RegisterAudio_LevelLoadEnd(const qboolean bDeleteEverythingNotUsedT
 
 	Com_DPrintf("SND_RegisterAudio_LevelLoadEnd():\n");
 
+	S_FinishPendingLoads();	// so everything registered this level is really in memory before we trim the pool
+
 	if (gbInsideLoadSound)
 	{
 		Com_DPrintf("(Inside S_LoadSound (z_malloc recovery?), exiting...\n");
@@ -5490,6 +5505,8 @@ qboolean SND_RegisterAudio_LevelLoadEnd(const qboolean bDeleteEverythingNotUsedT
 				}
 			}
 		}
+
+		S_LoadTimes_Report();
 	}
 
 	Com_DPrintf("SND_RegisterAudio_LevelLoadEnd(): Ok\n");
@@ -206,10 +206,17 @@ extern cvar_t* s_mixahead;
 
 extern cvar_t* s_testsound;
 extern cvar_t* s_separation;
+extern cvar_t* s_loadThreads;
+extern cvar_t* s_showLoadTimes;
 
 wavinfo_t GetWavinfo(const char* name, byte* wav, int wavlength);
 
-qboolean S_LoadSound(sfx_t* sfx);
+qboolean S_LoadSound(sfx_t* sfx, qboolean b_may_defer = qfalse);
+
+// level load workers, see snd_mem.cpp
+void S_FinishPendingLoads();
+void S_StopLoadThreads();
+void S_LoadTimes_Report();
 
 void S_PaintChannels(int endtime);
 
@@ -226,7 +233,7 @@ int SND_FreeOldestSound(const sfx_t* p_but_not_this_one = nullptr);
 void SND_TouchSFX(sfx_t* sfx);
 
 void S_DisplayFreeMemory();
-void S_memoryLoad(sfx_t* sfx);
+void S_memoryLoad(sfx_t* sfx, qboolean b_may_defer = qfalse);
 //
 //////////////////////////////////
 
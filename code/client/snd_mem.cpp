@@ -26,12 +26,17 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 
 #include "snd_local.h"
 #include "cl_mp3.h"
+#include "../mp3code/csimd.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #ifdef USE_OPENAL
 // Open AL
-void S_PreProcessLipSync(const sfx_t* sfx);
+static void S_PreProcessLipSync(const short* p_samples, int i_samples, float f_vol_range, const float* pf_thresholds, char* p_lip_sync_data);
 extern int s_UseOpenAL;
 #endif
 /*
@@ -196,56 +201,357 @@ wavinfo_t GetWavinfo(const char* name, byte* wav, const int wavlength)
 ResampleSfx
 
 resample / decimate to the current source rate
+
+returns the loudest sample (>> 8) for lip-synching. Only touches its args, so the
+level load workers can run it
 ================
 */
-void ResampleSfx(sfx_t* sfx, const int i_in_rate, const int i_in_width, byte* p_data)
+static float ResampleSfx(short* p_out, const int i_out_count, const float f_step_scale, const int i_in_width, const byte* p_data)
 {
-	int		i_sample;
-
-	const float f_step_scale = static_cast<float>(i_in_rate) / dma.speed;	// this is usually 0.5, 1, or 2
-
 	// When stepscale is > 1 (we're downsampling), we really ought to run a low pass filter on the samples
 
-	const int i_out_count = static_cast<int>(sfx->iSoundLengthInSamples / f_step_scale);
-	sfx->iSoundLengthInSamples = i_out_count;
-
-	sfx->pSoundData = reinterpret_cast<short*>(SND_malloc(sfx->iSoundLengthInSamples * 2, sfx));
-
-	sfx->fVolRange = 0;
+	float f_vol_range = 0;
 	unsigned int ui_sample_frac = 0;
 	const unsigned int ui_frac_step = static_cast<int>(f_step_scale * 256);
 
-	for (int i = 0; i < sfx->iSoundLengthInSamples; i++)
+	for (int i = 0; i < i_out_count; i++)
 	{
+		int i_sample;
 		const int i_src_sample = ui_sample_frac >> 8;
 		ui_sample_frac += ui_frac_step;
 		if (i_in_width == 2) {
-			i_sample = LittleShort reinterpret_cast<short*>(p_data)[i_src_sample];
+			i_sample = LittleShort reinterpret_cast<const short*>(p_data)[i_src_sample];
 		}
 		else {
 			i_sample = (p_data[i_src_sample] - 128) << 8;
 		}
 
-		sfx->pSoundData[i] = static_cast<short>(i_sample);
+		p_out[i] = static_cast<short>(i_sample);
 
 		// work out max vol for this sample...
 		//
 		if (i_sample < 0)
 			i_sample = -i_sample;
-		if (sfx->fVolRange < i_sample >> 8)
+		if (f_vol_range < i_sample >> 8)
+		{
+			f_vol_range = i_sample >> 8;
+		}
+	}
+
+	return f_vol_range;
+}
+
+/*
+===============================================================================
+
+LEVEL LOAD WORKERS
+
+The file reads and MP3 unpacking in S_LoadSound_Actual() stay on the main thread,
+since the filesystem and the MP3 decoder both keep global state, but once a sound's
+buffers are allocated the resample, volume scan and lip-sync pass only need those
+buffers. When S_RegisterSound() is loading, that part goes to s_loadThreads worker
+threads while the main thread reads the next file.
+
+The main thread finishes a job (AL upload, freeing the file) before anything can
+use the data: S_Update() finishes everything before mixing, SND_FreeSFXMem() before
+freeing and SND_RegisterAudio_LevelLoadEnd() before trimming the sound pool.
+
+===============================================================================
+*/
+
+using sndLoadJob_t = struct
+{
+	sfx_t* sfx;
+	byte* pb_file_data;			// from FS_ReadFile()
+	byte* pb_unpack_buffer;		// unpacked MP3, or NULL for WAVs
+	const byte* pb_src;			// what to resample, in one of the above
+	int i_in_width;
+	float f_step_scale;
+	short* p_out;				// sfx->pSoundData
+	int i_out_count;
+	bool b_mp3;
+#ifdef USE_OPENAL
+	char* p_lip_sync_data;		// sfx->lipSyncData if it wants working out here, else NULL
+	float f_lip_thresholds[4];
+#endif
+
+	// filled in by whoever runs the job...
+	float f_vol_range;
+	int64_t i_resample_usec;
+	int64_t i_lip_sync_usec;
+	bool b_done;
+};
+
+using sndLoadTimes_t = struct
+{
+	int i_sounds;
+	int i_mp3_unpacked;
+	int i_mp3_kept;
+	int i_file_bytes;
+	int64_t i_main_usec;		// all of S_LoadSound()
+	int64_t i_read_usec;		// FS_ReadFile(), including the foreign voice lookups
+	int64_t i_mp3_usec;			// validating, sizing and unpacking
+	int64_t i_resample_usec;	// summed over the workers
+	int64_t i_lip_sync_usec;	// summed over the workers
+	int64_t i_finish_usec;		// AL upload and freeing the file
+	int64_t i_wait_usec;		// main thread waiting for the workers
+};
+static sndLoadTimes_t s_load_times;
+
+constexpr size_t MAX_PENDING_LOADS = 32;	// files waiting to be finished still take up zone space
+
+static int s_load_workers;	// detached, so one still going at exit can't take the process down with it
+static std::mutex s_load_mutex;
+static std::condition_variable s_load_wake;		// job queued, or quitting
+static std::condition_variable s_load_done;		// job done, or worker gone
+static std::deque<sndLoadJob_t*> s_load_queue;	// waiting for a worker
+static std::deque<sndLoadJob_t> s_load_jobs;	// queued or done, in load order, until the main thread finishes them
+static bool s_load_quit;
+
+static void S_RunLoadJob(sndLoadJob_t& job)
+{
+	const int64_t i_start = Com_Microseconds();
+
+	job.f_vol_range = ResampleSfx(job.p_out, job.i_out_count, job.f_step_scale, job.i_in_width, job.pb_src);
+
+#ifdef Q3_BIG_ENDIAN
+	if (job.b_mp3)
+	{
+		// the MP3 decoder returns the samples in the correct endianness, but ResampleSfx byteswaps them,
+		// so we have to swap them again...
+		job.f_vol_range = 0;
+
+		for (int i = 0; i < job.i_out_count; i++)
+		{
+			job.p_out[i] = LittleShort(job.p_out[i]);
+			// C++11 defines double abs(short) which is not what we want here,
+			// because double >> int is not defined. Force interpretation as int
+			if (job.f_vol_range < (abs(static_cast<int>(job.p_out[i])) >> 8))
+			{
+				job.f_vol_range = abs(static_cast<int>(job.p_out[i])) >> 8;
+			}
+		}
+	}
+#endif
+
+	const int64_t i_resampled = Com_Microseconds();
+	job.i_resample_usec = i_resampled - i_start;
+
+#ifdef USE_OPENAL
+	if (job.p_lip_sync_data)
+	{
+		S_PreProcessLipSync(job.p_out, job.i_out_count, job.f_vol_range, job.f_lip_thresholds, job.p_lip_sync_data);
+	}
+#endif
+
+	job.i_lip_sync_usec = Com_Microseconds() - i_resampled;
+}
+
+static void S_LoadWorker()
+{
+	std::unique_lock<std::mutex> lock(s_load_mutex);
+
+	while (true)
+	{
+		s_load_wake.wait(lock, [] { return s_load_quit || !s_load_queue.empty(); });
+		if (s_load_queue.empty())
+		{
+			// quitting...
+			s_load_workers--;
+			s_load_done.notify_all();
+			return;
+		}
+
+		sndLoadJob_t* job = s_load_queue.front();
+		s_load_queue.pop_front();
+
+		lock.unlock();
+		S_RunLoadJob(*job);
+		lock.lock();
+
+		job->b_done = true;
+		s_load_done.notify_all();
+	}
+}
+
+// main thread only, once the job has been run...
+//
+static void S_FinishLoadJob(sndLoadJob_t& job)
+{
+	const int64_t i_start = Com_Microseconds();
+	sfx_t* sfx = job.sfx;
+
+	sfx->fVolRange = job.f_vol_range;
+
+	// Open AL
+#ifdef USE_OPENAL
+	if (s_UseOpenAL)
+	{
+		// Clear Open AL Error State
+		alGetError();
+
+		// Generate AL Buffer
+		ALuint buffer;
+		alGenBuffers(1, &buffer);
+		if (alGetError() == AL_NO_ERROR)
+		{
+			// Copy audio data to AL Buffer
+			alBufferData(buffer, AL_FORMAT_MONO16, sfx->pSoundData, sfx->iSoundLengthInSamples * 2, 22050);
+			if (alGetError() == AL_NO_ERROR)
+			{
+				// Store AL Buffer in sfx struct, and release sample data
+				sfx->Buffer = buffer;
+				Z_Free(sfx->pSoundData);
+				sfx->pSoundData = nullptr;
+			}
+		}
+	}
+#endif
+
+	if (job.pb_unpack_buffer)
+	{
+		Z_Free(job.pb_unpack_buffer);
+	}
+	FS_FreeFile(job.pb_file_data);
+
+	s_load_times.i_resample_usec += job.i_resample_usec;
+	s_load_times.i_lip_sync_usec += job.i_lip_sync_usec;
+	s_load_times.i_finish_usec += Com_Microseconds() - i_start;
+}
+
+static qboolean S_StartLoadThreads()
+{
+	if (!s_load_workers && s_loadThreads && s_loadThreads->integer > 0)
+	{
+		s_load_quit = false;
+		s_load_workers = Q_min(s_loadThreads->integer, 8);
+		for (int i = 0; i < s_load_workers; i++)
 		{
-			sfx->fVolRange = i_sample >> 8;
+			std::thread(S_LoadWorker).detach();
 		}
+		Com_DPrintf("Sound loading using %d worker threads\n", s_load_workers);
+	}
+
+	return static_cast<qboolean>(s_load_workers != 0);
+}
+
+// finishes jobs in load order, only waiting for the workers while there are more than i_leave_pending
+//
+static void S_FinishLoadJobs(const size_t i_leave_pending)
+{
+	while (!s_load_jobs.empty())
+	{
+		sndLoadJob_t& job = s_load_jobs.front();
+		{
+			std::unique_lock<std::mutex> lock(s_load_mutex);
+			if (!job.b_done)
+			{
+				if (s_load_jobs.size() <= i_leave_pending)
+				{
+					return;
+				}
+
+				const int64_t i_start = Com_Microseconds();
+				s_load_done.wait(lock, [&job] { return job.b_done; });
+				s_load_times.i_wait_usec += Com_Microseconds() - i_start;
+			}
+		}
+
+		S_FinishLoadJob(job);
+		s_load_jobs.pop_front();
 	}
 }
 
+void S_FinishPendingLoads()
+{
+	S_FinishLoadJobs(0);
+}
+
+void S_StopLoadThreads()
+{
+	S_FinishPendingLoads();
+
+	std::unique_lock<std::mutex> lock(s_load_mutex);
+	s_load_quit = true;
+	s_load_wake.notify_all();
+	s_load_done.wait(lock, [] { return s_load_workers == 0; });
+}
+
+static void S_RunOrQueueLoadJob(const sndLoadJob_t& job, const qboolean b_may_defer)
+{
+	if (!b_may_defer || !S_StartLoadThreads())
+	{
+		sndLoadJob_t now = job;
+		S_RunLoadJob(now);
+		S_FinishLoadJob(now);
+		return;
+	}
+
+	S_FinishLoadJobs(MAX_PENDING_LOADS - 1);
+
+	s_load_jobs.push_back(job);
+	{
+		std::lock_guard<std::mutex> lock(s_load_mutex);
+		s_load_queue.push_back(&s_load_jobs.back());
+	}
+	s_load_wake.notify_one();
+}
+
+// prints where the time went loading sounds since the last call, if s_showLoadTimes is set...
+//
+void S_LoadTimes_Report()
+{
+	const sndLoadTimes_t& t = s_load_times;
+
+	if (t.i_sounds && s_showLoadTimes && s_showLoadTimes->integer)
+	{
+		Com_Printf("%d sounds loaded (%d MP3s unpacked, %d kept as MP3), %.2fMB read, %.1fms in S_LoadSound()\n",
+			t.i_sounds, t.i_mp3_unpacked, t.i_mp3_kept, static_cast<float>(t.i_file_bytes) / 1024.0f / 1024.0f,
+			static_cast<float>(t.i_main_usec) / 1000.0f);
+		Com_Printf("  file reads  %8.1fms\n", static_cast<float>(t.i_read_usec) / 1000.0f);
+		Com_Printf("  MP3 unpack  %8.1fms\n", static_cast<float>(t.i_mp3_usec) / 1000.0f);
+		Com_Printf("  resample    %8.1fms (%s)\n", static_cast<float>(t.i_resample_usec) / 1000.0f,
+			s_load_workers ? va("%d worker threads", s_load_workers) : "main thread");
+		Com_Printf("  lip sync    %8.1fms\n", static_cast<float>(t.i_lip_sync_usec) / 1000.0f);
+		Com_Printf("  finishing   %8.1fms\n", static_cast<float>(t.i_finish_usec) / 1000.0f);
+		Com_Printf("  waiting     %8.1fms\n", static_cast<float>(t.i_wait_usec) / 1000.0f);
+	}
+
+	s_load_times = {};
+}
+
 //=============================================================================
 
-void S_LoadSound_Finalize(const wavinfo_t* info, sfx_t* sfx, byte* data)
+// allocates the sfx_t's data for the resampled sound described by info, and sets up the job that fills it in...
+//
+static void S_LoadSound_Finalize(const wavinfo_t* info, sfx_t* sfx, sndLoadJob_t& job, const bool b_lip_sync)
 {
+	job.f_step_scale = static_cast<float>(info->rate) / dma.speed;	// this is usually 0.5, 1, or 2
+	job.i_in_width = info->width;
+	job.i_out_count = static_cast<int>(info->samples / job.f_step_scale);
+
 	sfx->eSoundCompressionMethod = ct_16;
-	sfx->iSoundLengthInSamples = info->samples;
-	ResampleSfx(sfx, info->rate, info->width, data + info->dataofs);
+	sfx->iSoundLengthInSamples = job.i_out_count;
+	sfx->pSoundData = reinterpret_cast<short*>(SND_malloc(sfx->iSoundLengthInSamples * 2, sfx));
+	job.p_out = sfx->pSoundData;
+
+	// Open AL
+#ifdef USE_OPENAL
+	if (s_UseOpenAL)
+	{
+		if (b_lip_sync)
+		{
+			sfx->lipSyncData = static_cast<char*>(Z_Malloc(sfx->iSoundLengthInSamples / 1000 + 1, TAG_SND_RAWDATA, qfalse));
+			job.p_lip_sync_data = sfx->lipSyncData;
+			job.f_lip_thresholds[0] = s_lip_threshold_1->value;
+			job.f_lip_thresholds[1] = s_lip_threshold_2->value;
+			job.f_lip_thresholds[2] = s_lip_threshold_3->value;
+			job.f_lip_thresholds[3] = s_lip_threshold_4->value;
+		}
+		else
+			sfx->lipSyncData = nullptr;
+	}
+#endif
 }
 
 // maybe I'm re-inventing the wheel, here, but I can't see any functions that already do this, so...
@@ -336,21 +642,6 @@ void R_CheckMP3s(const char* ps_dir)
 
 				// I need to scan this file to get the volume...
 				//
-				// For EF1 I used a temp sfx_t struct, but I can't do that now with this new alloc scheme,
-				//	I have to ask for it legally, so I'll keep re-using one, and restoring it's name after use.
-				//	(slightly dodgy, but works ok if no-one else changes stuff)
-				//
-				//sfx_t SFX = {0};
-				extern sfx_t* s_find_name(const char* name);
-				//
-				static sfx_t* p_sfx = nullptr;
-				constexpr char s_reserved_sfx_entryname_for_mp3[] = "reserved_for_mp3";	// ( strlen() < MAX_QPATH )
-
-				if (p_sfx == nullptr)	// once only
-				{
-					p_sfx = s_find_name(s_reserved_sfx_entryname_for_mp3);	// always returns, else ERR_FATAL
-				}
-
 				if (MP3_IsValid(s_filename, pb_data, iSize, qbForceStereo))
 				{
 					wavinfo_t info{};
@@ -379,26 +670,15 @@ void R_CheckMP3s(const char* ps_dir)
 								info.format, info.rate, info.width, info.channels, info.samples, info.dataofs
 							);
 
-							S_LoadSound_Finalize(&info, p_sfx, pb_unpack_buffer);	// all this just for lipsynch. Oh well.
-
-							f_max_vol = p_sfx->fVolRange;
-
-							// free sfx->data...
+							// all this just for lipsynch. Oh well.
 							//
-							{
-#ifndef INT_MIN
-#define INT_MIN     (-2147483647 - 1) /* minimum (signed) int value */
-#endif
-								//
-								p_sfx->iLastTimeUsed = INT_MIN;		// force this to be oldest sound file, therefore disposable...
-								p_sfx->bInMemory = true;
-								SND_FreeOldestSound();		// ... and do the disposal
+							const float f_step_scale = static_cast<float>(info.rate) / dma.speed;
+							const int i_resampled = static_cast<int>(info.samples / f_step_scale);
+							const auto p_resampled = static_cast<short*>(Z_Malloc(i_resampled * 2, TAG_TEMP_WORKSPACE, qfalse));
 
-								// now set our temp SFX struct back to default name so nothing else accidentally uses it...
-								//
-								strcpy(p_sfx->sSoundName, s_reserved_sfx_entryname_for_mp3);
-								p_sfx->bDefaultSound = false;
-							}
+							f_max_vol = ResampleSfx(p_resampled, i_resampled, f_step_scale, info.width, pb_unpack_buffer + info.dataofs);
+
+							Z_Free(p_resampled);
 
 							//							OutputDebugString(va("File: \"%s\"   MaxVol %f\n",sFilename,pSFX->fVolRange));
 
@@ -543,6 +823,118 @@ void S_MP3_CalcVols_f()
 	}
 }
 
+struct mp3Bench_t
+{
+	int iFiles;
+	double dAudioSeconds;
+	int64_t iUsec[2];		// C, SIMD
+	int iSamplesDiffering;
+	int iMaxDiff;
+};
+
+static void S_MP3_Bench(const char* ps_dir, const int i_passes, mp3Bench_t& bench)
+{
+	int i, num_files, numdirs;
+
+	char** dir_files = FS_ListFiles(ps_dir, "/", &numdirs);
+	for (i = 2; i < numdirs; i++)
+	{
+		S_MP3_Bench(va("%s/%s", ps_dir, dir_files[i]), i_passes, bench);
+	}
+	FS_FreeFileList(dir_files);
+
+	char** mp3_files = FS_ListFiles(ps_dir, ".mp3", &num_files);
+	for (i = 0; i < num_files; i++)
+	{
+		char s_filename[MAX_QPATH];
+		Com_sprintf(s_filename, sizeof s_filename, "%s/%s", ps_dir, mp3_files[i]);
+
+		byte* pb_data = nullptr;
+		const int i_size = FS_ReadFile(s_filename, reinterpret_cast<void**>(&pb_data));
+		if (!pb_data)
+		{
+			continue;
+		}
+
+		int i_rate, i_width, i_channels;
+		const int i_raw_pcm_data_size = MP3_IsValid(s_filename, pb_data, i_size) ? MP3_GetUnpackedSize(s_filename, pb_data, i_size, qtrue) : 0;
+		if (i_raw_pcm_data_size && !C_MP3_GetHeaderData(pb_data, i_size, &i_rate, &i_width, &i_channels, qfalse))
+		{
+			// C synthesis into one buffer, SIMD into the other, then compare them
+			//
+			short* pcm[2];
+			for (int simd = 0; simd < 2; simd++)
+			{
+				pcm[simd] = static_cast<short*>(Z_Malloc(i_raw_pcm_data_size + 10, TAG_TEMP_WORKSPACE, qfalse));
+				mp3_simd_init(simd);
+
+				const int64_t start = Com_Microseconds();
+				for (int pass = 0; pass < i_passes; pass++)
+				{
+					MP3_UnpackRawPCM(s_filename, pb_data, i_size, reinterpret_cast<byte*>(pcm[simd]));
+				}
+				bench.iUsec[simd] += Com_Microseconds() - start;
+			}
+
+			for (int j = 0; j < i_raw_pcm_data_size / 2; j++)
+			{
+				const int i_diff = abs(pcm[0][j] - pcm[1][j]);
+				if (i_diff)
+				{
+					bench.iSamplesDiffering++;
+					bench.iMaxDiff = Q_max(bench.iMaxDiff, i_diff);
+				}
+			}
+			Z_Free(pcm[0]);
+			Z_Free(pcm[1]);
+
+			bench.iFiles++;
+			bench.dAudioSeconds += static_cast<double>(i_raw_pcm_data_size) * i_passes / (i_rate * i_width * i_channels);
+		}
+
+		FS_FreeFile(pb_data);
+	}
+	FS_FreeFileList(mp3_files);
+}
+
+// decodes every MP3 under a dir (default sound/chars, the voice files) to PCM with both the C and the SIMD synthesis
+//	code, reports how fast each went and checks they came out the same...
+//
+void S_MP3_Bench_f()
+{
+	if (Cmd_Argc() > 3)
+	{
+		Com_Printf("Usage: mp3bench [dir] [passes]\ne.g. mp3bench sound/chars/kyle 4\n");
+		return;
+	}
+
+	const char* ps_dir = Cmd_Argc() > 1 ? Cmd_Argv(1) : "sound/chars";
+	const int i_passes = Cmd_Argc() > 2 ? Q_max(1, atoi(Cmd_Argv(2))) : 1;
+
+	S_StopAllSounds();
+
+	mp3Bench_t bench{};
+	S_MP3_Bench(ps_dir, i_passes, bench);
+
+	extern cvar_t* cv_MP3simd;
+	const char* ps_synthesis = mp3_simd_init(cv_MP3simd ? cv_MP3simd->integer : 1);
+
+	if (!bench.iFiles)
+	{
+		Com_Printf("mp3bench: no MP3s found under \"%s\"\n", ps_dir);
+		return;
+	}
+
+	Com_Printf("mp3bench: %d files, %.1f seconds of audio x %d passes\n", bench.iFiles, bench.dAudioSeconds / i_passes, i_passes);
+	for (int simd = 0; simd < 2; simd++)
+	{
+		const double d_seconds = static_cast<double>(bench.iUsec[simd]) / 1000000.0;
+		Com_Printf("  %-6s %8.1f msec, %6.1fx realtime\n", simd ? "SIMD" : "C", d_seconds * 1000.0,
+			d_seconds > 0.0 ? bench.dAudioSeconds / d_seconds : 0.0);
+	}
+	Com_Printf("  %d samples differ, max difference %d (now using %s synthesis)\n", bench.iSamplesDiffering, bench.iMaxDiff, ps_synthesis);
+}
+
 // adjust filename for foreign languages and WAV/MP3 issues.
 //
 // returns qfalse if failed to load, else fills in *p_data
@@ -715,7 +1107,7 @@ of a forced fallback of a player specific sound	(or of a wav/mp3 substitution no
 ==============
 */
 qboolean gbInsideLoadSound = qfalse;
-static qboolean S_LoadSound_Actual(sfx_t* sfx)
+static qboolean S_LoadSound_Actual(sfx_t* sfx, const qboolean b_may_defer)
 {
 	byte* data;
 	wavinfo_t	info{};
@@ -749,17 +1141,26 @@ static qboolean S_LoadSound_Actual(sfx_t* sfx)
 		len = strlen(s_load_name);
 	}
 
-	if (!S_LoadSound_FileLoadAndNameAdjuster(s_load_name, &data, &size, len))
+	int64_t i_start = Com_Microseconds();
+	const qboolean b_found = S_LoadSound_FileLoadAndNameAdjuster(s_load_name, &data, &size, len);
+	s_load_times.i_read_usec += Com_Microseconds() - i_start;
+	if (!b_found)
 	{
 		return qfalse;
 	}
+	s_load_times.i_file_bytes += size;
 
 	SND_TouchSFX(sfx);
+
+	sndLoadJob_t job{};
+	job.sfx = sfx;
+	job.pb_file_data = data;
 	//=========
 	if (Q_stricmpn(ps_ext, ".mp3", 4) == 0)
 	{
 		// load MP3 file instead...
 		//
+		i_start = Com_Microseconds();
 		if (MP3_IsValid(s_load_name, data, size, qfalse))
 		{
 			const int i_raw_pcm_data_size = MP3_GetUnpackedSize(s_load_name, data, size, qfalse, qfalse);
@@ -781,90 +1182,45 @@ static qboolean S_LoadSound_Actual(sfx_t* sfx)
 						sfx->lipSyncData = nullptr;
 				}
 #endif
-			}
-			else
-			{
-				// small file, not worth keeping as MP3 since it would increase in size (with MP3 header etc)...
-				//
-				Com_DPrintf("S_LoadSound: Unpacking MP3 file \"%s\" to wav.\n", s_load_name);
-				//
-				// unpack and convert into WAV...
-				//
-				{
-					{
-						const auto pb_unpack_buffer = static_cast<byte*>(Z_Malloc(i_raw_pcm_data_size + 10 + 2304 /* <g> */, TAG_TEMP_WORKSPACE, qfalse));
-						const int i_result_bytes = MP3_UnpackRawPCM(s_load_name, data, size, pb_unpack_buffer, qfalse);
-
-						if (i_result_bytes != i_raw_pcm_data_size) {
-							Com_Printf(S_COLOR_YELLOW"**** MP3 %s final unpack size %d different to previous value %d\n", s_load_name, i_result_bytes, i_raw_pcm_data_size);
-							//assert (iResultBytes == iRawPCMDataSize);
-						}
-
-						// fake up a WAV structure so I can use the other post-load sound code such as volume calc for lip-synching
-						//
-						// (this is a bit crap really, but it lets me drop through into existing code)...
-						//
-						MP3_FakeUpWAVInfo(s_load_name, data, size, i_result_bytes,
-							// these params are all references...
-							info.format, info.rate, info.width, info.channels, info.samples, info.dataofs,
-							qfalse
-						);
+				s_load_times.i_mp3_usec += Com_Microseconds() - i_start;
+				s_load_times.i_mp3_kept++;
+				s_load_times.i_sounds++;
 
-						S_LoadSound_Finalize(&info, sfx, pb_unpack_buffer);
+				FS_FreeFile(data);
 
-#ifdef Q3_BIG_ENDIAN
-						// the MP3 decoder returns the samples in the correct endianness, but ResampleSfx byteswaps them,
-						// so we have to swap them again...
-						sfx->fVolRange = 0;
-
-						for (int i = 0; i < sfx->iSoundLengthInSamples; i++)
-						{
-							sfx->pSoundData[i] = LittleShort(sfx->pSoundData[i]);
-							// C++11 defines double abs(short) which is not what we want here,
-							// because double >> int is not defined. Force interpretation as int
-							if (sfx->fVolRange < (abs(static_cast<int>(sfx->pSoundData[i])) >> 8))
-							{
-								sfx->fVolRange = abs(static_cast<int>(sfx->pSoundData[i])) >> 8;
-							}
-						}
-#endif
-
-						// Open AL
-#ifdef USE_OPENAL
-						if (s_UseOpenAL)
-						{
-							if (strstr(sfx->sSoundName, "chars"))
-							{
-								sfx->lipSyncData = static_cast<char*>(Z_Malloc(sfx->iSoundLengthInSamples / 1000 + 1, TAG_SND_RAWDATA, qfalse));
-								S_PreProcessLipSync(sfx);
-							}
-							else
-								sfx->lipSyncData = nullptr;
-
-							// Clear Open AL Error state
-							alGetError();
+				return qtrue;
+			}
 
-							// Generate AL Buffer
-							ALuint buffer;
-							alGenBuffers(1, &buffer);
-							if (alGetError() == AL_NO_ERROR)
-							{
-								// Copy audio data to AL Buffer
-								alBufferData(buffer, AL_FORMAT_MONO16, sfx->pSoundData, sfx->iSoundLengthInSamples * 2, 22050);
-								if (alGetError() == AL_NO_ERROR)
-								{
-									sfx->Buffer = buffer;
-									Z_Free(sfx->pSoundData);
-									sfx->pSoundData = nullptr;
-								}
-							}
-						}
-#endif
+			// small file, not worth keeping as MP3 since it would increase in size (with MP3 header etc)...
+			//
+			Com_DPrintf("S_LoadSound: Unpacking MP3 file \"%s\" to wav.\n", s_load_name);
+			//
+			// unpack and convert into WAV...
+			//
+			job.pb_unpack_buffer = static_cast<byte*>(Z_Malloc(i_raw_pcm_data_size + 10 + 2304 /* <g> */, TAG_TEMP_WORKSPACE, qfalse));
+			const int i_result_bytes = MP3_UnpackRawPCM(s_load_name, data, size, job.pb_unpack_buffer, qfalse);
 
-						Z_Free(pb_unpack_buffer);
-					}
-				}
+			if (i_result_bytes != i_raw_pcm_data_size) {
+				Com_Printf(S_COLOR_YELLOW"**** MP3 %s final unpack size %d different to previous value %d\n", s_load_name, i_result_bytes, i_raw_pcm_data_size);
+				//assert (iResultBytes == iRawPCMDataSize);
 			}
+
+			// fake up a WAV structure so I can use the other post-load sound code such as volume calc for lip-synching
+			//
+			// (this is a bit crap really, but it lets me drop through into existing code)...
+			//
+			MP3_FakeUpWAVInfo(s_load_name, data, size, i_result_bytes,
+				// these params are all references...
+				info.format, info.rate, info.width, info.channels, info.samples, info.dataofs,
+				qfalse
+			);
+
+			s_load_times.i_mp3_usec += Com_Microseconds() - i_start;
+			s_load_times.i_mp3_unpacked++;
+
+			job.pb_src = job.pb_unpack_buffer + info.dataofs;
+			job.b_mp3 = true;
+			S_LoadSound_Finalize(&info, sfx, job, strstr(sfx->sSoundName, "chars") != nullptr);
 		}
 		else
 		{
@@ -895,50 +1251,14 @@ static qboolean S_LoadSound_Actual(sfx_t* sfx)
 					Com_Printf(S_COLOR_YELLOW "WARNING: %s is not a 22kHz wav file\n", sLoadName);
 				}
 		*/
-		const auto samples = static_cast<short*>(Z_Malloc(info.samples * sizeof(short) * 2, TAG_TEMP_WORKSPACE, qfalse));
-
-		sfx->eSoundCompressionMethod = ct_16;
-		sfx->iSoundLengthInSamples = info.samples;
-		sfx->pSoundData = nullptr;
-		ResampleSfx(sfx, info.rate, info.width, data + info.dataofs);
-
-		// Open AL
-#ifdef USE_OPENAL
-		if (s_UseOpenAL)
-		{
-			if (strstr(sfx->sSoundName, "chars") || strstr(sfx->sSoundName, "CHARS"))
-			{
-				sfx->lipSyncData = static_cast<char*>(Z_Malloc(sfx->iSoundLengthInSamples / 1000 + 1, TAG_SND_RAWDATA, qfalse));
-				S_PreProcessLipSync(sfx);
-			}
-			else
-				sfx->lipSyncData = nullptr;
-
-			// Clear Open AL Error State
-			alGetError();
-
-			// Generate AL Buffer
-			ALuint buffer;
-			alGenBuffers(1, &buffer);
-			if (alGetError() == AL_NO_ERROR)
-			{
-				// Copy audio data to AL Buffer
-				alBufferData(buffer, AL_FORMAT_MONO16, sfx->pSoundData, sfx->iSoundLengthInSamples * 2, 22050);
-				if (alGetError() == AL_NO_ERROR)
-				{
-					// Store AL Buffer in sfx struct, and release sample data
-					sfx->Buffer = buffer;
-					Z_Free(sfx->pSoundData);
-					sfx->pSoundData = nullptr;
-				}
-			}
-		}
-#endif
-
-		Z_Free(samples);
+		job.pb_src = data + info.dataofs;
+		S_LoadSound_Finalize(&info, sfx, job, strstr(sfx->sSoundName, "chars") || strstr(sfx->sSoundName, "CHARS"));
 	}
 
-	FS_FreeFile(data);
+	// the resample and lip-sync pass, then FS_FreeFile() of the data when it's finished...
+	//
+	S_RunOrQueueLoadJob(job, b_may_defer);
+	s_load_times.i_sounds++;
 
 	return qtrue;
 }
@@ -946,11 +1266,15 @@ static qboolean S_LoadSound_Actual(sfx_t* sfx)
 // wrapper function for above so I can guarantee that we don't attempt any audio-dumping during this call because
 //	of a z_malloc() fail recovery...
 //
-qboolean S_LoadSound(sfx_t* sfx)
+// b_may_defer lets the resample etc go to the level load workers, for S_RegisterSound()
+//
+qboolean S_LoadSound(sfx_t* sfx, const qboolean b_may_defer /* = qfalse */)
 {
 	gbInsideLoadSound = qtrue;	// !!!!!!!!!!!!!
 
-	const qboolean b_return = S_LoadSound_Actual(sfx);
+	const int64_t i_start = Com_Microseconds();
+	const qboolean b_return = S_LoadSound_Actual(sfx, b_may_defer);
+	s_load_times.i_main_usec += Com_Microseconds() - i_start;
 
 	gbInsideLoadSound = qfalse;	// !!!!!!!!!!!!!
 
@@ -960,17 +1284,19 @@ qboolean S_LoadSound(sfx_t* sfx)
 #ifdef USE_OPENAL
 /*
 	Precalculate the lipsync values for the whole sample
+
+	(runs on the level load workers, so everything comes in as args)
 */
-void S_PreProcessLipSync(const sfx_t* sfx)
+static void S_PreProcessLipSync(const short* p_samples, const int i_samples, const float f_vol_range, const float* pf_thresholds, char* p_lip_sync_data)
 {
 	int i;
 	int sample;
 	int sample_total = 0;
 
 	int j = 0;
-	for (i = 0; i < sfx->iSoundLengthInSamples; i += 100)
+	for (i = 0; i < i_samples; i += 100)
 	{
-		sample = LittleShort sfx->pSoundData[i];
+		sample = LittleShort p_samples[i];
 
 		sample = sample >> 8;
 		sample_total += sample * sample;
@@ -978,21 +1304,21 @@ void S_PreProcessLipSync(const sfx_t* sfx)
 		{
 			sample_total /= 10;
 
-			if (sample_total < sfx->fVolRange * s_lip_threshold_1->value)
+			if (sample_total < f_vol_range * pf_thresholds[0])
 			{
 				// tell the scripts that are relying on this that we are still going, but actually silent right now.
 				sample = -1;
 			}
-			else if (sample_total < sfx->fVolRange * s_lip_threshold_2->value)
+			else if (sample_total < f_vol_range * pf_thresholds[1])
 				sample = 1;
-			else if (sample_total < sfx->fVolRange * s_lip_threshold_3->value)
+			else if (sample_total < f_vol_range * pf_thresholds[2])
 				sample = 2;
-			else if (sample_total < sfx->fVolRange * s_lip_threshold_4->value)
+			else if (sample_total < f_vol_range * pf_thresholds[3])
 				sample = 3;
 			else
 				sample = 4;
 
-			sfx->lipSyncData[j] = sample;
+			p_lip_sync_data[j] = sample;
 			j++;
 
 			sample_total = 0;
@@ -1011,20 +1337,20 @@ void S_PreProcessLipSync(const sfx_t* sfx)
 	else
 		sample_total = 0;
 
-	if (sample_total < sfx->fVolRange * s_lip_threshold_1->value)
+	if (sample_total < f_vol_range * pf_thresholds[0])
 	{
 		// tell the scripts that are relying on this that we are still going, but actually silent right now.
 		sample = -1;
 	}
-	else if (sample_total < sfx->fVolRange * s_lip_threshold_2->value)
+	else if (sample_total < f_vol_range * pf_thresholds[1])
 		sample = 1;
-	else if (sample_total < sfx->fVolRange * s_lip_threshold_3->value)
+	else if (sample_total < f_vol_range * pf_thresholds[2])
 		sample = 2;
-	else if (sample_total < sfx->fVolRange * s_lip_threshold_4->value)
+	else if (sample_total < f_vol_range * pf_thresholds[3])
 		sample = 3;
 	else
 		sample = 4;
 
-	sfx->lipSyncData[j] = sample;
+	p_lip_sync_data[j] = sample;
 }
 #endif
\ No newline at end of file
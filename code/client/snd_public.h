@@ -51,6 +51,7 @@ void S_StopAllSounds();
 
 // scan all MP3s in the sound dir and add maxvol info if necessary.
 void S_MP3_CalcVols_f();
+void S_MP3_Bench_f();
 
 // all continuous looping sounds must be added before calling S_Update
 void S_ClearLoopingSounds();
@@ -30,6 +30,139 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #endif
 
 extern int eventClearTime;
+extern cvar_t* g_perceptionCache;
+
+/*
+-------------------------
+Perception cache
+
+Line of sight through opaque brushes does not depend on who is looking, only
+on where from and to, so within one frame every NPC asking the same question
+gets the answer of the first trace.  Entries are stamped with the frame they
+were traced on and simply ignored after that.  level.framenum starts over on
+a new map or a loaded save, so G_PerceptionClear() is called then.
+-------------------------
+*/
+
+enum perceptionKind_t
+{
+	PERCEPT_CANSEE, // CanSee() from an NPC's eyes to a target
+	PERCEPT_CLEARLOS // G_ClearLOS() between two points
+};
+
+struct perceptionEntry_t
+{
+	int frame;
+	int kind;
+	int target;
+	vec3_t start;
+	vec3_t end;
+	qboolean result;
+};
+
+constexpr auto PERCEPTION_CACHE_SIZE = 1024; // power of two
+constexpr auto PERCEPTION_CACHE_PROBES = 8;
+
+static perceptionEntry_t perceptionCache[PERCEPTION_CACHE_SIZE];
+
+static struct
+{
+	int queries;
+	int hits;
+	int traces;
+	int frames;
+} perceptionStats;
+
+static unsigned int G_PerceptionHash(const int kind, const int target, const vec3_t start, const vec3_t end)
+{
+	unsigned int hash = Com_HashFNV1a(FNV1A_INIT, kind);
+	hash = Com_HashFNV1a(hash, target);
+	for (int i = 0; i < 3; i++)
+	{
+		unsigned int bits;
+		memcpy(&bits, &start[i], sizeof bits);
+		hash = Com_HashFNV1a(hash, bits);
+		memcpy(&bits, &end[i], sizeof bits);
+		hash = Com_HashFNV1a(hash, bits);
+	}
+	return hash;
+}
+
+static perceptionEntry_t* G_PerceptionLookup(const int kind, const int target, const vec3_t start, const vec3_t end,
+	qboolean* found)
+{
+	const unsigned int hash = G_PerceptionHash(kind, target, start, end);
+	perceptionEntry_t* stale = nullptr;
+
+	perceptionStats.queries++;
+
+	for (int i = 0; i < PERCEPTION_CACHE_PROBES; i++)
+	{
+		perceptionEntry_t* entry = &perceptionCache[(hash + i) & (PERCEPTION_CACHE_SIZE - 1)];
+		if (entry->frame != level.framenum)
+		{
+			if (!stale)
+			{
+				stale = entry;
+			}
+			continue;
+		}
+		if (entry->kind == kind && entry->target == target
+			&& VectorCompare(entry->start, start) && VectorCompare(entry->end, end))
+		{
+			perceptionStats.hits++;
+			*found = qtrue;
+			return entry;
+		}
+	}
+
+	*found = qfalse;
+	if (stale)
+	{
+		stale->frame = level.framenum;
+		stale->kind = kind;
+		stale->target = target;
+		VectorCopy(start, stale->start);
+		VectorCopy(end, stale->end);
+	}
+	// if every probe is taken this frame the answer just isn't stored
+	return stale;
+}
+
+void G_PerceptionClear()
+{
+	for (perceptionEntry_t& entry : perceptionCache)
+	{
+		entry.frame = -1;
+	}
+}
+
+/*
+-------------------------
+G_PerceptionFrame
+
+Called once per frame before any entity thinks.
+-------------------------
+*/
+void G_PerceptionFrame()
+{
+	if (g_perceptionCache->integer < 2)
+	{
+		return;
+	}
+
+	perceptionStats.frames++;
+	if (perceptionStats.frames < 20)
+	{
+		return;
+	}
+
+	gi.Printf("perception: %d queries, %d from cache, %d traces in %d frames (%.1f traces/frame)\n",
+		perceptionStats.queries, perceptionStats.hits, perceptionStats.traces, perceptionStats.frames,
+		static_cast<float>(perceptionStats.traces) / perceptionStats.frames);
+	memset(&perceptionStats, 0, sizeof perceptionStats);
+}
+
 qboolean G_ClearLineOfSight(const vec3_t point1, const vec3_t point2, const int ignore, const int clipmask)
 {
 	trace_t tr;
@@ -65,17 +198,18 @@ or take any AI related factors (for example, the NPC's reaction time) into accou
 
 FIXME do we need fat and thin version of this?
 */
-qboolean CanSee(const gentity_t* ent)
+static qboolean CanSee_Trace(const gentity_t* ent, const vec3_t eyes)
 {
 	trace_t tr;
-	vec3_t eyes;
 	vec3_t spot;
 
-	CalcEntitySpot(NPC, SPOT_HEAD_LEAN, eyes);
-
 	CalcEntitySpot(ent, SPOT_ORIGIN, spot);
 	gi.trace(&tr, eyes, nullptr, nullptr, spot, NPC->s.number, MASK_OPAQUE, static_cast<EG2_Collision>(0), 0);
-	ShotThroughGlass(&tr, ent, spot, MASK_OPAQUE);
+	perceptionStats.traces++;
+	if (ShotThroughGlass(&tr, ent, spot, MASK_OPAQUE))
+	{
+		perceptionStats.traces++;
+	}
 	if (tr.fraction == 1.0)
 	{
 		return qtrue;
@@ -83,7 +217,11 @@ qboolean CanSee(const gentity_t* ent)
 
 	CalcEntitySpot(ent, SPOT_HEAD, spot);
 	gi.trace(&tr, eyes, nullptr, nullptr, spot, NPC->s.number, MASK_OPAQUE, static_cast<EG2_Collision>(0), 0);
-	ShotThroughGlass(&tr, ent, spot, MASK_OPAQUE);
+	perceptionStats.traces++;
+	if (ShotThroughGlass(&tr, ent, spot, MASK_OPAQUE))
+	{
+		perceptionStats.traces++;
+	}
 	if (tr.fraction == 1.0)
 	{
 		return qtrue;
@@ -91,7 +229,11 @@ qboolean CanSee(const gentity_t* ent)
 
 	CalcEntitySpot(ent, SPOT_LEGS, spot);
 	gi.trace(&tr, eyes, nullptr, nullptr, spot, NPC->s.number, MASK_OPAQUE, static_cast<EG2_Collision>(0), 0);
-	ShotThroughGlass(&tr, ent, spot, MASK_OPAQUE);
+	perceptionStats.traces++;
+	if (ShotThroughGlass(&tr, ent, spot, MASK_OPAQUE))
+	{
+		perceptionStats.traces++;
+	}
 	if (tr.fraction == 1.0)
 	{
 		return qtrue;
@@ -100,6 +242,34 @@ qboolean CanSee(const gentity_t* ent)
 	return qfalse;
 }
 
+qboolean CanSee(const gentity_t* ent)
+{
+	vec3_t eyes;
+
+	CalcEntitySpot(NPC, SPOT_HEAD_LEAN, eyes);
+
+	if (!g_perceptionCache->integer)
+	{
+		return CanSee_Trace(ent, eyes);
+	}
+
+	// the target's origin stands in for all three of its spots
+	qboolean found;
+	perceptionEntry_t* entry = G_PerceptionLookup(PERCEPT_CANSEE, NPC->s.number << 16 | ent->s.number, eyes,
+		ent->currentOrigin, &found);
+	if (found)
+	{
+		return entry->result;
+	}
+
+	const qboolean result = CanSee_Trace(ent, eyes);
+	if (entry)
+	{
+		entry->result = result;
+	}
+	return result;
+}
+
 qboolean InFront(vec3_t spot, vec3_t from, vec3_t fromAngles, const float threshHold = 0.0f)
 {
 	vec3_t dir, forward, angles;
@@ -949,8 +1119,7 @@ G_ClearLOS
 -------------------------
 */
 
-// Position to position
-qboolean G_ClearLOS(gentity_t* self, const vec3_t start, const vec3_t end)
+static qboolean G_ClearLOS_Trace(const vec3_t start, const vec3_t end)
 {
 	trace_t tr;
 	int traceCount = 0;
@@ -959,6 +1128,7 @@ qboolean G_ClearLOS(gentity_t* self, const vec3_t start, const vec3_t end)
 	gi.trace(&tr, start, nullptr, nullptr, end, ENTITYNUM_NONE,
 		CONTENTS_OPAQUE/*CONTENTS_SOLID*//*(CONTENTS_SOLID|CONTENTS_MONSTERCLIP)*/, static_cast<EG2_Collision>(0),
 		0);
+	perceptionStats.traces++;
 	while (tr.fraction < 1.0 && traceCount < 3)
 	{
 		//can see through 3 panes of glass
@@ -969,6 +1139,7 @@ qboolean G_ClearLOS(gentity_t* self, const vec3_t start, const vec3_t end)
 				//can see through glass, trace again, ignoring me
 				gi.trace(&tr, tr.endpos, nullptr, nullptr, end, tr.entityNum, MASK_OPAQUE,
 					static_cast<EG2_Collision>(0), 0);
+				perceptionStats.traces++;
 				traceCount++;
 				continue;
 			}
@@ -982,6 +1153,30 @@ qboolean G_ClearLOS(gentity_t* self, const vec3_t start, const vec3_t end)
 	return qfalse;
 }
 
+// Position to position
+qboolean G_ClearLOS(gentity_t* self, const vec3_t start, const vec3_t end)
+{
+	if (!g_perceptionCache->integer)
+	{
+		return G_ClearLOS_Trace(start, end);
+	}
+
+	// doesn't depend on self at all, so any NPC's answer will do
+	qboolean found;
+	perceptionEntry_t* entry = G_PerceptionLookup(PERCEPT_CLEARLOS, ENTITYNUM_NONE, start, end, &found);
+	if (found)
+	{
+		return entry->result;
+	}
+
+	const qboolean result = G_ClearLOS_Trace(start, end);
+	if (entry)
+	{
+		entry->result = result;
+	}
+	return result;
+}
+
 //Entity to position
 qboolean G_ClearLOS(gentity_t* self, const gentity_t* ent, const vec3_t end)
 {
@@ -4020,6 +4020,7 @@ static void Q3_SetTargetName(const int entID, const char* targetname)
 	else
 	{
 		self->targetname = G_NewString(targetname);
+		G_UpdateFindIndex(self);
 	}
 }
 
@@ -8001,6 +8002,7 @@ bool CQuake3GameInterface::ValidEntity(gentity_t* pEntity)
 		{
 			//Com_Printf( "WARNING: Entity %d (%s) has behaviorSet but no script_targetname -- using targetname\n", pEntity->s.number, pEntity->targetname );
 			pEntity->script_targetname = G_NewString(pEntity->targetname);
+			G_UpdateFindIndex(pEntity);
 			return true;
 		}
 	}
@@ -3319,6 +3319,7 @@ qboolean ClientSpawn(gentity_t* ent, SavedGameJustLoaded_e e_saved_game_just_loa
 		}
 		ent->classname = "player";
 		ent->targetname = ent->script_targetname = "player";
+		G_UpdateFindIndex(ent);
 		if (ent->client->NPC_class == CLASS_NONE)
 		{
 			ent->client->NPC_class = CLASS_PLAYER;
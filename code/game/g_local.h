@@ -441,6 +441,10 @@ int G_BSPIndex(const char* name);
 
 void G_KillBox(gentity_t* ent);
 gentity_t* G_Find(gentity_t* from, int fieldofs, const char* match);
+void G_UpdateFindIndex(const gentity_t* ent);
+void G_SyncFindIndex();
+void G_InvalidateFindIndex();
+void G_PerceptionClear();
 int G_RadiusList(vec3_t origin, float radius, const gentity_t* ignore, qboolean take_damage,
 	gentity_t* ent_list[MAX_GENTITIES]);
 gentity_t* G_PickTarget(char* targetname);
@@ -575,6 +579,7 @@ void NORETURN QDECL G_Error(const char* fmt, ...);
 void SetInUse(const gentity_t* ent);
 void ClearInUse(const gentity_t* ent);
 qboolean PInUse(unsigned int entNum);
+int G_NextInUse(int start, int limit);
 void WriteInUseBits();
 void ReadInUseBits();
 
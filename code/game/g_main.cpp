@@ -35,6 +35,8 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #include "../ghoul2/ghoul2_gore.h"
 //rww - RAGDOLL_END
 
+#include <chrono>
+
 #include "qcommon/ojk_saved_game_helper.h"
 
 extern void WP_SaberLoadParms();
@@ -51,6 +53,8 @@ extern void Troop_Reset();
 extern void Pilot_Reset();
 extern void Pilot_Update();
 
+extern void G_PerceptionFrame();
+
 extern void G_ASPreCacheFree();
 extern qboolean PM_RestAnim(int anim);
 extern qboolean PM_CrouchAnim(int anim);
@@ -102,6 +106,33 @@ qboolean PInUse(const unsigned int entNum)
 	return static_cast<qboolean>((g_entityInUseBits[entNum / 32] & static_cast<unsigned>(1) << (entNum & 0x1f)) != 0);
 }
 
+// returns the first in-use entity number from start up to limit, or limit;
+// whole empty words of the bit array are skipped at once
+int G_NextInUse(const int start, const int limit)
+{
+	for (int word = start / 32; word * 32 < limit; word++)
+	{
+		unsigned int bits = g_entityInUseBits[word];
+		if (word == start / 32)
+		{
+			bits &= ~0u << (start & 0x1f);
+		}
+		if (!bits)
+		{
+			continue;
+		}
+
+		int entNum = word * 32;
+		while (!(bits & 1))
+		{
+			bits >>= 1;
+			entNum++;
+		}
+		return entNum < limit ? entNum : limit;
+	}
+	return limit;
+}
+
 void WriteInUseBits()
 {
 	ojk::SavedGameHelper saved_game(
@@ -127,6 +158,7 @@ void ReadInUseBits()
 	{
 		g_entities[i].inuse = PInUse(i);
 	}
+	G_InvalidateFindIndex();
 }
 
 #ifdef _DEBUG
@@ -237,8 +269,17 @@ cvar_t* g_npcdebug;
 
 // mcg -- testing: make NPCs obey do not enter brushes better?
 cvar_t* g_navSafetyChecks;
+cvar_t* g_navNearestCache;
+cvar_t* g_navPathCache;
+cvar_t* g_navCorridor;
+cvar_t* g_perceptionCache;
+cvar_t* g_entityChecksum;
+cvar_t* g_findIndex;
+cvar_t* g_prefetch;
+cvar_t* g_showLoadTimes;
 
 cvar_t* g_broadsword;
+cvar_t* g_ragSleep;
 
 cvar_t* g_allowBunnyhopping;
 
@@ -768,6 +809,14 @@ static void G_InitCvars()
 	g_timescale = gi.cvar("timescale", "1", 0);
 	g_npcdebug = gi.cvar("g_npcdebug", "0", 0);
 	g_navSafetyChecks = gi.cvar("g_navSafetyChecks", "0", 0);
+	g_navNearestCache = gi.cvar("g_navNearestCache", "1", 0);
+	g_navPathCache = gi.cvar("g_navPathCache", "1", 0);
+	g_navCorridor = gi.cvar("g_navCorridor", "0", 0); // region corridor A*, faster but paths may not be the shortest
+	g_perceptionCache = gi.cvar("g_perceptionCache", "1", 0); // 2 also prints trace counts every 20 frames
+	g_entityChecksum = gi.cvar("g_entityChecksum", "0", 0);
+	g_findIndex = gi.cvar("g_findIndex", "1", 0); // 2 = check every lookup against the full scan
+	g_prefetch = gi.cvar("g_prefetch", "1", 0);
+	g_showLoadTimes = gi.cvar("g_showLoadTimes", "0", 0);
 	// NOTE : I also create this is UI_Init()
 	g_subtitles = gi.cvar("g_subtitles", "0", CVAR_ARCHIVE);
 	com_buildScript = gi.cvar("com_buildscript", "0", 0);
@@ -840,6 +889,7 @@ static void G_InitCvars()
 	g_darkkorriban = gi.cvar("g_darkkorriban", "0", CVAR_INIT);
 
 	g_broadsword = gi.cvar("broadsword", "1", 0);
+	g_ragSleep = gi.cvar("g_ragSleep", "1", 0);
 
 	g_allowBunnyhopping = gi.cvar("g_allowBunnyhopping", "0", 0);
 
@@ -986,6 +1036,7 @@ static void InitGame(const char* mapname, const char* spawntarget, const int che
 	gi.Printf("gamedate: %s\n", SOURCE_DATE);
 
 	srand(randomSeed);
+	Rand_Init(randomSeed);
 
 	G_InitCvars();
 
@@ -1011,6 +1062,8 @@ static void InitGame(const char* mapname, const char* spawntarget, const int che
 	memset(g_entities, 0, MAX_GENTITIES * sizeof g_entities[0]);
 	globals.gentities = g_entities;
 	ClearAllInUse();
+	G_InvalidateFindIndex();
+	G_PerceptionClear();
 	// initialize all clients for this game
 	level.maxclients = 1;
 	level.clients = static_cast<gclient_t*>(G_Alloc(level.maxclients * sizeof level.clients[0]));
@@ -1128,6 +1181,7 @@ and global variables
 =================
 */
 extern int PM_ValidateAnimRange(int startFrame, int endFrame, float animSpeed);
+static int G_EntityChecksum();
 
 extern "C" Q_EXPORT game_export_t * QDECL GetGameAPI(const game_import_t * import)
 {
@@ -1158,6 +1212,7 @@ extern "C" Q_EXPORT game_export_t * QDECL GetGameAPI(const game_import_t * impor
 	globals.GameSpawnRMGEntity = G_GameSpawnRMGEntity;
 
 	globals.gentitySize = sizeof(gentity_t);
+	globals.EntityChecksum = G_EntityChecksum;
 
 	gameinfo_import.FS_FOpenFile = gi.FS_FOpenFile;
 	gameinfo_import.FS_Read = gi.FS_Read;
@@ -1593,6 +1648,7 @@ class CGameRagDollUpdateParams : public CRagDollUpdateParams
 
 	void RagDollSettled() override
 	{
+		settled = qtrue;
 	}
 
 	void Collision() override
@@ -1613,8 +1669,77 @@ class CGameRagDollUpdateParams : public CRagDollUpdateParams
 public:
 	vec3_t effectorTotal;
 	qboolean hasEffectorData;
+	qboolean settled;
 };
 
+/*
+================
+ragdoll benchmark
+
+Accounts the time spent in the ghoul2 ragdoll solver while the ragbench
+command is running, and prints it along with how many corpses are awake
+or asleep every interval.
+================
+*/
+static struct
+{
+	qboolean active;
+	int interval;
+	int startTime;
+	int nextReport;
+	int64_t usec;
+	int updates;
+} ragBench;
+
+void G_RagBenchStart(const int interval)
+{
+	ragBench.active = qtrue;
+	ragBench.interval = interval;
+	ragBench.startTime = level.time;
+	ragBench.nextReport = level.time + interval;
+	ragBench.usec = 0;
+	ragBench.updates = 0;
+}
+
+void G_RagBenchStop()
+{
+	ragBench.active = qfalse;
+}
+
+static void G_RagBenchFrame()
+{
+	if (!ragBench.active || level.time < ragBench.nextReport)
+	{
+		return;
+	}
+
+	int awake = 0, asleep = 0;
+	for (int i = 0; i < globals.num_entities; i++)
+	{
+		const gentity_t* ent = &g_entities[i];
+
+		if (ent->inuse && ent->client && ent->client->isRagging)
+		{
+			if (ent->client->ragSleeping)
+			{
+				asleep++;
+			}
+			else
+			{
+				awake++;
+			}
+		}
+	}
+
+	gi.Printf("ragbench %6i: %3i awake %3i asleep, %5i updates, %8.3f ms solving, %7.1f us/update\n",
+		level.time - ragBench.startTime, awake, asleep, ragBench.updates, ragBench.usec / 1000.0,
+		ragBench.updates ? static_cast<double>(ragBench.usec) / ragBench.updates : 0.0);
+
+	ragBench.nextReport = level.time + ragBench.interval;
+	ragBench.usec = 0;
+	ragBench.updates = 0;
+}
+
 //list of valid ragdoll effectors
 static const char* g_effectorStringTable[] =
 {
@@ -2049,6 +2174,20 @@ qboolean G_RagDoll(gentity_t* ent, vec3_t forcedAngles)
 
 	if (ent->client->isRagging)
 	{
+		if (ent->client->ragSleeping)
+		{
+			//settled, so leave the bones where they are until something disturbs the body
+			if (g_ragSleep->integer
+				&& ent->client->ps.heldByClient > ENTITYNUM_WORLD
+				&& !ent->client->overridingBones
+				&& VectorCompare(ent->client->ps.velocity, vec3_origin)
+				&& DistanceSquared(usedOrg, ent->client->ragSleepOrigin) <= 15.0f)
+			{
+				return qtrue;
+			}
+			ent->client->ragSleeping = qfalse;
+		}
+
 		//We're in a ragdoll state, so make the call to keep our positions updated and whatnot.
 		CRagDollParams tParms{};
 		CGameRagDollUpdateParams tuParms;
@@ -2113,6 +2252,7 @@ qboolean G_RagDoll(gentity_t* ent, vec3_t forcedAngles)
 		gi.G2API_SetRagDoll(ent->ghoul2, &tParms);
 
 		tuParms.hasEffectorData = qfalse;
+		tuParms.settled = qfalse;
 		VectorClear(tuParms.effectorTotal);
 
 		VectorCopy(G2Angles, tuParms.angles);
@@ -2131,7 +2271,28 @@ qboolean G_RagDoll(gentity_t* ent, vec3_t forcedAngles)
 			VectorScale(ent->client->ps.velocity, 0.4f, tuParms.velocity);
 		}
 
-		gi.G2API_AnimateG2Models(ent->ghoul2, cg.time ? cg.time : level.time, &tuParms);
+		if (ragBench.active)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			gi.G2API_AnimateG2Models(ent->ghoul2, cg.time ? cg.time : level.time, &tuParms);
+			ragBench.usec += std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - start).count();
+			ragBench.updates++;
+		}
+		else
+		{
+			gi.G2API_AnimateG2Models(ent->ghoul2, cg.time ? cg.time : level.time, &tuParms);
+		}
+
+		if (tuParms.settled
+			&& g_ragSleep->integer
+			&& ent->client->ps.heldByClient > ENTITYNUM_WORLD
+			&& !ent->client->overridingBones)
+		{
+			//the solver has stopped moving this one, stop feeding it until it's disturbed
+			ent->client->ragSleeping = qtrue;
+			VectorCopy(usedOrg, ent->client->ragSleepOrigin);
+		}
 
 		if (ent->client->ps.heldByClient <= ENTITYNUM_WORLD)
 		{
@@ -2337,6 +2498,57 @@ constexpr auto BARRIER_DEFUEL_RATE = 100; //approx. 50 seconds of idle use from
 constexpr auto BARRIER_REFUEL_RATE = 200; //seems fair;
 constexpr auto DROIDEKA_BARRIER_DEFUEL_RATE = 1000;
 
+/*
+-------------------------
+G_EntityChecksum
+
+Hashes the network state and position of every entity in use, so two runs
+of the same recorded input can be compared frame by frame.  Also used by the
+engine's command stream playback to find where a replay diverges.
+-------------------------
+*/
+static unsigned int G_HashEntities(int* count)
+{
+	unsigned int hash = FNV1A_INIT;
+	const auto mix = [&hash](const void* data, const size_t size)
+	{
+		hash = Com_HashFNV1aBytes(hash, data, size);
+	};
+
+	*count = 0;
+	for (int i = G_NextInUse(0, globals.num_entities); i < globals.num_entities;
+		i = G_NextInUse(i + 1, globals.num_entities))
+	{
+		const gentity_t* ent = &g_entities[i];
+		mix(&i, sizeof i);
+		mix(&ent->s.eType, sizeof ent->s.eType);
+		mix(&ent->s.eFlags, sizeof ent->s.eFlags);
+		mix(&ent->s.pos, sizeof ent->s.pos);
+		mix(&ent->s.apos, sizeof ent->s.apos);
+		mix(ent->currentOrigin, sizeof ent->currentOrigin);
+		mix(ent->currentAngles, sizeof ent->currentAngles);
+		mix(&ent->health, sizeof ent->health);
+		mix(&ent->nextthink, sizeof ent->nextthink);
+		(*count)++;
+	}
+
+	return hash;
+}
+
+static int G_EntityChecksum()
+{
+	int count;
+	return static_cast<int>(G_HashEntities(&count));
+}
+
+static void G_PrintEntityChecksum()
+{
+	int count;
+	const unsigned int hash = G_HashEntities(&count);
+
+	gi.Printf("entity checksum: frame %d time %d ents %d hash %08x\n", level.framenum, level.time, count, hash);
+}
+
 void G_RunFrame(const int level_time)
 {
 	gentity_t* ent;
@@ -2353,6 +2565,9 @@ void G_RunFrame(const int level_time)
 
 	//ResetTeamCounters();
 	NAV::DecayDangerSenses();
+	NAV::UpdateNearestNodes();
+	G_SyncFindIndex();
+	G_PerceptionFrame();
 	Rail_Update();
 	Troop_Update();
 	Pilot_Update();
@@ -2369,10 +2584,11 @@ void G_RunFrame(const int level_time)
 
 	WorkshopThink();
 
-	for (int i = 0; i < globals.num_entities; i++)
+	// walk in entity number order, re-reading the in-use bits every step so
+	// anything spawned or freed by an earlier think is seen exactly as before
+	for (int i = G_NextInUse(0, globals.num_entities); i < globals.num_entities;
+		i = G_NextInUse(i + 1, globals.num_entities))
 	{
-		if (!PInUse(i))
-			continue;
 		ents_inuse++;
 		ent = &g_entities[i];
 
@@ -2435,8 +2651,8 @@ void G_RunFrame(const int level_time)
 
 		if (ent->s.eType == ET_MOVER)
 		{
-			// FIXME string comparison in per-frame thinks wut???
-			if (ent->model && Q_stricmp("models/test/mikeg/tie_fighter.md3", ent->model) == 0)
+			// brush movers all have "*n" models, so only compare the rest
+			if (ent->model && ent->model[0] != '*' && Q_stricmp("models/test/mikeg/tie_fighter.md3", ent->model) == 0)
 			{
 				TieFighterThink(ent);
 			}
@@ -2667,12 +2883,18 @@ void G_RunFrame(const int level_time)
 	{
 		gi.Printf(S_COLOR_WHITE"Number of Entities in use : %d\n", ents_inuse);
 	}
+	if (g_entityChecksum->integer > 0 && !(level.framenum % g_entityChecksum->integer))
+	{
+		G_PrintEntityChecksum();
+	}
 	//DEBUG STUFF
 	NAV::ShowDebugInfo(ent->currentOrigin, ent->waypoint);
 	NPC_ShowDebugInfo();
 
 	G_DynamicMusicUpdate();
 
+	G_RagBenchFrame();
+
 #if	AI_TIMERS
 	AITime -= navTime;
 	if (AITime > 20)
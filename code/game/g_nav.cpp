@@ -375,6 +375,10 @@ void Svcmd_Nav_f()
 	{
 		NAV::ShowStats();
 	}
+	else if (Q_stricmp(cmd, "bench") == 0)
+	{
+		NAV::BenchmarkPaths(atoi(gi.argv(2)));
+	}
 	else
 	{
 		//Print the available commands
@@ -383,6 +387,7 @@ void Svcmd_Nav_f()
 		Com_Printf("goto\n ---\n");
 		Com_Printf("gotonum\n ---\n");
 		Com_Printf("totals\n ---\n");
+		Com_Printf("bench <count>\n ---\n");
 		Com_Printf("set\n - testgoal\n---\n");
 	}
 }
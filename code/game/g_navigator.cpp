@@ -68,6 +68,9 @@ extern qboolean G_CheckInSolidTeleport(const vec3_t& teleport_pos, const gentity
 extern cvar_t* g_nav1;
 extern cvar_t* g_nav2;
 extern cvar_t* g_developer;
+extern cvar_t* g_navNearestCache;
+extern cvar_t* g_navPathCache;
+extern cvar_t* g_navCorridor;
 extern int delayedShutDown;
 extern vec3_t playerMinsStep;
 extern vec3_t playerMaxs;
@@ -526,6 +529,16 @@ public:
 		mDangerSpotRadiusSq = 0;
 	}
 
+	const CVec3& GetDangerSpot() const
+	{
+		return mDangerSpot;
+	}
+
+	float GetDangerSpotRadiusSq() const
+	{
+		return mDangerSpotRadiusSq;
+	}
+
 public:
 	////////////////////////////////////////////////////////////////////////////////////
 	//
@@ -738,7 +751,6 @@ TGraph mGraph;
 TGraphRegion mRegion(mGraph);
 TGraphCells mCells(mGraph);
 
-TGraph::search mSearch;
 CGraphUser mUser;
 
 TNameToNodeMap mNodeNames;
@@ -769,6 +781,145 @@ int mAirRegion = 0;
 char mLocStringA[256] = { 0 };
 char mLocStringB[256] = { 0 };
 
+////////////////////////////////////////////////////////////////////////////////////////
+// Nearest Node Cache
+//
+// Every cell keeps a few of its closest nodes along with a mask of the sub cells they
+// can be seen from (traced at build time from every corner and the center of each sub
+// cell).  A nearest node query standing in a marked sub cell at roughly the height of
+// the node can then skip the view trace.  On top of that, each entity remembers where
+// it last resolved its waypoint, and keeps it while it stays close to that spot.
+////////////////////////////////////////////////////////////////////////////////////////
+enum
+{
+	NEAREST_CLEAR_CANDIDATES = 8,
+	NEAREST_CLEAR_SUBCELLS = 2,
+	NEAREST_CLEAR_Z = 24,
+	NEAREST_HYSTERESIS = 16,
+	NEAREST_MAX_AGE = 3000,
+};
+
+struct SNearestCache
+{
+	vec3_t mOrigin;
+	int mTime;
+	NAV::TNodeHandle mResult;
+	NAV::TNodeHandle mGoal;
+	bool mFly;
+};
+
+struct SNearestQuery
+{
+	int mEntity;
+	int mCell;
+
+	bool operator <(const SNearestQuery& other) const
+	{
+		return mCell < other.mCell;
+	}
+};
+
+using TNearestQueries = ratl::vector_vs<SNearestQuery, NAV::MAX_PATH_USERS>;
+
+unsigned char mNearestClear[NAV::NUM_CELLS][NAV::NUM_CELLS][NEAREST_CLEAR_CANDIDATES];
+SNearestCache mNearestCache[MAX_GENTITIES];
+TNearestQueries mNearestQueries;
+
+int mNearestQueryCount = 0;
+int mNearestCacheHits = 0;
+int mNearestClearHits = 0;
+int mNearestTraceCount = 0;
+int mNearestBuildTraces = 0;
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Path Planner
+//
+// Searches run on a leased search object instead of one global, so a query never
+// stomps on the state of another one still in flight.
+//
+// Above the waypoint graph sits a coarse region layer: the regions found by mRegion,
+// linked by the graph edges that cross between them, each weighted by the distance
+// from region center to edge to region center.  A query first picks a corridor of
+// regions on that layer, and A* is then only allowed to open nodes inside it.
+//
+// Corridors and finished paths are kept in small LRU caches, shared by every actor with
+// the same movement abilities (and danger spot, if any).  A cached path is only handed
+// out again after each of its edges passes is_valid() for the new actor.
+////////////////////////////////////////////////////////////////////////////////////////
+enum
+{
+	MAX_PATH_QUERIES = 2,
+	MAX_REGION_PORTALS = NAV::NUM_EDGES * 2,
+	MAX_CORRIDOR_REGIONS = 32,
+	PATH_CACHE_SIZE = 32,
+	CORRIDOR_CACHE_SIZE = 32,
+	PATH_CACHE_MAX_AGE = 2000,
+	PATH_CACHE_DANGER_GRID = 64,
+};
+
+using TPathNodes = ratl::vector_vs<short, NAV::NUM_NODES>;
+using TRegionBits = ratl::bits_vs<NAV::NUM_REGIONS>;
+
+struct SRegionPortal
+{
+	short mRegion;
+	short mEdge;
+	float mCost;
+};
+
+struct SPathQuery
+{
+	TGraph::search mSearch;
+	bool mInUse;
+};
+
+struct SPathCacheKey
+{
+	int mStart;
+	int mEnd;
+	int mAbilities;
+	int mDanger[4];
+
+	bool operator ==(const SPathCacheKey& other) const
+	{
+		return memcmp(this, &other, sizeof *this) == 0;
+	}
+};
+
+struct SPathCacheEntry
+{
+	SPathCacheKey mKey;
+	int mTime;
+	int mLastUseTime;
+	float mCost;
+	TPathNodes mNodes;
+};
+
+struct SCorridorCacheEntry
+{
+	SPathCacheKey mKey;
+	int mTime;
+	int mLastUseTime;
+	TRegionBits mRegions;
+};
+
+ratl::array_vs<SRegionPortal, MAX_REGION_PORTALS> mRegionPortals;
+ratl::array_vs<int, NAV::NUM_REGIONS + 1> mRegionPortalStart;
+ratl::array_vs<CVec3, NAV::NUM_REGIONS> mRegionCenter;
+int mRegionLayerSize = 0;
+
+SPathQuery mPathQueries[MAX_PATH_QUERIES];
+SPathCacheEntry mPathCache[PATH_CACHE_SIZE];
+SCorridorCacheEntry mCorridorCache[CORRIDOR_CACHE_SIZE];
+TGraph::TNodeState mCorridorClosed;
+
+int mPathSearchCount = 0;
+int mPathCacheHits = 0;
+int mCorridorCacheHits = 0;
+int mCorridorSearchCount = 0;
+int mCorridorFallbackCount = 0;
+int mPathVisitedCount = 0;
+
 ////////////////////////////////////////////////////////////////////////////////////////
 //
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -814,6 +965,474 @@ int GetIslandRegion()
 	return mIslandRegion;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////
+// Lease A Search Object For The Length Of One Query
+//
+// This only keeps a nested query from reusing the open and closed lists of one still
+// in progress.  Planning is not reentrant: every query shares the graph user (mUser)
+// and the corridor mask (mCorridorClosed), so it must all run on the game thread.
+////////////////////////////////////////////////////////////////////////////////////////
+class CSearchLease
+{
+	SPathQuery* mQuery = nullptr;
+
+public:
+	CSearchLease()
+	{
+		for (SPathQuery& query : mPathQueries)
+		{
+			if (!query.mInUse)
+			{
+				mQuery = &query;
+				break;
+			}
+		}
+		assert(mQuery != nullptr); // More searches in flight than MAX_PATH_QUERIES
+		if (!mQuery)
+		{
+			mQuery = &mPathQueries[0];
+		}
+		mQuery->mInUse = true;
+	}
+
+	~CSearchLease()
+	{
+		mQuery->mInUse = false;
+	}
+
+	CSearchLease(const CSearchLease&) = delete;
+	CSearchLease& operator=(const CSearchLease&) = delete;
+
+	TGraph::search& get() const
+	{
+		return mQuery->mSearch;
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Forget Every Cached Path And Corridor
+////////////////////////////////////////////////////////////////////////////////////////
+static void ClearPathCaches()
+{
+	for (SPathCacheEntry& entry : mPathCache)
+	{
+		entry.mNodes.clear();
+		entry.mTime = 0;
+		entry.mLastUseTime = 0;
+	}
+	for (SCorridorCacheEntry& entry : mCorridorCache)
+	{
+		entry.mRegions.clear();
+		entry.mTime = -PATH_CACHE_MAX_AGE;
+		entry.mLastUseTime = 0;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Build The Region Layer (Region Centers And The Graph Edges Linking Regions)
+////////////////////////////////////////////////////////////////////////////////////////
+static void BuildRegionLayer()
+{
+	int nodeCount[NAV::NUM_REGIONS];
+	int portalCursor[NAV::NUM_REGIONS];
+
+	ClearPathCaches();
+
+	mRegionLayerSize = Min(mRegion.size(), static_cast<int>(NAV::NUM_REGIONS));
+	for (int r = 0; r < NAV::NUM_REGIONS; r++)
+	{
+		mRegionCenter[r].Clear();
+		nodeCount[r] = 0;
+		portalCursor[r] = 0;
+	}
+
+	// Average The Nodes Of Each Region
+	//----------------------------------
+	for (TGraph::TNodes::iterator nodeIter = mGraph.nodes_begin(); nodeIter != mGraph.nodes_end(); ++nodeIter)
+	{
+		const int region = mRegion.get_node_region(nodeIter.index());
+		if (region > 0 && region < mRegionLayerSize)
+		{
+			mRegionCenter[region] += (*nodeIter).mPoint;
+			nodeCount[region]++;
+		}
+	}
+	for (int r = 0; r < mRegionLayerSize; r++)
+	{
+		if (nodeCount[r])
+		{
+			mRegionCenter[r] *= 1.0f / nodeCount[r];
+		}
+	}
+
+	// Count The Edges Leaving Each Region, Then Lay Them Out Region By Region
+	//-------------------------------------------------------------------------
+	for (TGraph::TEdges::iterator edgeIter = mGraph.edges_begin(); edgeIter != mGraph.edges_end(); ++edgeIter)
+	{
+		const int regionA = mRegion.get_node_region((*edgeIter).mNodeA);
+		const int regionB = mRegion.get_node_region((*edgeIter).mNodeB);
+		if (regionA > 0 && regionB > 0 && regionA < mRegionLayerSize && regionB < mRegionLayerSize && regionA != regionB)
+		{
+			portalCursor[regionA]++;
+			portalCursor[regionB]++;
+		}
+	}
+
+	mRegionPortalStart[0] = 0;
+	for (int r = 0; r < NAV::NUM_REGIONS; r++)
+	{
+		mRegionPortalStart[r + 1] = mRegionPortalStart[r] + portalCursor[r];
+		portalCursor[r] = mRegionPortalStart[r];
+	}
+
+	for (TGraph::TEdges::iterator edgeIter = mGraph.edges_begin(); edgeIter != mGraph.edges_end(); ++edgeIter)
+	{
+		const CWayEdge& edge = *edgeIter;
+		const int regionA = mRegion.get_node_region(edge.mNodeA);
+		const int regionB = mRegion.get_node_region(edge.mNodeB);
+		if (regionA > 0 && regionB > 0 && regionA < mRegionLayerSize && regionB < mRegionLayerSize && regionA != regionB)
+		{
+			CVec3 Middle;
+			edge.Point(Middle);
+
+			const float cost = mRegionCenter[regionA].Dist(Middle) + Middle.Dist(mRegionCenter[regionB]);
+
+			SRegionPortal& toB = mRegionPortals[portalCursor[regionA]++];
+			toB.mRegion = regionB;
+			toB.mEdge = edgeIter.index();
+			toB.mCost = cost;
+
+			SRegionPortal& toA = mRegionPortals[portalCursor[regionB]++];
+			toA.mRegion = regionA;
+			toA.mEdge = edgeIter.index();
+			toA.mCost = cost;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Can The Current Graph User Share Cached Results?
+//
+// Personal danger alerts change the cost of individual edges for one actor only, so
+// those searches are always run fresh.
+////////////////////////////////////////////////////////////////////////////////////////
+static bool PathCacheable()
+{
+	const gentity_t* actor = mUser.GetActor();
+	if (actor)
+	{
+		const TAlertList& al = GetAlerts(actor);
+		for (int alIndex = 0; alIndex < TAlertList::CAPACITY; alIndex++)
+		{
+			if (al[alIndex].mDanger > 0.0f)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Everything About The Graph User That Changes Which Edges Are Valid Or What They Cost
+////////////////////////////////////////////////////////////////////////////////////////
+static SPathCacheKey PathCacheKey(const int start, const int end)
+{
+	SPathCacheKey key;
+	memset(&key, 0, sizeof key);
+	key.mStart = start;
+	key.mEnd = end;
+
+	const gentity_t* actor = mUser.GetActor();
+	if (actor)
+	{
+		key.mAbilities = NAV::ClassifyEntSize(actor) + 1;
+		if (actor->NPC)
+		{
+			key.mAbilities |= (actor->NPC->scriptFlags & SCF_NAV_CAN_FLY ? 1 : 0) << 8;
+			key.mAbilities |= (actor->NPC->scriptFlags & SCF_NAV_CAN_JUMP ? 1 : 0) << 9;
+			key.mAbilities |= (actor->NPC->aiFlags & NPCAI_NAV_THROUGH_BREAKABLES ? 1 : 0) << 10;
+		}
+		key.mAbilities |= (INV_GoodieKeyCheck(actor) ? 1 : 0) << 11;
+	}
+
+	if (mUser.GetDangerSpotRadiusSq() > 0.0f)
+	{
+		const CVec3& Spot = mUser.GetDangerSpot();
+		key.mDanger[0] = static_cast<int>(floorf(Spot[0] / PATH_CACHE_DANGER_GRID));
+		key.mDanger[1] = static_cast<int>(floorf(Spot[1] / PATH_CACHE_DANGER_GRID));
+		key.mDanger[2] = static_cast<int>(floorf(Spot[2] / PATH_CACHE_DANGER_GRID));
+		key.mDanger[3] = static_cast<int>(mUser.GetDangerSpotRadiusSq());
+	}
+	return key;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Look For A Recent Path With The Same Key Which Is Still Valid For This User
+////////////////////////////////////////////////////////////////////////////////////////
+static const SPathCacheEntry* FindCachedPath(const SPathCacheKey& key)
+{
+	for (SPathCacheEntry& entry : mPathCache)
+	{
+		if (entry.mNodes.empty() || !(entry.mKey == key))
+		{
+			continue;
+		}
+		if (entry.mTime > level.time || level.time - entry.mTime >= PATH_CACHE_MAX_AGE)
+		{
+			entry.mNodes.clear();
+			return nullptr;
+		}
+
+		for (int i = 0; i + 1 < entry.mNodes.size(); i++)
+		{
+			const int edge = mGraph.get_edge_across(entry.mNodes[i], entry.mNodes[i + 1]);
+			if (!edge || !mUser.is_valid(mGraph.get_edge(edge), key.mEnd))
+			{
+				entry.mNodes.clear();
+				return nullptr;
+			}
+		}
+
+		entry.mLastUseTime = level.time;
+		return &entry;
+	}
+	return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Store A Path Over The Least Recently Used Entry
+////////////////////////////////////////////////////////////////////////////////////////
+static void StoreCachedPath(const SPathCacheKey& key, const TPathNodes& path, const float cost)
+{
+	SPathCacheEntry* oldest = &mPathCache[0];
+	for (SPathCacheEntry& entry : mPathCache)
+	{
+		if (entry.mNodes.empty())
+		{
+			oldest = &entry;
+			break;
+		}
+		if (entry.mLastUseTime < oldest->mLastUseTime)
+		{
+			oldest = &entry;
+		}
+	}
+
+	oldest->mKey = key;
+	oldest->mTime = level.time;
+	oldest->mLastUseTime = level.time;
+	oldest->mCost = cost;
+	oldest->mNodes = path;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Pick The Regions A Search From start To end Is Allowed To Visit
+//
+// Runs Dijkstra over the region layer (or takes a cached corridor) and closes every
+// node outside the corridor in mCorridorClosed.  Returns false when the search should
+// run unrestricted instead.
+////////////////////////////////////////////////////////////////////////////////////////
+static bool BuildCorridor(const int start, const int end, const SPathCacheKey& key, const bool cacheable)
+{
+	constexpr float UNREACHED = 1e30f;
+
+	if (mRegionLayerSize <= 1)
+	{
+		return false;
+	}
+
+	const int startRegion = mRegion.get_node_region(start);
+	const int endRegion = mRegion.get_node_region(end);
+	if (startRegion <= 0 || endRegion <= 0 || startRegion >= mRegionLayerSize || endRegion >= mRegionLayerSize)
+	{
+		return false;
+	}
+
+	SPathCacheKey regionKey = key;
+	regionKey.mStart = startRegion;
+	regionKey.mEnd = endRegion;
+
+	TRegionBits corridor;
+	bool found = false;
+
+	// Check The Corridor Cache First
+	//--------------------------------
+	if (cacheable)
+	{
+		for (SCorridorCacheEntry& entry : mCorridorCache)
+		{
+			if (entry.mKey == regionKey && entry.mTime <= level.time && level.time - entry.mTime < PATH_CACHE_MAX_AGE)
+			{
+				entry.mLastUseTime = level.time;
+				corridor = entry.mRegions;
+				found = true;
+				mCorridorCacheHits++;
+				break;
+			}
+		}
+	}
+
+	// Otherwise Run Dijkstra Over The Regions
+	//-----------------------------------------
+	if (!found)
+	{
+		float dist[NAV::NUM_REGIONS];
+		short prev[NAV::NUM_REGIONS];
+		TRegionBits done;
+
+		for (int r = 0; r < mRegionLayerSize; r++)
+		{
+			dist[r] = UNREACHED;
+			prev[r] = -1;
+		}
+		dist[startRegion] = 0.0f;
+		mCorridorSearchCount++;
+
+		while (true)
+		{
+			int cur = -1;
+			for (int r = 1; r < mRegionLayerSize; r++)
+			{
+				if (!done.get_bit(r) && dist[r] < UNREACHED && (cur == -1 || dist[r] < dist[cur]))
+				{
+					cur = r;
+				}
+			}
+			if (cur == -1 || cur == endRegion)
+			{
+				break;
+			}
+			done.set_bit(cur);
+
+			for (int p = mRegionPortalStart[cur]; p < mRegionPortalStart[cur + 1]; p++)
+			{
+				const SRegionPortal& portal = mRegionPortals[p];
+				if (done.get_bit(portal.mRegion) || dist[cur] + portal.mCost >= dist[portal.mRegion])
+				{
+					continue;
+				}
+				if (mUser.is_valid(mGraph.get_edge(portal.mEdge), end))
+				{
+					dist[portal.mRegion] = dist[cur] + portal.mCost;
+					prev[portal.mRegion] = cur;
+				}
+			}
+		}
+
+		if (dist[endRegion] >= UNREACHED)
+		{
+			return false;
+		}
+
+		int length = 0;
+		for (int r = endRegion; r != -1; r = prev[r])
+		{
+			corridor.set_bit(r);
+			length++;
+		}
+		if (length > MAX_CORRIDOR_REGIONS)
+		{
+			return false;
+		}
+
+		if (cacheable)
+		{
+			SCorridorCacheEntry* oldest = &mCorridorCache[0];
+			for (SCorridorCacheEntry& entry : mCorridorCache)
+			{
+				if (entry.mLastUseTime < oldest->mLastUseTime)
+				{
+					oldest = &entry;
+				}
+			}
+			oldest->mKey = regionKey;
+			oldest->mTime = level.time;
+			oldest->mLastUseTime = level.time;
+			oldest->mRegions = corridor;
+		}
+	}
+
+	// Close Every Node Outside The Corridor
+	//---------------------------------------
+	mCorridorClosed.clear();
+	for (TGraph::TNodes::iterator nodeIter = mGraph.nodes_begin(); nodeIter != mGraph.nodes_end(); ++nodeIter)
+	{
+		const int region = mRegion.get_node_region(nodeIter.index());
+		if (region < 0 || region >= mRegionLayerSize || !corridor.get_bit(region))
+		{
+			mCorridorClosed.set_bit(nodeIter.index());
+		}
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Plan A Path From start To end For The Current Graph User
+//
+// The resulting nodes are listed from end back to start, the same order the search
+// itself walks them.
+////////////////////////////////////////////////////////////////////////////////////////
+static bool PlanPath(const int start, const int end, TPathNodes& path, float& cost, const bool useCorridor,
+	const bool useCache)
+{
+	const bool cacheable = useCache && PathCacheable();
+	const SPathCacheKey key = PathCacheKey(start, end);
+
+	path.clear();
+	cost = 0.0f;
+
+	if (cacheable)
+	{
+		const SPathCacheEntry* cached = FindCachedPath(key);
+		if (cached)
+		{
+			path = cached->mNodes;
+			cost = cached->mCost;
+			mPathCacheHits++;
+			return true;
+		}
+	}
+
+	const CSearchLease lease;
+	TGraph::search& search = lease.get();
+	search.mStart = start;
+	search.mEnd = end;
+	mPathSearchCount++;
+
+	if (useCorridor && BuildCorridor(start, end, key, cacheable))
+	{
+		mGraph.astar(search, mUser, &mCorridorClosed);
+		if (!search.success())
+		{
+			mCorridorFallbackCount++;
+			mGraph.astar(search, mUser);
+		}
+	}
+	else
+	{
+		mGraph.astar(search, mUser);
+	}
+	mPathVisitedCount += search.num_visited();
+
+	if (!search.success())
+	{
+		return false;
+	}
+
+	for (search.path_begin(); !search.path_end() && !path.full(); search.path_inc())
+	{
+		path.push_back(search.path_at());
+	}
+	cost = search.path_cost();
+
+	if (cacheable)
+	{
+		StoreCachedPath(key, path, cost);
+	}
+	return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // Helper Function : View Trace
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -1142,6 +1761,116 @@ bool NAV::GoTo(gentity_t* actor, const vec3_t& position, const float MaxDangerLe
 	return HasPath;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////
+// Find Which Sub Cell Of Its Cell A Position Lands In (-1 If Outside The Cell Grid)
+////////////////////////////////////////////////////////////////////////////////////////
+static int NearestClearSubCell(const vec3_t& position, int& cellX, int& cellY)
+{
+	float minX, minY, maxX, maxY;
+
+	mCells.convert_to_cell_coords(position[0], position[1], cellX, cellY);
+	mCells.get_cell_upperleft(cellX, cellY, minX, minY);
+	mCells.get_cell_lowerright(cellX, cellY, maxX, maxY);
+
+	if (position[0] < minX || position[0] >= maxX || position[1] < minY || position[1] >= maxY)
+	{
+		return -1;
+	}
+
+	const int subX = static_cast<int>((position[0] - minX) * NEAREST_CLEAR_SUBCELLS / (maxX - minX));
+	const int subY = static_cast<int>((position[1] - minY) * NEAREST_CLEAR_SUBCELLS / (maxY - minY));
+	return Com_Clampi(0, NEAREST_CLEAR_SUBCELLS - 1, subY) * NEAREST_CLEAR_SUBCELLS +
+		Com_Clampi(0, NEAREST_CLEAR_SUBCELLS - 1, subX);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Trace The Closest Nodes Of Every Cell From Each Of Its Sub Cells
+//
+// Nodes next to an edge that can become invalid (doors, breakables, etc) are left out,
+// as their visibility can change during play.
+////////////////////////////////////////////////////////////////////////////////////////
+static void BuildNearestClear()
+{
+	constexpr int NUM_SAMPLES = NEAREST_CLEAR_SUBCELLS + 1;
+	const int startTraces = mViewTraceCount;
+
+	memset(mNearestClear, 0, sizeof mNearestClear);
+
+	for (int x = 0; x < NAV::NUM_CELLS; x++)
+	{
+		for (int y = 0; y < NAV::NUM_CELLS; y++)
+		{
+			TGraphCells::SCell& Cell = mCells.get_cell(x, y);
+			float minX, minY, maxX, maxY;
+
+			mCells.get_cell_upperleft(x, y, minX, minY);
+			mCells.get_cell_lowerright(x, y, maxX, maxY);
+
+			const float stepX = (maxX - minX - 2.0f) / NEAREST_CLEAR_SUBCELLS;
+			const float stepY = (maxY - minY - 2.0f) / NEAREST_CLEAR_SUBCELLS;
+			const CVec3 Center((minX + maxX) * 0.5f, (minY + maxY) * 0.5f, 0.0f);
+
+			for (int c = 0; c < Cell.mNodes.size() && c < NEAREST_CLEAR_CANDIDATES; c++)
+			{
+				const int NodeHandle = Cell.mNodes[c];
+				const CWayNode& node = mGraph.get_node(NodeHandle);
+
+				if (node.mPoint.Dist2(CVec3(Center[0], Center[1], node.mPoint[2])) > NAV::VIEW_RANGE * NAV::VIEW_RANGE)
+				{
+					continue;
+				}
+
+				bool CanBeInvalid = false;
+				TGraph::TNodeNeighbors& neighbors = mGraph.get_node_neighbors(NodeHandle);
+				for (int n = 0; n < neighbors.size() && !CanBeInvalid; n++)
+				{
+					CanBeInvalid = mGraph.get_edge(neighbors[n].mEdge).mFlags.get_bit(CWayEdge::WE_CANBEINVAL);
+				}
+				if (CanBeInvalid)
+				{
+					continue;
+				}
+
+				// Trace From The Sub Cell Corners, Then The Centers Of Sub Cells With All Corners Clear
+				//----------------------------------------------------------------------------------------
+				bool CornerClear[NUM_SAMPLES][NUM_SAMPLES];
+				for (int sx = 0; sx < NUM_SAMPLES; sx++)
+				{
+					for (int sy = 0; sy < NUM_SAMPLES; sy++)
+					{
+						const CVec3 Sample(minX + 1.0f + sx * stepX, minY + 1.0f + sy * stepY, node.mPoint[2]);
+						CornerClear[sx][sy] = ViewNavTrace(Sample, node.mPoint);
+					}
+				}
+
+				for (int sx = 0; sx < NEAREST_CLEAR_SUBCELLS; sx++)
+				{
+					for (int sy = 0; sy < NEAREST_CLEAR_SUBCELLS; sy++)
+					{
+						if (!CornerClear[sx][sy] || !CornerClear[sx + 1][sy] ||
+							!CornerClear[sx][sy + 1] || !CornerClear[sx + 1][sy + 1])
+						{
+							continue;
+						}
+
+						const CVec3 Sample(minX + 1.0f + (sx + 0.5f) * stepX, minY + 1.0f + (sy + 0.5f) * stepY,
+							node.mPoint[2]);
+						if (ViewNavTrace(Sample, node.mPoint))
+						{
+							mNearestClear[x][y][c] |= 1 << (sy * NEAREST_CLEAR_SUBCELLS + sx);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// Keep These Out Of The Run Time View Trace Stats
+	//-------------------------------------------------
+	mNearestBuildTraces = mViewTraceCount - startTraces;
+	mViewTraceCount = startTraces;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // This function exists as a wrapper so that the graph can write to the gi.Printf()
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -1170,7 +1899,24 @@ bool NAV::LoadFromFile(const char* filename, int checksum)
 	mIslandRegion = 0;
 	mAirRegion = 0;
 
+	mNearestQueryCount = 0;
+	mNearestCacheHits = 0;
+	mNearestClearHits = 0;
+	mNearestTraceCount = 0;
+	mNearestBuildTraces = 0;
+
 	memset(&mEntityAlertList, 0, sizeof mEntityAlertList);
+	memset(mNearestClear, 0, sizeof mNearestClear);
+	memset(mNearestCache, 0, sizeof mNearestCache);
+
+	mRegionLayerSize = 0;
+	mPathSearchCount = 0;
+	mPathCacheHits = 0;
+	mCorridorCacheHits = 0;
+	mCorridorSearchCount = 0;
+	mCorridorFallbackCount = 0;
+	mPathVisitedCount = 0;
+	ClearPathCaches();
 
 #if !defined(FINAL_BUILD)
 	ratl::ratl_base::OutputPrint = stupid_print;
@@ -2016,6 +2762,7 @@ bool NAV::LoadFromEntitiesAndSaveToFile(const char* filename, int checksum)
 		delayedShutDown = level.time + 100;
 #endif
 	}
+	BuildRegionLayer();
 
 	// PHASE V: SCAN NODES AND FILL CELLS
 	//===================================
@@ -2061,6 +2808,10 @@ bool NAV::LoadFromEntitiesAndSaveToFile(const char* filename, int checksum)
 			}
 		}
 	}
+	// Precompute The Nearest Node Candidates Once Everything Is Back In Place
+	//-------------------------------------------------------------------------
+	BuildNearestClear();
+
 	mConnectTraceCount = mMoveTraceCount;
 	mMoveTraceCount = 0;
 
@@ -2204,6 +2955,10 @@ void NAV::WayEdgesNowClear(gentity_t* ent)
 				}
 			}
 			mEntEdgeMap.erase(EntNum);
+
+			// Shorter Routes May Have Just Opened Up
+			//----------------------------------------
+			ClearPathCaches();
 		}
 	}
 }
@@ -2315,17 +3070,43 @@ NAV::TNodeHandle NAV::GetNearestNode(gentity_t* ent, const bool forceRecalcNow,
 
 	if (ent->waypoint == WAYPOINT_NONE || forceRecalcNow || level.time > ent->noWaypointTime)
 	{
+		const bool Fly = ent->client && ent->client->moveType == MT_FLYSWIM;
+		SNearestCache& cache = mNearestCache[ent->s.number];
+
 		if (ent->waypoint)
 		{
 			ent->lastWaypoint = ent->waypoint;
 		}
-		ent->waypoint =
-			GetNearestNode(
-				ent->currentOrigin,
-				ent->waypoint,
-				goal,
-				ent->s.number,
-				ent->client && ent->client->moveType == MT_FLYSWIM);
+
+		// Keep The Last Result While The Entity Has Barely Moved Since It Was Resolved
+		//------------------------------------------------------------------------------
+		if (!forceRecalcNow &&
+			g_navNearestCache->integer &&
+			ent->waypoint != WAYPOINT_NONE &&
+			ent->waypoint == cache.mResult &&
+			goal == cache.mGoal &&
+			Fly == cache.mFly &&
+			cache.mTime <= level.time && level.time - cache.mTime < NEAREST_MAX_AGE &&
+			DistanceSquared(ent->currentOrigin, cache.mOrigin) < NEAREST_HYSTERESIS * NEAREST_HYSTERESIS)
+		{
+			mNearestCacheHits++;
+		}
+		else
+		{
+			ent->waypoint =
+				GetNearestNode(
+					ent->currentOrigin,
+					ent->waypoint,
+					goal,
+					ent->s.number,
+					Fly);
+
+			VectorCopy(ent->currentOrigin, cache.mOrigin);
+			cache.mTime = level.time;
+			cache.mResult = ent->waypoint;
+			cache.mGoal = goal;
+			cache.mFly = Fly;
+		}
 		ent->noWaypointTime = level.time + 1000; // Don't Erase This Result For 5 Seconds
 	}
 
@@ -2357,6 +3138,14 @@ NAV::TNodeHandle NAV::GetNearestNode(const vec3_t& position, const TNodeHandle p
 		CVec3 Pos(position);
 		SNodeSort NodeSort{};
 
+		mNearestQueryCount++;
+
+		// Find Which Precomputed Candidates Can Be Taken Without A Trace
+		//----------------------------------------------------------------
+		int ClearX = 0;
+		int ClearY = 0;
+		const int ClearSubCell = g_navNearestCache->integer ? NearestClearSubCell(position, ClearX, ClearY) : -1;
+
 		// PHASE I - TEST NAV POINTS
 		//===========================
 		{
@@ -2436,9 +3225,25 @@ NAV::TNodeHandle NAV::GetNearestNode(const vec3_t& position, const TNodeHandle p
 					return mNearestNavSort[j].mHandle;
 				}
 
+				// Was It Seen From This Part Of The Cell When The Nav Was Built?
+				//----------------------------------------------------------------
+				const CVec3& NodePoint = mGraph.get_node(mNearestNavSort[j].mHandle).mPoint;
+				if (ClearSubCell >= 0 && fabsf(NodePoint[2] - Pos[2]) < NEAREST_CLEAR_Z)
+				{
+					for (int c = 0; c < Cell.mNodes.size() && c < NEAREST_CLEAR_CANDIDATES; c++)
+					{
+						if (Cell.mNodes[c] == mNearestNavSort[j].mHandle && mNearestClear[ClearX][ClearY][c] & 1 << ClearSubCell)
+						{
+							mNearestClearHits++;
+							return mNearestNavSort[j].mHandle;
+						}
+					}
+				}
+
 				// Otherwise, We Need To Trace To It
 				//-----------------------------------
-				if (ViewNavTrace(Pos, mGraph.get_node(mNearestNavSort[j].mHandle).mPoint))
+				mNearestTraceCount++;
+				if (ViewNavTrace(Pos, NodePoint))
 				{
 					return mNearestNavSort[j].mHandle;
 				}
@@ -2500,6 +3305,7 @@ NAV::TNodeHandle NAV::GetNearestNode(const vec3_t& position, const TNodeHandle p
 				{
 					// Otherwise, We Need To Trace To It
 					//-----------------------------------
+					mNearestTraceCount++;
 					if (ViewNavTrace(Pos, PointOnEdge))
 					{
 						return mNearestNavSort[j].mHandle * -1; // "Edges" have negative IDs
@@ -2511,6 +3317,45 @@ NAV::TNodeHandle NAV::GetNearestNode(const vec3_t& position, const TNodeHandle p
 	return WAYPOINT_NONE;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////
+// Resolve The Waypoints Of Every Path User Due For A Refresh This Frame In One Pass
+//
+// Queries are grouped by cell, so actors standing together share the same candidate
+// lists while they are still hot.
+////////////////////////////////////////////////////////////////////////////////////////
+void NAV::UpdateNearestNodes()
+{
+	if (!g_navNearestCache->integer || mGraph.size_edges() <= 0)
+	{
+		return;
+	}
+
+	mNearestQueries.clear();
+	for (int i = G_NextInUse(0, globals.num_entities); i < globals.num_entities && !mNearestQueries.full();
+		i = G_NextInUse(i + 1, globals.num_entities))
+	{
+		const gentity_t* ent = &g_entities[i];
+		if (!ent->client || mPathUserIndex[i] == NULL_PATH_USER_INDEX ||
+			ent->waypoint != WAYPOINT_NONE && level.time <= ent->noWaypointTime)
+		{
+			continue;
+		}
+
+		int cellX, cellY;
+		SNearestQuery query;
+		mCells.convert_to_cell_coords(ent->currentOrigin[0], ent->currentOrigin[1], cellX, cellY);
+		query.mEntity = i;
+		query.mCell = cellY * NUM_CELLS + cellX;
+		mNearestQueries.push_back(query);
+	}
+
+	mNearestQueries.sort();
+	for (int i = 0; i < mNearestQueries.size(); i++)
+	{
+		GetNearestNode(&g_entities[mNearestQueries[i].mEntity]);
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////
 //
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -2747,13 +3592,11 @@ bool NAV::FindPath(gentity_t* actor, TNodeHandle target, const float MaxDangerLe
 
 	// Setup The Search
 	//------------------
-	mSearch.mStart = start;
-	mSearch.mEnd = target;
 	puser.mEnd = target;
 
 	// First Check The Region
 	//------------------------
-	if (mRegion.size() > 0 && !mRegion.has_valid_edge(mSearch.mStart, mSearch.mEnd, mUser))
+	if (mRegion.size() > 0 && !mRegion.has_valid_edge(start, target, mUser))
 	{
 		puser.mSuccess = false;
 		return puser.mSuccess;
@@ -2774,11 +3617,13 @@ bool NAV::FindPath(gentity_t* actor, TNodeHandle target, const float MaxDangerLe
 			mUser.SetDangerSpot(actor->enemy->currentOrigin, 400.0f);
 		}
 	}
-	mGraph.astar(mSearch, mUser);
+	TPathNodes pathNodes;
+	float pathCost;
+	puser.mSuccess = PlanPath(start, target, pathNodes, pathCost, g_navCorridor->integer != 0,
+		g_navPathCache->integer != 0);
 	mUser.ClearDangerSpot();
 
 	puser.mLastAStarTime = level.time + Q_irand(3000, 6000);
-	puser.mSuccess = mSearch.success();
 	if (!puser.mSuccess)
 	{
 		return puser.mSuccess;
@@ -2817,7 +3662,7 @@ bool NAV::FindPath(gentity_t* actor, TNodeHandle target, const float MaxDangerLe
 	{
 		SPathPoint PPoint = {};
 		puser.mPath.clear();
-		for (mSearch.path_begin(); !mSearch.path_end() && !puser.mPath.full(); mSearch.path_inc())
+		for (int n = 0; n < pathNodes.size() && !puser.mPath.full(); n++)
 		{
 			if (puser.mPath.full())
 			{
@@ -2830,7 +3675,7 @@ bool NAV::FindPath(gentity_t* actor, TNodeHandle target, const float MaxDangerLe
 				return false;
 			}
 
-			PPoint.mNode = mSearch.path_at();
+			PPoint.mNode = pathNodes[n];
 			PPoint.mPoint = mGraph.get_node(PPoint.mNode).mPoint;
 			PPoint.mSpeed = AtSpeed;
 			PPoint.mSlowingRadius = 0.0f;
@@ -2981,13 +3826,11 @@ bool NAV::SafePathExists(const CVec3& start_vec, const CVec3& stop_vec, const CV
 
 	// Setup The Search
 	//------------------
-	mSearch.mStart = start;
-	mSearch.mEnd = target;
 	puser.mEnd = target;
 
 	// First Check The Region
 	//------------------------
-	if (mRegion.size() > 0 && !mRegion.has_valid_edge(mSearch.mStart, mSearch.mEnd, mUser))
+	if (mRegion.size() > 0 && !mRegion.has_valid_edge(start, target, mUser))
 	{
 		puser.mSuccess = false;
 		return puser.mSuccess;
@@ -2996,11 +3839,13 @@ bool NAV::SafePathExists(const CVec3& start_vec, const CVec3& stop_vec, const CV
 	// Now, Run A*
 	//-------------
 	//	mUser.SetDangerSpot(danger, dangerDistSq);
-	mGraph.astar(mSearch, mUser);
+	TPathNodes pathNodes;
+	float pathCost;
+	puser.mSuccess = PlanPath(start, target, pathNodes, pathCost, g_navCorridor->integer != 0,
+		g_navPathCache->integer != 0);
 	//	mUser.ClearDangerSpot();
 
 	puser.mLastAStarTime = level.time + Q_irand(3000, 6000);
-	puser.mSuccess = mSearch.success();
 	if (!puser.mSuccess)
 	{
 		return puser.mSuccess;
@@ -3010,9 +3855,9 @@ bool NAV::SafePathExists(const CVec3& start_vec, const CVec3& stop_vec, const CV
 	//----------------------------------------
 	CVec3 Prev(stop_vec);
 	CVec3 Next{};
-	for (mSearch.path_begin(); !mSearch.path_end(); mSearch.path_inc())
+	for (int n = 0; n < pathNodes.size(); n++)
 	{
-		Next = mGraph.get_node(mSearch.path_at()).mPoint;
+		Next = mGraph.get_node(pathNodes[n]).mPoint;
 		if (dangerDistSq > danger.DistToLine2(Next, Prev))
 		{
 			puser.mSuccess = false;
@@ -3889,10 +4734,154 @@ void NAV::ShowStats()
 	mGraph.ProfilePrint("");
 	mGraph.ProfilePrint("Move Trace: Count(%d) PerFrame(%f)", mMoveTraceCount, (float)(mMoveTraceCount) / (float)(level.time));
 	mGraph.ProfilePrint("View Trace: Count(%d) PerFrame(%f)", mViewTraceCount, (float)(mViewTraceCount) / (float)(level.time));
+	mGraph.ProfilePrint("");
+	mGraph.ProfilePrint("Nearest Node: Queries(%d) CachedResults(%d) PrecomputedHits(%d) Traces(%d) PerFrame(%f)",
+		mNearestQueryCount, mNearestCacheHits, mNearestClearHits, mNearestTraceCount,
+		(float)(mNearestTraceCount) / (float)(level.time));
+	mGraph.ProfilePrint("Nearest Node: Build Traces(%d)", mNearestBuildTraces);
+	mGraph.ProfilePrint("");
+	mGraph.ProfilePrint("Path Planner: Searches(%d) Visited(%d) CachedPaths(%d)", mPathSearchCount, mPathVisitedCount,
+		mPathCacheHits);
+	mGraph.ProfilePrint("Path Planner: Regions(%d) Corridors(%d) CachedCorridors(%d) Fallbacks(%d)",
+		mRegionLayerSize, mCorridorSearchCount, mCorridorCacheHits, mCorridorFallbackCount);
 
 #endif
 }
 
+////////////////////////////////////////////////////////////////////////////////////////
+// Benchmark The Path Planner
+//
+// Runs count random queries over the loaded graph three ways: the flat A* search, the
+// region corridor search, and the corridor search with the shared caches.  A quarter
+// of the queries reuse the goal of the one before (a squad chasing one target) and a
+// few repeat an earlier query outright.  Path costs are compared against the flat
+// search.
+////////////////////////////////////////////////////////////////////////////////////////
+void NAV::BenchmarkPaths(int count)
+{
+	ratl::vector_vs<short, NUM_NODES> nodes;
+	for (TGraph::TNodes::iterator nodeIter = mGraph.nodes_begin(); nodeIter != mGraph.nodes_end(); ++nodeIter)
+	{
+		if (!(*nodeIter).mFlags.get_bit(CWayNode::WN_ISLAND))
+		{
+			nodes.push_back(nodeIter.index());
+		}
+	}
+	if (nodes.size() < 2 || mGraph.size_edges() <= 0)
+	{
+		gi.Printf("nav bench: no navigation graph loaded\n");
+		return;
+	}
+	if (count <= 0)
+	{
+		count = 1000;
+	}
+
+	// Generate The Queries With A Fixed Seed, So Runs Can Be Compared
+	//------------------------------------------------------------------
+	auto* starts = new int[count];
+	auto* ends = new int[count];
+	auto* costs = new float[count];
+	auto* found = new bool[count];
+
+	unsigned int seed = 0x4e415621u;
+	auto next_random = [&seed](const int range)
+		{
+			seed = seed * 1664525u + 1013904223u;
+			return static_cast<int>((seed >> 8) % static_cast<unsigned int>(range));
+		};
+
+	for (int i = 0; i < count; i++)
+	{
+		const int kind = next_random(8);
+		if (i > 0 && kind == 0)
+		{
+			const int earlier = next_random(i);
+			starts[i] = starts[earlier];
+			ends[i] = ends[earlier];
+		}
+		else
+		{
+			starts[i] = nodes[next_random(nodes.size())];
+			ends[i] = i > 0 && kind < 3 ? ends[i - 1] : nodes[next_random(nodes.size())];
+		}
+	}
+
+	mUser.ClearActor();
+
+	TPathNodes path;
+	float cost;
+
+	for (int pass = 0; pass < 4; pass++)
+	{
+		const bool useCorridor = pass > 1;
+		const bool useCache = pass & 1;
+
+		// Every Pass Starts Cold, So The Cache Passes Only Reuse Their Own Results
+		ClearPathCaches();
+
+		const int searches = mPathSearchCount;
+		const int visited = mPathVisitedCount;
+		const int cacheHits = mPathCacheHits;
+		const int corridorHits = mCorridorCacheHits;
+		const int fallbacks = mCorridorFallbackCount;
+
+		int succeeded = 0;
+		int mismatched = 0;
+		int worse = 0;
+		float costRatioTotal = 0.0f;
+		float costRatioWorst = 1.0f;
+
+		const int startTime = gi.Milliseconds();
+		for (int i = 0; i < count; i++)
+		{
+			const bool success = PlanPath(starts[i], ends[i], path, cost, useCorridor, useCache);
+			succeeded += success ? 1 : 0;
+
+			if (pass == 0)
+			{
+				found[i] = success;
+				costs[i] = cost;
+				continue;
+			}
+			if (success != found[i])
+			{
+				mismatched++;
+			}
+			else if (success && costs[i] > 0.0f)
+			{
+				const float ratio = cost / costs[i];
+				costRatioTotal += ratio;
+				costRatioWorst = Max(costRatioWorst, ratio);
+				if (ratio > 1.001f)
+				{
+					worse++;
+				}
+			}
+		}
+		const int elapsed = gi.Milliseconds() - startTime;
+
+		static const char* passNames[] = { "flat A*", "cache", "corridor", "corridor+cache" };
+		gi.Printf("nav bench %-14s: %d queries, %d ms, %d found, %d searches, %d visited, %d cached paths, %d cached corridors, %d fallbacks\n",
+			passNames[pass], count, elapsed, succeeded,
+			mPathSearchCount - searches, mPathVisitedCount - visited, mPathCacheHits - cacheHits,
+			mCorridorCacheHits - corridorHits, mCorridorFallbackCount - fallbacks);
+		if (pass > 0)
+		{
+			gi.Printf("nav bench %-14s: %d results differ, %d longer paths, cost ratio avg %.4f worst %.4f\n",
+				passNames[pass], mismatched, worse,
+				succeeded - mismatched > 0 ? costRatioTotal / (succeeded - mismatched) : 1.0f, costRatioWorst);
+		}
+	}
+
+	ClearPathCaches();
+
+	delete[] starts;
+	delete[] ends;
+	delete[] costs;
+	delete[] found;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 // TeleportTo
 ////////////////////////////////////////////////////////////////////////////////////
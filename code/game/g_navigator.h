@@ -82,6 +82,7 @@ namespace NAV
 	TNodeHandle GetNearestNode(gentity_t* ent, bool forceRecalcNow = false, TNodeHandle goal = 0);
 	TNodeHandle GetNearestNode(const vec3_t& position, TNodeHandle previous = 0, TNodeHandle goal = 0,
 		int ignoreEnt = ENTITYNUM_NONE, bool allowZOffset = false);
+	void UpdateNearestNodes();
 
 	TNodeHandle ChooseRandomNeighbor(TNodeHandle NodeHandle);
 	TNodeHandle ChooseRandomNeighbor(TNodeHandle NodeHandle, const vec3_t& position, float maxDistance);
@@ -151,6 +152,7 @@ namespace NAV
 	////////////////////////////////////////////////////////////////////////////////////
 	void ShowDebugInfo(const vec3_t& PlayerPosition, TNodeHandle player_waypoint);
 	void ShowStats();
+	void BenchmarkPaths(int count);
 
 	void TeleportTo(gentity_t* actor, const char* pointName);
 	void TeleportTo(gentity_t* actor, int pointNum);
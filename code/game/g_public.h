@@ -25,7 +25,7 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #define __G_PUBLIC_H__
 // g_public.h -- game module information visible to server
 
-#define	GAME_API_VERSION	10
+#define	GAME_API_VERSION	15
 
 // entity->svFlags
 // the server does not know how to interpret most of the values
@@ -384,10 +384,20 @@ using game_import_t = struct
 	bool (*WE_IsShaking)(vec3_t pos);
 	void (*WE_AddWeatherZone)(vec3_t mins, vec3_t maxs);
 	bool (*WE_SetTempGlobalFogColor)(vec3_t color);
+	void (*WE_IsOutsideBatch)(int numPoints, vec3_t* points, bool* outside);
+
+	// resolves several bolts of one model with a single skeleton build
+	qboolean(*G2API_GetBoltMatrices)(CGhoul2Info_v& ghoul2, int modelIndex, int numBolts, const int* bolt_indexes,
+		mdxaBone_t* matrices, const vec3_t angles, const vec3_t position, int frameNum, qhandle_t* model_list,
+		const vec3_t scale);
 
 	/*
 	Ghoul2 Insert End
 	*/
+
+	// read files ahead on background threads so the loads that follow come out of the OS file cache
+	void (*FS_PrefetchFiles)(int numFiles, const char* const* filenames);
+	void (*FS_PrefetchWait)(int* bytes, int* msec);
 };
 
 //
@@ -444,6 +454,9 @@ using game_export_t = struct
 	struct gentity_s* gentities;
 	int gentitySize;
 	int num_entities; // current number, <= MAX_GENTITIES
+
+	// hash of the state of every entity in use, for comparing runs of the same input
+	int (*EntityChecksum)();
 };
 
 game_export_t * GetGameApi(game_import_t * import);
@@ -1338,6 +1338,9 @@ void ReadLevel(const qboolean qbAutosave, const qboolean qb_load_transition)
 	saved_game.read_chunk<int32_t>(
 		INT_ID('D', 'O', 'N', 'E'),
 		iDONE);
+
+	// the loaded level.framenum can match frames cached before the load
+	G_PerceptionClear();
 }
 
 extern int killPlayerTimer;
@@ -812,6 +812,8 @@ public:
 
 	vec3_t ragLastOrigin; //keeping track of positions between rags while dragging corpses
 	int ragLastOriginTime;
+	qboolean ragSleeping; //settled, ragdoll updates are skipped until the body is disturbed (not saved)
+	vec3_t ragSleepOrigin; //where it went to sleep
 
 	//push refraction effect vars
 	int pushEffectFadeTime;
@@ -1061,6 +1063,7 @@ public:
 		saved_game.read<int32_t>(overridingBones);
 		saved_game.read<float>(ragLastOrigin);
 		saved_game.read<int32_t>(ragLastOriginTime);
+		ragSleeping = qfalse;
 		saved_game.read<int32_t>(pushEffectFadeTime);
 		saved_game.read<float>(pushEffectOrigin);
 		saved_game.read<int32_t>(rocketLockIndex);
@@ -28,6 +28,8 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 
 extern cvar_t* g_spskill;
 extern cvar_t* g_delayedShutdown;
+extern cvar_t* g_prefetch;
+extern cvar_t* g_showLoadTimes;
 
 // these vars I moved here out of the level_locals_t struct simply because it's pointless to try saving them,
 //	and the level_locals_t struct is included in the save process... -slc
@@ -42,6 +44,8 @@ int delayedShutDown = 0;
 
 #include "../qcommon/sstring.h"
 
+#include <algorithm>
+
 //NOTENOTE: Be sure to change the mirrored code in cgmain.cpp
 using namePrecache_m = std::map<sstring_t, unsigned char>;
 namePrecache_m* as_preCacheMap = nullptr;
@@ -1705,6 +1709,163 @@ void G_ASPreCacheFree()
 	}
 }
 
+/*
+-------------------------
+G_CollectPrefetches
+
+First pass of the two-phase map load. Reads the spawn vars of every entity without
+spawning anything and lists the files their spawn functions and the cgame are going
+to load, so the engine can read them ahead while the entities spawn. It only knows
+the common ones (models, target_speaker noises, effects, NPC models and skins),
+anything it misses loads just as it always did.
+-------------------------
+*/
+
+extern char NPCParms[];
+extern qboolean G_ParseLiteral(const char** data, const char* string);
+
+static const char* G_CollectSpawnVar(const char* key)
+{
+	for (int i = 0; i < numSpawnVars; i++)
+	{
+		if (!Q_stricmp(spawnVars[i][0], key))
+		{
+			return spawnVars[i][1];
+		}
+	}
+
+	return nullptr;
+}
+
+// the model and skin files CG_NPC_Precache() will ask for
+//
+static void G_CollectNPCPrefetches(const char* npc_type, std::vector<std::string>& files)
+{
+	char player_model[MAX_QPATH] = { 0 };
+	char custom_skin[MAX_QPATH] = "default";
+	const char* p = NPCParms;
+	const char* value;
+
+	if (!Q_stricmp("random", npc_type))
+	{
+		return;
+	}
+
+	COM_BeginParseSession();
+
+	// look for the right NPC
+	while (p)
+	{
+		const char* token = COM_ParseExt(&p, qtrue);
+		if (token[0] == 0)
+		{
+			COM_EndParseSession();
+			return;
+		}
+
+		if (!Q_stricmp(token, npc_type))
+		{
+			break;
+		}
+
+		SkipBracedSection(&p);
+	}
+
+	if (!p || G_ParseLiteral(&p, "{"))
+	{
+		COM_EndParseSession();
+		return;
+	}
+
+	while (true)
+	{
+		const char* token = COM_ParseExt(&p, qtrue);
+		if (!token[0] || !Q_stricmp(token, "}"))
+		{
+			break;
+		}
+
+		if (!Q_stricmp(token, "playerModel"))
+		{
+			if (!COM_ParseString(&p, &value))
+			{
+				Q_strncpyz(player_model, value, sizeof player_model);
+			}
+			continue;
+		}
+
+		if (!Q_stricmp(token, "customSkin"))
+		{
+			if (!COM_ParseString(&p, &value))
+			{
+				Q_strncpyz(custom_skin, value, sizeof custom_skin);
+			}
+			continue;
+		}
+
+		SkipRestOfLine(&p);
+	}
+
+	COM_EndParseSession();
+
+	if (player_model[0])
+	{
+		files.emplace_back(va("models/players/%s/model.glm", player_model));
+		if (!strchr(custom_skin, '|'))
+		{
+			files.emplace_back(va("models/players/%s/model_%s.skin", player_model, custom_skin));
+		}
+	}
+}
+
+static void G_CollectPrefetches(const char* entity_string, std::vector<std::string>& files)
+{
+	char buffer[MAX_QPATH];
+
+	while (G_ParseSpawnVars(&entity_string))
+	{
+		for (const char* key : { "model", "model2" })
+		{
+			const char* model = G_CollectSpawnVar(key);
+			if (model && model[0] && model[0] != '*')
+			{
+				files.emplace_back(model);
+			}
+		}
+
+		// target_speaker, "*" sounds are per player model and "%d" ones pick at random
+		const char* noise = G_CollectSpawnVar("noise");
+		if (noise && noise[0] && noise[0] != '*' && !strchr(noise, '%'))
+		{
+			COM_StripExtension(noise, buffer, sizeof buffer);
+			files.emplace_back(va("%s.wav", buffer));
+			files.emplace_back(va("%s.mp3", buffer));
+		}
+
+		for (const char* key : { "fxFile", "fxFile2" })
+		{
+			const char* fx = G_CollectSpawnVar(key);
+			if (fx && fx[0])
+			{
+				COM_StripExtension(fx, buffer, sizeof buffer);
+				files.emplace_back(va("effects/%s.efx", buffer));
+			}
+		}
+
+		const char* npc_type = G_CollectSpawnVar("NPC_type");
+		if (npc_type && npc_type[0])
+		{
+			G_CollectNPCPrefetches(npc_type, files);
+		}
+	}
+
+	numSpawnVars = 0;
+
+	// lots of entities share models, the engine ignores names it can't find
+	std::sort(files.begin(), files.end());
+	files.erase(std::unique(files.begin(), files.end()), files.end());
+}
+
 /*
 ==============
 G_SpawnEntitiesFromString
@@ -1754,9 +1915,29 @@ void G_SubBSPSpawnEntitiesFromString(const char* entityString, vec3_t posOffset,
 
 void G_SpawnEntitiesFromString(const char* entity_string)
 {
-	const char* entities;
+	const int i_start = gi.Milliseconds();
+	int i_prefetches = 0;
 
-	entities = entity_string;
+	// two-phase load: work out what the entities are going to load and have the engine
+	// start reading it in the background, then spawn them as usual
+	if (g_prefetch->integer)
+	{
+		std::vector<std::string> files;
+		G_CollectPrefetches(entity_string, files);
+
+		std::vector<const char*> names;
+		names.reserve(files.size());
+		for (const std::string& file : files)
+		{
+			names.push_back(file.c_str());
+		}
+		i_prefetches = static_cast<int>(names.size());
+		gi.FS_PrefetchFiles(i_prefetches, names.data());
+	}
+
+	const int i_collected = gi.Milliseconds();
+	const char* entities = entity_string;
+	int i_entities = 0;
 
 	// allow calls to G_Spawn*()
 	spawning = qtrue;
@@ -1777,8 +1958,11 @@ void G_SpawnEntitiesFromString(const char* entity_string)
 	while (G_ParseSpawnVars(&entities))
 	{
 		G_SpawnGEntityFromSpawnVars();
+		i_entities++;
 	}
 
+	const int i_spawned = gi.Milliseconds();
+
 	//Search the entities for precache information
 	G_ParsePrecaches();
 
@@ -1803,6 +1987,25 @@ void G_SpawnEntitiesFromString(const char* entity_string)
 
 	spawning = qfalse; // any future calls to G_Spawn*() will be errors
 
+	// the prefetch keeps going while the cgame registers its media, only wait for it to
+	// finish when asked for the numbers
+	if (g_showLoadTimes->integer)
+	{
+		const int i_precached = gi.Milliseconds();
+		int i_prefetch_bytes = 0, i_prefetch_msec = 0;
+		gi.FS_PrefetchWait(&i_prefetch_bytes, &i_prefetch_msec);
+		const int i_end = gi.Milliseconds();
+
+		gi.Printf("Spawned %d entities in %d msec: collect %d, spawn %d, precache %d, prefetch wait %d\n",
+			i_entities, i_end - i_start, i_collected - i_start, i_spawned - i_collected, i_precached - i_spawned,
+			i_end - i_precached);
+		if (i_prefetches)
+		{
+			gi.Printf("Prefetched %d files, %.2f MB in %d msec\n", i_prefetches,
+				static_cast<float>(i_prefetch_bytes) / (1024.0f * 1024.0f), i_prefetch_msec);
+		}
+	}
+
 	if (g_delayedShutdown->integer && delayedShutDown)
 	{
 		assert(0);
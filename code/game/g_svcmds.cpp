@@ -41,6 +41,11 @@ extern saber_colors_t TranslateSaberColor(const char* name);
 extern qboolean WP_SaberBladeUseSecondBladeStyle(const saberInfo_t* saber, int blade_num);
 extern qboolean WP_UseFirstValidSaberStyle(const gentity_t* ent, int* saber_anim_level);
 extern void G_RemoveWeather();
+extern gentity_t* NPC_Spawn_Do(gentity_t* ent, qboolean fullSpawnNow);
+extern void NPC_PrecacheAnimationCFG(const char* npc_type);
+extern void NPC_PrecacheByClassName(const char* type);
+extern void G_RagBenchStart(int interval);
+extern void G_RagBenchStop();
 extern void RemoveBarrier(gentity_t* ent);
 extern cvar_t* g_SerenityJediEngineMode;
 extern cvar_t* g_RealisticBlockingMode;
@@ -1224,6 +1229,95 @@ static void Svcmd_Difficulty_f()
 	}
 }
 
+/*
+=================
+Svcmd_RagBench_f
+
+ragbench <count> [npc type] [report msec]
+ragbench stop
+
+Drops count dead NPCs in a grid in front of the player and prints the ragdoll
+solver cost every report interval until stopped.  broadsword 2 sends them
+straight into ragdoll.  For a headless run:
+	+set broadsword 2 +set com_benchmark 3000 +devmap <map> +wait 20 +ragbench 16
+=================
+*/
+static void Svcmd_RagBench_f()
+{
+	if (gi.argc() < 2)
+	{
+		gi.Printf("usage: ragbench <count> [npc type] [report msec]\n       ragbench stop\n");
+		return;
+	}
+
+	if (!Q_stricmp(gi.argv(1), "stop"))
+	{
+		G_RagBenchStop();
+		return;
+	}
+
+	const gentity_t* player = &g_entities[0];
+	if (!player->inuse || !player->client)
+	{
+		gi.Printf(S_COLOR_RED "ragbench: no player to drop them in front of\n");
+		return;
+	}
+
+	const int count = Com_Clampi(1, 256, atoi(gi.argv(1)));
+	const char* npc_type = gi.argc() > 2 ? gi.argv(2) : "stormtrooper";
+	const int interval = gi.argc() > 3 ? Com_Clampi(50, 60000, atoi(gi.argv(3))) : 1000;
+
+	constexpr float spacing = 48.0f;
+	const int columns = static_cast<int>(ceilf(sqrtf(static_cast<float>(count))));
+	vec3_t forward, right, corner;
+
+	AngleVectors(player->client->ps.viewangles, forward, right, nullptr);
+	forward[2] = 0;
+	VectorNormalize(forward);
+	VectorMA(player->currentOrigin, 96.0f, forward, corner);
+	VectorMA(corner, -0.5f * spacing * (columns - 1), right, corner);
+	corner[2] += 48.0f;
+
+	NPC_PrecacheAnimationCFG(npc_type);
+	NPC_PrecacheByClassName(npc_type);
+
+	int spawned = 0;
+	for (int i = 0; i < count; i++)
+	{
+		gentity_t* spawner = G_Spawn();
+		vec3_t origin;
+
+		if (!spawner)
+		{
+			gi.Printf(S_COLOR_RED "ragbench: out of entities after %i\n", spawned);
+			break;
+		}
+
+		VectorMA(corner, spacing * (i / columns), forward, origin);
+		VectorMA(origin, spacing * (i % columns), right, origin);
+		G_SetOrigin(spawner, origin);
+		VectorCopy(spawner->currentOrigin, spawner->s.origin);
+		spawner->s.angles[YAW] = static_cast<float>(i * 67 % 360);
+		gi.linkentity(spawner);
+
+		spawner->NPC_type = Q_strlwr(G_NewString(npc_type));
+		spawner->count = 1;
+
+		gentity_t* npc = NPC_Spawn_Do(spawner, qtrue);
+		if (!npc || !npc->client)
+		{
+			continue;
+		}
+
+		npc->health = 0;
+		GEntity_DieFunc(npc, npc, npc, npc->max_health, MOD_UNKNOWN);
+		spawned++;
+	}
+
+	gi.Printf("ragbench: dropped %i %s\n", spawned, npc_type);
+	G_RagBenchStart(interval);
+}
+
 constexpr auto CMD_NONE = 0x00000000u;
 constexpr auto CMD_CHEAT = 0x00000001u;
 constexpr auto CMD_ALIVE = 0x00000002u;
@@ -1294,6 +1388,7 @@ static svcmd_t svcmds[] = {
 	{"control", Svcmd_Control_f, CMD_CHEAT},
 	{"grab", Svcmd_Grab_f, CMD_CHEAT},
 	{"knockdown", Svcmd_Knockdown_f, CMD_CHEAT},
+	{"ragbench", Svcmd_RagBench_f, CMD_CHEAT},
 
 	{"playerModel", Svcmd_PlayerModel_f, CMD_NONE},
 	{"playerTint", Svcmd_PlayerTint_f, CMD_NONE},
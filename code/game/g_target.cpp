@@ -810,6 +810,7 @@ void scriptrunner_run(gentity_t* self)
 				{
 					//We don't have a script_targetname, so create a new one
 					self->activator->script_targetname = va("newICARUSEnt%d", numNewICARUSEnts++);
+					G_UpdateFindIndex(self->activator);
 				}
 
 				if (Quake3Game()->ValidEntity(self->activator))
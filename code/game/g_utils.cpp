@@ -479,6 +479,267 @@ void G_SpeechEvent(const gentity_t* self, const int event)
 
 //=====================================================================
 
+/*
+=============
+Name indexes
+
+targetname, classname, script_targetname and NPC_targetname are also kept
+in case-insensitive hash chains, sorted by entity number, so G_Find can go
+straight to the entities holding a name instead of comparing every one.
+
+The index remembers which string pointer it saw for each entity.  Entities
+spawned or freed this frame are re-checked on every lookup, so fields filled
+in right after G_Spawn are always seen; other name changes on live entities
+should call G_UpdateFindIndex, and anything that slips through is caught by
+the full pass at the start of the next frame.  Chain entries are always
+compared against the live field, so a stale one can never give a false match.
+=============
+*/
+
+extern cvar_t* g_findIndex;
+
+constexpr auto FIND_INDEX_FIELDS = 4;
+constexpr auto FIND_INDEX_HASH = 1024; // power of two
+
+struct findIndex_t
+{
+	int head[FIND_INDEX_HASH];
+	int next[MAX_GENTITIES];
+	int prev[MAX_GENTITIES];
+	int bucket[MAX_GENTITIES]; // -1 if not in any chain
+	const char* seen[MAX_GENTITIES]; // field pointer when last indexed
+};
+
+static findIndex_t findIndex[FIND_INDEX_FIELDS];
+static qboolean findIndexValid;
+
+static int findPending[MAX_GENTITIES];
+static int findPendingFrame[MAX_GENTITIES]; // frame it was queued on, -1 if not queued
+static int numFindPending;
+
+static int G_FindIndexField(const int fieldofs)
+{
+	if (fieldofs == FOFS(targetname))
+		return 0;
+	if (fieldofs == FOFS(classname))
+		return 1;
+	if (fieldofs == FOFS(script_targetname))
+		return 2;
+	if (fieldofs == FOFS(NPC_targetname))
+		return 3;
+	return -1;
+}
+
+static int G_FindIndexFieldOfs(const int field)
+{
+	static const int fieldofs[FIND_INDEX_FIELDS] = {
+		FOFS(targetname), FOFS(classname), FOFS(script_targetname), FOFS(NPC_targetname)
+	};
+	return fieldofs[field];
+}
+
+static int G_FindIndexHash(const char* s)
+{
+	unsigned int hash = FNV1A_INIT;
+	for (; *s; s++)
+	{
+		hash = Com_HashFNV1a(hash, tolower(static_cast<unsigned char>(*s)));
+	}
+	return hash & (FIND_INDEX_HASH - 1);
+}
+
+static const char* G_FindIndexValue(const int entNum, const int field)
+{
+	if (!PInUse(entNum))
+	{
+		return nullptr;
+	}
+	return *reinterpret_cast<char**>(reinterpret_cast<byte*>(&g_entities[entNum]) + G_FindIndexFieldOfs(field));
+}
+
+static void G_FindIndexUnlink(findIndex_t& index, const int entNum)
+{
+	if (index.bucket[entNum] == -1)
+	{
+		return;
+	}
+	if (index.prev[entNum] == -1)
+	{
+		index.head[index.bucket[entNum]] = index.next[entNum];
+	}
+	else
+	{
+		index.next[index.prev[entNum]] = index.next[entNum];
+	}
+	if (index.next[entNum] != -1)
+	{
+		index.prev[index.next[entNum]] = index.prev[entNum];
+	}
+	index.bucket[entNum] = -1;
+}
+
+static void G_FindIndexEntity(const int entNum)
+{
+	for (int field = 0; field < FIND_INDEX_FIELDS; field++)
+	{
+		findIndex_t& index = findIndex[field];
+		const char* value = G_FindIndexValue(entNum, field);
+		if (value == index.seen[entNum])
+		{
+			continue;
+		}
+
+		G_FindIndexUnlink(index, entNum);
+		index.seen[entNum] = value;
+		if (!value || !value[0])
+		{
+			continue;
+		}
+
+		// keep the chain in entity order so lookups return what the scan would
+		const int bucket = G_FindIndexHash(value);
+		int prev = -1;
+		int next = index.head[bucket];
+		while (next != -1 && next < entNum)
+		{
+			prev = next;
+			next = index.next[next];
+		}
+		index.bucket[entNum] = bucket;
+		index.prev[entNum] = prev;
+		index.next[entNum] = next;
+		if (prev == -1)
+		{
+			index.head[bucket] = entNum;
+		}
+		else
+		{
+			index.next[prev] = entNum;
+		}
+		if (next != -1)
+		{
+			index.prev[next] = entNum;
+		}
+	}
+}
+
+static void G_RebuildFindIndex()
+{
+	for (auto& index : findIndex)
+	{
+		memset(index.head, -1, sizeof index.head);
+		memset(index.bucket, -1, sizeof index.bucket);
+		memset(index.seen, 0, sizeof index.seen);
+	}
+	memset(findPendingFrame, -1, sizeof findPendingFrame);
+	numFindPending = 0;
+	findIndexValid = qtrue;
+
+	for (int i = 0; i < MAX_GENTITIES; i++)
+	{
+		G_FindIndexEntity(i);
+	}
+}
+
+// forget everything, the next lookup rebuilds from scratch (new level, loaded game)
+void G_InvalidateFindIndex()
+{
+	findIndexValid = qfalse;
+}
+
+// re-index an entity whose name fields may have changed
+void G_UpdateFindIndex(const gentity_t* ent)
+{
+	if (findIndexValid)
+	{
+		G_FindIndexEntity(ent - g_entities);
+	}
+}
+
+// entities being spawned or freed get re-checked on every lookup this frame
+static void G_QueueFindIndex(const gentity_t* ent)
+{
+	const int entNum = ent - g_entities;
+	if (!findIndexValid || findPendingFrame[entNum] != -1)
+	{
+		return;
+	}
+	findPendingFrame[entNum] = level.framenum;
+	findPending[numFindPending++] = entNum;
+}
+
+static void G_FlushFindPending()
+{
+	for (int i = 0; i < numFindPending; i++)
+	{
+		const int entNum = findPending[i];
+		G_FindIndexEntity(entNum);
+		if (findPendingFrame[entNum] != level.framenum)
+		{
+			findPendingFrame[entNum] = -1;
+			findPending[i--] = findPending[--numFindPending];
+		}
+	}
+}
+
+/*
+=============
+G_SyncFindIndex
+
+Called at the start of every frame to pick up any name change made without
+telling the index.
+=============
+*/
+void G_SyncFindIndex()
+{
+	if (!g_findIndex->integer)
+	{
+		findIndexValid = qfalse;
+		return;
+	}
+	if (!findIndexValid)
+	{
+		G_RebuildFindIndex();
+		return;
+	}
+
+	G_FlushFindPending();
+	for (int i = 0; i < MAX_GENTITIES; i++)
+	{
+		G_FindIndexEntity(i);
+	}
+}
+
+static gentity_t* G_FindIndexed(const int start, const int field, const char* match)
+{
+	if (!findIndexValid)
+	{
+		G_RebuildFindIndex();
+	}
+	else
+	{
+		G_FlushFindPending();
+	}
+
+	const int fieldofs = G_FindIndexFieldOfs(field);
+	for (int i = findIndex[field].head[G_FindIndexHash(match)]; i != -1 && i < globals.num_entities;
+		i = findIndex[field].next[i])
+	{
+		if (i < start || !PInUse(i))
+		{
+			continue;
+		}
+		const char* s = *reinterpret_cast<char**>(reinterpret_cast<byte*>(&g_entities[i]) + fieldofs);
+		if (s && !Q_stricmp(s, match))
+		{
+			return &g_entities[i];
+		}
+	}
+	return nullptr;
+}
+
+static gentity_t* G_FindLinear(gentity_t* from, int fieldofs, const char* match);
+
 /*
 =============
 G_Find
@@ -498,6 +759,28 @@ gentity_t* G_Find(gentity_t* from, const int fieldofs, const char* match)
 		return nullptr;
 	}
 
+	const int field = g_findIndex->integer ? G_FindIndexField(fieldofs) : -1;
+	if (field == -1)
+	{
+		return G_FindLinear(from, fieldofs, match);
+	}
+
+	gentity_t* found = G_FindIndexed(from ? from - g_entities + 1 : 0, field, match);
+	if (g_findIndex->integer == 2)
+	{
+		gentity_t* linear = G_FindLinear(from, fieldofs, match);
+		if (linear != found)
+		{
+			gi.Printf(S_COLOR_YELLOW "G_Find index mismatch for \"%s\": index %d, scan %d\n", match,
+				found ? found->s.number : -1, linear ? linear->s.number : -1);
+		}
+		return linear;
+	}
+	return found;
+}
+
+static gentity_t* G_FindLinear(gentity_t* from, const int fieldofs, const char* match)
+{
 	if (!from)
 		from = g_entities;
 	else
@@ -782,6 +1065,7 @@ void G_InitGentity(gentity_t* e, const qboolean b_free_g2)
 	e->m_iIcarusID = IIcarusInterface::ICARUS_INVALID;
 	e->classname = "noclass";
 	e->s.number = e - g_entities;
+	G_QueueFindIndex(e);
 
 	// remove any ghoul2 models here in case we're reusing
 	if (b_free_g2 && e->ghoul2.IsValid())
@@ -1101,6 +1385,7 @@ void G_FreeEntity(gentity_t* ent)
 	ent->freetime = level.time;
 	ent->inuse = qfalse;
 	ClearInUse(ent);
+	G_QueueFindIndex(ent);
 }
 
 /*
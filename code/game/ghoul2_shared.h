@@ -526,6 +526,8 @@ public:
 	int currentAnimModelSize;
 	const mdxaHeader_t* aHeader;
 
+	int mRagStepTime; // time the ragdoll solver has stepped up to, runtime only
+
 	CGhoul2Info() :
 		mModelindex(-1),
 		animModelIndexOffset(0),
@@ -551,7 +553,8 @@ public:
 		currentModelSize(0),
 		animModel(nullptr),
 		currentAnimModelSize(0),
-		aHeader(nullptr)
+		aHeader(nullptr),
+		mRagStepTime(0)
 	{
 		mFileName[0] = 0;
 	}
@@ -180,6 +180,7 @@ qboolean G2API_AttachEnt(int* boltInfo, CGhoul2Info* ghlInfoTo, int toBoltIndex,
 void G2API_DetachEnt(int* boltInfo);
 
 qboolean G2API_GetBoltMatrix(CGhoul2Info_v& ghoul2, const int modelIndex, const int bolt_index, mdxaBone_t* matrix, const vec3_t angles, const vec3_t position, const int aframe_num, qhandle_t* model_list, const vec3_t scale);
+qboolean G2API_GetBoltMatrices(CGhoul2Info_v& ghoul2, const int modelIndex, const int numBolts, const int* bolt_indexes, mdxaBone_t* matrices, const vec3_t angles, const vec3_t position, const int aframe_num, qhandle_t* model_list, const vec3_t scale);
 
 void G2API_ListSurfaces(CGhoul2Info* ghlInfo);
 void G2API_ListBones(CGhoul2Info* ghlInfo, const int frame);
@@ -223,6 +224,7 @@ int G2API_GetSurfaceRenderStatus(CGhoul2Info* ghlInfo, const char* surfaceName);
 // From tr_ghoul2.cpp
 void G2_ConstructGhoulSkeleton(CGhoul2Info_v& ghoul2, int frameNum, bool checkForNewOrigin, const vec3_t scale);
 void G2_GetBoltMatrixLow(CGhoul2Info& ghoul2, int boltNum, const vec3_t scale, mdxaBone_t& retMatrix);
+bool G2_GetBoneCacheStamp(const CGhoul2Info& ghoul2, const void** boneCache, int* touch, int* epoch);
 void G2_TimingModel(boneInfo_t& bone, const int current_time, const int numFramesInFile, int& current_frame, int& newFrame, float& lerp);
 
 bool G2_SetupModelPointers(CGhoul2Info_v& ghoul2); // returns true if any model is properly set up
@@ -58,6 +58,7 @@ void window8_dual(const float* vbuf, int vb_ptr, short* pcm);
 /*-------------------------------------------------------------------------*/
 /* circular window buffers */
 #include "mp3struct.h"
+#include "csimd.h"
 ////static signed int vb_ptr;	// !!!!!!!!!!!!!
 ////static signed int vb2_ptr;	// !!!!!!!!!!!!!
 ////static float pMP3Stream->vbuf[512];		// !!!!!!!!!!!!!
@@ -115,8 +116,8 @@ void sbt_mono(float* sample, short* pcm, const int n)
 {
 	for (int i = 0; i < n; i++)
 	{
-		fdct32(sample, pMP3Stream->vbuf + pMP3Stream->vb_ptr);
-		window(pMP3Stream->vbuf, pMP3Stream->vb_ptr, pcm);
+		sbt_fdct32(sample, pMP3Stream->vbuf + pMP3Stream->vb_ptr);
+		sbt_window(pMP3Stream->vbuf, pMP3Stream->vb_ptr, pcm);
 		sample += 64;
 		pMP3Stream->vb_ptr = (pMP3Stream->vb_ptr - 32) & 511;
 		pcm += 32;
@@ -128,10 +129,10 @@ void sbt_dual(float* sample, short* pcm, const int n)
 {
 	for (int i = 0; i < n; i++)
 	{
-		fdct32_dual(sample, pMP3Stream->vbuf + pMP3Stream->vb_ptr);
-		fdct32_dual(sample + 1, pMP3Stream->vbuf2 + pMP3Stream->vb_ptr);
-		window_dual(pMP3Stream->vbuf, pMP3Stream->vb_ptr, pcm);
-		window_dual(pMP3Stream->vbuf2, pMP3Stream->vb_ptr, pcm + 1);
+		sbt_fdct32_dual(sample, pMP3Stream->vbuf + pMP3Stream->vb_ptr);
+		sbt_fdct32_dual(sample + 1, pMP3Stream->vbuf2 + pMP3Stream->vb_ptr);
+		sbt_window_dual(pMP3Stream->vbuf, pMP3Stream->vb_ptr, pcm);
+		sbt_window_dual(pMP3Stream->vbuf2, pMP3Stream->vb_ptr, pcm + 1);
 		sample += 64;
 		pMP3Stream->vb_ptr = (pMP3Stream->vb_ptr - 32) & 511;
 		pcm += 64;
@@ -144,8 +145,8 @@ void sbt_dual_mono(float* sample, short* pcm, const int n)
 {
 	for (int i = 0; i < n; i++)
 	{
-		fdct32_dual_mono(sample, pMP3Stream->vbuf + pMP3Stream->vb_ptr);
-		window(pMP3Stream->vbuf, pMP3Stream->vb_ptr, pcm);
+		sbt_fdct32_dual_mono(sample, pMP3Stream->vbuf + pMP3Stream->vb_ptr);
+		sbt_window(pMP3Stream->vbuf, pMP3Stream->vb_ptr, pcm);
 		sample += 64;
 		pMP3Stream->vb_ptr = (pMP3Stream->vb_ptr - 32) & 511;
 		pcm += 32;
@@ -158,8 +159,8 @@ void sbt_dual_left(float* sample, short* pcm, const int n)
 {
 	for (int i = 0; i < n; i++)
 	{
-		fdct32_dual(sample, pMP3Stream->vbuf + pMP3Stream->vb_ptr);
-		window(pMP3Stream->vbuf, pMP3Stream->vb_ptr, pcm);
+		sbt_fdct32_dual(sample, pMP3Stream->vbuf + pMP3Stream->vb_ptr);
+		sbt_window(pMP3Stream->vbuf, pMP3Stream->vb_ptr, pcm);
 		sample += 64;
 		pMP3Stream->vb_ptr = (pMP3Stream->vb_ptr - 32) & 511;
 		pcm += 32;
@@ -173,8 +174,8 @@ void sbt_dual_right(float* sample, short* pcm, const int n)
 	sample++; /* point to right chan */
 	for (int i = 0; i < n; i++)
 	{
-		fdct32_dual(sample, pMP3Stream->vbuf + pMP3Stream->vb_ptr);
-		window(pMP3Stream->vbuf, pMP3Stream->vb_ptr, pcm);
+		sbt_fdct32_dual(sample, pMP3Stream->vbuf + pMP3Stream->vb_ptr);
+		sbt_window(pMP3Stream->vbuf, pMP3Stream->vb_ptr, pcm);
 		sample += 64;
 		pMP3Stream->vb_ptr = (pMP3Stream->vb_ptr - 32) & 511;
 		pcm += 32;
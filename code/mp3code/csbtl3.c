@@ -40,8 +40,8 @@ void sbt_mono_L3(float* sample, short* pcm, int ch)
 	ch = 0;
 	for (int i = 0; i < 18; i++)
 	{
-		fdct32(sample, pMP3Stream->vbuf + pMP3Stream->vb_ptr);
-		window(pMP3Stream->vbuf, pMP3Stream->vb_ptr, pcm);
+		sbt_fdct32(sample, pMP3Stream->vbuf + pMP3Stream->vb_ptr);
+		sbt_window(pMP3Stream->vbuf, pMP3Stream->vb_ptr, pcm);
 		sample += 32;
 		pMP3Stream->vb_ptr = (pMP3Stream->vb_ptr - 32) & 511;
 		pcm += 32;
@@ -57,8 +57,8 @@ void sbt_dual_L3(float* sample, short* pcm, const int n)
 	{
 		for (i = 0; i < 18; i++)
 		{
-			fdct32(sample, pMP3Stream->vbuf + pMP3Stream->vb_ptr);
-			window_dual(pMP3Stream->vbuf, pMP3Stream->vb_ptr, pcm);
+			sbt_fdct32(sample, pMP3Stream->vbuf + pMP3Stream->vb_ptr);
+			sbt_window_dual(pMP3Stream->vbuf, pMP3Stream->vb_ptr, pcm);
 			sample += 32;
 			pMP3Stream->vb_ptr = (pMP3Stream->vb_ptr - 32) & 511;
 			pcm += 64;
@@ -68,8 +68,8 @@ void sbt_dual_L3(float* sample, short* pcm, const int n)
 	{
 		for (i = 0; i < 18; i++)
 		{
-			fdct32(sample, pMP3Stream->vbuf2 + pMP3Stream->vb2_ptr);
-			window_dual(pMP3Stream->vbuf2, pMP3Stream->vb2_ptr, pcm + 1);
+			sbt_fdct32(sample, pMP3Stream->vbuf2 + pMP3Stream->vb2_ptr);
+			sbt_window_dual(pMP3Stream->vbuf2, pMP3Stream->vb2_ptr, pcm + 1);
 			sample += 32;
 			pMP3Stream->vb2_ptr = (pMP3Stream->vb2_ptr - 32) & 511;
 			pcm += 64;
@@ -176,7 +176,7 @@ void sbtB_mono_L3(float* sample, unsigned char* pcm, int ch)
 	ch = 0;
 	for (int i = 0; i < 18; i++)
 	{
-		fdct32(sample, pMP3Stream->vbuf + pMP3Stream->vb_ptr);
+		sbt_fdct32(sample, pMP3Stream->vbuf + pMP3Stream->vb_ptr);
 		windowB(pMP3Stream->vbuf, pMP3Stream->vb_ptr, pcm);
 		sample += 32;
 		pMP3Stream->vb_ptr = (pMP3Stream->vb_ptr - 32) & 511;
@@ -193,7 +193,7 @@ void sbtB_dual_L3(float* sample, unsigned char* pcm, const int ch)
 	{
 		for (i = 0; i < 18; i++)
 		{
-			fdct32(sample, pMP3Stream->vbuf + pMP3Stream->vb_ptr);
+			sbt_fdct32(sample, pMP3Stream->vbuf + pMP3Stream->vb_ptr);
 			windowB_dual(pMP3Stream->vbuf, pMP3Stream->vb_ptr, pcm);
 			sample += 32;
 			pMP3Stream->vb_ptr = (pMP3Stream->vb_ptr - 32) & 511;
@@ -204,7 +204,7 @@ void sbtB_dual_L3(float* sample, unsigned char* pcm, const int ch)
 	{
 		for (i = 0; i < 18; i++)
 		{
-			fdct32(sample, pMP3Stream->vbuf2 + pMP3Stream->vb2_ptr);
+			sbt_fdct32(sample, pMP3Stream->vbuf2 + pMP3Stream->vb2_ptr);
 			windowB_dual(pMP3Stream->vbuf2, pMP3Stream->vb2_ptr, pcm + 1);
 			sample += 32;
 			pMP3Stream->vb2_ptr = (pMP3Stream->vb2_ptr - 32) & 511;
@@ -0,0 +1,333 @@
+// Filename:	csimd.c
+//
+// SSE2 polyphase synthesis, see csimd.h. The routines here mirror fdct32 (cdct.c) and window (cwin.c) step for step:
+//	the dct butterflies are element-wise so they just go four at a time, and the window runs four output samples
+//	side by side, each accumulating its 16 taps in the original order.
+//
+
+#include "csimd.h"
+
+#ifdef MP3_SIMD_KERNELS
+#include <emmintrin.h>
+#endif
+
+extern const float wincoef[264];
+
+void (*sbt_fdct32)(float x[], float c[]) = fdct32;
+void (*sbt_fdct32_dual)(float x[], float c[]) = fdct32_dual;
+void (*sbt_fdct32_dual_mono)(float x[], float c[]) = fdct32_dual_mono;
+void (*sbt_window)(const float* vbuf, int vb_ptr, short* pcm) = window;
+void (*sbt_window_dual)(const float* vbuf, int vb_ptr, short* pcm) = window_dual;
+
+#ifdef MP3_SIMD_KERNELS
+
+/*-- window coefs regrouped so four outputs load theirs together --*/
+static float wincoefFirst[8][2][16];	/* [tap][si,bx][output 0..15] */
+static float wincoefLast[8][2][12];	/* [tap][si,bx][output 17..28] */
+
+static void gen_simd_wincoef(void)
+{
+	int i, j;
+
+	for (j = 0; j < 8; j++)
+	{
+		for (i = 0; i < 16; i++)
+		{
+			wincoefFirst[j][0][i] = wincoef[i * 16 + 2 * j];
+			wincoefFirst[j][1][i] = wincoef[i * 16 + 2 * j + 1];
+		}
+		for (i = 0; i < 12; i++)
+		{
+			wincoefLast[j][0][i] = wincoef[255 - i * 16 - 2 * j];
+			wincoefLast[j][1][i] = wincoef[254 - i * 16 - 2 * j];
+		}
+	}
+}
+
+static __m128 reverse_ps(const __m128 v)
+{
+	return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+/*------------------------------------------------------------*/
+/* same as forward_bf in cdct.c, for n >= 8 */
+static void forward_bf_sse2(const int m, const int n, const float x[], float f[], const float coef[])
+{
+	const int n2 = n >> 1;
+	int p0 = 0;
+
+	for (int i = 0; i < m; i++, p0 += n)
+	{
+		for (int j = 0; j < n2; j += 4)
+		{
+			const __m128 xp = _mm_loadu_ps(x + p0 + j);
+			const __m128 xq = reverse_ps(_mm_loadu_ps(x + p0 + n - 4 - j));
+			_mm_storeu_ps(f + p0 + j, _mm_add_ps(xp, xq));
+			_mm_storeu_ps(f + p0 + n2 + j, _mm_mul_ps(_mm_loadu_ps(coef + j), _mm_sub_ps(xp, xq)));
+		}
+	}
+}
+
+/*------------------------------------------------------------*/
+static void forward_bf(const int m, const int n, const float x[], float f[], const float coef[])
+{
+	int p0 = 0;
+	const int n2 = n >> 1;
+	for (int i = 0; i < m; i++, p0 += n)
+	{
+		int k = 0;
+		int p = p0;
+		int q = p + n - 1;
+		for (int j = 0; j < n2; j++, p++, q--, k++)
+		{
+			f[p] = x[p] + x[q];
+			f[n2 + p] = coef[k] * (x[p] - x[q]);
+		}
+	}
+}
+
+/*------------------------------------------------------------*/
+static void back_bf(const int m, const int n, const float x[], float f[])
+{
+	int j;
+
+	int p0 = 0;
+	const int n2 = n >> 1;
+	const int n21 = n2 - 1;
+	for (int i = 0; i < m; i++, p0 += n)
+	{
+		int p = p0;
+		int q = p0;
+		for (j = 0; j < n2; j++, p += 2, q++)
+			f[p] = x[q];
+		p = p0 + 1;
+		for (j = 0; j < n21; j++, p += 2, q++)
+			f[p] = x[q] + x[q + 1];
+		f[p] = x[q];
+	}
+}
+
+/*------------------------------------------------------------*/
+/* everything after the special first stage, a[] holds its result */
+static void fdct32_stages_sse2(float a[32], float c[])
+{
+	float b[32];
+	const float* coef32 = dct_coef_addr();
+
+	forward_bf_sse2(2, 16, a, b, coef32 + 16);
+	forward_bf_sse2(4, 8, b, a, coef32 + 16 + 8);
+	forward_bf(8, 4, a, b, coef32 + 16 + 8 + 4);
+	forward_bf(16, 2, b, a, coef32 + 16 + 8 + 4 + 2);
+	back_bf(8, 4, a, b);
+	back_bf(4, 8, b, a);
+	back_bf(2, 16, a, b);
+	back_bf(1, 32, b, c);
+}
+
+/*------------------------------------------------------------*/
+void fdct32_sse2(float x[], float c[])
+{
+	float a[32];
+
+	forward_bf_sse2(1, 32, x, a, dct_coef_addr());
+	fdct32_stages_sse2(a, c);
+}
+
+/*------------------------------------------------------------*/
+/* x[] interleaved, xp gets x[2p], x[2p+2], x[2p+4], x[2p+6] and xq gets x[62-2p], x[60-2p], x[58-2p], x[56-2p], all
+	one further on for odd.  The loads stay inside what the C code reads, fdct32_dual is handed sample + 1 */
+static void load_dual(const float x[], const int p, __m128* xp, __m128* xq, const int odd)
+{
+	const __m128 p0 = _mm_loadu_ps(x + 2 * p);
+	const __m128 p1 = _mm_loadu_ps(x + 2 * p + 4);
+	const __m128 q0 = _mm_loadu_ps(x + 55 - 2 * p + odd);
+	const __m128 q1 = _mm_loadu_ps(x + 59 - 2 * p + odd);
+
+	if (odd)
+	{
+		*xp = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 1, 3, 1));
+	}
+	else
+	{
+		*xp = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(2, 0, 2, 0));
+	}
+	*xq = reverse_ps(_mm_shuffle_ps(q0, q1, _MM_SHUFFLE(3, 1, 3, 1)));
+}
+
+/*------------------------------------------------------------*/
+void fdct32_dual_sse2(float x[], float c[])
+{
+	float a[32];
+	const float* coef32 = dct_coef_addr();
+
+	for (int p = 0; p < 16; p += 4)
+	{
+		__m128 xp, xq;
+		load_dual(x, p, &xp, &xq, 0);
+		_mm_storeu_ps(a + p, _mm_add_ps(xp, xq));
+		_mm_storeu_ps(a + 16 + p, _mm_mul_ps(_mm_loadu_ps(coef32 + p), _mm_sub_ps(xp, xq)));
+	}
+	fdct32_stages_sse2(a, c);
+}
+
+/*------------------------------------------------------------*/
+void fdct32_dual_mono_sse2(float x[], float c[])
+{
+	float a[32];
+	const float* coef32 = dct_coef_addr();
+	const __m128 half = _mm_set1_ps(0.5F);
+
+	for (int p = 0; p < 16; p += 4)
+	{
+		__m128 lp, lq, rp, rq;
+		load_dual(x, p, &lp, &lq, 0);
+		load_dual(x, p, &rp, &rq, 1);
+		const __m128 t1 = _mm_mul_ps(half, _mm_add_ps(lp, rp));
+		const __m128 t2 = _mm_mul_ps(half, _mm_add_ps(lq, rq));
+		_mm_storeu_ps(a + p, _mm_add_ps(t1, t2));
+		_mm_storeu_ps(a + 16 + p, _mm_mul_ps(_mm_loadu_ps(coef32 + p), _mm_sub_ps(t1, t2)));
+	}
+	fdct32_stages_sse2(a, c);
+}
+
+/*------------------------------------------------------------*/
+/* (long) then clamp, as cwin.c does it, for four sums at once.  Clamping in float first gives the same result and
+	keeps cvttps away from values it can't convert */
+static void store_pcm4(const __m128 sum, short* pcm, const int step)
+{
+	const __m128 clamped = _mm_max_ps(_mm_min_ps(sum, _mm_set1_ps(32767.0F)), _mm_set1_ps(-32768.0F));
+	const __m128i packed = _mm_packs_epi32(_mm_cvttps_epi32(clamped), _mm_setzero_si128());
+
+	if (step == 1)
+	{
+		_mm_storel_epi64((__m128i*)pcm, packed);
+	}
+	else
+	{
+		pcm[0] = (short)_mm_extract_epi16(packed, 0);
+		pcm[step] = (short)_mm_extract_epi16(packed, 1);
+		pcm[2 * step] = (short)_mm_extract_epi16(packed, 2);
+		pcm[3 * step] = (short)_mm_extract_epi16(packed, 3);
+	}
+}
+
+static short clamp_pcm(const float sum)
+{
+	long tmp = (long)sum;
+	if (tmp > 32767)
+		tmp = 32767;
+	else if (tmp < -32768)
+		tmp = -32768;
+	return (short)tmp;
+}
+
+/*------------------------------------------------------------*/
+/* window() with pcm written every step samples.  vb_ptr is always a multiple of 32, so none of the four-wide loads
+	below run off the end of vbuf[512] */
+static void window_step_sse2(const float* vbuf, const int vb_ptr, short* pcm, const int step)
+{
+	int i, j;
+	float sum;
+
+	const int si0 = vb_ptr + 16;
+	const int bx0 = (si0 + 32) & 511;
+
+	/*-- first 16, outputs i..i+3 read vbuf[si+i..si+i+3] and vbuf[bx-i-3..bx-i] --*/
+	for (i = 0; i < 16; i += 4)
+	{
+		__m128 vsum = _mm_setzero_ps();
+		for (j = 0; j < 8; j++)
+		{
+			const int si = (si0 + i + 64 * j) & 511;
+			const int bx = (bx0 - i - 3 + 64 * j) & 511;
+			vsum = _mm_add_ps(vsum, _mm_mul_ps(_mm_loadu_ps(wincoefFirst[j][0] + i), _mm_loadu_ps(vbuf + si)));
+			vsum = _mm_sub_ps(vsum, _mm_mul_ps(_mm_loadu_ps(wincoefFirst[j][1] + i), reverse_ps(_mm_loadu_ps(vbuf + bx))));
+		}
+		store_pcm4(vsum, pcm + i * step, step);
+	}
+
+	/*--  special case --*/
+	int bx = (bx0 - 16) & 511;
+	const float* coef = wincoef + 256;
+	sum = 0.0F;
+	for (j = 0; j < 8; j++)
+	{
+		sum += (*coef++) * vbuf[bx];
+		bx = (bx + 64) & 511;
+	}
+	pcm[16 * step] = clamp_pcm(sum);
+
+	/*-- last 15, output 17+i reads vbuf[si-i] and vbuf[bx+i] --*/
+	const int si1 = vb_ptr + 31;
+	const int bx1 = bx0 - 15;
+	for (i = 0; i < 12; i += 4)
+	{
+		__m128 vsum = _mm_setzero_ps();
+		for (j = 0; j < 8; j++)
+		{
+			const int si = (si1 - i - 3 + 64 * j) & 511;
+			const int bx = (bx1 + i + 64 * j) & 511;
+			vsum = _mm_add_ps(vsum, _mm_mul_ps(_mm_loadu_ps(wincoefLast[j][0] + i), reverse_ps(_mm_loadu_ps(vbuf + si))));
+			vsum = _mm_add_ps(vsum, _mm_mul_ps(_mm_loadu_ps(wincoefLast[j][1] + i), _mm_loadu_ps(vbuf + bx)));
+		}
+		store_pcm4(vsum, pcm + (17 + i) * step, step);
+	}
+	for (; i < 15; i++)
+	{
+		int si = si1 - i;
+		bx = bx1 + i;
+		coef = wincoef + 255 - 16 * i;
+		sum = 0.0F;
+		for (j = 0; j < 8; j++)
+		{
+			sum += (*coef--) * vbuf[si];
+			si = (si + 64) & 511;
+			sum += (*coef--) * vbuf[bx];
+			bx = (bx + 64) & 511;
+		}
+		pcm[(17 + i) * step] = clamp_pcm(sum);
+	}
+}
+
+/*------------------------------------------------------------*/
+void window_sse2(const float* vbuf, const int vb_ptr, short* pcm)
+{
+	window_step_sse2(vbuf, vb_ptr, pcm, 1);
+}
+
+/*------------------------------------------------------------*/
+void window_dual_sse2(const float* vbuf, const int vb_ptr, short* pcm)
+{
+	window_step_sse2(vbuf, vb_ptr, pcm, 2);
+}
+
+#endif	// #ifdef MP3_SIMD_KERNELS
+
+/*------------------------------------------------------------*/
+const char* mp3_simd_init(const int enable)
+{
+	sbt_fdct32 = fdct32;
+	sbt_fdct32_dual = fdct32_dual;
+	sbt_fdct32_dual_mono = fdct32_dual_mono;
+	sbt_window = window;
+	sbt_window_dual = window_dual;
+
+#ifdef MP3_SIMD_KERNELS
+	if (enable)
+	{
+		static int iOnceOnly = 0;
+		if (!iOnceOnly++)
+		{
+			gen_simd_wincoef();
+		}
+
+		sbt_fdct32 = fdct32_sse2;
+		sbt_fdct32_dual = fdct32_dual_sse2;
+		sbt_fdct32_dual_mono = fdct32_dual_mono_sse2;
+		sbt_window = window_sse2;
+		sbt_window_dual = window_dual_sse2;
+		return "SSE2";
+	}
+#endif
+	return "scalar";
+}
@@ -0,0 +1,51 @@
+// Filename:	csimd.h
+//
+// SIMD versions of the polyphase synthesis (32 point dct and synthesis window), the inner loop of every decoded
+//	granule. The sbt_xxx routines in csbt.c/csbtl3.c call through the pointers below, which are the portable C
+//	routines unless mp3_simd_init() picked the SSE2 ones. Those do the same float operations in the same order for
+//	each output sample, so the pcm comes out the same.
+//
+
+#ifndef CSIMD_H
+#define CSIMD_H
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MP3_SIMD_KERNELS
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+	/* portable C versions, cdct.c and cwin.c */
+	float* dct_coef_addr(void);
+	void fdct32(float x[], float c[]);
+	void fdct32_dual(float x[], float c[]);
+	void fdct32_dual_mono(float x[], float c[]);
+	void window(const float* vbuf, int vb_ptr, short* pcm);
+	void window_dual(const float* vbuf, int vb_ptr, short* pcm);
+
+#ifdef MP3_SIMD_KERNELS
+	void fdct32_sse2(float x[], float c[]);
+	void fdct32_dual_sse2(float x[], float c[]);
+	void fdct32_dual_mono_sse2(float x[], float c[]);
+	void window_sse2(const float* vbuf, int vb_ptr, short* pcm);
+	void window_dual_sse2(const float* vbuf, int vb_ptr, short* pcm);
+#endif
+
+	/* what sbt_xxx call */
+	extern void (*sbt_fdct32)(float x[], float c[]);
+	extern void (*sbt_fdct32_dual)(float x[], float c[]);
+	extern void (*sbt_fdct32_dual_mono)(float x[], float c[]);
+	extern void (*sbt_window)(const float* vbuf, int vb_ptr, short* pcm);
+	extern void (*sbt_window_dual)(const float* vbuf, int vb_ptr, short* pcm);
+
+	/* enable != 0 picks the SIMD routines where there are some, returns the name of the set in use */
+	const char* mp3_simd_init(int enable);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CSIMD_H */
@@ -24,6 +24,7 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 // cmodel.c -- model loading
 
 #include "cm_local.h"
+#include "cm_patch.h"
 #include "qcommon/ojk_saved_game.h"
 #include "qcommon/ojk_saved_game_helper.h"
 
@@ -61,6 +62,8 @@ byte* cmod_base;
 cvar_t* cm_noAreas;
 cvar_t* cm_noCurves;
 cvar_t* cm_playerCurveClip;
+cvar_t* cm_patchCache;
+cvar_t* cm_patchVerify;
 #endif
 
 cmodel_t box_model;
@@ -534,6 +537,93 @@ void CMod_LoadVisibility(const lump_t* l, clipMap_t& cm)
 
 //==================================================================
 
+/*
+=================
+CMod_LoadPatchCache
+
+The patch cache stores the generated collision data of every patch in the map
+so it doesn't have to be rebuilt on each load. It is only trusted when both
+the map checksum and the data layout match.
+=================
+*/
+constexpr auto PATCH_CACHE_IDENT = ('C' << 24) + ('P' << 16) + ('C' << 8) + 'P';
+constexpr auto PATCH_CACHE_VERSION = 1;
+
+using patchCacheHeader_t = struct
+{
+	int ident;
+	int version;
+	int checksum;
+	int numSurfaces;
+	int planeSize;
+	int facetSize;
+};
+
+static void CM_PatchCachePath(const char* name, char* path, const int size)
+{
+	char stripped[MAX_QPATH];
+
+	COM_StripExtension(name, stripped, sizeof stripped);
+	Com_sprintf(path, size, "cache/%s.pcc", stripped);
+}
+
+static qboolean CMod_ReadPatchCacheHeader(const byte* data, const int len, const int checksum, const int numSurfaces)
+{
+	patchCacheHeader_t header;
+
+	if (len < static_cast<int>(sizeof header))
+	{
+		return qfalse;
+	}
+	memcpy(&header, data, sizeof header);
+
+	return static_cast<qboolean>(header.ident == PATCH_CACHE_IDENT
+		&& header.version == PATCH_CACHE_VERSION
+		&& header.checksum == checksum
+		&& header.numSurfaces == numSurfaces
+		&& header.planeSize == static_cast<int>(sizeof(patchPlane_t))
+		&& header.facetSize == static_cast<int>(sizeof(facet_t)));
+}
+
+static void CMod_WritePatchCache(const char* name, const int checksum, const clipMap_t& cm)
+{
+	char path[MAX_QPATH];
+	int size = sizeof(patchCacheHeader_t);
+
+	for (int i = 0; i < cm.numSurfaces; i++)
+	{
+		if (cm.surfaces[i])
+		{
+			size += sizeof(int) + CM_PatchCollideCacheSize(cm.surfaces[i]->pc);
+		}
+	}
+
+	byte* data = static_cast<byte*>(Z_Malloc(size, TAG_TEMP_WORKSPACE, qfalse));
+	patchCacheHeader_t header;
+	header.ident = PATCH_CACHE_IDENT;
+	header.version = PATCH_CACHE_VERSION;
+	header.checksum = checksum;
+	header.numSurfaces = cm.numSurfaces;
+	header.planeSize = sizeof(patchPlane_t);
+	header.facetSize = sizeof(facet_t);
+	memcpy(data, &header, sizeof header);
+
+	byte* out = data + sizeof header;
+	for (int i = 0; i < cm.numSurfaces; i++)
+	{
+		if (cm.surfaces[i])
+		{
+			memcpy(out, &i, sizeof(int));
+			out += sizeof(int);
+			out = CM_WritePatchCollideCache(cm.surfaces[i]->pc, out);
+		}
+	}
+
+	CM_PatchCachePath(name, path, sizeof path);
+	FS_WriteFile(path, data, size);
+	Z_Free(data);
+}
+
 /*
 =================
 CMod_LoadPatches
@@ -541,11 +631,18 @@ CMod_LoadPatches
 */
 constexpr auto MAX_PATCH_VERTS = 1024;
 
-void CMod_LoadPatches(const lump_t* surfs, const lump_t* verts, clipMap_t& cm)
+void CMod_LoadPatches(const lump_t* surfs, const lump_t* verts, clipMap_t& cm, const char* name, const int checksum)
 {
 	int count;
 	cPatch_t* patch;
 	vec3_t points[MAX_PATCH_VERTS]{};
+	byte* cache = nullptr;
+	const byte* cache_p = nullptr;
+	const byte* cache_end = nullptr;
+	int num_patches = 0;
+	int num_cached = 0;
+
+	const int start_time = Sys_Milliseconds();
 
 	auto in = reinterpret_cast<dsurface_t*>(cmod_base + surfs->fileofs);
 	if (surfs->filelen % sizeof * in)
@@ -557,6 +654,21 @@ void CMod_LoadPatches(const lump_t* surfs, const lump_t* verts, clipMap_t& cm)
 	if (verts->filelen % sizeof * dv)
 		Com_Error(ERR_DROP, "MOD_LoadBmodel: funny lump size");
 
+#ifndef BSPC
+	if (cm_patchCache && cm_patchCache->integer)
+	{
+		char path[MAX_QPATH];
+
+		CM_PatchCachePath(name, path, sizeof path);
+		const int len = FS_ReadFile(path, reinterpret_cast<void**>(&cache));
+		if (cache && CMod_ReadPatchCacheHeader(cache, len, checksum, count))
+		{
+			cache_p = cache + sizeof(patchCacheHeader_t);
+			cache_end = cache + len;
+		}
+	}
+#endif
+
 	// scan through all the surfaces, but only load patches,
 	// not planar faces
 	for (int i = 0; i < count; i++, in++)
@@ -568,6 +680,7 @@ void CMod_LoadPatches(const lump_t* surfs, const lump_t* verts, clipMap_t& cm)
 		// FIXME: check for non-colliding patches
 
 		cm.surfaces[i] = patch = static_cast<cPatch_t*>(Z_Malloc(sizeof * patch, TAG_BSP, qtrue));
+		num_patches++;
 
 		// load the full drawverts onto the stack
 		const int width = in->patchWidth;
@@ -592,9 +705,67 @@ void CMod_LoadPatches(const lump_t* surfs, const lump_t* verts, clipMap_t& cm)
 
 		patch->surfaceFlags = cm.shaders[shaderNum].surfaceFlags;
 
-		// create the internal facet structure
-		patch->pc = CM_GeneratePatchCollide(width, height, points);
+		// take the facet structure from the cache if we have it
+		if (cache_p)
+		{
+			int surface_num = -1;
+
+			if (cache_end - cache_p >= static_cast<ptrdiff_t>(sizeof(int)))
+			{
+				memcpy(&surface_num, cache_p, sizeof(int));
+				cache_p += sizeof(int);
+			}
+			if (surface_num == i)
+			{
+				patch->pc = CM_ReadPatchCollideCache(&cache_p, cache_end);
+			}
+			if (!patch->pc)
+			{
+				Com_DPrintf(S_COLOR_YELLOW "CMod_LoadPatches: patch cache for %s is corrupt, regenerating\n", name);
+				cache_p = nullptr;
+			}
+		}
+
+		if (patch->pc)
+		{
+			num_cached++;
+#ifndef BSPC
+			if (cm_patchVerify && cm_patchVerify->integer)
+			{
+				patchCollide_s* generated = CM_GeneratePatchCollide(width, height, points);
+				if (!CM_PatchCollideEqual(patch->pc, generated))
+				{
+					Com_Error(ERR_DROP, "CMod_LoadPatches: cached patch %i in %s differs from the generated one", i, name);
+				}
+				Z_Free(generated->planes);
+				if (generated->facets)
+				{
+					Z_Free(generated->facets);
+				}
+				Z_Free(generated);
+			}
+#endif
+		}
+		else
+		{
+			// create the internal facet structure
+			patch->pc = CM_GeneratePatchCollide(width, height, points);
+		}
 	}
+
+	if (cache)
+	{
+		FS_FreeFile(cache);
+	}
+
+#ifndef BSPC
+	if (cm_patchCache && cm_patchCache->integer && num_cached != num_patches)
+	{
+		CMod_WritePatchCache(name, checksum, cm);
+	}
+#endif
+
+	Com_DPrintf("CMod_LoadPatches: %i patches (%i cached) in %i msec\n", num_patches, num_cached, Sys_Milliseconds() - start_time);
 }
 
 //==================================================================
@@ -670,6 +841,8 @@ static void CM_LoadMap_Actual(const char* name, const qboolean clientload, int*
 	cm_noAreas = Cvar_Get("cm_noAreas", "0", CVAR_CHEAT);
 	cm_noCurves = Cvar_Get("cm_noCurves", "0", CVAR_CHEAT);
 	cm_playerCurveClip = Cvar_Get("cm_playerCurveClip", "1", CVAR_ARCHIVE_ND | CVAR_CHEAT);
+	cm_patchCache = Cvar_Get("cm_patchCache", "0", CVAR_ARCHIVE_ND);
+	cm_patchVerify = Cvar_Get("cm_patchVerify", "0", CVAR_CHEAT);
 #endif
 	Com_DPrintf("CM_LoadMap( %s, %i )\n", name, clientload);
 
@@ -806,7 +979,7 @@ static void CM_LoadMap_Actual(const char* name, const qboolean clientload, int*
 		CMod_LoadNodes(&header.lumps[LUMP_NODES], cm);
 		CMod_LoadEntityString(&header.lumps[LUMP_ENTITIES], cm, name);
 		CMod_LoadVisibility(&header.lumps[LUMP_VISIBILITY], cm);
-		CMod_LoadPatches(&header.lumps[LUMP_SURFACES], &header.lumps[LUMP_DRAWVERTS], cm);
+		CMod_LoadPatches(&header.lumps[LUMP_SURFACES], &header.lumps[LUMP_DRAWVERTS], cm, name, last_checksum);
 
 		TotalSubModels += cm.numSubModels;
 
@@ -167,6 +167,8 @@ extern int c_traces, c_brush_traces, c_patch_traces;
 extern cvar_t* cm_noAreas;
 extern cvar_t* cm_noCurves;
 extern cvar_t* cm_playerCurveClip;
+extern cvar_t* cm_patchCache;
+extern cvar_t* cm_patchVerify;
 
 extern clipMap_t SubBSP[MAX_SUB_BSP];
 extern int NumSubBSP;
@@ -240,6 +242,10 @@ patchCollide_s* CM_GeneratePatchCollide(int width, int height, vec3_t* points);
 void CM_TraceThroughPatchCollide(traceWork_t* tw, const patchCollide_s* pc);
 qboolean CM_PositionTestInPatchCollide(const traceWork_t* tw, const patchCollide_s* pc);
 void CM_ClearLevelPatches();
+int CM_PatchCollideCacheSize(const patchCollide_s* pc);
+byte* CM_WritePatchCollideCache(const patchCollide_s* pc, byte* out);
+patchCollide_s* CM_ReadPatchCollideCache(const byte** in, const byte* end);
+qboolean CM_PatchCollideEqual(const patchCollide_s* a, const patchCollide_s* b);
 
 //cm_trace.cpp
 void CM_CalcExtents(const vec3_t start, const vec3_t end, const traceWork_t* tw, vec3pair_t bounds);
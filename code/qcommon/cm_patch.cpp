@@ -23,6 +23,7 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 
 #include "cm_local.h"
 #include "cm_patch.h"
+#include "cm_planehash.h"
 
 //#define	CULL_BBOX
 
@@ -439,36 +440,8 @@ static	patchPlane_t	planes[MAX_PATCH_PLANES];
 //static	facet_t			facets[MAX_FACETS];	// Switched to MAX_FACETS = VV_FIXME, allocate these only during use
 static	facet_t* facets = nullptr;
 
-constexpr auto NORMAL_EPSILON = 0.00015;
-constexpr auto DIST_EPSILON = 0.0235;
-
 int CM_PlaneEqual(const patchPlane_t* p, float plane[4], int* flipped) {
-	float invplane[4]{};
-
-	if (
-		Q_fabs(p->plane[0] - plane[0]) < NORMAL_EPSILON
-		&& Q_fabs(p->plane[1] - plane[1]) < NORMAL_EPSILON
-		&& Q_fabs(p->plane[2] - plane[2]) < NORMAL_EPSILON
-		&& Q_fabs(p->plane[3] - plane[3]) < DIST_EPSILON)
-	{
-		*flipped = qfalse;
-		return qtrue;
-	}
-
-	VectorNegate(plane, invplane);
-	invplane[3] = -plane[3];
-
-	if (
-		Q_fabs(p->plane[0] - invplane[0]) < NORMAL_EPSILON
-		&& Q_fabs(p->plane[1] - invplane[1]) < NORMAL_EPSILON
-		&& Q_fabs(p->plane[2] - invplane[2]) < NORMAL_EPSILON
-		&& Q_fabs(p->plane[3] - invplane[3]) < DIST_EPSILON)
-	{
-		*flipped = qtrue;
-		return qtrue;
-	}
-
-	return qfalse;
+	return CM_PlaneMatches(*p, plane, flipped);
 }
 
 void CM_SnapVector(vec3_t normal) {
@@ -489,21 +462,43 @@ void CM_SnapVector(vec3_t normal) {
 	}
 }
 
-int CM_FindPlane2(float plane[4], int* flipped) {
-	// see if the points are close enough to an existing plane
-	for (int i = 0; i < numplanes; i++) {
-		if (CM_PlaneEqual(&planes[i], plane, flipped)) return i;
-	}
+// see cm_planehash.h
+static CPlaneHash<patchPlane_t, MAX_PATCH_PLANES> planeHash;
 
-	// add a new plane
+static int CM_AddPlane(const float plane[4]) {
 	if (numplanes == MAX_PATCH_PLANES) {
 		Com_Error(ERR_DROP, "MAX_PATCH_PLANES reached (%d)", MAX_PATCH_PLANES);
 	}
 
 	VectorCopy4(plane, planes[numplanes].plane);
-	planes[numplanes].signbits = CM_SignbitsForNormal(plane);
+	planes[numplanes].signbits = CM_SignbitsForNormal(planes[numplanes].plane);
+	planeHash.Add(planes, numplanes);
+
+	return numplanes++;
+}
+
+int CM_FindPlane2(float plane[4], int* flipped) {
+	// see if the points are close enough to an existing plane
+	const int found = planeHash.Find(planes, plane, flipped);
+
+#ifndef BSPC
+	if (cm_patchVerify && cm_patchVerify->integer) {
+		int linearFlipped = qfalse;
+		const int linear = CM_FindPlaneLinear(planes, numplanes, plane, &linearFlipped);
 
-	numplanes++;
+		if (linear != found || linear != -1 && linearFlipped != *flipped) {
+			Com_Error(ERR_DROP, "CM_FindPlane2: plane hash returned %i (flipped %i), linear scan %i (flipped %i)",
+				found, found == -1 ? 0 : *flipped, linear, linearFlipped);
+		}
+	}
+#endif
+
+	if (found != -1) {
+		return found;
+	}
+
+	// add a new plane
+	CM_AddPlane(plane);
 
 	*flipped = qfalse;
 
@@ -523,41 +518,24 @@ static int CM_FindPlane(float* p1, float* p2, float* p3) {
 	}
 
 	// see if the points are close enough to an existing plane
-	for (int i = 0; i < numplanes; i++) {
-		if (DotProduct(plane, planes[i].plane) < 0) {
-			continue;	// allow backwards planes?
-		}
-
-		float d = DotProduct(p1, planes[i].plane) - planes[i].plane[3];
-		if (d < -PLANE_TRI_EPSILON || d > PLANE_TRI_EPSILON) {
-			continue;
-		}
+	const int found = planeHash.FindTri(planes, numplanes, plane, p1, p2, p3, PLANE_TRI_EPSILON);
 
-		d = DotProduct(p2, planes[i].plane) - planes[i].plane[3];
-		if (d < -PLANE_TRI_EPSILON || d > PLANE_TRI_EPSILON) {
-			continue;
-		}
+#ifndef BSPC
+	if (cm_patchVerify && cm_patchVerify->integer) {
+		const int linear = CM_FindTriPlaneLinear(planes, numplanes, plane, p1, p2, p3, PLANE_TRI_EPSILON);
 
-		d = DotProduct(p3, planes[i].plane) - planes[i].plane[3];
-		if (d < -PLANE_TRI_EPSILON || d > PLANE_TRI_EPSILON) {
-			continue;
+		if (linear != found) {
+			Com_Error(ERR_DROP, "CM_FindPlane: plane hash returned %i, linear scan %i", found, linear);
 		}
-
-		// found it
-		return i;
 	}
+#endif
 
-	// add a new plane
-	if (numplanes == MAX_PATCH_PLANES) {
-		Com_Error(ERR_DROP, "MAX_PATCH_PLANES");
+	if (found != -1) {
+		return found;
 	}
 
-	VectorCopy4(plane, planes[numplanes].plane);
-	planes[numplanes].signbits = CM_SignbitsForNormal(plane);
-
-	numplanes++;
-
-	return numplanes - 1;
+	// add a new plane
+	return CM_AddPlane(plane);
 }
 
 /*
@@ -989,6 +967,7 @@ static void CM_PatchCollideFromGrid(cGrid_t* grid, patchCollide_t* pf) {
 	facets = static_cast<facet_t*>(Z_Malloc(MAX_FACETS * sizeof(facet_t), TAG_TEMP_WORKSPACE, qfalse));
 
 	numplanes = 0;
+	planeHash.Clear();
 	int num_facets = 0;
 
 	// find the planes for each triangle of the grid
@@ -1249,6 +1228,159 @@ patchCollide_s* CM_GeneratePatchCollide(const int width, const int height, vec3_
 /*
 ================================================================================
 
+PATCH COLLIDE CACHE
+
+A generated patchCollide_t is flattened as its bounds, plane and facet counts,
+followed by the raw plane and facet arrays.  The map checksum and the layout of
+the file are validated by the caller in CMod_LoadPatches.
+
+================================================================================
+*/
+
+/*
+===================
+CM_PatchCollideCacheSize
+===================
+*/
+int CM_PatchCollideCacheSize(const patchCollide_s* pc) {
+	return sizeof(pc->bounds) + sizeof(int) * 2
+		+ pc->numplanes * sizeof(*pc->planes)
+		+ pc->numFacets * sizeof(*pc->facets);
+}
+
+/*
+===================
+CM_WritePatchCollideCache
+
+Returns the first byte after the written patch
+===================
+*/
+byte* CM_WritePatchCollideCache(const patchCollide_s* pc, byte* out) {
+	memcpy(out, pc->bounds, sizeof(pc->bounds));
+	out += sizeof(pc->bounds);
+	memcpy(out, &pc->numplanes, sizeof(int));
+	out += sizeof(int);
+	memcpy(out, &pc->numFacets, sizeof(int));
+	out += sizeof(int);
+	memcpy(out, pc->planes, pc->numplanes * sizeof(*pc->planes));
+	out += pc->numplanes * sizeof(*pc->planes);
+	memcpy(out, pc->facets, pc->numFacets * sizeof(*pc->facets));
+	out += pc->numFacets * sizeof(*pc->facets);
+
+	return out;
+}
+
+/*
+===================
+CM_ReadPatchCollideCache
+
+Returns NULL if the data is truncated or out of range, otherwise
+advances *in past the patch
+===================
+*/
+patchCollide_s* CM_ReadPatchCollideCache(const byte** in, const byte* end) {
+	const byte* p = *in;
+	vec3_t bounds[2];
+	int num_planes, num_facets;
+
+	if (end - p < static_cast<ptrdiff_t>(sizeof(bounds) + sizeof(int) * 2)) {
+		return nullptr;
+	}
+	memcpy(bounds, p, sizeof(bounds));
+	p += sizeof(bounds);
+	memcpy(&num_planes, p, sizeof(int));
+	p += sizeof(int);
+	memcpy(&num_facets, p, sizeof(int));
+	p += sizeof(int);
+
+	if (num_planes < 0 || num_planes > MAX_PATCH_PLANES || num_facets < 0 || num_facets > MAX_FACETS) {
+		return nullptr;
+	}
+	if (end - p < static_cast<ptrdiff_t>(num_planes * sizeof(patchPlane_t) + num_facets * sizeof(facet_t))) {
+		return nullptr;
+	}
+
+	// the facets index the planes while tracing, so a stale or damaged cache must not get
+	// past here. CM_ValidateFacet() drops facets with a -1 plane, so none are expected
+	const byte* facets = p + num_planes * sizeof(patchPlane_t);
+	for (int i = 0; i < num_facets; i++) {
+		facet_t facet;
+		memcpy(&facet, facets + i * sizeof(facet_t), sizeof(facet));
+
+		if (facet.surfacePlane < 0 || facet.surfacePlane >= num_planes
+			|| facet.numBorders < 0 || facet.numBorders > static_cast<int>(ARRAY_LEN(facet.borderPlanes))) {
+			return nullptr;
+		}
+		for (int j = 0; j < facet.numBorders; j++) {
+			if (facet.borderPlanes[j] < 0 || facet.borderPlanes[j] >= num_planes) {
+				return nullptr;
+			}
+		}
+	}
+
+	patchCollide_t* pf = static_cast<patchCollide_t*>(Z_Malloc(sizeof(*pf), TAG_BSP, qfalse));
+	VectorCopy(bounds[0], pf->bounds[0]);
+	VectorCopy(bounds[1], pf->bounds[1]);
+	pf->numplanes = num_planes;
+	pf->numFacets = num_facets;
+
+	pf->planes = static_cast<patchPlane_t*>(Z_Malloc(num_planes * sizeof(*pf->planes), TAG_BSP, qfalse));
+	memcpy(pf->planes, p, num_planes * sizeof(*pf->planes));
+	p += num_planes * sizeof(*pf->planes);
+
+	if (num_facets)
+	{
+		pf->facets = static_cast<facet_t*>(Z_Malloc(num_facets * sizeof(*pf->facets), TAG_BSP, qfalse));
+		memcpy(pf->facets, p, num_facets * sizeof(*pf->facets));
+		p += num_facets * sizeof(*pf->facets);
+	}
+	else
+	{
+		pf->facets = nullptr;
+	}
+
+	*in = p;
+	return pf;
+}
+
+/*
+===================
+CM_PatchCollideEqual
+
+Compares two generated patches, used by cm_patchVerify
+===================
+*/
+qboolean CM_PatchCollideEqual(const patchCollide_s* a, const patchCollide_s* b) {
+	if (memcmp(a->bounds, b->bounds, sizeof(a->bounds)) != 0
+		|| a->numplanes != b->numplanes
+		|| a->numFacets != b->numFacets) {
+		return qfalse;
+	}
+	if (memcmp(a->planes, b->planes, a->numplanes * sizeof(*a->planes)) != 0) {
+		return qfalse;
+	}
+	// only the used border slots are meaningful, the rest of each facet is scratch
+	for (int i = 0; i < a->numFacets; i++) {
+		const facet_t* fa = &a->facets[i];
+		const facet_t* fb = &b->facets[i];
+
+		if (fa->surfacePlane != fb->surfacePlane || fa->numBorders != fb->numBorders) {
+			return qfalse;
+		}
+		for (int j = 0; j < fa->numBorders; j++) {
+			if (fa->borderPlanes[j] != fb->borderPlanes[j]
+				|| fa->borderInward[j] != fb->borderInward[j]
+				|| fa->borderNoAdjust[j] != fb->borderNoAdjust[j]) {
+				return qfalse;
+			}
+		}
+	}
+	return qtrue;
+}
+
+/*
+================================================================================
+
 TRACE TESTING
 
 ================================================================================
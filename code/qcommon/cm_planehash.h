@@ -0,0 +1,278 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// cm_planehash.h -- plane lookups for patch collision generation
+//
+// Every plane generated for the current patch is bucketed twice, so that both
+// ways cm_patch.cpp looks for an existing plane avoid scanning all of them:
+//
+// - CM_FindPlane2 matches on normal and distance within NORMAL_EPSILON and
+//   DIST_EPSILON.  Those chains are keyed on all four components in cells four
+//   epsilons wide, so the tolerance window reaches at most two cells per
+//   component, for the plane and for its inverse.
+//
+// - CM_FindPlane matches a plane that holds three points within a tolerance.
+//   A plane can only lean away from the triangle's own normal by as much as
+//   that tolerance allows across the triangle, so those chains are keyed on
+//   the normal alone, in coarse cells, and probed over that bound.  When that
+//   window covers more buckets than there are planes, the linear scan runs.
+//
+// Both return the lowest matching plane number, exactly what the linear scans
+// return.  Nothing in here depends on q_shared.h so the tests can check that.
+
+#pragma once
+
+#include <cmath>
+#include <cstring>
+
+constexpr auto NORMAL_EPSILON = 0.00015;
+constexpr auto DIST_EPSILON = 0.0235;
+
+// true if p is plane within the epsilons, either way round
+template <typename Plane>
+bool CM_PlaneMatches(const Plane& p, const float plane[4], int* flipped)
+{
+	if (std::fabs(p.plane[0] - plane[0]) < NORMAL_EPSILON
+		&& std::fabs(p.plane[1] - plane[1]) < NORMAL_EPSILON
+		&& std::fabs(p.plane[2] - plane[2]) < NORMAL_EPSILON
+		&& std::fabs(p.plane[3] - plane[3]) < DIST_EPSILON)
+	{
+		*flipped = 0;
+		return true;
+	}
+
+	const float invplane[4] = { -plane[0], -plane[1], -plane[2], -plane[3] };
+
+	if (std::fabs(p.plane[0] - invplane[0]) < NORMAL_EPSILON
+		&& std::fabs(p.plane[1] - invplane[1]) < NORMAL_EPSILON
+		&& std::fabs(p.plane[2] - invplane[2]) < NORMAL_EPSILON
+		&& std::fabs(p.plane[3] - invplane[3]) < DIST_EPSILON)
+	{
+		*flipped = 1;
+		return true;
+	}
+
+	return false;
+}
+
+// true if p faces the same way as plane, the plane of the triangle p1 p2 p3,
+// and all three points lie within epsilon of it
+template <typename Plane>
+bool CM_PlaneHoldsTri(const Plane& p, const float plane[4], const float* p1, const float* p2, const float* p3,
+	const double epsilon)
+{
+	if (plane[0] * p.plane[0] + plane[1] * p.plane[1] + plane[2] * p.plane[2] < 0) {
+		return false;	// allow backwards planes?
+	}
+
+	for (const float* point : { p1, p2, p3 }) {
+		const float d = point[0] * p.plane[0] + point[1] * p.plane[1] + point[2] * p.plane[2] - p.plane[3];
+		if (d < -epsilon || d > epsilon) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <typename Plane>
+int CM_FindPlaneLinear(const Plane* planes, const int numPlanes, const float plane[4], int* flipped)
+{
+	for (int i = 0; i < numPlanes; i++) {
+		if (CM_PlaneMatches(planes[i], plane, flipped)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+template <typename Plane>
+int CM_FindTriPlaneLinear(const Plane* planes, const int numPlanes, const float plane[4],
+	const float* p1, const float* p2, const float* p3, const double epsilon)
+{
+	for (int i = 0; i < numPlanes; i++) {
+		if (CM_PlaneHoldsTri(planes[i], plane, p1, p2, p3, epsilon)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+template <typename Plane, int MaxPlanes>
+class CPlaneHash
+{
+	static constexpr int HASH_SIZE = 1024;
+	static constexpr double NORMAL_CELL = NORMAL_EPSILON * 4;
+	static constexpr double DIST_CELL = DIST_EPSILON * 4;
+	static constexpr double TRI_NORMAL_CELL = 1.0 / 16;
+	// widen the probe windows a little so float rounding on a cell boundary can't hide a match
+	static constexpr double SLACK = 1.01;
+
+	int mHead[HASH_SIZE];
+	int mNext[MaxPlanes];
+	int mTriHead[HASH_SIZE];
+	int mTriNext[MaxPlanes];
+
+	static int Key(const int cells[4])
+	{
+		const unsigned int hash = static_cast<unsigned int>(cells[0]) * 73856093u
+			^ static_cast<unsigned int>(cells[1]) * 19349663u
+			^ static_cast<unsigned int>(cells[2]) * 83492791u
+			^ static_cast<unsigned int>(cells[3]) * 2654435761u;
+
+		return hash & (HASH_SIZE - 1);
+	}
+
+	static int Cell(const double value, const double size)
+	{
+		return static_cast<int>(std::floor(value / size));
+	}
+
+public:
+	void Clear()
+	{
+		memset(mHead, -1, sizeof mHead);
+		memset(mTriHead, -1, sizeof mTriHead);
+	}
+
+	void Add(const Plane* planes, const int planeNum)
+	{
+		int cells[4];
+
+		for (int i = 0; i < 4; i++) {
+			cells[i] = Cell(planes[planeNum].plane[i], i == 3 ? DIST_CELL : NORMAL_CELL);
+		}
+		int key = Key(cells);
+		mNext[planeNum] = mHead[key];
+		mHead[key] = planeNum;
+
+		for (int i = 0; i < 3; i++) {
+			cells[i] = Cell(planes[planeNum].plane[i], TRI_NORMAL_CELL);
+		}
+		cells[3] = 0;
+		key = Key(cells);
+		mTriNext[planeNum] = mTriHead[key];
+		mTriHead[key] = planeNum;
+	}
+
+	// same result as CM_FindPlaneLinear
+	int Find(const Plane* planes, const float plane[4], int* flipped) const
+	{
+		int best = -1;
+		int bestFlipped = 0;
+
+		for (int side = 0; side < 2; side++) {
+			int lo[4], hi[4], cells[4];
+
+			for (int i = 0; i < 4; i++) {
+				const double value = side ? -plane[i] : plane[i];
+				const double epsilon = (i == 3 ? DIST_EPSILON : NORMAL_EPSILON) * SLACK;
+				const double size = i == 3 ? DIST_CELL : NORMAL_CELL;
+
+				lo[i] = Cell(value - epsilon, size);
+				hi[i] = Cell(value + epsilon, size);
+			}
+
+			for (cells[0] = lo[0]; cells[0] <= hi[0]; cells[0]++) {
+				for (cells[1] = lo[1]; cells[1] <= hi[1]; cells[1]++) {
+					for (cells[2] = lo[2]; cells[2] <= hi[2]; cells[2]++) {
+						for (cells[3] = lo[3]; cells[3] <= hi[3]; cells[3]++) {
+							for (int i = mHead[Key(cells)]; i != -1; i = mNext[i]) {
+								int f;
+
+								if (best != -1 && i >= best) {
+									continue;
+								}
+								if (CM_PlaneMatches(planes[i], plane, &f)) {
+									best = i;
+									bestFlipped = f;
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+
+		if (best != -1) {
+			*flipped = bestFlipped;
+		}
+		return best;
+	}
+
+	// same result as CM_FindTriPlaneLinear, plane must be the unit plane of p1 p2 p3
+	int FindTri(const Plane* planes, const int numPlanes, const float plane[4],
+		const float* p1, const float* p2, const float* p3, const double epsilon) const
+	{
+		// a matching plane meets the edges p1p2 and p1p3 within 2 * epsilon, so
+		// sin(lean) * width <= 2 * epsilon, where width is the least either edge can
+		// reach across the triangle along any direction in its plane:
+		// |e1 x e2| / (|e1| + |e2|).  With the lean at most 90 degrees, no normal
+		// component can then differ by more than sqrt(2) * sin(lean).
+		double e1[3], e2[3];
+		for (int i = 0; i < 3; i++) {
+			e1[i] = static_cast<double>(p2[i]) - p1[i];
+			e2[i] = static_cast<double>(p3[i]) - p1[i];
+		}
+		const double cross[3] = {
+			e1[1] * e2[2] - e1[2] * e2[1],
+			e1[2] * e2[0] - e1[0] * e2[2],
+			e1[0] * e2[1] - e1[1] * e2[0]
+		};
+		const double edges = std::sqrt(e1[0] * e1[0] + e1[1] * e1[1] + e1[2] * e1[2])
+			+ std::sqrt(e2[0] * e2[0] + e2[1] * e2[1] + e2[2] * e2[2]);
+		const double area = std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+
+		const double reach = area > 0 ? std::sqrt(2.0) * 2.0 * epsilon * edges / area * SLACK + 1e-5 : 1.0;
+		if (reach >= 1.0) {
+			// nothing to narrow down, any facing plane could match
+			return CM_FindTriPlaneLinear(planes, numPlanes, plane, p1, p2, p3, epsilon);
+		}
+
+		int lo[3], hi[3], cells[4];
+		int probes = 1;
+		for (int i = 0; i < 3; i++) {
+			lo[i] = Cell(plane[i] - reach, TRI_NORMAL_CELL);
+			hi[i] = Cell(plane[i] + reach, TRI_NORMAL_CELL);
+			probes *= hi[i] - lo[i] + 1;
+		}
+		if (probes >= numPlanes) {
+			// the window covers more buckets than there are planes to scan
+			return CM_FindTriPlaneLinear(planes, numPlanes, plane, p1, p2, p3, epsilon);
+		}
+
+		int best = -1;
+		cells[3] = 0;
+		for (cells[0] = lo[0]; cells[0] <= hi[0]; cells[0]++) {
+			for (cells[1] = lo[1]; cells[1] <= hi[1]; cells[1]++) {
+				for (cells[2] = lo[2]; cells[2] <= hi[2]; cells[2]++) {
+					for (int i = mTriHead[Key(cells)]; i != -1; i = mTriNext[i]) {
+						if (best != -1 && i >= best) {
+							continue;
+						}
+						if (CM_PlaneHoldsTri(planes[i], plane, p1, p2, p3, epsilon)) {
+							best = i;
+						}
+					}
+				}
+			}
+		}
+		return best;
+	}
+};
@@ -35,6 +35,10 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #include <windows.h>
 #endif
 
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
 // Because renderer.
 #include "../rd-common/tr_public.h"
 extern refexport_t re;
@@ -82,9 +86,13 @@ cvar_t* com_G2Report;
 #endif
 
 cvar_t* com_affinity;
+cvar_t* com_benchmark;
+cvar_t* com_benchmarkMsec;
+cvar_t* com_benchmarkWarmup;
 
 // com_speeds times
 int time_game;
+int time_gameUsec;
 int time_frontend; // renderer frontend time
 int time_backend; // renderer backend time
 
@@ -975,6 +983,12 @@ int Com_Milliseconds()
 	return ev.evTime;
 }
 
+int64_t Com_Microseconds()
+{
+	static const auto base = std::chrono::steady_clock::now();
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - base).count();
+}
+
 //============================================================================
 
 /*
@@ -1216,6 +1230,17 @@ void Com_Init(char* commandLine)
 
 		com_bootlogo = Cvar_Get("com_bootlogo", "1", CVAR_ARCHIVE_ND);
 
+		com_benchmark = Cvar_Get("com_benchmark", "0", CVAR_INIT);
+		com_benchmarkMsec = Cvar_Get("com_benchmarkMsec", "16", CVAR_INIT);
+		com_benchmarkWarmup = Cvar_Get("com_benchmarkWarmup", "100", CVAR_INIT);
+		if (com_benchmark->integer)
+		{
+			// no window or GL context unless the command line asked for
+			// one, and never a sound device
+			Cvar_Get("r_headless", "1", CVAR_INIT);
+			Cvar_Set("s_initsound", "0");
+		}
+
 		if (com_developer && com_developer->integer)
 		{
 			Cmd_AddCommand("error", Com_Error_f);
@@ -1434,6 +1459,117 @@ static int Com_TimeVal(const int minMsec)
 	return timeVal;
 }
 
+/*
+==============================================================================
+
+BENCHMARK
+
+com_benchmark N runs N frames at a fixed com_benchmarkMsec timestep once a
+level is running, skipping the first com_benchmarkWarmup frames so loading and
+the client connect don't count, then prints per subsystem frame times and
+quits.  Typical use is
+	+set com_benchmark 3000 +devmap <map>
+which also brings the renderer up headless and leaves sound off.  To measure
+a recorded session instead, give a large frame count and replay it with
+	+set com_benchmark 999999 +cmdplay <name>
+and the report is printed when the command stream ends.
+
+==============================================================================
+*/
+
+enum benchmarkTimer_t
+{
+	BENCH_FRAME,
+	BENCH_SERVER,
+	BENCH_GAME,
+	BENCH_CLIENT,
+	BENCH_NUM_TIMERS
+};
+
+static const char* benchmarkTimerNames[BENCH_NUM_TIMERS] = { "frame", "server", "game", "client" };
+static std::vector<int> benchmarkSamples[BENCH_NUM_TIMERS];
+static int benchmarkFrames;
+static int64_t benchmarkStart;
+static bool benchmarkDone;
+
+static bool Com_BenchmarkRunning()
+{
+	return com_benchmark->integer > 0 && !benchmarkDone && com_sv_running->integer;
+}
+
+static void Com_BenchmarkReport()
+{
+	const int64_t elapsed = Com_Microseconds() - benchmarkStart;
+	const int count = static_cast<int>(benchmarkSamples[BENCH_FRAME].size());
+
+	Com_Printf("----- Benchmark: %i frames at %i msec -----\n", count, com_benchmarkMsec->integer);
+	Com_Printf("%-8s %9s %9s %9s %9s  (usec)\n", "", "mean", "p50", "p99", "max");
+	for (int i = 0; i < BENCH_NUM_TIMERS; i++)
+	{
+		std::vector<int>& samples = benchmarkSamples[i];
+		if (samples.empty())
+		{
+			continue;
+		}
+
+		int64_t total = 0;
+		for (const int sample : samples)
+		{
+			total += sample;
+		}
+		std::sort(samples.begin(), samples.end());
+
+		const size_t n = samples.size();
+		Com_Printf("%-8s %9.1f %9i %9i %9i\n", benchmarkTimerNames[i],
+			static_cast<double>(total) / n, samples[n / 2], samples[Q_min(n - 1, n * 99 / 100)], samples[n - 1]);
+	}
+	Com_Printf("%.2f seconds, %.1f frames per second\n", elapsed / 1e6, count ? count * 1e6 / elapsed : 0.0);
+	Com_Printf("-------------------------------------\n");
+}
+
+static void Com_BenchmarkFrame(const int frameUsec, const int serverUsec, const int clientUsec)
+{
+	if (benchmarkFrames++ < com_benchmarkWarmup->integer)
+	{
+		benchmarkStart = Com_Microseconds();
+		return;
+	}
+
+	benchmarkSamples[BENCH_FRAME].push_back(frameUsec);
+	benchmarkSamples[BENCH_SERVER].push_back(serverUsec - time_gameUsec);
+	benchmarkSamples[BENCH_GAME].push_back(time_gameUsec);
+	benchmarkSamples[BENCH_CLIENT].push_back(clientUsec);
+
+	if (static_cast<int>(benchmarkSamples[BENCH_FRAME].size()) >= com_benchmark->integer)
+	{
+		benchmarkDone = true;
+		Com_BenchmarkReport();
+		Cbuf_AddText("quit\n");
+	}
+}
+
+/*
+=================
+Com_BenchmarkFinish
+
+Ends a benchmark early, e.g. when a replayed command stream runs out
+=================
+*/
+void Com_BenchmarkFinish()
+{
+	if (!com_benchmark || com_benchmark->integer <= 0 || benchmarkDone)
+	{
+		return;
+	}
+
+	benchmarkDone = true;
+	if (!benchmarkSamples[BENCH_FRAME].empty())
+	{
+		Com_BenchmarkReport();
+	}
+	Cbuf_AddText("quit\n");
+}
+
 /*
 =================
 Com_Frame
@@ -1493,15 +1629,23 @@ void Com_Frame()
 		// that framerate is stable at the requested value.
 		min_msec -= bias;
 
-		time_val = Com_TimeVal(min_msec);
-		do
+		const bool benchmarking = Com_BenchmarkRunning();
+		const int64_t bench_frame_start = benchmarking ? Com_Microseconds() : 0;
+		int64_t bench_server_start = 0, bench_client_start = 0, bench_client_end = 0;
+
+		// a benchmark runs flat out
+		if (!benchmarking)
 		{
-			// Busy sleep the last millisecond for better timeout precision
-			if (com_busyWait->integer || time_val < 1)
-				Sys_Sleep(0);
-			else
-				Sys_Sleep(time_val - 1);
-		} while ((time_val = Com_TimeVal(min_msec)) != 0);
+			time_val = Com_TimeVal(min_msec);
+			do
+			{
+				// Busy sleep the last millisecond for better timeout precision
+				if (com_busyWait->integer || time_val < 1)
+					Sys_Sleep(0);
+				else
+					Sys_Sleep(time_val - 1);
+			} while ((time_val = Com_TimeVal(min_msec)) != 0);
+		}
 		IN_Frame();
 
 		last_time = com_frameTime;
@@ -1514,6 +1658,13 @@ void Com_Frame()
 		// mess with msec if needed
 		float fraction_msec = 0.0f;
 		msec = Com_ModifyMsec(msec, fraction_msec);
+		if (benchmarking)
+		{
+			msec = com_benchmarkMsec->integer;
+			fraction_msec = 0.0f;
+			bench_server_start = Com_Microseconds();
+		}
+		msec = CL_CmdStreamFrameMsec(msec);
 
 		//
 		// server side
@@ -1535,6 +1686,10 @@ void Com_Frame()
 			// run event loop a second time to get server to client packets
 			// without a frame of latency
 			//
+			if (benchmarking)
+			{
+				bench_client_start = Com_Microseconds();
+			}
 			if (com_speeds->integer)
 			{
 				time_before_events = Sys_Milliseconds();
@@ -1551,11 +1706,23 @@ void Com_Frame()
 			}
 
 			CL_Frame(msec, fraction_msec);
+			CL_CmdStreamEndFrame();
 
 			if (com_speeds->integer)
 			{
 				time_after = Sys_Milliseconds();
 			}
+			if (benchmarking)
+			{
+				bench_client_end = Com_Microseconds();
+			}
+		}
+
+		if (benchmarking)
+		{
+			Com_BenchmarkFrame(static_cast<int>(bench_client_end - bench_frame_start),
+				static_cast<int>(bench_client_start - bench_server_start),
+				static_cast<int>(bench_client_end - bench_client_start));
 		}
 
 		//
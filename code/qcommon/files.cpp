@@ -37,6 +37,13 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #endif
 #include <minizip/unzip.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
  // for rmdir
 #if defined (_MSC_VER)
 #include <direct.h>
@@ -1618,6 +1625,29 @@ CONVENIENCE FUNCTIONS FOR ENTIRE FILES
 ======================================================================================
 */
 
+/*
+=====================
+FS_LoadedPakHash
+
+Returns a 64-bit hash of the checksums of all loaded pk3 files, in search order.
+Used to key caches derived from pak contents.
+=====================
+*/
+uint64_t FS_LoadedPakHash() {
+	uint64_t hash = FNV1A64_INIT;
+
+	for (const searchpath_t* search = fs_searchpaths; search; search = search->next) {
+		// is the element a pak file?
+		if (!search->pack) {
+			continue;
+		}
+
+		hash = Com_HashFNV1a64Bytes(hash, &search->pack->checksum, sizeof(search->pack->checksum));
+	}
+
+	return hash;
+}
+
 int	FS_FileIsInPAK(const char* filename) {
 	long			hash = 0;
 
@@ -1665,6 +1695,205 @@ int	FS_FileIsInPAK(const char* filename) {
 	return -1;
 }
 
+/*
+=================================================================================
+
+PREFETCHING
+
+FS_PrefetchFiles() looks a list of files up in the pk3s on the calling thread,
+then reads their compressed data on fs_prefetchThreads worker threads, each with
+its own FILE handle, and throws it away. The loads that follow then come out of
+the OS file cache instead of waiting on the disk one file at a time. The workers
+only see the pk3 names and offsets handed to them, never fsh[] or the search
+paths, so the main thread carries on loading while they run. Loose files aren't
+prefetched.
+
+=================================================================================
+*/
+
+typedef struct fsPrefetchFile_s {
+	const pack_t* pack;
+	unsigned long	pos;		// central directory entry, as fileInPack_t
+} fsPrefetchFile_t;
+
+static cvar_t* fs_prefetchThreads;
+static std::vector<fsPrefetchFile_t> fs_prefetchList;
+static std::atomic<int>	fs_prefetchNext;
+static std::mutex		fs_prefetchMutex;
+static std::condition_variable fs_prefetchDone;
+static int				fs_prefetchWorkers;		// detached, so one still going at exit can't take the process down with it
+static int				fs_prefetchBytes;
+static int64_t			fs_prefetchStart;
+static int64_t			fs_prefetchEnd;
+
+static unsigned int FS_ZipShort(const byte* p) {
+	return p[0] | p[1] << 8;
+}
+
+static unsigned int FS_ZipLong(const byte* p) {
+	return p[0] | p[1] << 8 | p[2] << 16 | static_cast<unsigned int>(p[3]) << 24;
+}
+
+// returns the number of bytes read
+static int FS_PrefetchRead(FILE* f, const unsigned long pos, byte* buffer, const int bufferSize) {
+	byte header[46];
+
+	// central directory entry, for the sizes and where the local header is
+	if (fseek(f, static_cast<long>(pos), SEEK_SET) || fread(header, 1, 46, f) != 46 || FS_ZipLong(header) != 0x02014b50) {
+		return 0;
+	}
+	const unsigned long compressedSize = FS_ZipLong(header + 20);
+	const unsigned long localHeader = FS_ZipLong(header + 42);
+
+	if (fseek(f, static_cast<long>(localHeader), SEEK_SET) || fread(header, 1, 30, f) != 30 || FS_ZipLong(header) != 0x04034b50) {
+		return 46;
+	}
+
+	// name, extra field and the data itself
+	unsigned long remaining = FS_ZipShort(header + 26) + FS_ZipShort(header + 28) + compressedSize;
+	int bytes = 46 + 30;
+	while (remaining) {
+		const size_t chunk = remaining < static_cast<unsigned long>(bufferSize) ? remaining : bufferSize;
+		const size_t got = fread(buffer, 1, chunk, f);
+		bytes += static_cast<int>(got);
+		if (got != chunk) {
+			break;
+		}
+		remaining -= chunk;
+	}
+
+	return bytes;
+}
+
+static void FS_PrefetchWorker() {
+	static constexpr int bufferSize = 64 * 1024;
+	byte* buffer = new byte[bufferSize];
+	FILE* f = nullptr;
+	const pack_t* open = nullptr;
+	int bytes = 0;
+
+	for (int i = fs_prefetchNext++; i < static_cast<int>(fs_prefetchList.size()); i = fs_prefetchNext++) {
+		const fsPrefetchFile_t& file = fs_prefetchList[i];
+
+		if (file.pack != open) {
+			if (f) {
+				fclose(f);
+			}
+			f = fopen(file.pack->pakFilename, "rb");
+			open = file.pack;
+		}
+		if (f) {
+			bytes += FS_PrefetchRead(f, file.pos, buffer, bufferSize);
+		}
+	}
+
+	if (f) {
+		fclose(f);
+	}
+	delete[] buffer;
+
+	std::lock_guard<std::mutex> lock(fs_prefetchMutex);
+	fs_prefetchBytes += bytes;
+	if (--fs_prefetchWorkers == 0) {
+		fs_prefetchEnd = Com_Microseconds();
+		fs_prefetchDone.notify_all();
+	}
+}
+
+/*
+============
+FS_PrefetchWait
+
+Waits for the last FS_PrefetchFiles() to finish, optionally returning what it read and how long
+it took. Fine to call when nothing is being prefetched.
+============
+*/
+void FS_PrefetchWait(int* bytes, int* msec) {
+	{
+		std::unique_lock<std::mutex> lock(fs_prefetchMutex);
+		fs_prefetchDone.wait(lock, [] { return fs_prefetchWorkers == 0; });
+	}
+
+	if (bytes) {
+		*bytes = fs_prefetchBytes;
+	}
+	if (msec) {
+		*msec = fs_prefetchList.empty() ? 0 : static_cast<int>((fs_prefetchEnd - fs_prefetchStart) / 1000);
+	}
+}
+
+/*
+============
+FS_PrefetchFiles
+
+Starts reading the given files in the background. Names that aren't in a pk3 are skipped, so
+callers can guess (eg. both .wav and .mp3).
+============
+*/
+void FS_PrefetchFiles(const int numFiles, const char* const* filenames) {
+	FS_AssertInitialised();
+
+	// one batch at a time
+	FS_PrefetchWait(nullptr, nullptr);
+	fs_prefetchList.clear();
+	fs_prefetchBytes = 0;
+
+	if (fs_prefetchThreads->integer <= 0) {
+		return;
+	}
+
+	for (int i = 0; i < numFiles; i++) {
+		const char* filename = filenames[i];
+
+		// qpaths are not supposed to have a leading slash
+		if (filename[0] == '/' || filename[0] == '\\') {
+			filename++;
+		}
+		if (!filename[0] || strstr(filename, "..") || strstr(filename, "::")) {
+			continue;
+		}
+
+		// first pk3 in the search order that has it, which is the one FS_FOpenFileRead would use
+		// unless there's a loose copy
+		bool found = false;
+		for (const searchpath_t* search = fs_searchpaths; search && !found; search = search->next) {
+			if (!search->pack) {
+				continue;
+			}
+			const pack_t* pak = search->pack;
+			for (const fileInPack_t* pakFile = pak->hashTable[FS_HashFileName(filename, pak->hashSize)]; pakFile; pakFile = pakFile->next) {
+				if (!FS_FilenameCompare(pakFile->name, filename)) {
+					fs_prefetchList.push_back({ pak, pakFile->pos });
+					found = true;
+					break;
+				}
+			}
+		}
+	}
+
+	if (fs_prefetchList.empty()) {
+		return;
+	}
+
+	// pk3 order, so each thread mostly reads forwards through one file
+	std::sort(fs_prefetchList.begin(), fs_prefetchList.end(), [](const fsPrefetchFile_t& a, const fsPrefetchFile_t& b) {
+		return a.pack != b.pack ? a.pack < b.pack : a.pos < b.pos;
+		});
+
+	fs_prefetchNext = 0;
+	fs_prefetchStart = Com_Microseconds();
+	fs_prefetchWorkers = Q_min(fs_prefetchThreads->integer, static_cast<int>(fs_prefetchList.size()));
+	fs_prefetchWorkers = Q_min(fs_prefetchWorkers, 16);
+
+	if (fs_debug->integer) {
+		Com_Printf("FS_PrefetchFiles: %d of %d files on %d threads\n", static_cast<int>(fs_prefetchList.size()), numFiles, fs_prefetchWorkers);
+	}
+
+	for (int i = fs_prefetchWorkers; i > 0; i--) {
+		std::thread(FS_PrefetchWorker).detach();
+	}
+}
+
 /*
 ============
 FS_ReadFile
@@ -2707,6 +2936,9 @@ Frees all resources and closes all files
 void FS_Shutdown() {
 	searchpath_t* next = nullptr;
 
+	// the prefetch workers are reading the pk3s by name
+	FS_PrefetchWait(nullptr, nullptr);
+
 	for (int i = 0; i < MAX_FILE_HANDLES; i++) {
 		if (fsh[i].fileSize) {
 			FS_FCloseFile(i);
@@ -2747,6 +2979,7 @@ static void FS_Startup(const char* gameName) {
 	fs_packFiles = 0;
 
 	fs_debug = Cvar_Get("fs_debug", "0", 0);
+	fs_prefetchThreads = Cvar_Get("fs_prefetchThreads", "4", CVAR_ARCHIVE_ND);
 	fs_copyfiles = Cvar_Get("fs_copyfiles", "0", CVAR_INIT);
 	fs_cdpath = Cvar_Get("fs_cdpath", "", CVAR_INIT | CVAR_PROTECTED);
 	fs_basepath = Cvar_Get("fs_basepath", Sys_DefaultInstallPath(), CVAR_INIT | CVAR_PROTECTED);
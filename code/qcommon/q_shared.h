@@ -31,6 +31,7 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #include "qcommon/q_math.h"
 #include "qcommon/q_color.h"
 #include "qcommon/q_string.h"
+#include "qcommon/q_hash.h"
 
 #ifdef _MSC_VER
 
@@ -613,6 +614,22 @@ using trace_t = struct
 // trace->entityNum can also be 0 to (MAX_GENTITIES-1)
 // or ENTITYNUM_NONE, ENTITYNUM_WORLD
 
+// one entry of a batched box trace, see SV_TraceBatch
+// only the results ragdoll probes look at are filled in
+using traceQuery_t = struct
+{
+	vec3_t start;
+	vec3_t end;
+	vec3_t mins;
+	vec3_t maxs;
+
+	qboolean allsolid;
+	qboolean startsolid;
+	float fraction;
+	vec3_t endpos;
+	int entityNum;
+};
+
 // markfragments are returned by CM_MarkFragments()
 using markFragment_t = struct
 {
@@ -652,6 +669,7 @@ constexpr auto KEYCATCH_UI = 2;
 constexpr auto SNAPFLAG_RATE_DELAYED = 1;
 constexpr auto SNAPFLAG_NOT_ACTIVE = 2; // snapshot used during connection and for zombies;
 constexpr auto SNAPFLAG_SERVERCOUNT = 4; // toggled every map_restart so transitions can be detected;
+constexpr auto SNAPFLAG_LOOPBACK = 8; // playerstate and entities were left in the server's snapshot ring;
 
 //
 // per-level limits
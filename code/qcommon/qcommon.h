@@ -499,6 +499,9 @@ static inline int FS_FileIsInPAK(const char* filename, int* checksum)
 	return FS_FileIsInPAK(filename);
 }
 
+// hash of the checksums of every loaded pk3, in search order
+uint64_t FS_LoadedPakHash();
+
 int FS_Write(const void* buffer, int len, fileHandle_t h);
 
 int FS_Read(void* buffer, int len, fileHandle_t f);
@@ -515,6 +518,11 @@ long FS_ReadFile(const char* qpath, void** buffer);
 // the buffer should be considered read-only, because it may be cached
 // for other uses.
 
+void FS_PrefetchFiles(int numFiles, const char* const* filenames);
+void FS_PrefetchWait(int* bytes, int* msec);
+// reads the files ahead on background threads, so the loads that follow come out of
+// the OS file cache. Only one batch at a time, FS_PrefetchWait() is optional
+
 void FS_ForceFlush(fileHandle_t f);
 // forces flush on files we're writing to.
 
@@ -606,6 +614,8 @@ void NORETURN QDECL Com_Error(int level, const char* fmt, ...);
 void NORETURN Com_Quit_f();
 int Com_EventLoop();
 int Com_Milliseconds(); // will be journaled properly
+int64_t Com_Microseconds(); // not journaled, for timing only
+void Com_BenchmarkFinish();
 uint32_t Com_BlockChecksum(const void* buffer, int length);
 int Com_Filter(const char* filter, const char* name, int casesensitive);
 int Com_FilterPath(const char* filter, const char* name, int casesensitive);
@@ -640,6 +650,7 @@ extern	cvar_t* com_ansiColor;
 
 extern cvar_t* com_affinity;
 extern cvar_t* com_busyWait;
+extern cvar_t* com_benchmark;
 
 // both client and server must agree to pause
 extern cvar_t* cl_paused;
@@ -647,6 +658,7 @@ extern cvar_t* sv_paused;
 
 // com_speeds times
 extern int time_game;
+extern int time_gameUsec; // com_benchmark only
 extern int time_frontend;
 extern int time_backend; // renderer backend time
 
@@ -772,6 +784,13 @@ void CL_FlushMemory();
 
 void CL_StartHunkUsers();
 
+void CL_CmdStreamStop();
+int CL_CmdStreamSeed(int seed);
+int CL_CmdStreamFrameMsec(int msec);
+void CL_CmdStreamUsercmd(usercmd_t* cmd);
+void CL_CmdStreamEndFrame();
+// recording and replay of user commands, see cl_cmdstream.cpp
+
 void Key_KeynameCompletion(callbackFunc_t callback);
 // for keyname autocompletion
 
@@ -791,6 +810,7 @@ void SV_Shutdown(const char* finalmsg);
 void SV_Frame(int msec, float fraction_msec);
 void SV_PacketEvent(netadr_t from, msg_t* msg);
 qboolean SV_GameCommand();
+int SV_EntityChecksum();
 
 //
 // UI interface
@@ -46,6 +46,7 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #ifdef _MSC_VER
 #pragma warning ( disable : 4786 )			// disable the usual stupid and pointless STL warning
 #endif
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -62,20 +63,98 @@ cvar_t* sp_leet = nullptr; // kept as 'sp_' for JK2 compact.
 #define __DEBUGOUT(_string)	OutputDebugString(_string)
 #define __ASSERT(_blah)		assert(_blah)
 
+// one reference (eg "OBJECTIVES_T1_SMUGGLER"). Entries are never removed once added, only their text is dropped when
+//	the language changes, so an entry's index can be handed out as a handle (see SE_GetStringHandle())...
+//
 using SE_Entry_t = struct SE_Entry_s
 {
-	std::string m_strString;
-	std::string m_strDebug;
+	const char* m_psReference; // in the reference arena, lives as long as the package
+	unsigned int m_uiHash;
+	const char* m_psString; // in the text arena, or NULL
+	const char* m_psDebug;
 	// english and/or "#same", used for debugging only. Also prefixed by "SE:" to show which strings go through StringEd (ie aren't hardwired)
 	int m_iFlags;
+	SE_BOOL m_bLoaded; // was this reference in the files loaded for the current language?
+};
 
-	SE_Entry_s()
+// all text for a language is copied into a few big blocks instead of one heap allocation per string, and the blocks
+//	are kept for reuse by the next language rather than freed. Pointers into it stay valid until Clear()...
+//
+class CStringEdArena
+{
+public:
+	const char* Store(const char* psPrefix, const char* psString, const char* psSuffix);
+	const char* Store(const char* psString)
 	{
-		m_iFlags = 0;
+		return Store("", psString, "");
 	}
+	void Clear();
+
+private:
+	static constexpr size_t iBLOCK_SIZE = 256 * 1024;
+
+	std::vector<std::unique_ptr<char[]>> m_Blocks;
+	std::vector<std::unique_ptr<char[]>> m_OversizeBlocks; // for anything bigger than iBLOCK_SIZE
+	size_t m_iCurrentBlock = 0;
+	size_t m_iUsed = 0; // bytes used in m_Blocks[ m_iCurrentBlock ]
 };
 
-using mapStringEntries_t = std::map<std::string, SE_Entry_t>;
+const char* CStringEdArena::Store(const char* psPrefix, const char* psString, const char* psSuffix)
+{
+	const size_t iPrefixLen = strlen(psPrefix);
+	const size_t iStringLen = strlen(psString);
+	const size_t iSuffixLen = strlen(psSuffix);
+	const size_t iLen = iPrefixLen + iStringLen + iSuffixLen + 1;
+
+	char* psDest;
+	if (iLen > iBLOCK_SIZE)
+	{
+		m_OversizeBlocks.emplace_back(new char[iLen]);
+		psDest = m_OversizeBlocks.back().get();
+	}
+	else
+	{
+		if (m_Blocks.empty() || m_iUsed + iLen > iBLOCK_SIZE)
+		{
+			if (!m_Blocks.empty())
+			{
+				m_iCurrentBlock++;
+			}
+			if (m_iCurrentBlock == m_Blocks.size())
+			{
+				m_Blocks.emplace_back(new char[iBLOCK_SIZE]);
+			}
+			m_iUsed = 0;
+		}
+		psDest = m_Blocks[m_iCurrentBlock].get() + m_iUsed;
+		m_iUsed += iLen;
+	}
+
+	memcpy(psDest, psPrefix, iPrefixLen);
+	memcpy(psDest + iPrefixLen, psString, iStringLen);
+	memcpy(psDest + iPrefixLen + iStringLen, psSuffix, iSuffixLen + 1);
+
+	return psDest;
+}
+
+void CStringEdArena::Clear()
+{
+	m_OversizeBlocks.clear();
+	m_iCurrentBlock = 0;
+	m_iUsed = 0;
+}
+
+// case-insensitive since lookups have always been done on uppercased references...
+//
+static unsigned int SE_HashReference(const char* psReference)
+{
+	unsigned int uiHash = FNV1A_INIT;
+	while (*psReference)
+	{
+		uiHash = Com_HashFNV1a(uiHash, toupper(static_cast<unsigned char>(*psReference++)));
+	}
+	return uiHash;
+}
 
 class CStringEdPackage
 {
@@ -98,7 +177,7 @@ public:
 		Clear(SE_FALSE);
 	}
 
-	mapStringEntries_t m_StringEntries; // needs to be in public space now
+	std::vector<SE_Entry_t> m_StringEntries; // needs to be in public space now
 	SE_BOOL m_bLoadDebug; // ""
 	//
 	// flag stuff...
@@ -107,6 +186,8 @@ public:
 	std::map<std::string, int> m_mapFlagMasks;
 
 	void Clear(SE_BOOL bChangingLanguages);
+	int FindEntry(const char* psReference) const;
+	int FindOrAddEntry(const char* psReference);
 	void SetupNewFileParse(const char* psFileName, SE_BOOL bLoadDebug);
 	SE_BOOL ReadLine(const char*& psParsePos, char* psDest) const;
 	const char* ParseLine(const char* psLine);
@@ -131,13 +212,31 @@ private:
 	char* Filename_PathOnly(const char* ps_filename) const;
 	static char* Filename_WithoutPath(const char* ps_filename);
 	char* Filename_WithoutExt(const char* ps_filename) const;
+	void GrowHashTable();
+
+	// open-addressed (linear probe) table of indexes into m_StringEntries, -1 for an empty slot. The size is always
+	//	a power of two and it's kept no more than half full...
+	//
+	std::vector<int> m_HashSlots;
+	CStringEdArena m_ReferenceArena; // never cleared, handles depend on it
+	CStringEdArena m_TextArena;
 };
 
 CStringEdPackage TheStringPackage;
 
 void CStringEdPackage::Clear(SE_BOOL bChangingLanguages)
 {
-	m_StringEntries.clear();
+	// the references themselves are kept even when not changing languages, so that any handles given out to the
+	//	game stay valid for the life of the app...
+	//
+	for (SE_Entry_t& Entry : m_StringEntries)
+	{
+		Entry.m_psString = nullptr;
+		Entry.m_psDebug = nullptr;
+		Entry.m_iFlags = 0;
+		Entry.m_bLoaded = SE_FALSE;
+	}
+	m_TextArena.Clear();
 
 	if (!bChangingLanguages)
 	{
@@ -162,6 +261,76 @@ void CStringEdPackage::Clear(SE_BOOL bChangingLanguages)
 	//
 }
 
+// returns index into m_StringEntries, else -1 if this reference has never been seen...
+//
+int CStringEdPackage::FindEntry(const char* psReference) const
+{
+	if (m_HashSlots.empty())
+	{
+		return -1;
+	}
+
+	const unsigned int uiHash = SE_HashReference(psReference);
+	const size_t iMask = m_HashSlots.size() - 1;
+
+	for (size_t iSlot = uiHash & iMask; m_HashSlots[iSlot] != -1; iSlot = (iSlot + 1) & iMask)
+	{
+		const SE_Entry_t& Entry = m_StringEntries[m_HashSlots[iSlot]];
+		if (Entry.m_uiHash == uiHash && !Q_stricmp(Entry.m_psReference, psReference))
+		{
+			return m_HashSlots[iSlot];
+		}
+	}
+
+	return -1;
+}
+
+int CStringEdPackage::FindOrAddEntry(const char* psReference)
+{
+	int iEntry = FindEntry(psReference);
+	if (iEntry == -1)
+	{
+		if ((m_StringEntries.size() + 1) * 2 > m_HashSlots.size())
+		{
+			GrowHashTable();
+		}
+
+		SE_Entry_t Entry = {};
+		Entry.m_psReference = m_ReferenceArena.Store(psReference);
+		Entry.m_uiHash = SE_HashReference(psReference);
+
+		iEntry = m_StringEntries.size();
+		m_StringEntries.push_back(Entry);
+
+		const size_t iMask = m_HashSlots.size() - 1;
+		size_t iSlot = Entry.m_uiHash & iMask;
+		while (m_HashSlots[iSlot] != -1)
+		{
+			iSlot = (iSlot + 1) & iMask;
+		}
+		m_HashSlots[iSlot] = iEntry;
+	}
+
+	return iEntry;
+}
+
+void CStringEdPackage::GrowHashTable()
+{
+	const size_t iNewSize = m_HashSlots.empty() ? 4096 : m_HashSlots.size() * 2; // english SP has ~3000 strings
+	const size_t iMask = iNewSize - 1;
+
+	m_HashSlots.assign(iNewSize, -1);
+	for (size_t iEntry = 0; iEntry < m_StringEntries.size(); iEntry++)
+	{
+		size_t iSlot = m_StringEntries[iEntry].m_uiHash & iMask;
+		while (m_HashSlots[iSlot] != -1)
+		{
+			iSlot = (iSlot + 1) & iMask;
+		}
+		m_HashSlots[iSlot] = static_cast<int>(iEntry);
+	}
+}
+
 // loses anything after the path (if any), (eg) "dir/name.bmp" becomes "dir"
 // (copes with either slash-scheme for names)
 //
@@ -464,11 +633,10 @@ void CStringEdPackage::AddFlagReference(const char* psLocalReference, const char
 	//
 	// then add the reference to this flag to the currently-parsed reference...
 	//
-	const auto itEntry = m_StringEntries.find(va("%s_%s", m_strCurrentFileRef_ParseOnly.c_str(), psLocalReference));
-	if (itEntry != m_StringEntries.end())
+	const int iEntry = FindEntry(va("%s_%s", m_strCurrentFileRef_ParseOnly.c_str(), psLocalReference));
+	if (iEntry != -1)
 	{
-		SE_Entry_t& Entry = (*itEntry).second;
-		Entry.m_iFlags |= iMask;
+		m_StringEntries[iEntry].m_iFlags |= iMask;
 	}
 }
 
@@ -738,12 +906,8 @@ void CStringEdPackage::AddEntry(const char* psLocalReference)
 	// the reason I don't just assign it anyway is because the optional .STE override files don't contain flags,
 	//	and therefore would wipe out the parsed flags of the .STR file...
 	//
-	const auto itEntry = m_StringEntries.find(va("%s_%s", m_strCurrentFileRef_ParseOnly.c_str(), psLocalReference));
-	if (itEntry == m_StringEntries.end())
-	{
-		const SE_Entry_t SE_Entry;
-		m_StringEntries[va("%s_%s", m_strCurrentFileRef_ParseOnly.c_str(), psLocalReference)] = SE_Entry;
-	}
+	SE_Entry_t& Entry = m_StringEntries[FindOrAddEntry(va("%s_%s", m_strCurrentFileRef_ParseOnly.c_str(), psLocalReference))];
+	Entry.m_bLoaded = SE_TRUE;
 	m_strCurrentEntryRef_ParseOnly = psLocalReference;
 }
 
@@ -773,22 +937,20 @@ const char* Leetify(const char* psString)
 
 void CStringEdPackage::SetString(const char* psLocalReference, const char* psNewString, SE_BOOL bEnglishDebug)
 {
-	const auto itEntry = m_StringEntries.find(va("%s_%s", m_strCurrentFileRef_ParseOnly.c_str(), psLocalReference));
-	if (itEntry != m_StringEntries.end())
+	const int iEntry = FindEntry(va("%s_%s", m_strCurrentFileRef_ParseOnly.c_str(), psLocalReference));
+	if (iEntry != -1 && m_StringEntries[iEntry].m_bLoaded)
 	{
-		SE_Entry_t& Entry = (*itEntry).second;
+		SE_Entry_t& Entry = m_StringEntries[iEntry];
 
 		if (bEnglishDebug || m_bLoadingEnglish_ParseOnly)
 		{
 			// then this is the leading english text of a foreign sentence pair (so it's the debug-key text),
 			//	or it's the only text when it's english being loaded...
 			//
-			Entry.m_strString = Leetify(psNewString);
+			Entry.m_psString = m_TextArena.Store(Leetify(psNewString));
 			if (m_bLoadDebug)
 			{
-				Entry.m_strDebug = sSE_DEBUGSTR_PREFIX;
-				Entry.m_strDebug += /* m_bLoadingEnglish_ParseOnly ? "" : */ psNewString;
-				Entry.m_strDebug += sSE_DEBUGSTR_SUFFIX;
+				Entry.m_psDebug = m_TextArena.Store(sSE_DEBUGSTR_PREFIX, /* m_bLoadingEnglish_ParseOnly ? "" : */ psNewString, sSE_DEBUGSTR_SUFFIX);
 			}
 			m_strCurrentEntryEnglish_ParseOnly = psNewString; // for possible "#same" resolving in foreign later
 		}
@@ -798,17 +960,15 @@ void CStringEdPackage::SetString(const char* psLocalReference, const char* psNew
 			//
 			if (!Q_stricmp(psNewString, sSE_EXPORT_SAME))
 			{
-				Entry.m_strString = m_strCurrentEntryEnglish_ParseOnly; // foreign "#same" is now english
+				Entry.m_psString = m_TextArena.Store(m_strCurrentEntryEnglish_ParseOnly.c_str()); // foreign "#same" is now english
 				if (m_bLoadDebug)
 				{
-					Entry.m_strDebug = sSE_DEBUGSTR_PREFIX;
-					Entry.m_strDebug += sSE_EXPORT_SAME; // english (debug) is now "#same"
-					Entry.m_strDebug += sSE_DEBUGSTR_SUFFIX;
+					Entry.m_psDebug = m_TextArena.Store(sSE_DEBUGSTR_PREFIX, sSE_EXPORT_SAME, sSE_DEBUGSTR_SUFFIX); // english (debug) is now "#same"
 				}
 			}
 			else
 			{
-				Entry.m_strString = psNewString; // foreign is just foreign
+				Entry.m_psString = m_TextArena.Store(psNewString); // foreign is just foreign
 			}
 		}
 	}
@@ -969,6 +1129,15 @@ const char* SE_GetString(const char* psPackageReference, const char* psStringRef
 	return SE_GetString(Q_strupr(sReference));
 }
 
+#ifndef JK2_MODE
+static const char* SE_GetEntryText(const SE_Entry_t& Entry)
+{
+	const char* psText = (se_debug->integer && TheStringPackage.m_bLoadDebug) ? Entry.m_psDebug : Entry.m_psString;
+
+	return psText ? psText : "";
+}
+#endif
+
 const char* SE_GetString(const char* psPackageAndStringReference)
 {
 #ifdef JK2_MODE
@@ -976,21 +1145,12 @@ const char* SE_GetString(const char* psPackageAndStringReference)
 	extern const char* JK2SP_GetStringTextString(const char* Reference);
 	return JK2SP_GetStringTextString((const char*)psPackageAndStringReference);
 #else
-	char sReference[512]; // will always be enough, I've never seen one more than about 30 chars long
-	//assert(strlen(psPackageAndStringReference) < sizeof(sReference) );
-	Q_strncpyz(sReference, psPackageAndStringReference, sizeof(sReference));
-	Q_strupr(sReference);
-
-	const auto itEntry = TheStringPackage.m_StringEntries.find(sReference);
-	if (itEntry != TheStringPackage.m_StringEntries.end())
+	// (no need to uppercase a copy of the reference first, the lookup ignores case)
+	//
+	const int iEntry = TheStringPackage.FindEntry(psPackageAndStringReference);
+	if (iEntry != -1 && TheStringPackage.m_StringEntries[iEntry].m_bLoaded)
 	{
-		const SE_Entry_t& Entry = (*itEntry).second;
-
-		if (se_debug->integer && TheStringPackage.m_bLoadDebug)
-		{
-			return Entry.m_strDebug.c_str();
-		}
-		return Entry.m_strString.c_str();
+		return SE_GetEntryText(TheStringPackage.m_StringEntries[iEntry]);
 	}
 
 	// should never get here, but fall back anyway... (except we DO use this to see if there's a debug-friendly key bind, which may not exist)
@@ -1000,6 +1160,30 @@ const char* SE_GetString(const char* psPackageAndStringReference)
 #endif
 }
 
+// for anything looked up every frame: resolve the reference once, then use SE_GetStringByHandle(). The handle stays
+//	valid across language changes (and is fine to get before the reference has even been loaded), 0 is never a valid one.
+//
+int SE_GetStringHandle(const char* psPackageAndStringReference)
+{
+	return TheStringPackage.FindOrAddEntry(psPackageAndStringReference) + 1;
+}
+
+const char* SE_GetStringByHandle(const int iHandle)
+{
+	if (iHandle <= 0 || iHandle > static_cast<int>(TheStringPackage.m_StringEntries.size()))
+	{
+		__ASSERT(0);
+		return "";
+	}
+
+	const SE_Entry_t& Entry = TheStringPackage.m_StringEntries[iHandle - 1];
+#ifdef JK2_MODE
+	return SE_GetString(Entry.m_psReference);
+#else
+	return Entry.m_bLoaded ? SE_GetEntryText(Entry) : "";
+#endif
+}
+
 // convenience-function for the main GetFlags call...
 //
 int SE_GetFlags(const char* psPackageReference, const char* psStringReference)
@@ -1013,12 +1197,10 @@ int SE_GetFlags(const char* psPackageReference, const char* psStringReference)
 
 int SE_GetFlags(const char* psPackageAndStringReference)
 {
-	const auto itEntry = TheStringPackage.m_StringEntries.find(psPackageAndStringReference);
-	if (itEntry != TheStringPackage.m_StringEntries.end())
+	const int iEntry = TheStringPackage.FindEntry(psPackageAndStringReference);
+	if (iEntry != -1 && TheStringPackage.m_StringEntries[iEntry].m_bLoaded)
 	{
-		const SE_Entry_t& Entry = (*itEntry).second;
-
-		return Entry.m_iFlags;
+		return TheStringPackage.m_StringEntries[iEntry].m_iFlags;
 	}
 
 	// should never get here, but fall back anyway...
@@ -71,6 +71,11 @@ void SE_NewLanguage();
 const char* SE_GetString(const char* psPackageReference, const char* psStringReference);
 const char* SE_GetString(const char* psPackageAndStringReference);
 //
+// for per-frame lookups, resolve the reference to a handle once (stays valid across language changes)...
+//
+int SE_GetStringHandle(const char* psPackageAndStringReference);
+const char* SE_GetStringByHandle(int iHandle);
+//
 // ditto...
 //
 int SE_GetFlags(const char* psPackageReference, const char* psStringReference);
@@ -27,6 +27,7 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #include "../qcommon/sstring.h"	// stl string class won't compile in here (MS shite), so use Gil's.
 #include "tr_local.h"
 #include "tr_font.h"
+#include "tr_font_batch.h"
 
 #include "../qcommon/stringed_ingame.h"
 
@@ -266,6 +267,9 @@ int							g_iCurrentFontIndex;	// entry 0 is reserved index for missing/invalid,
 std::vector<CFontInfo*>			g_vFontArray;
 using FontIndexMap_t = std::map<sstring_t, int>;
 FontIndexMap_t g_mapFontIndexes;
+#ifndef JK2_MODE
+static CFontLayoutCache g_FontLayouts;	// see tr_font_batch.h
+#endif
 int g_iNonScaledCharRange;	// this is used with auto-scaling of asian fonts, anything below this number is preserved in scale, anything above is scaled down by 0.75f
 
 //paletteRGBA_c				lastcolour;
@@ -1489,6 +1493,17 @@ int RE_Font_StrLenPixels(const char* psText, const int iFontHandle, const float
 		return(0);
 	}
 
+	// the HUD and menus ask for the same few strings' widths every frame, so remember them alongside the layouts
+	// (-1 is the same max width RE_Font_DrawString() is normally called with, so both usually share an entry)...
+	//
+	const fontLayoutKey_t key = { iFontHandle & SET_MASK, fScale, -1, GetLanguageEnum() };
+	bool bFound;
+	fontLayout_t& layout = g_FontLayouts.Lookup(psText, key, bFound);
+	if (layout.iStrLenPixels != -1)
+	{
+		return layout.iStrLenPixels;
+	}
+
 	float fScaleAsian = fScale;
 	if (Language_IsAsian() && fScale > 0.7f)
 	{
@@ -1530,7 +1545,8 @@ int RE_Font_StrLenPixels(const char* psText, const int iFontHandle, const float
 	}
 
 	// using ceil because we need to make sure that all the text is contained within the integer pixel width we're returning
-	return static_cast<int>(ceilf(fMaxWidth));
+	layout.iStrLenPixels = static_cast<int>(ceilf(fMaxWidth));
+	return layout.iStrLenPixels;
 #endif
 }
 
@@ -1584,6 +1600,132 @@ int RE_Font_HeightPixels(const int iFontHandle, const float fScale)
 	return(0);
 }
 
+#ifndef JK2_MODE
+// lays psText out into glyph quads relative to (0,0), the same way RE_Font_DrawString() always placed them...
+//
+static void RE_Font_LayoutString(CFontInfo* curfont, const char* psText, const int iMaxPixelWidth, const float fScale, fontLayout_t& layout)
+{
+	const glyphInfo_t* pLetter;
+	qhandle_t			hShader = 0;
+
+	float fScaleAsian = fScale;
+	float fAsianYAdjust = 0.0f;
+	if (Language_IsAsian() && fScale > 0.7f)
+	{
+		fScaleAsian = fScale * 0.75f;
+		fAsianYAdjust = ((curfont->GetPointSize() * fScale) - (curfont->GetPointSize() * fScaleAsian)) / 2.0f;
+	}
+
+	// Now we take off the training wheels and become a big font renderer
+	// It's all floats from here on out
+	float fx = 0.0f;
+	float foy = curfont->mbRoundCalcs ? Round((curfont->GetHeight() - (curfont->GetDescender() >> 1)) * fScale) : (curfont->GetHeight() - (curfont->GetDescender() >> 1)) * fScale;
+	int iColour = -1;
+
+	qboolean bNextTextWouldOverflow = qfalse;
+	while (*psText && !bNextTextWouldOverflow)
+	{
+		int iAdvanceCount;
+		unsigned int uiLetter = AnyLanguage_ReadCharFromString(const_cast<char*>(psText), &iAdvanceCount, nullptr);
+		psText += iAdvanceCount;
+
+		switch (uiLetter)
+		{
+		case 10:						//linefeed
+			fx = 0.0f;
+			foy += curfont->mbRoundCalcs ? Round(curfont->GetPointSize() * fScale) : curfont->GetPointSize() * fScale;
+			if (Language_IsAsian())
+			{
+				foy += 4.0f;	// this only comes into effect when playing in asian for "A long time ago in a galaxy" etc, all other text is line-broken in feeder functions
+			}
+			break;
+		case 13:						// Return
+			break;
+		case 32:						// Space
+			pLetter = curfont->GetLetter(' ');
+			fx += curfont->mbRoundCalcs ? Round(pLetter->horizAdvance * fScale) : pLetter->horizAdvance * fScale;
+			bNextTextWouldOverflow = (iMaxPixelWidth != -1 && (fx > static_cast<float>(iMaxPixelWidth))) ? qtrue : qfalse; // yeuch
+			break;
+		case '_':	// has a special word-break usage if in Thai (and followed by a thai char), and should not be displayed, else treat as normal
+			if (GetLanguageEnum() == eThai && ((unsigned char*)psText)[0] >= TIS_GLYPHS_START)
+			{
+				break;
+			}
+			// else drop through and display as normal...
+		case '^':
+			if (uiLetter != '_')	// necessary because of fallthrough above
+			{
+				if (*psText >= '0' &&
+					*psText <= '9')
+				{
+					iColour = ColorIndex(*psText++);
+					layout.iFinalColour = iColour;
+					break;
+				}
+			}
+			//purposely falls thrugh
+		default:
+			pLetter = curfont->GetLetter(uiLetter, &hShader);			// Description of pLetter
+			if (!pLetter->width)
+			{
+				pLetter = curfont->GetLetter('.');
+			}
+
+			float fThisScale = uiLetter > static_cast<unsigned>(g_iNonScaledCharRange) ? fScaleAsian : fScale;
+
+			// sigh, super-language-specific hack...
+			//
+			if (uiLetter == TIS_SARA_AM && GetLanguageEnum() == eThai)
+			{
+				fx -= curfont->mbRoundCalcs ? Round(7.0f * fThisScale) : 7.0f * fThisScale;
+			}
+
+			float fAdvancePixels = curfont->mbRoundCalcs ? Round(pLetter->horizAdvance * fThisScale) : pLetter->horizAdvance * fThisScale;
+			bNextTextWouldOverflow = (iMaxPixelWidth != -1 && ((fx + fAdvancePixels) > static_cast<float>(iMaxPixelWidth))) ? qtrue : qfalse; // yeuch
+			if (!bNextTextWouldOverflow)
+			{
+				// this 'mbRoundCalcs' stuff is crap, but the only way to make the font code work. Sigh...
+				//
+				float fy = foy - (curfont->mbRoundCalcs ? Round(pLetter->baseline * fThisScale) : pLetter->baseline * fThisScale);
+				if (curfont->m_fAltSBCSFontScaleFactor != -1)
+				{
+					fy += 3.0f; // I'm sick and tired of going round in circles trying to do this legally, so bollocks to it
+				}
+
+				fontGlyphQuad_t glyph;
+				glyph.x = curfont->mbRoundCalcs ? fx + Round(pLetter->horizOffset * fThisScale) : fx + pLetter->horizOffset * fThisScale;
+				glyph.y = (uiLetter > static_cast<unsigned>(g_iNonScaledCharRange)) ? fy - fAsianYAdjust : fy;
+				glyph.w = curfont->mbRoundCalcs ? Round(pLetter->width * fThisScale) : pLetter->width * fThisScale;
+				glyph.h = curfont->mbRoundCalcs ? Round(pLetter->height * fThisScale) : pLetter->height * fThisScale;
+				glyph.s1 = pLetter->s;
+				glyph.t1 = pLetter->t;
+				glyph.s2 = pLetter->s2;
+				glyph.t2 = pLetter->t2;
+				glyph.hShader = hShader;
+				glyph.iColour = iColour;
+				layout.glyphs.push_back(glyph);
+
+				fx += fAdvancePixels;
+			}
+			break;
+		}
+	}
+}
+
+static const fontLayout_t& RE_Font_GetLayout(CFontInfo* curfont, const int iFontHandle, const char* psText, const int iMaxPixelWidth, const float fScale)
+{
+	const fontLayoutKey_t key = { iFontHandle & SET_MASK, fScale, iMaxPixelWidth, GetLanguageEnum() };
+	bool bFound;
+	fontLayout_t& layout = g_FontLayouts.Lookup(psText, key, bFound);
+	if (!layout.bHasGlyphs)
+	{
+		RE_Font_LayoutString(curfont, psText, iMaxPixelWidth, fScale, layout);
+		layout.bHasGlyphs = true;
+	}
+	return layout;
+}
+#endif
+
 // iMaxPixelWidth is -1 for "all of string", else pixel display count...
 //
 void RE_Font_DrawString(int ox, int oy, const char* psText, const float* rgba, const int iFontHandle, int iMaxPixelWidth, const float fScale)
@@ -1737,8 +1879,6 @@ void RE_Font_DrawString(int ox, int oy, const char* psText, const float* rgba, c
 	//let it remember the old color //RE_SetColor(NULL);
 #else
 	static qboolean gbInShadow = qfalse;	// MUST default to this
-	const glyphInfo_t* pLetter;
-	qhandle_t			hShader;
 
 	assert(psText);
 
@@ -1800,13 +1940,7 @@ void RE_Font_DrawString(int ox, int oy, const char* psText, const float* rgba, c
 		return;
 	}
 
-	float fScaleAsian = fScale;
-	float fAsianYAdjust = 0.0f;
-	if (Language_IsAsian() && fScale > 0.7f)
-	{
-		fScaleAsian = fScale * 0.75f;
-		fAsianYAdjust = ((curfont->GetPointSize() * fScale) - (curfont->GetPointSize() * fScaleAsian)) / 2.0f;
-	}
+	const fontLayout_t& layout = RE_Font_GetLayout(curfont, iFontHandle, psText, iMaxPixelWidth, fScale);
 
 	// Draw a dropshadow if required
 	if (iFontHandle & STYLE_DROPSHADOW)
@@ -1820,108 +1954,26 @@ void RE_Font_DrawString(int ox, int oy, const char* psText, const float* rgba, c
 		gbInShadow = qfalse;
 	}
 
-	RE_SetColor(rgba);
-
-	// Now we take off the training wheels and become a big font renderer
-	// It's all floats from here on out
-	float fox = ox;
-	float foy = oy;
-
-	float fx = fox;
-	foy += curfont->mbRoundCalcs ? Round((curfont->GetHeight() - (curfont->GetDescender() >> 1)) * fScale) : (curfont->GetHeight() - (curfont->GetDescender() >> 1)) * fScale;
-
-	qboolean bNextTextWouldOverflow = qfalse;
-	while (*psText && !bNextTextWouldOverflow)
-	{
-		int iAdvanceCount;
-		unsigned int uiLetter = AnyLanguage_ReadCharFromString(const_cast<char*>(psText), &iAdvanceCount, nullptr);
-		psText += iAdvanceCount;
-
-		switch (uiLetter)
+	// colour codes are carried per quad, so the whole string goes out as one batch per glyph shader...
+	//
+	R_Font_BatchLayout(layout, static_cast<float>(ox), static_cast<float>(oy), rgba, gbInShadow ? nullptr : g_color_table,
+		[](const int hBatchShader, const stretchPicQuad_t* quads, const int numQuads)
 		{
-		case 10:						//linefeed
-			fx = fox;
-			foy += curfont->mbRoundCalcs ? Round(curfont->GetPointSize() * fScale) : curfont->GetPointSize() * fScale;
-			if (Language_IsAsian())
-			{
-				foy += 4.0f;	// this only comes into effect when playing in asian for "A long time ago in a galaxy" etc, all other text is line-broken in feeder functions
-			}
-			break;
-		case 13:						// Return
-			break;
-		case 32:						// Space
-			pLetter = curfont->GetLetter(' ');
-			fx += curfont->mbRoundCalcs ? Round(pLetter->horizAdvance * fScale) : pLetter->horizAdvance * fScale;
-			bNextTextWouldOverflow = (iMaxPixelWidth != -1 && ((fx - fox) > static_cast<float>(iMaxPixelWidth))) ? qtrue : qfalse; // yeuch
-			break;
-		case '_':	// has a special word-break usage if in Thai (and followed by a thai char), and should not be displayed, else treat as normal
-			if (GetLanguageEnum() == eThai && ((unsigned char*)psText)[0] >= TIS_GLYPHS_START)
-			{
-				break;
-			}
-			// else drop through and display as normal...
-		case '^':
-			if (uiLetter != '_')	// necessary because of fallthrough above
-			{
-				if (*psText >= '0' &&
-					*psText <= '9')
-				{
-					int colour = ColorIndex(*psText++);
-					if (!gbInShadow)
-					{
-						vec4_t color;
-						Com_Memcpy(color, g_color_table[colour], sizeof(color));
-						color[3] = rgba ? rgba[3] : 1.0f;
-						RE_SetColor(color);
-					}
-					break;
-				}
-			}
-			//purposely falls thrugh
-		default:
-			pLetter = curfont->GetLetter(uiLetter, &hShader);			// Description of pLetter
-			if (!pLetter->width)
-			{
-				pLetter = curfont->GetLetter('.');
-			}
-
-			float fThisScale = uiLetter > static_cast<unsigned>(g_iNonScaledCharRange) ? fScaleAsian : fScale;
-
-			// sigh, super-language-specific hack...
-			//
-			if (uiLetter == TIS_SARA_AM && GetLanguageEnum() == eThai)
-			{
-				fx -= curfont->mbRoundCalcs ? Round(7.0f * fThisScale) : 7.0f * fThisScale;
-			}
+			RE_StretchPicBatch(quads, numQuads, hBatchShader);
+		});
 
-			float fAdvancePixels = curfont->mbRoundCalcs ? Round(pLetter->horizAdvance * fThisScale) : pLetter->horizAdvance * fThisScale;
-			bNextTextWouldOverflow = (iMaxPixelWidth != -1 && (((fx + fAdvancePixels) - fox) > static_cast<float>(iMaxPixelWidth))) ? qtrue : qfalse; // yeuch
-			if (!bNextTextWouldOverflow)
-			{
-				// this 'mbRoundCalcs' stuff is crap, but the only way to make the font code work. Sigh...
-				//
-				float fy = foy - (curfont->mbRoundCalcs ? Round(pLetter->baseline * fThisScale) : pLetter->baseline * fThisScale);
-				if (curfont->m_fAltSBCSFontScaleFactor != -1)
-				{
-					fy += 3.0f; // I'm sick and tired of going round in circles trying to do this legally, so bollocks to it
-				}
-
-				RE_StretchPic(curfont->mbRoundCalcs ? fx + Round(pLetter->horizOffset * fThisScale) : fx + pLetter->horizOffset * fThisScale, // float x
-					(uiLetter > static_cast<unsigned>(g_iNonScaledCharRange)) ? fy - fAsianYAdjust : fy,	// float y
-					curfont->mbRoundCalcs ? Round(pLetter->width * fThisScale) : pLetter->width * fThisScale,	// float w
-					curfont->mbRoundCalcs ? Round(pLetter->height * fThisScale) : pLetter->height * fThisScale, // float h
-					pLetter->s,						// float s1
-					pLetter->t,						// float t1
-					pLetter->s2,					// float s2
-					pLetter->t2,					// float t2
-					//lastcolour.c,
-					hShader							// qhandle_t hShader
-				);
-
-				fx += fAdvancePixels;
-			}
-			break;
-		}
+	// ... but leave the current colour where the per-glyph version would have
+	//
+	if (!gbInShadow && layout.iFinalColour >= 0)
+	{
+		vec4_t color;
+		Com_Memcpy(color, g_color_table[layout.iFinalColour], sizeof(color));
+		color[3] = rgba ? rgba[3] : 1.0f;
+		RE_SetColor(color);
+	}
+	else
+	{
+		RE_SetColor(rgba);
 	}
 	//let it remember the old color //RE_SetColor(NULL);
 #endif
@@ -1990,6 +2042,9 @@ void R_ShutdownFonts()
 	g_mapFontIndexes.clear();
 	g_vFontArray.clear();
 	g_iCurrentFontIndex = 1;	// entry 0 is reserved for "missing/invalid"
+#ifndef JK2_MODE
+	g_FontLayouts.Clear();	// the handles in these are about to be reused
+#endif
 
 	g_ThaiCodes.Clear();
 }
@@ -0,0 +1,215 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// tr_font_batch.h -- text layout cache and glyph quad batching for RE_Font_DrawString
+//
+// A string is laid out once into glyph quads relative to the pen origin and
+// kept in a direct-mapped cache keyed on font, scale, max width, language and
+// the text itself.  Drawing a layout offsets the quads and hands runs that
+// share a shader to the renderer as a single RC_STRETCH_PIC_BATCH command, so
+// a line of text costs one command instead of one per glyph and colour code.
+// Nothing in here touches renderer state so the tests can run without GL.
+
+// This file is shared in the single and multiplayer codebases, so be CAREFUL WHAT YOU ADD/CHANGE!!!!!
+
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "qcommon/q_hash.h"
+
+// one quad of a RC_STRETCH_PIC_BATCH command, already in screen space
+struct stretchPicQuad_t
+{
+	float x, y;
+	float w, h;
+	float s1, t1;
+	float s2, t2;
+	float color[4];
+};
+
+#define MAX_STRETCHPIC_BATCH	256		// quads per RC_STRETCH_PIC_BATCH command
+
+// one glyph of a laid-out string, relative to the pen origin
+struct fontGlyphQuad_t
+{
+	float x, y;
+	float w, h;
+	float s1, t1;
+	float s2, t2;
+	int hShader;
+	int iColour;		// ^n colour code in effect, -1 for the caller's colour
+};
+
+struct fontLayoutKey_t
+{
+	int iFont;			// without the STYLE_ bits
+	float fScale;
+	int iMaxPixelWidth;
+	int iLanguage;
+
+	bool operator==(const fontLayoutKey_t& other) const
+	{
+		return iFont == other.iFont && fScale == other.fScale &&
+			iMaxPixelWidth == other.iMaxPixelWidth && iLanguage == other.iLanguage;
+	}
+};
+
+struct fontLayout_t
+{
+	fontLayoutKey_t key;
+	unsigned int uiHash;
+	std::string strText;
+	bool bValid;
+
+	bool bHasGlyphs;	// glyphs/iFinalColour filled in by RE_Font_DrawString
+	std::vector<fontGlyphQuad_t> glyphs;
+	int iFinalColour;	// last colour code in the string, -1 for none
+
+	int iStrLenPixels;	// filled in by RE_Font_StrLenPixels, -1 until then
+};
+
+class CFontLayoutCache
+{
+public:
+	static const int iCACHE_SIZE = 1024;		// power of two
+	static const size_t iMAX_CACHED_TEXT = 512;	// longer strings are laid out every time
+
+	CFontLayoutCache() : m_Layouts(iCACHE_SIZE)
+	{
+		Clear();
+	}
+
+	// returns the layout for this text and key, with bFound set if it was already there.  When it wasn't
+	//	the returned layout has been reset to empty and the caller fills it in
+	//
+	fontLayout_t& Lookup(const char* psText, const fontLayoutKey_t& key, bool& bFound)
+	{
+		const size_t iLen = strlen(psText);
+		const unsigned int uiHash = Hash(psText, iLen, key);
+
+		fontLayout_t* pLayout = &m_Uncached;
+		if (iLen <= iMAX_CACHED_TEXT)
+		{
+			pLayout = &m_Layouts[uiHash & (iCACHE_SIZE - 1)];
+			if (pLayout->bValid && pLayout->uiHash == uiHash && pLayout->key == key &&
+				pLayout->strText.size() == iLen && !memcmp(pLayout->strText.data(), psText, iLen))
+			{
+				bFound = true;
+				return *pLayout;
+			}
+		}
+
+		// assign() and clear() keep the old capacity, so a warm cache doesn't allocate on a miss either
+		//
+		pLayout->key = key;
+		pLayout->uiHash = uiHash;
+		pLayout->strText.assign(psText, iLen);
+		pLayout->bValid = pLayout != &m_Uncached;
+		pLayout->bHasGlyphs = false;
+		pLayout->glyphs.clear();
+		pLayout->iFinalColour = -1;
+		pLayout->iStrLenPixels = -1;
+
+		bFound = false;
+		return *pLayout;
+	}
+
+	void Clear()
+	{
+		for (fontLayout_t& layout : m_Layouts)
+		{
+			layout.bValid = false;
+		}
+		m_Uncached.bValid = false;
+	}
+
+private:
+	static unsigned int Hash(const char* psText, const size_t iLen, const fontLayoutKey_t& key)
+	{
+		unsigned int uiHash = Com_HashFNV1aBytes(FNV1A_INIT, psText, iLen);
+
+		unsigned int uiScale;
+		memcpy(&uiScale, &key.fScale, sizeof(uiScale));
+		uiHash = Com_HashFNV1a(uiHash, static_cast<unsigned int>(key.iFont));
+		uiHash = Com_HashFNV1a(uiHash, uiScale);
+		uiHash = Com_HashFNV1a(uiHash, static_cast<unsigned int>(key.iMaxPixelWidth));
+		uiHash = Com_HashFNV1a(uiHash, static_cast<unsigned int>(key.iLanguage));
+		return uiHash;
+	}
+
+	std::vector<fontLayout_t> m_Layouts;
+	fontLayout_t m_Uncached;
+};
+
+// offsets a layout to (ox,oy) and passes each run of up to MAX_STRETCHPIC_BATCH quads sharing a shader to
+//	emitBatch( hShader, quads, numQuads ).  rgba NULL is white, same as RE_SetColor().  colourTable NULL ignores the
+//	colour codes (drop shadows), else code colours take their alpha from rgba like the old per-glyph RE_SetColor() did.
+//
+template <typename EmitBatch>
+void R_Font_BatchLayout(const fontLayout_t& layout, const float ox, const float oy, const float* rgba,
+	const float (*colourTable)[4], EmitBatch emitBatch)
+{
+	static const float colourWhite[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	const float* baseColour = rgba ? rgba : colourWhite;
+
+	stretchPicQuad_t quads[MAX_STRETCHPIC_BATCH];
+	int numQuads = 0;
+	int hBatchShader = 0;
+
+	for (const fontGlyphQuad_t& glyph : layout.glyphs)
+	{
+		if (numQuads && (glyph.hShader != hBatchShader || numQuads == MAX_STRETCHPIC_BATCH))
+		{
+			emitBatch(hBatchShader, quads, numQuads);
+			numQuads = 0;
+		}
+		hBatchShader = glyph.hShader;
+
+		stretchPicQuad_t& quad = quads[numQuads++];
+		quad.x = ox + glyph.x;
+		quad.y = oy + glyph.y;
+		quad.w = glyph.w;
+		quad.h = glyph.h;
+		quad.s1 = glyph.s1;
+		quad.t1 = glyph.t1;
+		quad.s2 = glyph.s2;
+		quad.t2 = glyph.t2;
+
+		if (colourTable && glyph.iColour >= 0)
+		{
+			quad.color[0] = colourTable[glyph.iColour][0];
+			quad.color[1] = colourTable[glyph.iColour][1];
+			quad.color[2] = colourTable[glyph.iColour][2];
+			quad.color[3] = rgba ? rgba[3] : 1.0f;
+		}
+		else
+		{
+			memcpy(quad.color, baseColour, sizeof(quad.color));
+		}
+	}
+
+	if (numQuads)
+	{
+		emitBatch(hBatchShader, quads, numQuads);
+	}
+}
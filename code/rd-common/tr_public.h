@@ -30,7 +30,7 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #include "../ghoul2/G2.h"
 #include "../ghoul2/ghoul2_gore.h"
 
-constexpr auto REF_API_VERSION = 20;
+constexpr auto REF_API_VERSION = 25;
 
 using refimport_t = struct
 {
@@ -124,6 +124,9 @@ using refimport_t = struct
 	qboolean* (*gbUsingCachedMapDataRightNow)();
 	qboolean* (*gbAlreadyDoingLoad)();
 	int (*com_frameTime)();
+
+	uint64_t (*FS_LoadedPakHash)();
+	void (*SV_TraceBatch)(traceQuery_t* queries, int count, int passEntityNum, int contentmask);
 };
 
 extern refimport_t ri;
@@ -386,6 +389,11 @@ using refexport_t = struct
 	// Performance analysis (perform anal)
 	void (*G2Time_ResetTimers)();
 	void (*G2Time_ReportTimers)();
+
+	void (*IsOutsideBatch)(int numPoints, vec3_t* points, bool* outside);
+	qboolean(*G2API_GetBoltMatrices)(CGhoul2Info_v& ghoul2, int modelIndex, int numBolts, const int* bolt_indexes,
+		mdxaBone_t* matrices, const vec3_t angles, const vec3_t position, int AframeNum, qhandle_t* model_list,
+		const vec3_t scale);
 };
 
 // this is the only function actually exported at the linker level
@@ -0,0 +1,67 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// tr_ragstep.h -- fixed-step clock for the Ghoul2 ragdoll solver
+//
+// Each ragdoll keeps the time its solver has stepped up to (CGhoul2Info::mRagStepTime)
+// and an update runs however many whole steps have come due since, so the
+// amount of settling follows real time instead of the framerate.  The solver
+// itself works on file static bone and effector arrays in G2_bones.cpp that
+// every ragdoll shares, so anything that reads them has to rebuild them for
+// the ragdoll at hand first, including on an update where no step is due.
+// Nothing in here touches renderer state so the tests can run without GL.
+
+// This file is shared in the single and multiplayer codebases, so be CAREFUL WHAT YOU ADD/CHANGE!!!!!
+
+#pragma once
+
+#define MAX_RAG_STEPS	3		// most solver steps one update may catch up on
+
+// advances stepClock to curTime and returns the number of whole steps due, at most maxSteps
+inline int G2_RagStepCount( int& stepClock, const int curTime, const int stepTime, const int maxSteps = MAX_RAG_STEPS )
+{
+	if ( stepTime <= 0 )
+	{
+		// stepping disabled, settle once per update like the old code
+		return 1;
+	}
+
+	if ( !stepClock || curTime < stepClock )
+	{
+		// first update, or the clock went backwards on a restart
+		stepClock = curTime - stepTime;
+	}
+	int steps = ( curTime - stepClock ) / stepTime;
+	if ( steps > maxSteps )
+	{
+		// don't try to catch up on a long hitch, just drop the time
+		stepClock = curTime - maxSteps * stepTime;
+		steps = maxSteps;
+	}
+	stepClock += steps * stepTime;
+	return steps;
+}
+
+// the shared solver state must be set up for this ragdoll if it is going to be
+// stepped or if its current position is going to be read back out of it
+inline bool G2_RagNeedsSetup( const int iters, const bool refreshPosition )
+{
+	return iters > 0 || refreshPosition;
+}
@@ -1788,6 +1788,128 @@ void G2API_DetachEnt(int* boltInfo)
 
 bool G2_NeedsRecalc(CGhoul2Info* ghlInfo, int frameNum);
 
+/*
+=================
+Bolt matrix cache
+
+Remembers the world space result of recent bolt lookups. An entry is only
+used while the skeleton it was computed from is still current: bone edits
+reset mSkelFrameNum and every rebuild changes the bone cache stamp, so
+either one makes the entry stale. Origin, angles and scale have to match
+exactly.
+=================
+*/
+constexpr int G2_BOLT_CACHE_SIZE = 512;
+
+using g2BoltCacheEntry_t = struct
+{
+	const CGhoul2Info* ghlInfo;
+	const void* boneCache;
+	int touch;
+	int epoch;
+	int frameNum;
+	int boltIndex;
+	vec3_t angles;
+	vec3_t position;
+	vec3_t scale;
+	mdxaBone_t matrix;
+};
+
+static g2BoltCacheEntry_t g2BoltCache[G2_BOLT_CACHE_SIZE];
+
+static g2BoltCacheEntry_t* G2_BoltCacheSlot(const CGhoul2Info* ghlInfo, const int bolt_index)
+{
+	const uintptr_t key = reinterpret_cast<uintptr_t>(ghlInfo) / sizeof(CGhoul2Info) + bolt_index * 131;
+	return &g2BoltCache[(key ^ (key >> 9)) & (G2_BOLT_CACHE_SIZE - 1)];
+}
+
+static qboolean G2_GetBoltMatrixInternal(CGhoul2Info_v& ghoul2, CGhoul2Info* ghlInfo, const int frameNum, const int bolt_index, mdxaBone_t* matrix, const vec3_t angles, const vec3_t position, const vec3_t scale)
+{
+	G2ERROR(bolt_index >= 0 && (bolt_index < ghlInfo->mBltlist.size()), va("Invalid Bolt Index (%d:%s)", bolt_index, ghlInfo->mFileName));
+
+	if (bolt_index < 0 || bolt_index >= static_cast<int>(ghlInfo->mBltlist.size()))
+	{
+		return qfalse;
+	}
+
+	tr.pc.c_g2BoltQueries++;
+
+	const bool useCache = r_g2BoltCache->integer && angles && position && scale;
+	g2BoltCacheEntry_t* entry = useCache ? G2_BoltCacheSlot(ghlInfo, bolt_index) : nullptr;
+	const void* boneCache;
+	int touch, epoch;
+
+	if (entry && ghlInfo->mSkelFrameNum == frameNum
+		&& G2_GetBoneCacheStamp(*ghlInfo, &boneCache, &touch, &epoch)
+		&& entry->ghlInfo == ghlInfo
+		&& entry->boneCache == boneCache
+		&& entry->touch == touch
+		&& entry->epoch == epoch
+		&& entry->frameNum == frameNum
+		&& entry->boltIndex == bolt_index
+		&& VectorCompare(entry->angles, angles)
+		&& VectorCompare(entry->position, position)
+		&& VectorCompare(entry->scale, scale))
+	{
+		tr.pc.c_g2BoltCacheHits++;
+		*matrix = entry->matrix;
+		return qtrue;
+	}
+
+	mdxaBone_t bolt;
+
+	if (G2_NeedsRecalc(ghlInfo, frameNum))
+	{
+		G2_ConstructGhoulSkeleton(ghoul2, frameNum, true, scale);
+	}
+
+	G2_GetBoltMatrixLow(*ghlInfo, bolt_index, scale, bolt);
+	// scale the bolt position by the scale factor for this model since at this point its still in model space
+	if (scale[0])
+	{
+		bolt.matrix[0][3] *= scale[0];
+	}
+	if (scale[1])
+	{
+		bolt.matrix[1][3] *= scale[1];
+	}
+	if (scale[2])
+	{
+		bolt.matrix[2][3] *= scale[2];
+	}
+	VectorNormalize(reinterpret_cast<float*>(&bolt.matrix[0]));
+	VectorNormalize(reinterpret_cast<float*>(&bolt.matrix[1]));
+	VectorNormalize(reinterpret_cast<float*>(&bolt.matrix[2]));
+
+	Mat3x4_Multiply(matrix, &worldMatrix, &bolt);
+#if G2API_DEBUG
+	for (int i = 0; i < 3; i++)
+	{
+		for (int j = 0; j < 4; j++)
+		{
+			assert(!Q_isnan(matrix->matrix[i][j]));
+		}
+	}
+#endif // _DEBUG
+
+	if (entry && G2_GetBoneCacheStamp(*ghlInfo, &boneCache, &touch, &epoch))
+	{
+		entry->ghlInfo = ghlInfo;
+		entry->boneCache = boneCache;
+		entry->touch = touch;
+		entry->epoch = epoch;
+		entry->frameNum = frameNum;
+		entry->boltIndex = bolt_index;
+		VectorCopy(angles, entry->angles);
+		VectorCopy(position, entry->position);
+		VectorCopy(scale, entry->scale);
+		entry->matrix = *matrix;
+	}
+
+	G2ANIM(ghlInfo, "G2API_GetBoltMatrix");
+	return qtrue;
+}
+
 qboolean G2API_GetBoltMatrix(CGhoul2Info_v& ghoul2, const int modelIndex, const int bolt_index, mdxaBone_t* matrix, const vec3_t angles, const vec3_t position, const int aframe_num, qhandle_t* model_list, const vec3_t scale)
 {
 	G2ERROR(ghoul2.IsValid(), "Invalid ghlInfo");
@@ -1809,46 +1931,9 @@ qboolean G2API_GetBoltMatrix(CGhoul2Info_v& ghoul2, const int modelIndex, const
 		{
 			const int frameNum = G2API_GetTime(aframe_num);
 			CGhoul2Info* ghlInfo = &ghoul2[modelIndex];
-			G2ERROR(bolt_index >= 0 && (bolt_index < ghlInfo->mBltlist.size()), va("Invalid Bolt Index (%d:%s)", bolt_index, ghlInfo->mFileName));
 
-			if (bolt_index >= 0 && ghlInfo && bolt_index < static_cast<int>(ghlInfo->mBltlist.size()))
+			if (G2_GetBoltMatrixInternal(ghoul2, ghlInfo, frameNum, bolt_index, matrix, angles, position, scale))
 			{
-				mdxaBone_t bolt;
-
-				if (G2_NeedsRecalc(ghlInfo, frameNum))
-				{
-					G2_ConstructGhoulSkeleton(ghoul2, frameNum, true, scale);
-				}
-
-				G2_GetBoltMatrixLow(*ghlInfo, bolt_index, scale, bolt);
-				// scale the bolt position by the scale factor for this model since at this point its still in model space
-				if (scale[0])
-				{
-					bolt.matrix[0][3] *= scale[0];
-				}
-				if (scale[1])
-				{
-					bolt.matrix[1][3] *= scale[1];
-				}
-				if (scale[2])
-				{
-					bolt.matrix[2][3] *= scale[2];
-				}
-				VectorNormalize(reinterpret_cast<float*>(&bolt.matrix[0]));
-				VectorNormalize(reinterpret_cast<float*>(&bolt.matrix[1]));
-				VectorNormalize(reinterpret_cast<float*>(&bolt.matrix[2]));
-
-				Mat3x4_Multiply(matrix, &worldMatrix, &bolt);
-#if G2API_DEBUG
-				for (int i = 0; i < 3; i++)
-				{
-					for (int j = 0; j < 4; j++)
-					{
-						assert(!Q_isnan(matrix->matrix[i][j]));
-					}
-				}
-#endif // _DEBUG
-				G2ANIM(ghlInfo, "G2API_GetBoltMatrix");
 				return qtrue;
 			}
 		}
@@ -1861,6 +1946,57 @@ qboolean G2API_GetBoltMatrix(CGhoul2Info_v& ghoul2, const int modelIndex, const
 	return qfalse;
 }
 
+// resolves several bolts of one model; the world matrix, model pointers and
+// skeleton are set up once for the whole batch. bolts that can't be resolved
+// get the same fallback matrix G2API_GetBoltMatrix would return
+qboolean G2API_GetBoltMatrices(CGhoul2Info_v& ghoul2, const int modelIndex, const int numBolts, const int* bolt_indexes, mdxaBone_t* matrices, const vec3_t angles, const vec3_t position, const int aframe_num, qhandle_t* model_list, const vec3_t scale)
+{
+	G2ERROR(ghoul2.IsValid(), "Invalid ghlInfo");
+	G2ERROR(matrices, "NULL matrices");
+	G2ERROR(modelIndex >= 0 && modelIndex < ghoul2.size(), "Invalid ModelIndex");
+	constexpr static mdxaBone_t identity_matrix =
+	{
+		{
+			{0.0f, -1.0f, 0.0f, 0.0f},
+			{1.0f, 0.0f, 0.0f, 0.0f},
+			{0.0f, 0.0f, 1.0f, 0.0f}
+		}
+	};
+
+	if (!matrices || numBolts <= 0)
+	{
+		return qfalse;
+	}
+
+	G2_GenerateWorldMatrix(angles, position);
+
+	CGhoul2Info* ghlInfo = nullptr;
+	int frameNum = 0;
+	if (G2_SetupModelPointers(ghoul2))
+	{
+		if (modelIndex >= 0 && modelIndex < ghoul2.size())
+		{
+			frameNum = G2API_GetTime(aframe_num);
+			ghlInfo = &ghoul2[modelIndex];
+		}
+	}
+	else
+	{
+		G2WARNING(0, "G2API_GetBoltMatrices Failed on empty or bad model");
+	}
+
+	qboolean all = qtrue;
+	for (int i = 0; i < numBolts; i++)
+	{
+		if (!ghlInfo || !G2_GetBoltMatrixInternal(ghoul2, ghlInfo, frameNum, bolt_indexes[i], &matrices[i], angles, position, scale))
+		{
+			Mat3x4_Multiply(&matrices[i], &worldMatrix, (mdxaBone_t*)&identity_matrix);
+			all = qfalse;
+		}
+	}
+	return all;
+}
+
 void G2API_ListSurfaces(CGhoul2Info* ghlInfo)
 {
 	if (G2_SetupModelPointers(ghlInfo))
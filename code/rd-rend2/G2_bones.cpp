@@ -19,6 +19,7 @@
 //rww - RAGDOLL_BEGIN
 #include <float.h>
 #include "ghoul2/ghoul2_gore.h"
+#include "rd-common/tr_ragstep.h"
 //rww - RAGDOLL_END
 
 extern mdxaBone_t worldMatrix;
@@ -1134,6 +1135,8 @@ extern cvar_t* broadsword_ragtobase;
 
 extern cvar_t* broadsword_dircap;
 
+extern cvar_t* broadsword_ragstep;
+
 extern cvar_t* broadsword_extra1;
 extern cvar_t* broadsword_extra2;
 
@@ -1154,6 +1157,8 @@ static bool				haveDesiredPelvisOffset = false;
 static vec3_t			desiredPelvisOffset; // this is for the root
 static float			ragOriginChange = 0.0f;
 static vec3_t			ragOriginChangeDir;
+static traceQuery_t		ragProbes[MAX_BONES_RAG];	// in-solid probes for one settle pass, traced together
+static int				ragProbeIndex[MAX_BONES_RAG];	// ragProbes entry for each rag bone, -1 if it doesn't probe
 //debug
 #if 0
 static vec3_t			handPos = { 0,0,0 };
@@ -2385,7 +2390,12 @@ static void G2_RagDoll(CGhoul2Info_v& ghoul2_v, const int g2_index, CRagDollUpda
 		}
 	}
 
-	int iters = (ragState == ERS_DYNAMIC) ? 4 : 2;
+	//step on a fixed clock so the cost doesn't follow the framerate, one step is the
+	//amount of settling a single call used to do at 60fps
+	const int steps = G2_RagStepCount(ghoul2.mRagStepTime, curTime,
+		broadsword_ragstep ? broadsword_ragstep->integer : 0);
+
+	int iters = ((ragState == ERS_DYNAMIC) ? 4 : 2) * steps;
 	/*
 	//bool kicked=false;
 	if (ragOriginChangeDir[2]<-100.0f)
@@ -2395,7 +2405,9 @@ static void G2_RagDoll(CGhoul2Info_v& ghoul2_v, const int g2_index, CRagDollUpda
 		iters*=2; //rww - changed to this.. it was getting up to around 600 traces at times before (which is insane)
 	}
 	*/
-	if (iters)
+	//the solver arrays are shared by every ragdoll, so even with no step due they have
+	//to be set up for this one before its position is read back out below
+	if (G2_RagNeedsSetup(iters, params->me != ENTITYNUM_NONE))
 	{
 		if (!G2_RagDollSetup(ghoul2, frameNum, resetOrigin, dPos, anyRendered))
 		{
@@ -2572,6 +2584,28 @@ static void Rag_Trace(trace_t* results, const vec3_t start, const vec3_t mins, c
 #endif
 }
 
+static void Rag_TraceBatch(traceQuery_t* queries, const int count, const int passEntityNum, const int contentmask)
+{
+#ifdef _DEBUG
+	int ragPreTrace = ri.Milliseconds();
+#endif
+	ri.SV_TraceBatch(queries, count, passEntityNum, contentmask);
+
+#ifdef _DEBUG
+	int ragPostTrace = ri.Milliseconds();
+
+	ragTraceTime += (ragPostTrace - ragPreTrace);
+	for (int i = 0; i < count; i++)
+	{
+		if (queries[i].startsolid)
+		{
+			ragSSCount++;
+		}
+	}
+	ragTraceCount += count;
+#endif
+}
+
 //run advanced physics on each bone indivudually
 //an adaption of my "exphys" custom game physics model
 #define MAX_GRAVITY_PULL 256//512
@@ -3212,6 +3246,62 @@ static inline void G2_RagGetPelvisLumbarOffsets(CGhoul2Info& ghoul2, CRagDollUpd
 	*/
 }
 
+//finds the closest rag bone above this one and gives back its current origin
+static bool G2_RagParentOrigin(CGhoul2Info& ghoul2, boneInfo_t& bone, vec3_t parentOrigin)
+{
+	if (!bone.boneNumber)
+	{
+		return false;
+	}
+	assert(ghoul2.animModel);
+	assert(ghoul2.aHeader);
+
+	if (bone.parentBoneIndex == -1)
+	{
+		mdxaSkel_t* skel;
+		mdxaSkelOffsets_t* offsets;
+		int bParentIndex, bParentListIndex = -1;
+
+		offsets = (mdxaSkelOffsets_t*)((byte*)ghoul2.aHeader + sizeof(mdxaHeader_t));
+		skel = (mdxaSkel_t*)((byte*)ghoul2.aHeader + sizeof(mdxaHeader_t) + offsets->offsets[bone.boneNumber]);
+
+		bParentIndex = skel->parent;
+
+		while (bParentIndex > 0)
+		{ //go upward through hierarchy searching for the first parent that is a rag bone
+			skel = (mdxaSkel_t*)((byte*)ghoul2.aHeader + sizeof(mdxaHeader_t) + offsets->offsets[bParentIndex]);
+			bParentIndex = skel->parent;
+			bParentListIndex = G2_Find_Bone(ghoul2.animModel, ghoul2.mBlist, skel->name);
+
+			if (bParentListIndex != -1)
+			{
+				boneInfo_t& pbone = ghoul2.mBlist[bParentListIndex];
+				if (pbone.flags & BONE_ANGLES_RAGDOLL)
+				{ //valid rag bone
+					break;
+				}
+			}
+
+			//didn't work out, reset to -1 again
+			bParentListIndex = -1;
+		}
+
+		bone.parentBoneIndex = bParentListIndex;
+	}
+
+	if (bone.parentBoneIndex != -1)
+	{
+		boneInfo_t& pbone = ghoul2.mBlist[bone.parentBoneIndex];
+
+		if (pbone.flags & BONE_ANGLES_RAGDOLL)
+		{ //has origin calculated for us already
+			VectorCopy(ragEffectors[pbone.ragIndex].currentOrigin, parentOrigin);
+			return true;
+		}
+	}
+	return false;
+}
+
 static bool G2_RagDollSettlePositionNumeroTrois(CGhoul2Info_v& ghoul2_v, const vec3_t currentOrg, CRagDollUpdateParams* params, int curTime)
 { //now returns true if any bone was in solid, otherwise false
 	int ignoreNum = params->me;
@@ -3289,6 +3379,34 @@ static bool G2_RagDollSettlePositionNumeroTrois(CGhoul2Info_v& ghoul2_v, const v
 		vectoangles(animPelvisDir, animPelvisDir);
 	}
 
+	//nothing the in-solid probes look at moves until the solve, so gather them
+	//for every effector first and trace them as one batch
+	int numProbes = 0;
+	for (i = 0; i < numRags; i++)
+	{
+		boneInfo_t& bone = *ragBoneData[i];
+		SRagEffector& e = ragEffectors[i];
+
+		ragProbeIndex[i] = -1;
+		if ((bone.RagFlags & RAG_PCJ_PELVIS) ||
+			!(bone.RagFlags & RAG_EFFECTOR) ||
+			bone.hasOverGoal)
+		{
+			continue;
+		}
+
+		traceQuery_t& probe = ragProbes[numProbes];
+		VectorSet(probe.mins, -e.radius * entScale[0], -e.radius * entScale[1], -e.radius * entScale[2]);
+		VectorSet(probe.maxs, e.radius * entScale[0], e.radius * entScale[1], e.radius * entScale[2]);
+		VectorCopy(e.currentOrigin, probe.start);
+		if (!G2_RagParentOrigin(ghoul2_v[0], bone, probe.end))
+		{
+			VectorCopy(params->position, probe.end);
+		}
+		ragProbeIndex[i] = numProbes++;
+	}
+	Rag_TraceBatch(ragProbes, numProbes, ignoreNum, RAG_MASK);
+
 	for (i = 0; i < numRags; i++)
 	{
 		boneInfo_t& bone = *ragBoneData[i];
@@ -3335,56 +3453,7 @@ static bool G2_RagDollSettlePositionNumeroTrois(CGhoul2Info_v& ghoul2_v, const v
 		assert(ghoul2_v[0].mBoneCache);
 
 		//get the parent bone's position
-		hasDaddy = false;
-		if (bone.boneNumber)
-		{
-			assert(ghoul2_v[0].animModel);
-			assert(ghoul2_v[0].aHeader);
-
-			if (bone.parentBoneIndex == -1)
-			{
-				mdxaSkel_t* skel;
-				mdxaSkelOffsets_t* offsets;
-				int bParentIndex, bParentListIndex = -1;
-
-				offsets = (mdxaSkelOffsets_t*)((byte*)ghoul2_v[0].aHeader + sizeof(mdxaHeader_t));
-				skel = (mdxaSkel_t*)((byte*)ghoul2_v[0].aHeader + sizeof(mdxaHeader_t) + offsets->offsets[bone.boneNumber]);
-
-				bParentIndex = skel->parent;
-
-				while (bParentIndex > 0)
-				{ //go upward through hierarchy searching for the first parent that is a rag bone
-					skel = (mdxaSkel_t*)((byte*)ghoul2_v[0].aHeader + sizeof(mdxaHeader_t) + offsets->offsets[bParentIndex]);
-					bParentIndex = skel->parent;
-					bParentListIndex = G2_Find_Bone(ghoul2_v[0].animModel, ghoul2_v[0].mBlist, skel->name);
-
-					if (bParentListIndex != -1)
-					{
-						boneInfo_t& pbone = ghoul2_v[0].mBlist[bParentListIndex];
-						if (pbone.flags & BONE_ANGLES_RAGDOLL)
-						{ //valid rag bone
-							break;
-						}
-					}
-
-					//didn't work out, reset to -1 again
-					bParentListIndex = -1;
-				}
-
-				bone.parentBoneIndex = bParentListIndex;
-			}
-
-			if (bone.parentBoneIndex != -1)
-			{
-				boneInfo_t& pbone = ghoul2_v[0].mBlist[bone.parentBoneIndex];
-
-				if (pbone.flags & BONE_ANGLES_RAGDOLL)
-				{ //has origin calculated for us already
-					VectorCopy(ragEffectors[pbone.ragIndex].currentOrigin, parentOrigin);
-					hasDaddy = true;
-				}
-			}
-		}
+		hasDaddy = G2_RagParentOrigin(ghoul2_v[0], bone, parentOrigin);
 
 		//get the position this bone would be in if we were in the desired frame
 		hasBasePos = false;
@@ -3457,18 +3526,11 @@ static bool G2_RagDollSettlePositionNumeroTrois(CGhoul2Info_v& ghoul2_v, const v
 			hasBasePos = true;
 		}
 
-		//Are we in solid?
-		if (hasDaddy)
-		{
-			Rag_Trace(&tr, e.currentOrigin, testMins, testMaxs, parentOrigin, ignoreNum, RAG_MASK, G2_NOCOLLIDE, 0);
-			//Rag_Trace(&tr, parentOrigin, testMins, testMaxs, e.currentOrigin, ignoreNum, RAG_MASK, G2_NOCOLLIDE, 0);
-		}
-		else
-		{
-			Rag_Trace(&tr, e.currentOrigin, testMins, testMaxs, params->position, ignoreNum, RAG_MASK, G2_NOCOLLIDE, 0);
-		}
+		//Are we in solid? (traced above, from here towards the parent or the ent origin)
+		assert(ragProbeIndex[i] != -1);
+		const traceQuery_t& probe = ragProbes[ragProbeIndex[i]];
 
-		if (tr.startsolid || tr.allsolid || tr.fraction != 1.0f)
+		if (probe.startsolid || probe.allsolid || probe.fraction != 1.0f)
 		{ //currently in solid, see what we can do about it
 			vec3_t vSub;
 
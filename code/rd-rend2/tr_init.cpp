@@ -119,6 +119,9 @@ cvar_t* r_mergeLeafSurfaces;
 cvar_t* r_cameraExposure;
 
 cvar_t* r_externalGLSL;
+cvar_t* r_glslCache;
+cvar_t* r_shaderIndex;
+cvar_t* r_g2BoltCache;
 
 cvar_t* r_hdr;
 cvar_t* r_floatLightmap;
@@ -246,8 +249,10 @@ cvar_t* broadsword_extra2 = 0;
 cvar_t* broadsword_effcorr = 0;
 cvar_t* broadsword_ragtobase = 0;
 cvar_t* broadsword_dircap = 0;
+cvar_t* broadsword_ragstep = 0;
 
 cvar_t* r_marksOnTriangleMeshes;
+cvar_t* r_markBVH;
 
 cvar_t* r_aviMotionJpegQuality;
 cvar_t* r_screenshotJpegQuality;
@@ -1468,6 +1473,7 @@ static consoleCommand_t	commands[] = {
 	{ "capframes",			R_CaptureFrameData_f },
 	{ "r_weather",			R_WeatherEffect_f },
 	{ "weather",			R_SetWeatherEffect_f },
+	{ "weatherbench",		R_WeatherBench_f },
 };
 
 static const size_t numCommands = ARRAY_LEN(commands);
@@ -1528,6 +1534,9 @@ static void R_Register(void)
 	ri.Cvar_CheckRange(r_greyscale, 0, 1, qfalse);
 
 	r_externalGLSL = ri_Cvar_Get_NoComm("r_externalGLSL", "0", CVAR_LATCH, "");
+	r_glslCache = ri_Cvar_Get_NoComm("r_glslCache", "1", CVAR_ARCHIVE | CVAR_LATCH, "Disable/enable caching linked GLSL program binaries on disk");
+	r_g2BoltCache = ri_Cvar_Get_NoComm("r_g2BoltCache", "1", CVAR_ARCHIVE, "Disable/enable reusing ghoul2 bolt matrices until the skeleton changes");
+	r_shaderIndex = ri_Cvar_Get_NoComm("r_shaderIndex", "1", CVAR_ARCHIVE | CVAR_LATCH, "Disable/enable the on-disk index of shader file text");
 
 	r_hdr = ri_Cvar_Get_NoComm("r_hdr", "1", CVAR_ARCHIVE | CVAR_LATCH, "Disable/enable rendering in HDR");
 	r_floatLightmap = ri_Cvar_Get_NoComm("r_floatLightmap", "1", CVAR_ARCHIVE | CVAR_LATCH, "Disable/enable HDR lightmap support");
@@ -1669,6 +1678,7 @@ static void R_Register(void)
 	r_shadows = ri_Cvar_Get_NoComm("cg_shadows", "3", 0, "");
 
 	r_marksOnTriangleMeshes = ri_Cvar_Get_NoComm("r_marksOnTriangleMeshes", "0", CVAR_ARCHIVE, "");
+	r_markBVH = ri_Cvar_Get_NoComm("r_markBVH", "1", CVAR_CHEAT, "0 = clip every triangle, 1 = skip triangles with the surface BVH, 2 = run both and compare");
 
 	r_aviMotionJpegQuality = ri_Cvar_Get_NoComm("r_aviMotionJpegQuality", "90", CVAR_ARCHIVE, "");
 	r_screenshotJpegQuality = ri_Cvar_Get_NoComm("r_screenshotJpegQuality", "90", CVAR_ARCHIVE, "");
@@ -1700,6 +1710,7 @@ static void R_Register(void)
 	broadsword_effcorr = ri_Cvar_Get_NoComm("broadsword_effcorr", "1", CVAR_TEMP, "");
 	broadsword_ragtobase = ri_Cvar_Get_NoComm("broadsword_ragtobase", "2", CVAR_TEMP, "");
 	broadsword_dircap = ri_Cvar_Get_NoComm("broadsword_dircap", "64", CVAR_TEMP, "");
+	broadsword_ragstep = ri_Cvar_Get_NoComm("broadsword_ragstep", "16", CVAR_TEMP, "Milliseconds of ragdoll settling per solver step, 0 steps once per update");
 
 	r_com_rend2 = ri.Cvar_Get("com_rend2", "0", CVAR_ARCHIVE | CVAR_SAVEGAME);
 
@@ -2420,6 +2431,7 @@ extern "C" Q_EXPORT refexport_t * QDECL GetRefAPI(const int api_version, const r
 	re.GetWindVector = R_GetWindVector;
 	re.GetWindGusting = R_GetWindGusting;
 	re.IsOutside = R_IsOutside;
+	re.IsOutsideBatch = R_IsOutsideBatch;
 	re.IsOutsideCausingPain = R_IsOutsideCausingPain;
 	re.GetChanceOfSaberFizz = R_GetChanceOfSaberFizz;
 	re.IsShaking = R_IsShaking;
@@ -2454,6 +2466,7 @@ extern "C" Q_EXPORT refexport_t * QDECL GetRefAPI(const int api_version, const r
 	re.G2API_GetBoneAnimIndex = G2API_GetBoneAnimIndex;
 	re.G2API_GetBoneIndex = G2API_GetBoneIndex;
 	re.G2API_GetBoltMatrix = G2API_GetBoltMatrix;
+	re.G2API_GetBoltMatrices = G2API_GetBoltMatrices;
 	re.G2API_GetGhoul2ModelFlags = G2API_GetGhoul2ModelFlags;
 	re.G2API_GetGLAName = G2API_GetGLAName;
 	re.G2API_GetParentSurface = G2API_GetParentSurface;
@@ -1767,6 +1767,21 @@ qboolean G2API_GetBoltMatrix(CGhoul2Info_v& ghoul2, const int modelIndex, const
 	return qfalse;
 }
 
+// the skeleton is only rebuilt by the first lookup of a frame, so this is
+// just the single bolt version in a loop
+qboolean G2API_GetBoltMatrices(CGhoul2Info_v& ghoul2, const int modelIndex, const int numBolts, const int* bolt_indexes, mdxaBone_t* matrices, const vec3_t angles, const vec3_t position, const int aframe_num, qhandle_t* model_list, const vec3_t scale)
+{
+	qboolean all = qtrue;
+	for (int i = 0; i < numBolts; i++)
+	{
+		if (!G2API_GetBoltMatrix(ghoul2, modelIndex, bolt_indexes[i], &matrices[i], angles, position, aframe_num, model_list, scale))
+		{
+			all = qfalse;
+		}
+	}
+	return all;
+}
+
 void G2API_ListSurfaces(CGhoul2Info* ghlInfo)
 {
 	if (G2_SetupModelPointers(ghlInfo))
@@ -42,6 +42,7 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 //rww - RAGDOLL_BEGIN
 #include <cfloat>
 #include "../ghoul2/ghoul2_gore.h"
+#include "../rd-common/tr_ragstep.h"
 //rww - RAGDOLL_END
 
 extern cvar_t* r_Ghoul2BlendMultiplier;
@@ -1072,6 +1073,8 @@ extern cvar_t* broadsword_ragtobase;
 
 extern cvar_t* broadsword_dircap;
 
+extern cvar_t* broadsword_ragstep;
+
 extern cvar_t* broadsword_extra1;
 extern cvar_t* broadsword_extra2;
 
@@ -1112,6 +1115,8 @@ static bool haveDesiredPelvisOffset = false;
 static vec3_t desiredPelvisOffset; // this is for the root
 static float ragOriginChange = 0.0f;
 static vec3_t ragOriginChangeDir;
+static traceQuery_t ragProbes[MAX_BONES_RAG]; // in-solid probes for one settle pass, traced together
+static int ragProbeIndex[MAX_BONES_RAG]; // ragProbes entry for each rag bone, -1 if it doesn't probe
 //debug
 //static vec3_t			handPos={0,0,0};
 //static vec3_t			handPos2={0,0,0};
@@ -2440,8 +2445,13 @@ static void G2_RagDoll(CGhoul2Info_v& ghoul2_v, const int g2_index, CRagDollUpda
 			}
 		}
 	}
+	//step on a fixed clock so the cost doesn't follow the framerate, one step is the
+	//amount of settling a single call used to do at 60fps
+	const int steps = G2_RagStepCount(ghoul2.mRagStepTime, curTime,
+		broadsword_ragstep ? broadsword_ragstep->integer : 0);
+
 	//int iters=(ragState==ERS_DYNAMIC)?2:1;
-	int iters = ragState == ERS_DYNAMIC ? 4 : 2;
+	int iters = (ragState == ERS_DYNAMIC ? 4 : 2) * steps;
 	/*
 		bool kicked=false;
 		if (ragOriginChangeDir[2]<-100.0f)
@@ -2451,7 +2461,9 @@ static void G2_RagDoll(CGhoul2Info_v& ghoul2_v, const int g2_index, CRagDollUpda
 			iters*=5; //rww - changed to this.. it was getting up to around 600 traces at times before (which is insane)
 		}
 	*/
-	if (iters)
+	//the solver arrays are shared by every ragdoll, so even with no step due they have
+	//to be set up for this one before its position is read back out below
+	if (G2_RagNeedsSetup(iters, params->me != ENTITYNUM_NONE))
 	{
 		constexpr bool resetOrigin = false;
 		if (!G2_RagDollSetup(ghoul2, frameNum, resetOrigin, d_pos, anyRendered))
@@ -2625,6 +2637,27 @@ static void Rag_Trace(trace_t* results, const vec3_t start, const vec3_t mins, c
 #endif
 }
 
+static void Rag_TraceBatch(traceQuery_t* queries, const int count, const int passEntityNum, const int contentmask)
+{
+#ifdef _DEBUG
+	const int rag_pre_trace = ri.Milliseconds();
+#endif
+	ri.SV_TraceBatch(queries, count, passEntityNum, contentmask);
+#ifdef _DEBUG
+	const int rag_post_trace = ri.Milliseconds();
+
+	ragTraceTime += rag_post_trace - rag_pre_trace;
+	for (int i = 0; i < count; i++)
+	{
+		if (queries[i].startsolid)
+		{
+			ragSSCount++;
+		}
+	}
+	ragTraceCount += count;
+#endif
+}
+
 //run advanced physics on each bone indivudually
 //an adaption of my "exphys" custom game physics model
 #define MAX_GRAVITY_PULL 256//512
@@ -3238,6 +3271,65 @@ static void G2_RagGetPelvisLumbarOffsets(CGhoul2Info& ghoul2, CRagDollUpdatePara
 	G2API_GiveMeVectorFromMatrix(final, POSITIVE_X, dir);
 }
 
+//finds the closest rag bone above this one and gives back its current origin
+static bool G2_RagParentOrigin(CGhoul2Info& ghoul2, boneInfo_t& bone, vec3_t parent_origin)
+{
+	if (!bone.boneNumber)
+	{
+		return false;
+	}
+	assert(ghoul2.animModel);
+	assert(ghoul2.aHeader);
+
+	if (bone.parentBoneIndex == -1)
+	{
+		int b_parent_list_index = -1;
+
+		auto offsets = reinterpret_cast<mdxaSkelOffsets_t*>((byte*)ghoul2.aHeader + sizeof(mdxaHeader_t));
+		auto skel = reinterpret_cast<mdxaSkel_t*>((byte*)ghoul2.aHeader + sizeof(mdxaHeader_t) + offsets->offsets[bone.
+			boneNumber]);
+
+		int b_parent_index = skel->parent;
+
+		while (b_parent_index > 0)
+		{
+			//go upward through hierarchy searching for the first parent that is a rag bone
+			skel = reinterpret_cast<mdxaSkel_t*>((byte*)ghoul2.aHeader + sizeof(mdxaHeader_t) + offsets->offsets[
+				b_parent_index]);
+			b_parent_index = skel->parent;
+			b_parent_list_index = G2_Find_Bone(&ghoul2, ghoul2.mBlist, skel->name);
+
+			if (b_parent_list_index != -1)
+			{
+				const boneInfo_t& pbone = ghoul2.mBlist[b_parent_list_index];
+				if (pbone.flags & BONE_ANGLES_RAGDOLL)
+				{
+					//valid rag bone
+					break;
+				}
+			}
+
+			//didn't work out, reset to -1 again
+			b_parent_list_index = -1;
+		}
+
+		bone.parentBoneIndex = b_parent_list_index;
+	}
+
+	if (bone.parentBoneIndex != -1)
+	{
+		const boneInfo_t& pbone = ghoul2.mBlist[bone.parentBoneIndex];
+
+		if (pbone.flags & BONE_ANGLES_RAGDOLL)
+		{
+			//has origin calculated for us already
+			VectorCopy(ragEffectors[pbone.ragIndex].currentOrigin, parent_origin);
+			return true;
+		}
+	}
+	return false;
+}
+
 static bool G2_RagDollSettlePositionNumeroTrois(CGhoul2Info_v& ghoul2_v, CRagDollUpdateParams* params, const int curTime)
 {
 	//now returns true if any bone was in solid, otherwise false
@@ -3303,6 +3395,34 @@ static bool G2_RagDollSettlePositionNumeroTrois(CGhoul2Info_v& ghoul2_v, CRagDol
 		vectoangles(anim_pelvis_dir, anim_pelvis_dir);
 	}
 
+	//nothing the in-solid probes look at moves until the solve, so gather them
+	//for every effector first and trace them as one batch
+	int num_probes = 0;
+	for (i = 0; i < numRags; i++)
+	{
+		boneInfo_t& bone = *ragBoneData[i];
+		const SRagEffector& e = ragEffectors[i];
+
+		ragProbeIndex[i] = -1;
+		if (bone.RagFlags & RAG_PCJ_PELVIS ||
+			!(bone.RagFlags & RAG_EFFECTOR) ||
+			bone.hasOverGoal)
+		{
+			continue;
+		}
+
+		traceQuery_t& probe = ragProbes[num_probes];
+		VectorSet(probe.mins, -e.radius * entScale[0], -e.radius * entScale[1], -e.radius * entScale[2]);
+		VectorSet(probe.maxs, e.radius * entScale[0], e.radius * entScale[1], e.radius * entScale[2]);
+		VectorCopy(e.currentOrigin, probe.start);
+		if (!G2_RagParentOrigin(ghoul2_v[0], bone, probe.end))
+		{
+			VectorCopy(params->position, probe.end);
+		}
+		ragProbeIndex[i] = num_probes++;
+	}
+	Rag_TraceBatch(ragProbes, num_probes, ignore_num, RAG_MASK);
+
 	for (i = 0; i < numRags; i++)
 	{
 		static vec3_t parent_origin;
@@ -3356,59 +3476,7 @@ static bool G2_RagDollSettlePositionNumeroTrois(CGhoul2Info_v& ghoul2_v, CRagDol
 		assert(ghoul2_v[0].mBoneCache);
 
 		//get the parent bone's position
-		has_daddy = false;
-		if (bone.boneNumber)
-		{
-			assert(ghoul2_v[0].animModel);
-			assert(ghoul2_v[0].aHeader);
-
-			if (bone.parentBoneIndex == -1)
-			{
-				int b_parent_list_index = -1;
-
-				auto offsets = reinterpret_cast<mdxaSkelOffsets_t*>((byte*)ghoul2_v[0].aHeader + sizeof(mdxaHeader_t));
-				auto skel = reinterpret_cast<mdxaSkel_t*>((byte*)ghoul2_v[0].aHeader + sizeof(mdxaHeader_t) + offsets->offsets[bone.
-					boneNumber]);
-
-				int b_parent_index = skel->parent;
-
-				while (b_parent_index > 0)
-				{
-					//go upward through hierarchy searching for the first parent that is a rag bone
-					skel = reinterpret_cast<mdxaSkel_t*>((byte*)ghoul2_v[0].aHeader + sizeof(mdxaHeader_t) + offsets->offsets[
-						b_parent_index]);
-					b_parent_index = skel->parent;
-					b_parent_list_index = G2_Find_Bone(&ghoul2_v[0], ghoul2_v[0].mBlist, skel->name);
-
-					if (b_parent_list_index != -1)
-					{
-						const boneInfo_t& pbone = ghoul2_v[0].mBlist[b_parent_list_index];
-						if (pbone.flags & BONE_ANGLES_RAGDOLL)
-						{
-							//valid rag bone
-							break;
-						}
-					}
-
-					//didn't work out, reset to -1 again
-					b_parent_list_index = -1;
-				}
-
-				bone.parentBoneIndex = b_parent_list_index;
-			}
-
-			if (bone.parentBoneIndex != -1)
-			{
-				const boneInfo_t& pbone = ghoul2_v[0].mBlist[bone.parentBoneIndex];
-
-				if (pbone.flags & BONE_ANGLES_RAGDOLL)
-				{
-					//has origin calculated for us already
-					VectorCopy(ragEffectors[pbone.ragIndex].currentOrigin, parent_origin);
-					has_daddy = true;
-				}
-			}
-		}
+		has_daddy = G2_RagParentOrigin(ghoul2_v[0], bone, parent_origin);
 
 		//get the position this bone would be in if we were in the desired frame
 		has_base_pos = false;
@@ -3488,18 +3556,11 @@ static bool G2_RagDollSettlePositionNumeroTrois(CGhoul2Info_v& ghoul2_v, CRagDol
 			has_base_pos = true;
 		}
 
-		//Are we in solid?
-		if (has_daddy)
-		{
-			Rag_Trace(&tr, e.currentOrigin, testMins, testMaxs, parent_origin, ignore_num, RAG_MASK, G2_NOCOLLIDE, 0);
-			//Rag_Trace(&tr, parentOrigin, testMins, testMaxs, e.currentOrigin, ignoreNum, RAG_MASK, G2_NOCOLLIDE, 0);
-		}
-		else
-		{
-			Rag_Trace(&tr, e.currentOrigin, testMins, testMaxs, params->position, ignore_num, RAG_MASK, G2_NOCOLLIDE, 0);
-		}
+		//Are we in solid? (traced above, from here towards the parent or the ent origin)
+		assert(ragProbeIndex[i] != -1);
+		const traceQuery_t& probe = ragProbes[ragProbeIndex[i]];
 
-		if (tr.startsolid || tr.allsolid || tr.fraction != 1.0f)
+		if (probe.startsolid || probe.allsolid || probe.fraction != 1.0f)
 		{
 			//currently in solid, see what we can do about it
 			start_solid = true;
@@ -468,7 +468,7 @@ private:
 		////////////////////////////////////////////////////////////////////////////////////
 		// Convert To Cell
 		////////////////////////////////////////////////////////////////////////////////////
-		void	ConvertToCell(const CVec3& pos, int& x, int& y, int& z, int& bit)
+		void	ConvertToCell(const CVec3& pos, int& x, int& y, int& z, int& bit) const
 		{
 			x = static_cast<int>(pos[0] / POINTCACHE_CELL_SIZE - mSize.mMins[0]);
 			y = static_cast<int>(pos[1] / POINTCACHE_CELL_SIZE - mSize.mMins[1]);
@@ -798,7 +798,7 @@ public:
 		}
 		for (int zone = 0; zone < mWeatherZones.size(); zone++)
 		{
-			SWeatherZone	wz = mWeatherZones[zone];
+			const SWeatherZone& wz = mWeatherZones[zone];
 			if (wz.mExtents.In(pos))
 			{
 				int		bit, x, y, z;
@@ -809,6 +809,48 @@ public:
 		return !SWeatherZone::mMarkedOutside;
 	}
 
+	////////////////////////////////////////////////////////////////////////////////////
+	// PointsOutside - Test a batch of points, starting each search at the last zone hit
+	////////////////////////////////////////////////////////////////////////////////////
+	void	PointsOutside(const int numPoints, vec3_t* points, bool* outside)
+	{
+		int lastZone = -1;
+
+		for (int i = 0; i < numPoints; i++)
+		{
+			const CVec3 pos(points[i]);
+
+			if (!mCacheInit)
+			{
+				outside[i] = ContentsOutside(ri.CM_PointContents(points[i], 0));
+				continue;
+			}
+
+			if (lastZone == -1 || !mWeatherZones[lastZone].mExtents.In(pos))
+			{
+				lastZone = -1;
+				for (int zone = 0; zone < mWeatherZones.size(); zone++)
+				{
+					if (mWeatherZones[zone].mExtents.In(pos))
+					{
+						lastZone = zone;
+						break;
+					}
+				}
+			}
+
+			if (lastZone == -1)
+			{
+				outside[i] = !SWeatherZone::mMarkedOutside;
+				continue;
+			}
+
+			int		bit, x, y, z;
+			mWeatherZones[lastZone].ConvertToCell(pos, x, y, z, bit);
+			outside[i] = mWeatherZones[lastZone].CellOutside(x, y, z, bit);
+		}
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////
 	// PointOutside - Test to see if a given bounded plane is outside
 	////////////////////////////////////////////////////////////////////////////////////
@@ -816,7 +858,7 @@ public:
 	{
 		for (int zone = 0; zone < mWeatherZones.size(); zone++)
 		{
-			SWeatherZone	wz = mWeatherZones[zone];
+			const SWeatherZone& wz = mWeatherZones[zone];
 			if (wz.mExtents.In(pos))
 			{
 				int		bit, x, y, z;
@@ -865,6 +907,11 @@ bool R_IsOutside(vec3_t pos)
 	return mOutside.PointOutside(pos);
 }
 
+void R_IsOutsideBatch(const int numPoints, vec3_t* points, bool* outside)
+{
+	mOutside.PointsOutside(numPoints, points, outside);
+}
+
 bool R_IsShaking(vec3_t pos)
 {
 	return mOutside.mOutsideShake && mOutside.PointOutside(pos);
@@ -54,6 +54,7 @@ bool R_GetWindVector(vec3_t windVector, vec3_t atpoint);
 bool R_GetWindSpeed(float& windSpeed, vec3_t atpoint);
 bool R_GetWindGusting(vec3_t atpoint);
 bool R_IsOutside(vec3_t pos);
+void R_IsOutsideBatch(int numPoints, vec3_t* points, bool* outside);
 float R_IsOutsideCausingPain(vec3_t pos);
 float R_GetChanceOfSaberFizz();
 bool R_IsShaking(vec3_t pos);
@@ -997,18 +997,17 @@ static const void* RB_SetColor(const void* data) {
 
 /*
 =============
-RB_StretchPic
+RB_BeginStretchPic
+
+Common setup for RB_StretchPic and RB_StretchPicBatch
 =============
 */
-static const void* RB_StretchPic(const void* data)
+static void RB_BeginStretchPic(shader_t* shader)
 {
-	const auto cmd = static_cast<const stretchPicCommand_t*>(data);
-
 	if (!backEnd.projection2D) {
 		RB_SetGL2D();
 	}
 
-	shader_t* shader = cmd->shader;
 	if (shader != tess.shader) {
 		if (tess.numIndexes) {
 			RB_EndSurface();
@@ -1016,7 +1015,15 @@ static const void* RB_StretchPic(const void* data)
 		backEnd.currentEntity = &backEnd.entity2D;
 		RB_BeginSurface(shader, 0);
 	}
+}
 
+/*
+=============
+RB_AddStretchPicQuad
+=============
+*/
+static void RB_AddStretchPicQuad(const float x, const float y, const float w, const float h, const float s1, const float t1, const float s2, const float t2, const byte* color)
+{
 	RB_CHECKOVERFLOW(4, 6);
 	const int numVerts = tess.numVertexes;
 	const int numIndexes = tess.numIndexes;
@@ -1031,43 +1038,81 @@ static const void* RB_StretchPic(const void* data)
 	tess.indexes[numIndexes + 4] = numVerts + 0;
 	tess.indexes[numIndexes + 5] = numVerts + 1;
 
-	const byteAlias_t* ba_source = reinterpret_cast<byteAlias_t*>(&backEnd.color2D);
+	const byteAlias_t* ba_source = reinterpret_cast<const byteAlias_t*>(color);
 	auto ba_dest = reinterpret_cast<byteAlias_t*>(&tess.vertexColors[numVerts + 0]); ba_dest->ui = ba_source->ui;
 	ba_dest = reinterpret_cast<byteAlias_t*>(&tess.vertexColors[numVerts + 1]); ba_dest->ui = ba_source->ui;
 	ba_dest = reinterpret_cast<byteAlias_t*>(&tess.vertexColors[numVerts + 2]); ba_dest->ui = ba_source->ui;
 	ba_dest = reinterpret_cast<byteAlias_t*>(&tess.vertexColors[numVerts + 3]); ba_dest->ui = ba_source->ui;
 
-	tess.xyz[numVerts][0] = cmd->x;
-	tess.xyz[numVerts][1] = cmd->y;
+	tess.xyz[numVerts][0] = x;
+	tess.xyz[numVerts][1] = y;
 	tess.xyz[numVerts][2] = 0;
 
-	tess.texCoords[numVerts][0][0] = cmd->s1;
-	tess.texCoords[numVerts][0][1] = cmd->t1;
+	tess.texCoords[numVerts][0][0] = s1;
+	tess.texCoords[numVerts][0][1] = t1;
 
-	tess.xyz[numVerts + 1][0] = cmd->x + cmd->w;
-	tess.xyz[numVerts + 1][1] = cmd->y;
+	tess.xyz[numVerts + 1][0] = x + w;
+	tess.xyz[numVerts + 1][1] = y;
 	tess.xyz[numVerts + 1][2] = 0;
 
-	tess.texCoords[numVerts + 1][0][0] = cmd->s2;
-	tess.texCoords[numVerts + 1][0][1] = cmd->t1;
+	tess.texCoords[numVerts + 1][0][0] = s2;
+	tess.texCoords[numVerts + 1][0][1] = t1;
 
-	tess.xyz[numVerts + 2][0] = cmd->x + cmd->w;
-	tess.xyz[numVerts + 2][1] = cmd->y + cmd->h;
+	tess.xyz[numVerts + 2][0] = x + w;
+	tess.xyz[numVerts + 2][1] = y + h;
 	tess.xyz[numVerts + 2][2] = 0;
 
-	tess.texCoords[numVerts + 2][0][0] = cmd->s2;
-	tess.texCoords[numVerts + 2][0][1] = cmd->t2;
+	tess.texCoords[numVerts + 2][0][0] = s2;
+	tess.texCoords[numVerts + 2][0][1] = t2;
 
-	tess.xyz[numVerts + 3][0] = cmd->x;
-	tess.xyz[numVerts + 3][1] = cmd->y + cmd->h;
+	tess.xyz[numVerts + 3][0] = x;
+	tess.xyz[numVerts + 3][1] = y + h;
 	tess.xyz[numVerts + 3][2] = 0;
 
-	tess.texCoords[numVerts + 3][0][0] = cmd->s1;
-	tess.texCoords[numVerts + 3][0][1] = cmd->t2;
+	tess.texCoords[numVerts + 3][0][0] = s1;
+	tess.texCoords[numVerts + 3][0][1] = t2;
+}
+
+/*
+=============
+RB_StretchPic
+=============
+*/
+static const void* RB_StretchPic(const void* data)
+{
+	const auto cmd = static_cast<const stretchPicCommand_t*>(data);
+
+	RB_BeginStretchPic(cmd->shader);
+	RB_AddStretchPicQuad(cmd->x, cmd->y, cmd->w, cmd->h, cmd->s1, cmd->t1, cmd->s2, cmd->t2, backEnd.color2D);
 
 	return cmd + 1;
 }
 
+/*
+=============
+RB_StretchPicBatch
+=============
+*/
+static const void* RB_StretchPicBatch(const void* data)
+{
+	const auto cmd = static_cast<const stretchPicBatchCommand_t*>(data);
+	const auto quads = reinterpret_cast<const stretchPicQuad_t*>(cmd + 1);
+
+	RB_BeginStretchPic(cmd->shader);
+	for (int i = 0; i < cmd->numQuads; i++)
+	{
+		const stretchPicQuad_t& quad = quads[i];
+		byteAlias_t color;
+		color.b[0] = quad.color[0] * 255;	// same conversion as RB_SetColor
+		color.b[1] = quad.color[1] * 255;
+		color.b[2] = quad.color[2] * 255;
+		color.b[3] = quad.color[3] * 255;
+		RB_AddStretchPicQuad(quad.x, quad.y, quad.w, quad.h, quad.s1, quad.t1, quad.s2, quad.t2, color.b);
+	}
+
+	return quads + cmd->numQuads;
+}
+
 /*
 =============
 RB_RotatePic
@@ -1573,6 +1618,9 @@ void RB_ExecuteRenderCommands(const void* data)
 		case RC_STRETCH_PIC:
 			data = RB_StretchPic(data);
 			break;
+		case RC_STRETCH_PIC_BATCH:
+			data = RB_StretchPicBatch(data);
+			break;
 		case RC_ROTATE_PIC:
 			data = RB_RotatePic(data);
 			break;
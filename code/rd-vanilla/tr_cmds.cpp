@@ -113,7 +113,7 @@ static void R_IssueRenderCommands(const qboolean runPerformanceCounters)
 	}
 
 	// actually start the commands going
-	if (!r_skipBackEnd->integer) {
+	if (!r_skipBackEnd->integer && !r_headless->integer) {
 		// let it start on the new batch
 		RB_ExecuteRenderCommands(cmd_list->cmds);
 	}
@@ -244,6 +244,28 @@ void RE_StretchPic(const float x, const float y, const float w, const float h, c
 	cmd->t2 = t2;
 }
 
+/*
+=============
+RE_StretchPicBatch
+
+Any number of quads sharing one shader as a single command, each with its own colour
+=============
+*/
+void RE_StretchPicBatch(const stretchPicQuad_t* quads, const int numQuads, const qhandle_t hShader)
+{
+	if (!tr.registered || numQuads <= 0) {
+		return;
+	}
+	stretchPicBatchCommand_t* cmd = static_cast<stretchPicBatchCommand_t*>(R_GetCommandBuffer(sizeof * cmd + numQuads * sizeof(stretchPicQuad_t)));
+	if (!cmd) {
+		return;
+	}
+	cmd->commandId = RC_STRETCH_PIC_BATCH;
+	cmd->shader = R_GetShaderByHandle(hShader);
+	cmd->numQuads = numQuads;
+	memcpy(cmd + 1, quads, numQuads * sizeof(stretchPicQuad_t));
+}
+
 /*
 =============
 RE_RotatePic
@@ -0,0 +1,153 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// tr_g2skin.h -- Ghoul2 CPU skinning kernels
+//
+// Vertices are unpacked once per mesh surface into g2SkinVert_t, with the
+// bone weights already expanded the way RB_SurfaceGhoul uses them (the last
+// weight is whatever is left of 1.0).  Each bone matrix is the 3x4 row-major
+// mdxaBone_t layout, passed as 12 contiguous floats.
+//
+// The records sit in std::vector storage, which makes no promise beyond the
+// alignment of float, so the kernels only use unaligned loads.
+//
+// Kept free of renderer headers so the unit tests can check the SIMD kernel
+// against the scalar one.
+
+#pragma once
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define G2_SIMD_SKINNING
+#include <emmintrin.h>
+#endif
+
+struct g2SkinVert_t
+{
+	float xyz[4]; // w is 1
+	float normal[4]; // w is 0
+	float weights[4];
+	unsigned char bones[4]; // index into the surface's bone references
+	int numWeights;
+	int pad[2];
+};
+
+inline void G2Skin_SetWeights(g2SkinVert_t& vert, const int numWeights, const float* packedWeights)
+{
+	vert.numWeights = numWeights;
+	if (numWeights == 1)
+	{
+		vert.weights[0] = 1.0f;
+		return;
+	}
+
+	float total = 0.0f;
+	for (int i = 0; i < numWeights - 1; i++)
+	{
+		vert.weights[i] = packedWeights[i];
+		total += packedWeights[i];
+	}
+	vert.weights[numWeights - 1] = 1.0f - total;
+}
+
+/*
+==============
+G2Skin_VertScalar
+
+Same arithmetic as the scalar loop in RB_SurfaceGhoul: the normal only
+follows the first bone, the position is the weighted sum over all of them.
+==============
+*/
+inline void G2Skin_VertScalar(const g2SkinVert_t& vert, const float* const* bones, float* xyzOut, float* normalOut)
+{
+	const float* m = bones[vert.bones[0]];
+	for (int r = 0; r < 3; r++)
+	{
+		normalOut[r] = m[r * 4 + 0] * vert.normal[0] + m[r * 4 + 1] * vert.normal[1] + m[r * 4 + 2] * vert.normal[2];
+		xyzOut[r] = 0.0f;
+	}
+
+	for (int i = 0; i < vert.numWeights; i++)
+	{
+		m = bones[vert.bones[i]];
+		for (int r = 0; r < 3; r++)
+		{
+			xyzOut[r] += vert.weights[i] * (m[r * 4 + 0] * vert.xyz[0] + m[r * 4 + 1] * vert.xyz[1]
+				+ m[r * 4 + 2] * vert.xyz[2] + m[r * 4 + 3]);
+		}
+	}
+}
+
+#ifdef G2_SIMD_SKINNING
+// rows times a column vector, result in x,y,z of the return value
+inline __m128 G2Skin_Transform(const __m128 row0, const __m128 row1, const __m128 row2, const __m128 v)
+{
+	__m128 a = _mm_mul_ps(row0, v);
+	__m128 b = _mm_mul_ps(row1, v);
+	__m128 c = _mm_mul_ps(row2, v);
+	__m128 d = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS(a, b, c, d);
+	return _mm_add_ps(_mm_add_ps(a, b), _mm_add_ps(c, d));
+}
+
+inline void G2Skin_Store3(const __m128 v, float* out)
+{
+	alignas(16) float tmp[4];
+	_mm_store_ps(tmp, v);
+	out[0] = tmp[0];
+	out[1] = tmp[1];
+	out[2] = tmp[2];
+}
+
+/*
+==============
+G2Skin_VertSIMD
+
+Blends the bone matrices a row at a time and transforms once, which is the
+same sum as transforming by each bone and weighting the results.
+==============
+*/
+inline void G2Skin_VertSIMD(const g2SkinVert_t& vert, const float* const* bones, float* xyzOut, float* normalOut)
+{
+	const float* m = bones[vert.bones[0]];
+	__m128 row0 = _mm_loadu_ps(m);
+	__m128 row1 = _mm_loadu_ps(m + 4);
+	__m128 row2 = _mm_loadu_ps(m + 8);
+
+	G2Skin_Store3(G2Skin_Transform(row0, row1, row2, _mm_loadu_ps(vert.normal)), normalOut);
+
+	if (vert.numWeights > 1)
+	{
+		__m128 w = _mm_set1_ps(vert.weights[0]);
+		row0 = _mm_mul_ps(row0, w);
+		row1 = _mm_mul_ps(row1, w);
+		row2 = _mm_mul_ps(row2, w);
+		for (int i = 1; i < vert.numWeights; i++)
+		{
+			m = bones[vert.bones[i]];
+			w = _mm_set1_ps(vert.weights[i]);
+			row0 = _mm_add_ps(row0, _mm_mul_ps(_mm_loadu_ps(m), w));
+			row1 = _mm_add_ps(row1, _mm_mul_ps(_mm_loadu_ps(m + 4), w));
+			row2 = _mm_add_ps(row2, _mm_mul_ps(_mm_loadu_ps(m + 8), w));
+		}
+	}
+
+	G2Skin_Store3(G2Skin_Transform(row0, row1, row2, _mm_loadu_ps(vert.xyz)), xyzOut);
+}
+#endif // G2_SIMD_SKINNING
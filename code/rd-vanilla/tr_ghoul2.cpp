@@ -43,6 +43,11 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #include "../ghoul2/ghoul2_gore.h"
 #endif
 
+#include "tr_g2skin.h"
+
+#include <unordered_map>
+#include <vector>
+
 #define	LL(x) x=LittleLong(x)
 #define	LS(x) x=LittleShort(x)
 #define	LF(x) x=LittleFloat(x)
@@ -79,6 +84,7 @@ extern	cvar_t* r_Ghoul2AnimSmooth;
 extern	cvar_t* r_Ghoul2NoLerp;
 extern	cvar_t* r_Ghoul2NoBlend;
 extern	cvar_t* r_Ghoul2UnSqashAfterSmooth;
+extern	cvar_t* r_G2SimdSkinning;
 
 bool HackadelicOnClient = false; // means this is a render traversal
 
@@ -2664,6 +2670,188 @@ void G2_ConstructGhoulSkeleton(CGhoul2Info_v& ghoul2, const int frameNum, const
 	}
 }
 
+/*
+=============================================================================
+
+SIMD SKINNING
+
+The packed mdxmVertex_t bone indices and weights are unpacked once per mesh
+surface into g2SkinVert_t, so the per-frame loop only has to fetch the bone
+matrices and run the kernel from tr_g2skin.h.  The unpacked copies live until
+the model data they were built from is freed.
+
+=============================================================================
+*/
+
+static constexpr int MAX_G2_SKIN_BONEREFS = 1 << iG2_BITS_PER_BONEREF;
+
+using g2SkinVerts_t = std::vector<g2SkinVert_t>;
+static std::unordered_map<const mdxmSurface_t*, g2SkinVerts_t> g2SkinCache;
+
+void R_G2_ClearSkinCache()
+{
+	g2SkinCache.clear();
+}
+
+static const g2SkinVerts_t& R_G2_GetSkinVerts(const mdxmSurface_t* surface)
+{
+	g2SkinVerts_t& verts = g2SkinCache[surface];
+	if (static_cast<int>(verts.size()) == surface->numVerts)
+	{
+		return verts;
+	}
+
+	const mdxmVertex_t* v = reinterpret_cast<const mdxmVertex_t*>(reinterpret_cast<const byte*>(surface) + surface->ofsVerts);
+	verts.resize(surface->numVerts);
+	for (int j = 0; j < surface->numVerts; j++, v++)
+	{
+		g2SkinVert_t& out = verts[j];
+		const int iNumWeights = G2_GetVertWeights(v);
+		float weights[iMAX_G2_BONEWEIGHTS_PER_VERT];
+
+		memset(&out, 0, sizeof(out));
+		VectorCopy(v->vertCoords, out.xyz);
+		out.xyz[3] = 1.0f;
+		VectorCopy(v->normal, out.normal);
+		for (int k = 0; k < iNumWeights; k++)
+		{
+			out.bones[k] = static_cast<unsigned char>(G2_GetVertBoneIndex(v, k));
+			weights[k] = G2_GetVertBoneWeightNotSlow(v, k);
+		}
+		G2Skin_SetWeights(out, iNumWeights, weights);
+	}
+	return verts;
+}
+
+/*
+==============
+R_G2_SkinSurface
+
+Returns false if the surface has to go through the scalar loop instead.
+==============
+*/
+static bool R_G2_SkinSurface(const mdxmSurface_t* surface, CBoneCache* bones, int baseVertex)
+{
+#ifdef G2_SIMD_SKINNING
+	if (surface->numBoneReferences > MAX_G2_SKIN_BONEREFS)
+	{
+		return false;
+	}
+
+	const int* piBoneReferences = reinterpret_cast<const int*>(reinterpret_cast<const byte*>(surface) + surface->ofsBoneReferences);
+	const float* boneMats[MAX_G2_SKIN_BONEREFS];
+	for (int i = 0; i < surface->numBoneReferences; i++)
+	{
+#ifdef JK2_MODE
+		boneMats[i] = &bones->Eval(piBoneReferences[i]).matrix[0][0];
+#else
+		boneMats[i] = &bones->EvalRender(piBoneReferences[i]).matrix[0][0];
+#endif // JK2_MODE
+	}
+
+	const g2SkinVerts_t& verts = R_G2_GetSkinVerts(surface);
+	const mdxmVertex_t* v = reinterpret_cast<const mdxmVertex_t*>(reinterpret_cast<const byte*>(surface) + surface->ofsVerts);
+	const mdxmVertexTexCoord_t* pTexCoords = reinterpret_cast<const mdxmVertexTexCoord_t*>(&v[surface->numVerts]);
+
+	for (int j = 0; j < surface->numVerts; j++, baseVertex++)
+	{
+		G2Skin_VertSIMD(verts[j], boneMats, tess.xyz[baseVertex], tess.normal[baseVertex]);
+		tess.texCoords[baseVertex][0][0] = pTexCoords[j].texCoords[0];
+		tess.texCoords[baseVertex][0][1] = pTexCoords[j].texCoords[1];
+	}
+	return true;
+#else
+	return false;
+#endif // G2_SIMD_SKINNING
+}
+
+/*
+==============
+R_G2SkinBench_f
+
+Runs both kernels over every surface in the skin cache against the same
+made-up bone set, so load a level with some characters in view first.
+==============
+*/
+void R_G2SkinBench_f()
+{
+	const int iterations = ri.Cmd_Argc() > 1 ? atoi(ri.Cmd_Argv(1)) : 100;
+
+	if (g2SkinCache.empty())
+	{
+		ri.Printf(PRINT_ALL, "g2skinbench: no skinned surfaces cached yet\n");
+		return;
+	}
+
+	mdxaBone_t fakeBones[MAX_G2_SKIN_BONEREFS];
+	const float* boneMats[MAX_G2_SKIN_BONEREFS];
+	for (int i = 0; i < MAX_G2_SKIN_BONEREFS; i++)
+	{
+		vec3_t angles = { i * 7.0f, i * 13.0f, i * 3.0f };
+		matrix3_t axis;
+		AnglesToAxis(angles, axis);
+		for (int r = 0; r < 3; r++)
+		{
+			VectorCopy(axis[r], fakeBones[i].matrix[r]);
+			fakeBones[i].matrix[r][3] = i * 0.5f - r;
+		}
+		boneMats[i] = &fakeBones[i].matrix[0][0];
+	}
+
+	int numVerts = 0;
+	float xyz[4], normal[4];
+	float xyz2[4], normal2[4];
+	float maxError = 0.0f;
+
+	int start = ri.Milliseconds();
+	for (int n = 0; n < iterations; n++)
+	{
+		for (const auto& it : g2SkinCache)
+		{
+			for (const g2SkinVert_t& vert : it.second)
+			{
+				G2Skin_VertScalar(vert, boneMats, xyz, normal);
+			}
+		}
+	}
+	const int scalarMsec = ri.Milliseconds() - start;
+
+#ifdef G2_SIMD_SKINNING
+	start = ri.Milliseconds();
+	for (int n = 0; n < iterations; n++)
+	{
+		for (const auto& it : g2SkinCache)
+		{
+			for (const g2SkinVert_t& vert : it.second)
+			{
+				G2Skin_VertSIMD(vert, boneMats, xyz, normal);
+			}
+		}
+	}
+	const int simdMsec = ri.Milliseconds() - start;
+
+	for (const auto& it : g2SkinCache)
+	{
+		for (const g2SkinVert_t& vert : it.second)
+		{
+			G2Skin_VertScalar(vert, boneMats, xyz, normal);
+			G2Skin_VertSIMD(vert, boneMats, xyz2, normal2);
+			for (int r = 0; r < 3; r++)
+			{
+				maxError = Q_max(maxError, fabsf(xyz[r] - xyz2[r]));
+				maxError = Q_max(maxError, fabsf(normal[r] - normal2[r]));
+			}
+			numVerts++;
+		}
+	}
+
+	ri.Printf(PRINT_ALL, "g2skinbench: %i surfaces, %i verts, %i iterations\n", static_cast<int>(g2SkinCache.size()), numVerts, iterations);
+	ri.Printf(PRINT_ALL, "  scalar %i msec, simd %i msec, max difference %f\n", scalarMsec, simdMsec, maxError);
+#else
+	ri.Printf(PRINT_ALL, "g2skinbench: scalar %i msec, no SIMD kernel in this build\n", scalarMsec);
+#endif // G2_SIMD_SKINNING
+}
+
 /*
 ==============
 RB_SurfaceGhoul
@@ -2883,6 +3071,8 @@ void RB_SurfaceGhoul(CRenderableSurface* surf)
 	else
 	{
 #endif
+	if (!r_G2SimdSkinning->integer || !R_G2_SkinSurface(surface, bones, baseVertex))
+	{
 		float fTotalWeight;
 		float fBoneWeight;
 		float t1;
@@ -2974,6 +3164,7 @@ void RB_SurfaceGhoul(CRenderableSurface* surf)
 			tess.texCoords[baseVertex][0][0] = pTexCoords[j].texCoords[0];
 			tess.texCoords[baseVertex][0][1] = pTexCoords[j].texCoords[1];
 		}
+	}
 #if 0
 	}
 #endif
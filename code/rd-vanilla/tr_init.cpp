@@ -160,6 +160,9 @@ cvar_t* r_Ghoul2NoLerp;
 cvar_t* r_Ghoul2NoBlend;
 cvar_t* r_Ghoul2BlendMultiplier = nullptr;
 cvar_t* r_Ghoul2UnSqashAfterSmooth;
+cvar_t* r_G2SimdSkinning;
+cvar_t* r_simdShadeCalc;
+cvar_t* r_headless;
 
 cvar_t* broadsword;
 cvar_t* broadsword_kickbones;
@@ -174,6 +177,7 @@ cvar_t* broadsword_extra2;
 cvar_t* broadsword_effcorr;
 cvar_t* broadsword_ragtobase;
 cvar_t* broadsword_dircap;
+cvar_t* broadsword_ragstep;
 
 cvar_t* r_ratiofix;
 
@@ -741,6 +745,30 @@ static void InitOpenGL()
 	//		- r_gamma
 	//
 
+	if (r_headless->integer)
+	{
+		// no window and no context: the front end still runs, the back end
+		// is never issued, and the few GL calls made while registering media
+		// land on the GL loader's no-context stubs
+		if (glConfig.vidWidth == 0)
+		{
+			memset(&glConfig, 0, sizeof glConfig);
+			glConfig.vendor_string = "none";
+			glConfig.renderer_string = "headless";
+			glConfig.version_string = "none";
+			glConfig.extensions_string = "";
+			glConfig.vidWidth = 640;
+			glConfig.vidHeight = 480;
+			glConfig.colorBits = 32;
+			glConfig.depthBits = 24;
+			glConfig.stencilBits = 8;
+			glConfig.maxTextureSize = 2048;
+			glConfig.maxActiveTextures = 1;
+			glConfig.displayFrequency = 60;
+		}
+		return;
+	}
+
 	if (glConfig.vidWidth == 0)
 	{
 		constexpr windowDesc_t window_desc = { GRAPHICS_API_OPENGL };
@@ -1500,6 +1528,7 @@ using consoleCommand_t = struct consoleCommand_s {
 };
 
 void R_ReloadFonts_f();
+void R_G2SkinBench_f();
 
 static consoleCommand_t	commands[] = {
 	{ "imagelist",			R_ImageList_f },
@@ -1515,6 +1544,7 @@ static consoleCommand_t	commands[] = {
 	{ "imagecacheinfo",		RE_RegisterImages_Info_f },
 	{ "modellist",			R_Modellist_f },
 	{ "modelcacheinfo",		RE_RegisterModels_Info_f },
+	{ "g2skinbench",		R_G2SkinBench_f },
 	{ "r_fogDistance",		R_FogDistance_f },
 	{ "r_fogColor",			R_FogColor_f },
 	{ "r_reloadfonts",		R_ReloadFonts_f },
@@ -1674,6 +1704,9 @@ static void R_Register()
 	r_Ghoul2NoBlend = ri.Cvar_Get("r_ghoul2noblend", "0", 0);
 	r_Ghoul2BlendMultiplier = ri.Cvar_Get("r_ghoul2blendmultiplier", "1", 0);
 	r_Ghoul2UnSqashAfterSmooth = ri.Cvar_Get("r_ghoul2unsquashaftersmooth", "1", 0);
+	r_G2SimdSkinning = ri.Cvar_Get("r_G2SimdSkinning", "1", CVAR_ARCHIVE_ND);
+	r_simdShadeCalc = ri.Cvar_Get("r_simdShadeCalc", "1", CVAR_ARCHIVE_ND | CVAR_LATCH);
+	r_headless = ri.Cvar_Get("r_headless", "0", CVAR_INIT);
 
 	broadsword = ri.Cvar_Get("broadsword", "1", 0);
 	broadsword_kickbones = ri.Cvar_Get("broadsword_kickbones", "1", 0);
@@ -1687,6 +1720,7 @@ static void R_Register()
 	broadsword_effcorr = ri.Cvar_Get("broadsword_effcorr", "1", 0);
 	broadsword_ragtobase = ri.Cvar_Get("broadsword_ragtobase", "2", 0);
 	broadsword_dircap = ri.Cvar_Get("broadsword_dircap", "64", 0);
+	broadsword_ragstep = ri.Cvar_Get("broadsword_ragstep", "16", 0);
 
 	r_com_rend2 = ri.Cvar_Get("com_rend2", "0", CVAR_ARCHIVE | CVAR_SAVEGAME | CVAR_NORESTART);
 
@@ -1786,6 +1820,7 @@ void R_Init()
 	R_ImageLoader_Init();
 	R_NoiseInit();
 	R_Register();
+	R_InitShadeKernels();
 
 	backEndData = static_cast<backEndData_t*>(R_Hunk_Alloc(sizeof(backEndData_t), qtrue));
 	R_InitNextFrame();
@@ -2125,6 +2160,7 @@ extern "C" Q_EXPORT refexport_t * QDECL GetRefAPI(const int api_version, const r
 	re.GetWindVector = R_GetWindVector;
 	re.GetWindGusting = R_GetWindGusting;
 	re.IsOutside = R_IsOutside;
+	re.IsOutsideBatch = R_IsOutsideBatch;
 	re.IsOutsideCausingPain = R_IsOutsideCausingPain;
 	re.GetChanceOfSaberFizz = R_GetChanceOfSaberFizz;
 	re.IsShaking = R_IsShaking;
@@ -2158,6 +2194,7 @@ extern "C" Q_EXPORT refexport_t * QDECL GetRefAPI(const int api_version, const r
 	G2EX(GetBoneAnimIndex);
 	G2EX(GetBoneIndex);
 	G2EX(GetBoltMatrix);
+	G2EX(GetBoltMatrices);
 	G2EX(GetGhoul2ModelFlags);
 	G2EX(GetGLAName);
 	G2EX(GetParentSurface);
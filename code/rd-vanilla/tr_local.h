@@ -28,6 +28,7 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #include "../qcommon/qfiles.h"
 #include "tr_common.h"
 #include "tr_public.h"
+#include "tr_font_batch.h"
 #include "mdx_format.h"
 #include "qgl.h"
 
@@ -1137,6 +1138,9 @@ extern cvar_t* r_DynamicGlowWidth;
 extern cvar_t* r_DynamicGlowHeight;
 extern cvar_t* r_Dynamic_AMD_Fix;
 
+extern cvar_t* r_simdShadeCalc;
+extern cvar_t* r_headless;						// no window or GL context, front end only
+
 extern	cvar_t* r_nobind;						// turns off binding to appropriate textures
 extern	cvar_t* r_singleShader;				// make most world faces use default shader
 extern	cvar_t* r_colorMipLevels;				// development aid to see texture mip usage
@@ -1605,6 +1609,7 @@ void	R_TransformModelToClip(const vec3_t src, const float* model_matrix, const f
 	vec4_t eye, vec4_t dst);
 void	R_TransformClipToWindow(const vec4_t clip, const viewParms_t* view, vec4_t normalized, vec4_t window);
 
+void	R_InitShadeKernels();
 void	RB_DeformTessGeometry();
 
 void	RB_CalcScaleTexCoords(const float scale[2], float* dst_tex_coords);
@@ -1703,6 +1708,13 @@ using rotatePicCommand_t = struct {
 	float	a;
 };
 
+using stretchPicBatchCommand_t = struct {
+	int		commandId;
+	shader_t* shader;
+	int		numQuads;
+	// followed by numQuads stretchPicQuad_t
+};
+
 using setModeCommand_t = struct
 {
 	int			commandId;
@@ -1727,6 +1739,7 @@ using renderCommand_t = enum {
 	RC_END_OF_LIST,
 	RC_SET_COLOR,
 	RC_STRETCH_PIC,
+	RC_STRETCH_PIC_BATCH,
 	RC_SCISSOR,
 	RC_ROTATE_PIC,
 	RC_ROTATE_PIC2,
@@ -1764,6 +1777,7 @@ void R_AddDrawSurfCmd(drawSurf_t* drawSurfs, const int numDrawSurfs);
 
 void RE_SetColor(const float* rgba);
 void RE_StretchPic(const float x, const float y, const float w, const float h, const float s1, const float t1, const float s2, const float t2, const qhandle_t hShader);
+void RE_StretchPicBatch(const stretchPicQuad_t* quads, int numQuads, qhandle_t hShader);
 void RE_RotatePic(const float x, const float y, const float w, const float h, const float s1, const float t1, const float s2, const float t2, const float a, const qhandle_t hShader);
 void RE_RotatePic2(const float x, const float y, const float w, const float h, const float s1, const float t1, const float s2, const float t2, const float a, const qhandle_t hShader);
 void RE_RenderWorldEffects();
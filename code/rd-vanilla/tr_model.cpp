@@ -244,6 +244,7 @@ extern cvar_t* r_modelpoolmegs;
 // return qtrue if at least one cached model was freed (which tells z_malloc()-fail recovery code to try again)
 //
 extern qboolean gbInsideRegisterModel;
+void R_G2_ClearSkinCache();
 qboolean RE_RegisterModels_LevelLoadEnd(const qboolean b_delete_everything_not_used_this_level /* = qfalse */)
 {
 	qboolean bAtLeastoneModelFreed = qfalse;
@@ -298,6 +299,12 @@ qboolean RE_RegisterModels_LevelLoadEnd(const qboolean b_delete_everything_not_u
 		}
 	}
 
+	if (bAtLeastoneModelFreed)
+	{
+		// the unpacked skinning verts point into the freed model images
+		R_G2_ClearSkinCache();
+	}
+
 	//ri.Printf( PRINT_DEVELOPER, "RE_RegisterModels_LevelLoadEnd(): Ok\n");
 
 	return bAtLeastoneModelFreed;
@@ -346,6 +353,8 @@ static void RE_RegisterModels_DeleteAll()
 		CachedModels->erase(it_model++);
 	}
 
+	R_G2_ClearSkinCache();
+
 	extern void RE_AnimationCFGs_DeleteAll();
 	RE_AnimationCFGs_DeleteAll();
 }
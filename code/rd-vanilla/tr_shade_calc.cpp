@@ -27,6 +27,7 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 
 #include "tr_local.h"
 #include "../rd-common/tr_common.h"
+#include "tr_shade_kernels.h"
 #define	WAVEVALUE( table, base, amplitude, phase, freq )  ((base) + table[ Q_ftol( ( ( (phase) + backEnd.refdef.floatTime * (freq) ) * FUNCTABLE_SIZE ) ) & FUNCTABLE_MASK ] * (amplitude))
 
 static float* table_for_func(const genFunc_t func)
@@ -51,6 +52,25 @@ static float* table_for_func(const genFunc_t func)
 	Com_Error(ERR_DROP, "TableForFunc called with invalid function '%d' in shader '%s'\n", func, tess.shader->name);
 }
 
+static const shadeKernels_t* shadeKernels = &shadeKernelsScalar;
+
+/*
+** R_InitShadeKernels
+**
+** Picks the per-vertex loops used by the deforms, tcMods and vertex lighting
+*/
+void R_InitShadeKernels()
+{
+	shadeKernels = &shadeKernelsScalar;
+#ifdef SHADE_SIMD_KERNELS
+	if (r_simdShadeCalc->integer)
+	{
+		shadeKernels = &shadeKernelsSSE2;
+	}
+#endif
+	ri.Printf(PRINT_DEVELOPER, "...using %s shade kernels\n", shadeKernels->name);
+}
+
 /*
 ** EvalWaveForm
 **
@@ -124,44 +144,28 @@ RB_CalcDeformVertexes
 */
 void RB_CalcDeformVertexes(const deformStage_t* ds)
 {
-	int i;
-	vec3_t	offset;
-	float	scale;
 	auto* xyz = reinterpret_cast<float*>(tess.xyz);
 	auto* normal = reinterpret_cast<float*>(tess.normal);
 
 	if (ds->deformationWave.frequency == 0)
 	{
-		scale = EvalWaveForm(&ds->deformationWave);
-
-		for (i = 0; i < tess.numVertexes; i++, xyz += 4, normal += 4)
-		{
-			VectorScale(normal, scale, offset);
-
-			xyz[0] += offset[0];
-			xyz[1] += offset[1];
-			xyz[2] += offset[2];
-		}
+		shadeKernels->addScaledNormals(xyz, normal, tess.numVertexes, EvalWaveForm(&ds->deformationWave));
 	}
 	else
 	{
-		const float* table = table_for_func(ds->deformationWave.func);
-
-		for (i = 0; i < tess.numVertexes; i++, xyz += 4, normal += 4)
-		{
-			const float off = (xyz[0] + xyz[1] + xyz[2]) * ds->deformationSpread;
-
-			scale = WAVEVALUE(table, ds->deformationWave.base,
-				ds->deformationWave.amplitude,
-				ds->deformationWave.phase + off,
-				ds->deformationWave.frequency);
-
-			VectorScale(normal, scale, offset);
-
-			xyz[0] += offset[0];
-			xyz[1] += offset[1];
-			xyz[2] += offset[2];
-		}
+		shadeWaveParms_t wave;
+
+		wave.table = table_for_func(ds->deformationWave.func);
+		wave.tableSize = FUNCTABLE_SIZE;
+		wave.tableMask = FUNCTABLE_MASK;
+		wave.base = ds->deformationWave.base;
+		wave.amplitude = ds->deformationWave.amplitude;
+		wave.phase = ds->deformationWave.phase;
+		wave.frequency = ds->deformationWave.frequency;
+		wave.spread = ds->deformationSpread;
+		wave.time = backEnd.refdef.floatTime;
+
+		shadeKernels->deformWave(xyz, normal, tess.numVertexes, wave);
 	}
 }
 
@@ -212,12 +216,7 @@ void RB_CalcBulgeVertexes(const deformStage_t* ds)
 	if (ds->bulgeSpeed == 0.0f && ds->bulgeWidth == 0.0f)
 	{
 		// We don't have a speed and width, so just use height to expand uniformly
-		for (i = 0; i < tess.numVertexes; i++, xyz += 4, normal += 4)
-		{
-			xyz[0] += normal[0] * ds->bulgeHeight;
-			xyz[1] += normal[1] * ds->bulgeHeight;
-			xyz[2] += normal[2] * ds->bulgeHeight;
-		}
+		shadeKernels->addScaledNormals(xyz, normal, tess.numVertexes, ds->bulgeHeight);
 	}
 	else
 	{
@@ -260,10 +259,7 @@ void RB_CalcMoveVertexes(const deformStage_t* ds)
 
 	VectorScale(ds->moveVector, scale, offset);
 
-	auto* xyz = reinterpret_cast<float*>(tess.xyz);
-	for (int i = 0; i < tess.numVertexes; i++, xyz += 4) {
-		VectorAdd(xyz, offset, xyz);
-	}
+	shadeKernels->addOffset(reinterpret_cast<float*>(tess.xyz), tess.numVertexes, offset);
 }
 
 /*
@@ -867,32 +863,15 @@ void RB_CalcFogTexCoords(float* dst_tex_coords)
 */
 void RB_CalcEnvironmentTexCoords(float* dst_tex_coords)
 {
-	int			i;
-	float		d;
-
-	float* v = tess.xyz[0];
-	float* normal = tess.normal[0];
+	const float* v = tess.xyz[0];
+	const float* normal = tess.normal[0];
 
 	if (backEnd.currentEntity && backEnd.currentEntity->e.renderfx & RF_FIRST_PERSON)	//this is a view model so we must use world lights instead of vieworg
 	{
-		for (i = 0; i < tess.numVertexes; i++, v += 4, normal += 4, dst_tex_coords += 2)
-		{
-			d = DotProduct(normal, backEnd.currentEntity->lightDir);
-			dst_tex_coords[0] = normal[0] * d - backEnd.currentEntity->lightDir[0];
-			dst_tex_coords[1] = normal[1] * d - backEnd.currentEntity->lightDir[1];
-		}
+		shadeKernels->environmentTexCoordsDir(dst_tex_coords, normal, tess.numVertexes, backEnd.currentEntity->lightDir);
 	}
 	else {	//the normal way
-		for (i = 0; i < tess.numVertexes; i++, v += 4, normal += 4, dst_tex_coords += 2)
-		{
-			vec3_t viewer;
-			VectorSubtract(backEnd.ori.viewOrigin, v, viewer);
-			VectorNormalizeFast(viewer);
-
-			d = DotProduct(normal, viewer);
-			dst_tex_coords[0] = normal[0] * d - 0.5 * viewer[0];
-			dst_tex_coords[1] = normal[1] * d - 0.5 * viewer[1];
-		}
+		shadeKernels->environmentTexCoords(dst_tex_coords, v, normal, tess.numVertexes, backEnd.ori.viewOrigin);
 	}
 }
 
@@ -918,11 +897,7 @@ void RB_CalcTurbulentTexCoords(const waveForm_t* wf, float* dst_tex_coords)
 */
 void RB_CalcScaleTexCoords(const float scale[2], float* dst_tex_coords)
 {
-	for (int i = 0; i < tess.numVertexes; i++, dst_tex_coords += 2)
-	{
-		dst_tex_coords[0] *= scale[0];
-		dst_tex_coords[1] *= scale[1];
-	}
+	shadeKernels->scaleTexCoords(dst_tex_coords, tess.numVertexes, scale[0], scale[1]);
 }
 
 /*
@@ -940,11 +915,7 @@ void RB_CalcScrollTexCoords(const float scroll_speed[2], float* dst_tex_coords)
 	adjusted_scroll_s = adjusted_scroll_s - floor(adjusted_scroll_s);
 	adjusted_scroll_t = adjusted_scroll_t - floor(adjusted_scroll_t);
 
-	for (int i = 0; i < tess.numVertexes; i++, dst_tex_coords += 2)
-	{
-		dst_tex_coords[0] += adjusted_scroll_s;
-		dst_tex_coords[1] += adjusted_scroll_t;
-	}
+	shadeKernels->scrollTexCoords(dst_tex_coords, tess.numVertexes, adjusted_scroll_s, adjusted_scroll_t);
 }
 
 /*
@@ -952,14 +923,7 @@ void RB_CalcScrollTexCoords(const float scroll_speed[2], float* dst_tex_coords)
 */
 void RB_CalcTransformTexCoords(const texModInfo_t* tmi, float* dst_tex_coords)
 {
-	for (int i = 0; i < tess.numVertexes; i++, dst_tex_coords += 2)
-	{
-		const float s = dst_tex_coords[0];
-		const float t = dst_tex_coords[1];
-
-		dst_tex_coords[0] = s * tmi->matrix[0][0] + t * tmi->matrix[1][0] + tmi->translate[0];
-		dst_tex_coords[1] = s * tmi->matrix[0][1] + t * tmi->matrix[1][1] + tmi->translate[1];
-	}
+	shadeKernels->transformTexCoords(dst_tex_coords, tess.numVertexes, tmi->matrix, tmi->translate);
 }
 
 void RB_CalcRotateTexCoords(const float degs_per_second, float* dst_tex_coords)
@@ -1051,48 +1015,15 @@ void RB_CalcSpecularAlpha(unsigned char* alphas)
 */
 void RB_CalcDiffuseColor(unsigned char* colors)
 {
-	vec3_t			ambient_light;
-	vec3_t			lightDir;
-	vec3_t			directed_light;
+	shadeLightParms_t light;
 
 	const trRefEntity_t* ent = backEnd.currentEntity;
-	const int ambient_light_int = ent->ambientLightInt;
-	VectorCopy(ent->ambientLight, ambient_light);
-	VectorCopy(ent->directedLight, directed_light);
-	VectorCopy(ent->lightDir, lightDir);
-
-	float* v = tess.xyz[0];
-	float* normal = tess.normal[0];
+	light.ambientInt = ent->ambientLightInt;
+	VectorCopy(ent->ambientLight, light.ambient);
+	VectorCopy(ent->directedLight, light.directed);
+	VectorCopy(ent->lightDir, light.lightDir);
 
-	const int num_vertexes = tess.numVertexes;
-
-	for (int i = 0; i < num_vertexes; i++, v += 4, normal += 4)
-	{
-		const float incoming = DotProduct(normal, lightDir);
-		if (incoming <= 0) {
-			*reinterpret_cast<int*>(&colors[i * 4]) = ambient_light_int;
-			continue;
-		}
-		int j = Q_ftol(ambient_light[0] + incoming * directed_light[0]);
-		if (j > 255) {
-			j = 255;
-		}
-		colors[i * 4 + 0] = j;
-
-		j = Q_ftol(ambient_light[1] + incoming * directed_light[1]);
-		if (j > 255) {
-			j = 255;
-		}
-		colors[i * 4 + 1] = j;
-
-		j = Q_ftol(ambient_light[2] + incoming * directed_light[2]);
-		if (j > 255) {
-			j = 255;
-		}
-		colors[i * 4 + 2] = j;
-
-		colors[i * 4 + 3] = 255;
-	}
+	shadeKernels->diffuseColor(colors, tess.normal[0], tess.numVertexes, light);
 }
 
 /*
@@ -1289,24 +1220,6 @@ void RB_CalcDisintegrateVertDeform()
 	{
 		const float	threshold = (backEnd.refdef.time - backEnd.currentEntity->e.endTime) * 0.045f;
 
-		for (int i = 0; i < tess.numVertexes; i++, xyz += 4, normal += 4)
-		{
-			vec3_t temp;
-			VectorSubtract(backEnd.currentEntity->e.oldorigin, xyz, temp);
-
-			const float scale = VectorLengthSquared(temp);
-
-			if (scale < threshold * threshold)
-			{
-				xyz[0] += normal[0] * 2.0f;
-				xyz[1] += normal[1] * 2.0f;
-				xyz[2] += normal[2] * 0.5f;
-			}
-			else if (scale < threshold * threshold + 50)
-			{
-				xyz[0] += normal[0] * 1.0f;
-				xyz[1] += normal[1] * 1.0f;
-			}
-		}
+		shadeKernels->disintegrateDeform(xyz, normal, tess.numVertexes, backEnd.currentEntity->e.oldorigin, threshold);
 	}
 }
\ No newline at end of file
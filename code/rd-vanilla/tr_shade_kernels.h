@@ -0,0 +1,509 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// tr_shade_kernels.h -- per-vertex loops behind the deforms, tcMods and
+// vertex lighting in tr_shade_calc.cpp
+//
+// Every kernel works on raw tess arrays: positions and normals are 4 floats
+// per vertex, texture coordinates 2 floats, colors 4 bytes.  The scalar set
+// is the original code; the SSE2 set handles four vertices (or two texcoord
+// pairs) per step and produces the same bits, which the unit tests check.
+// Nothing in here touches renderer state so the tests can run without GL.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SHADE_SIMD_KERNELS
+#include <emmintrin.h>
+#endif
+
+struct shadeWaveParms_t
+{
+	const float* table;
+	int tableSize;
+	int tableMask;
+	float base;
+	float amplitude;
+	float phase;
+	float frequency;
+	float spread;
+	float time;
+};
+
+struct shadeLightParms_t
+{
+	float ambient[3];
+	float directed[3];
+	float lightDir[3];
+	int ambientInt;
+};
+
+struct shadeKernels_t
+{
+	const char* name;
+	void (*addScaledNormals)(float* xyz, const float* normal, int numVerts, float scale);
+	void (*addOffset)(float* xyz, int numVerts, const float* offset);
+	void (*deformWave)(float* xyz, const float* normal, int numVerts, const shadeWaveParms_t& wave);
+	void (*scrollTexCoords)(float* st, int numVerts, float s, float t);
+	void (*scaleTexCoords)(float* st, int numVerts, float s, float t);
+	void (*transformTexCoords)(float* st, int numVerts, const float matrix[2][2], const float translate[2]);
+	void (*environmentTexCoords)(float* st, const float* xyz, const float* normal, int numVerts, const float* viewOrigin);
+	void (*environmentTexCoordsDir)(float* st, const float* normal, int numVerts, const float* lightDir);
+	void (*diffuseColor)(unsigned char* colors, const float* normal, int numVerts, const shadeLightParms_t& light);
+	void (*disintegrateDeform)(float* xyz, const float* normal, int numVerts, const float* origin, float threshold);
+};
+
+/*
+====================================================================
+
+SCALAR KERNELS
+
+====================================================================
+*/
+
+// same bits as Q_rsqrt, which VectorNormalizeFast uses
+inline float ShadeKernel_RSqrt(const float number)
+{
+	int32_t i;
+	float y;
+
+	const float x2 = number * 0.5f;
+	memcpy(&i, &number, sizeof(i));
+	i = 0x5f3759df - (i >> 1);
+	memcpy(&y, &i, sizeof(y));
+	return y * (1.5f - x2 * y * y);
+}
+
+inline void ShadeKernel_AddScaledNormals(float* xyz, const float* normal, const int numVerts, const float scale)
+{
+	for (int i = 0; i < numVerts; i++, xyz += 4, normal += 4)
+	{
+		xyz[0] += normal[0] * scale;
+		xyz[1] += normal[1] * scale;
+		xyz[2] += normal[2] * scale;
+	}
+}
+
+inline void ShadeKernel_AddOffset(float* xyz, const int numVerts, const float* offset)
+{
+	for (int i = 0; i < numVerts; i++, xyz += 4)
+	{
+		xyz[0] += offset[0];
+		xyz[1] += offset[1];
+		xyz[2] += offset[2];
+	}
+}
+
+inline void ShadeKernel_DeformWave(float* xyz, const float* normal, const int numVerts, const shadeWaveParms_t& wave)
+{
+	for (int i = 0; i < numVerts; i++, xyz += 4, normal += 4)
+	{
+		const float off = (xyz[0] + xyz[1] + xyz[2]) * wave.spread;
+		const long index = static_cast<long>((wave.phase + off + wave.time * wave.frequency) * wave.tableSize);
+		const float scale = wave.base + wave.table[index & wave.tableMask] * wave.amplitude;
+
+		xyz[0] += normal[0] * scale;
+		xyz[1] += normal[1] * scale;
+		xyz[2] += normal[2] * scale;
+	}
+}
+
+inline void ShadeKernel_ScrollTexCoords(float* st, const int numVerts, const float s, const float t)
+{
+	for (int i = 0; i < numVerts; i++, st += 2)
+	{
+		st[0] += s;
+		st[1] += t;
+	}
+}
+
+inline void ShadeKernel_ScaleTexCoords(float* st, const int numVerts, const float s, const float t)
+{
+	for (int i = 0; i < numVerts; i++, st += 2)
+	{
+		st[0] *= s;
+		st[1] *= t;
+	}
+}
+
+inline void ShadeKernel_TransformTexCoords(float* st, const int numVerts, const float matrix[2][2], const float translate[2])
+{
+	for (int i = 0; i < numVerts; i++, st += 2)
+	{
+		const float s = st[0];
+		const float t = st[1];
+
+		st[0] = s * matrix[0][0] + t * matrix[1][0] + translate[0];
+		st[1] = s * matrix[0][1] + t * matrix[1][1] + translate[1];
+	}
+}
+
+inline void ShadeKernel_EnvironmentTexCoords(float* st, const float* xyz, const float* normal, const int numVerts, const float* viewOrigin)
+{
+	for (int i = 0; i < numVerts; i++, xyz += 4, normal += 4, st += 2)
+	{
+		float viewer[3];
+		viewer[0] = viewOrigin[0] - xyz[0];
+		viewer[1] = viewOrigin[1] - xyz[1];
+		viewer[2] = viewOrigin[2] - xyz[2];
+
+		const float ilength = ShadeKernel_RSqrt(viewer[0] * viewer[0] + viewer[1] * viewer[1] + viewer[2] * viewer[2]);
+		viewer[0] *= ilength;
+		viewer[1] *= ilength;
+		viewer[2] *= ilength;
+
+		const float d = normal[0] * viewer[0] + normal[1] * viewer[1] + normal[2] * viewer[2];
+		st[0] = normal[0] * d - 0.5f * viewer[0];
+		st[1] = normal[1] * d - 0.5f * viewer[1];
+	}
+}
+
+inline void ShadeKernel_EnvironmentTexCoordsDir(float* st, const float* normal, const int numVerts, const float* lightDir)
+{
+	for (int i = 0; i < numVerts; i++, normal += 4, st += 2)
+	{
+		const float d = normal[0] * lightDir[0] + normal[1] * lightDir[1] + normal[2] * lightDir[2];
+		st[0] = normal[0] * d - lightDir[0];
+		st[1] = normal[1] * d - lightDir[1];
+	}
+}
+
+inline void ShadeKernel_DiffuseColor(unsigned char* colors, const float* normal, const int numVerts, const shadeLightParms_t& light)
+{
+	for (int i = 0; i < numVerts; i++, normal += 4, colors += 4)
+	{
+		const float incoming = normal[0] * light.lightDir[0] + normal[1] * light.lightDir[1] + normal[2] * light.lightDir[2];
+		if (incoming <= 0)
+		{
+			memcpy(colors, &light.ambientInt, sizeof(int));
+			continue;
+		}
+
+		for (int c = 0; c < 3; c++)
+		{
+			long j = static_cast<long>(light.ambient[c] + incoming * light.directed[c]);
+			if (j > 255)
+			{
+				j = 255;
+			}
+			colors[c] = static_cast<unsigned char>(j);
+		}
+		colors[3] = 255;
+	}
+}
+
+inline void ShadeKernel_DisintegrateDeform(float* xyz, const float* normal, const int numVerts, const float* origin, const float threshold)
+{
+	for (int i = 0; i < numVerts; i++, xyz += 4, normal += 4)
+	{
+		const float d0 = origin[0] - xyz[0];
+		const float d1 = origin[1] - xyz[1];
+		const float d2 = origin[2] - xyz[2];
+		const float scale = d0 * d0 + d1 * d1 + d2 * d2;
+
+		if (scale < threshold * threshold)
+		{
+			xyz[0] += normal[0] * 2.0f;
+			xyz[1] += normal[1] * 2.0f;
+			xyz[2] += normal[2] * 0.5f;
+		}
+		else if (scale < threshold * threshold + 50)
+		{
+			xyz[0] += normal[0] * 1.0f;
+			xyz[1] += normal[1] * 1.0f;
+		}
+	}
+}
+
+static const shadeKernels_t shadeKernelsScalar = {
+	"scalar",
+	ShadeKernel_AddScaledNormals,
+	ShadeKernel_AddOffset,
+	ShadeKernel_DeformWave,
+	ShadeKernel_ScrollTexCoords,
+	ShadeKernel_ScaleTexCoords,
+	ShadeKernel_TransformTexCoords,
+	ShadeKernel_EnvironmentTexCoords,
+	ShadeKernel_EnvironmentTexCoordsDir,
+	ShadeKernel_DiffuseColor,
+	ShadeKernel_DisintegrateDeform,
+};
+
+#ifdef SHADE_SIMD_KERNELS
+/*
+====================================================================
+
+SSE2 KERNELS
+
+The vertex loops load four vec4s and transpose them so x, y and z each sit
+in one register, keeping the scalar order of operations so the results
+match bit for bit.  Leftover vertices go through the scalar kernel.
+
+====================================================================
+*/
+
+inline __m128 ShadeKernel_Select(const __m128 mask, const __m128 a, const __m128 b)
+{
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline void ShadeKernel_AddScaledNormalsSSE2(float* xyz, const float* normal, const int numVerts, const float scale)
+{
+	const __m128 keepW = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+	const __m128 vscale = _mm_set1_ps(scale);
+
+	for (int i = 0; i < numVerts; i++, xyz += 4, normal += 4)
+	{
+		const __m128 p = _mm_loadu_ps(xyz);
+		const __m128 moved = _mm_add_ps(p, _mm_mul_ps(_mm_loadu_ps(normal), vscale));
+		_mm_storeu_ps(xyz, ShadeKernel_Select(keepW, p, moved));
+	}
+}
+
+inline void ShadeKernel_AddOffsetSSE2(float* xyz, const int numVerts, const float* offset)
+{
+	const __m128 voffset = _mm_set_ps(0.0f, offset[2], offset[1], offset[0]);
+	const __m128 keepW = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+
+	for (int i = 0; i < numVerts; i++, xyz += 4)
+	{
+		const __m128 p = _mm_loadu_ps(xyz);
+		_mm_storeu_ps(xyz, ShadeKernel_Select(keepW, p, _mm_add_ps(p, voffset)));
+	}
+}
+
+inline void ShadeKernel_DeformWaveSSE2(float* xyz, const float* normal, const int numVerts, const shadeWaveParms_t& wave)
+{
+	const __m128 spread = _mm_set1_ps(wave.spread);
+	const __m128 phase = _mm_set1_ps(wave.phase);
+	const __m128 timeFreq = _mm_set1_ps(wave.time * wave.frequency);
+	const __m128 tableSize = _mm_set1_ps(static_cast<float>(wave.tableSize));
+	const __m128i tableMask = _mm_set1_epi32(wave.tableMask);
+	const __m128 base = _mm_set1_ps(wave.base);
+	const __m128 amplitude = _mm_set1_ps(wave.amplitude);
+
+	int i = 0;
+	for (; i + 4 <= numVerts; i += 4, xyz += 16, normal += 16)
+	{
+		__m128 x = _mm_loadu_ps(xyz), y = _mm_loadu_ps(xyz + 4), z = _mm_loadu_ps(xyz + 8), w = _mm_loadu_ps(xyz + 12);
+		__m128 nx = _mm_loadu_ps(normal), ny = _mm_loadu_ps(normal + 4), nz = _mm_loadu_ps(normal + 8), nw = _mm_loadu_ps(normal + 12);
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+		_MM_TRANSPOSE4_PS(nx, ny, nz, nw);
+
+		const __m128 off = _mm_mul_ps(_mm_add_ps(_mm_add_ps(x, y), z), spread);
+		const __m128 arg = _mm_mul_ps(_mm_add_ps(_mm_add_ps(phase, off), timeFreq), tableSize);
+		alignas(16) int index[4];
+		_mm_store_si128(reinterpret_cast<__m128i*>(index), _mm_and_si128(_mm_cvttps_epi32(arg), tableMask));
+
+		const __m128 value = _mm_set_ps(wave.table[index[3]], wave.table[index[2]], wave.table[index[1]], wave.table[index[0]]);
+		const __m128 scale = _mm_add_ps(base, _mm_mul_ps(value, amplitude));
+
+		x = _mm_add_ps(x, _mm_mul_ps(nx, scale));
+		y = _mm_add_ps(y, _mm_mul_ps(ny, scale));
+		z = _mm_add_ps(z, _mm_mul_ps(nz, scale));
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+		_mm_storeu_ps(xyz, x);
+		_mm_storeu_ps(xyz + 4, y);
+		_mm_storeu_ps(xyz + 8, z);
+		_mm_storeu_ps(xyz + 12, w);
+	}
+	ShadeKernel_DeformWave(xyz, normal, numVerts - i, wave);
+}
+
+inline void ShadeKernel_ScrollTexCoordsSSE2(float* st, const int numVerts, const float s, const float t)
+{
+	const __m128 scroll = _mm_set_ps(t, s, t, s);
+
+	int i = 0;
+	for (; i + 2 <= numVerts; i += 2, st += 4)
+	{
+		_mm_storeu_ps(st, _mm_add_ps(_mm_loadu_ps(st), scroll));
+	}
+	ShadeKernel_ScrollTexCoords(st, numVerts - i, s, t);
+}
+
+inline void ShadeKernel_ScaleTexCoordsSSE2(float* st, const int numVerts, const float s, const float t)
+{
+	const __m128 scale = _mm_set_ps(t, s, t, s);
+
+	int i = 0;
+	for (; i + 2 <= numVerts; i += 2, st += 4)
+	{
+		_mm_storeu_ps(st, _mm_mul_ps(_mm_loadu_ps(st), scale));
+	}
+	ShadeKernel_ScaleTexCoords(st, numVerts - i, s, t);
+}
+
+inline void ShadeKernel_TransformTexCoordsSSE2(float* st, const int numVerts, const float matrix[2][2], const float translate[2])
+{
+	const __m128 fromS = _mm_set_ps(matrix[0][1], matrix[0][0], matrix[0][1], matrix[0][0]);
+	const __m128 fromT = _mm_set_ps(matrix[1][1], matrix[1][0], matrix[1][1], matrix[1][0]);
+	const __m128 move = _mm_set_ps(translate[1], translate[0], translate[1], translate[0]);
+
+	int i = 0;
+	for (; i + 2 <= numVerts; i += 2, st += 4)
+	{
+		const __m128 v = _mm_loadu_ps(st);
+		const __m128 s = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0));
+		const __m128 t = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 1, 1));
+		_mm_storeu_ps(st, _mm_add_ps(_mm_add_ps(_mm_mul_ps(s, fromS), _mm_mul_ps(t, fromT)), move));
+	}
+	ShadeKernel_TransformTexCoords(st, numVerts - i, matrix, translate);
+}
+
+inline __m128 ShadeKernel_RSqrtSSE2(const __m128 number)
+{
+	const __m128 x2 = _mm_mul_ps(number, _mm_set1_ps(0.5f));
+	const __m128i i = _mm_sub_epi32(_mm_set1_epi32(0x5f3759df), _mm_srai_epi32(_mm_castps_si128(number), 1));
+	const __m128 y = _mm_castsi128_ps(i);
+	return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(x2, y), y)));
+}
+
+inline void ShadeKernel_StoreTexCoords(float* st, const __m128 s, const __m128 t)
+{
+	_mm_storeu_ps(st, _mm_unpacklo_ps(s, t));
+	_mm_storeu_ps(st + 4, _mm_unpackhi_ps(s, t));
+}
+
+inline void ShadeKernel_EnvironmentTexCoordsSSE2(float* st, const float* xyz, const float* normal, const int numVerts, const float* viewOrigin)
+{
+	const __m128 ox = _mm_set1_ps(viewOrigin[0]), oy = _mm_set1_ps(viewOrigin[1]), oz = _mm_set1_ps(viewOrigin[2]);
+	const __m128 half = _mm_set1_ps(0.5f);
+
+	int i = 0;
+	for (; i + 4 <= numVerts; i += 4, xyz += 16, normal += 16, st += 8)
+	{
+		__m128 x = _mm_loadu_ps(xyz), y = _mm_loadu_ps(xyz + 4), z = _mm_loadu_ps(xyz + 8), w = _mm_loadu_ps(xyz + 12);
+		__m128 nx = _mm_loadu_ps(normal), ny = _mm_loadu_ps(normal + 4), nz = _mm_loadu_ps(normal + 8), nw = _mm_loadu_ps(normal + 12);
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+		_MM_TRANSPOSE4_PS(nx, ny, nz, nw);
+
+		__m128 vx = _mm_sub_ps(ox, x), vy = _mm_sub_ps(oy, y), vz = _mm_sub_ps(oz, z);
+		const __m128 ilength = ShadeKernel_RSqrtSSE2(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz)));
+		vx = _mm_mul_ps(vx, ilength);
+		vy = _mm_mul_ps(vy, ilength);
+		vz = _mm_mul_ps(vz, ilength);
+
+		const __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, vx), _mm_mul_ps(ny, vy)), _mm_mul_ps(nz, vz));
+		ShadeKernel_StoreTexCoords(st,
+			_mm_sub_ps(_mm_mul_ps(nx, d), _mm_mul_ps(half, vx)),
+			_mm_sub_ps(_mm_mul_ps(ny, d), _mm_mul_ps(half, vy)));
+	}
+	ShadeKernel_EnvironmentTexCoords(st, xyz, normal, numVerts - i, viewOrigin);
+}
+
+inline void ShadeKernel_EnvironmentTexCoordsDirSSE2(float* st, const float* normal, const int numVerts, const float* lightDir)
+{
+	const __m128 lx = _mm_set1_ps(lightDir[0]), ly = _mm_set1_ps(lightDir[1]), lz = _mm_set1_ps(lightDir[2]);
+
+	int i = 0;
+	for (; i + 4 <= numVerts; i += 4, normal += 16, st += 8)
+	{
+		__m128 nx = _mm_loadu_ps(normal), ny = _mm_loadu_ps(normal + 4), nz = _mm_loadu_ps(normal + 8), nw = _mm_loadu_ps(normal + 12);
+		_MM_TRANSPOSE4_PS(nx, ny, nz, nw);
+
+		const __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, lx), _mm_mul_ps(ny, ly)), _mm_mul_ps(nz, lz));
+		ShadeKernel_StoreTexCoords(st, _mm_sub_ps(_mm_mul_ps(nx, d), lx), _mm_sub_ps(_mm_mul_ps(ny, d), ly));
+	}
+	ShadeKernel_EnvironmentTexCoordsDir(st, normal, numVerts - i, lightDir);
+}
+
+inline __m128i ShadeKernel_LightChannel(const float ambient, const float directed, const __m128 incoming)
+{
+	const __m128i limit = _mm_set1_epi32(255);
+	const __m128i j = _mm_cvttps_epi32(_mm_add_ps(_mm_set1_ps(ambient), _mm_mul_ps(incoming, _mm_set1_ps(directed))));
+	const __m128i over = _mm_cmpgt_epi32(j, limit);
+	return _mm_and_si128(_mm_or_si128(_mm_and_si128(over, limit), _mm_andnot_si128(over, j)), limit);
+}
+
+inline void ShadeKernel_DiffuseColorSSE2(unsigned char* colors, const float* normal, const int numVerts, const shadeLightParms_t& light)
+{
+	const __m128 lx = _mm_set1_ps(light.lightDir[0]), ly = _mm_set1_ps(light.lightDir[1]), lz = _mm_set1_ps(light.lightDir[2]);
+	const __m128i ambientInt = _mm_set1_epi32(light.ambientInt);
+	const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xff000000u));
+
+	int i = 0;
+	for (; i + 4 <= numVerts; i += 4, normal += 16, colors += 16)
+	{
+		__m128 nx = _mm_loadu_ps(normal), ny = _mm_loadu_ps(normal + 4), nz = _mm_loadu_ps(normal + 8), nw = _mm_loadu_ps(normal + 12);
+		_MM_TRANSPOSE4_PS(nx, ny, nz, nw);
+
+		const __m128 incoming = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, lx), _mm_mul_ps(ny, ly)), _mm_mul_ps(nz, lz));
+		const __m128i r = ShadeKernel_LightChannel(light.ambient[0], light.directed[0], incoming);
+		const __m128i g = ShadeKernel_LightChannel(light.ambient[1], light.directed[1], incoming);
+		const __m128i b = ShadeKernel_LightChannel(light.ambient[2], light.directed[2], incoming);
+		const __m128i lit = _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)), _mm_or_si128(_mm_slli_epi32(b, 16), alpha));
+
+		const __m128i dark = _mm_castps_si128(_mm_cmple_ps(incoming, _mm_setzero_ps()));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(colors), _mm_or_si128(_mm_and_si128(dark, ambientInt), _mm_andnot_si128(dark, lit)));
+	}
+	ShadeKernel_DiffuseColor(colors, normal, numVerts - i, light);
+}
+
+inline void ShadeKernel_DisintegrateDeformSSE2(float* xyz, const float* normal, const int numVerts, const float* origin, const float threshold)
+{
+	const __m128 ox = _mm_set1_ps(origin[0]), oy = _mm_set1_ps(origin[1]), oz = _mm_set1_ps(origin[2]);
+	const __m128 inner = _mm_set1_ps(threshold * threshold);
+	const __m128 outer = _mm_set1_ps(threshold * threshold + 50);
+	const __m128 one = _mm_set1_ps(1.0f), two = _mm_set1_ps(2.0f), half = _mm_set1_ps(0.5f);
+
+	int i = 0;
+	for (; i + 4 <= numVerts; i += 4, xyz += 16, normal += 16)
+	{
+		__m128 x = _mm_loadu_ps(xyz), y = _mm_loadu_ps(xyz + 4), z = _mm_loadu_ps(xyz + 8), w = _mm_loadu_ps(xyz + 12);
+		__m128 nx = _mm_loadu_ps(normal), ny = _mm_loadu_ps(normal + 4), nz = _mm_loadu_ps(normal + 8), nw = _mm_loadu_ps(normal + 12);
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+		_MM_TRANSPOSE4_PS(nx, ny, nz, nw);
+
+		const __m128 dx = _mm_sub_ps(ox, x), dy = _mm_sub_ps(oy, y), dz = _mm_sub_ps(oz, z);
+		const __m128 scale = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+		const __m128 burnt = _mm_cmplt_ps(scale, inner);
+		const __m128 edge = _mm_andnot_ps(burnt, _mm_cmplt_ps(scale, outer));
+
+		x = ShadeKernel_Select(burnt, _mm_add_ps(x, _mm_mul_ps(nx, two)), ShadeKernel_Select(edge, _mm_add_ps(x, _mm_mul_ps(nx, one)), x));
+		y = ShadeKernel_Select(burnt, _mm_add_ps(y, _mm_mul_ps(ny, two)), ShadeKernel_Select(edge, _mm_add_ps(y, _mm_mul_ps(ny, one)), y));
+		z = ShadeKernel_Select(burnt, _mm_add_ps(z, _mm_mul_ps(nz, half)), z);
+
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+		_mm_storeu_ps(xyz, x);
+		_mm_storeu_ps(xyz + 4, y);
+		_mm_storeu_ps(xyz + 8, z);
+		_mm_storeu_ps(xyz + 12, w);
+	}
+	ShadeKernel_DisintegrateDeform(xyz, normal, numVerts - i, origin, threshold);
+}
+
+static const shadeKernels_t shadeKernelsSSE2 = {
+	"SSE2",
+	ShadeKernel_AddScaledNormalsSSE2,
+	ShadeKernel_AddOffsetSSE2,
+	ShadeKernel_DeformWaveSSE2,
+	ShadeKernel_ScrollTexCoordsSSE2,
+	ShadeKernel_ScaleTexCoordsSSE2,
+	ShadeKernel_TransformTexCoordsSSE2,
+	ShadeKernel_EnvironmentTexCoordsSSE2,
+	ShadeKernel_EnvironmentTexCoordsDirSSE2,
+	ShadeKernel_DiffuseColorSSE2,
+	ShadeKernel_DisintegrateDeformSSE2,
+};
+#endif // SHADE_SIMD_KERNELS
@@ -97,6 +97,8 @@ using clientSnapshot_t = struct
 	int messageSent; // time the message was transmitted
 	int messageAcked; // time the message was acked
 	int messageSize; // used to rate drop packets
+	int messageNum; // netchan sequence this frame went out with
+	qboolean loopback; // handed to the client in place, never serialized
 };
 
 using clientState_t = enum
@@ -178,6 +180,8 @@ extern cvar_t* sv_mapname;
 extern cvar_t* sv_spawntarget;
 extern cvar_t* sv_mapChecksum;
 extern cvar_t* sv_serverid;
+extern cvar_t* sv_loopbackSnapshots;
+extern cvar_t* sv_snapshotBuckets;
 extern cvar_t* sv_testsave;
 extern cvar_t* sv_compress_saved_games;
 
@@ -224,6 +228,7 @@ void SV_AddServerCommand(client_t* client, const char* cmd);
 void SV_SendMessageToClient(const msg_t* msg, client_t* client);
 void SV_SendClientMessages();
 void SV_SendClientSnapshot(client_t* client);
+const clientSnapshot_t* SV_GetLoopbackSnapshot(int messageNum);
 
 //
 // sv_game.c
@@ -254,6 +259,14 @@ void SV_LinkEntity(gentity_t* g_ent);
 // sets ent->leafnums[] for pvs determination even if the entity
 // is not solid
 
+void SV_RefreshLooseEntities();
+// picks up broadcast and portal flag changes made without a relink,
+// call once before building each snapshot
+
+int SV_GatherVisibleEntities(const byte* pvs, int* ents, int maxEnts);
+// fills in the numbers of every entity linked into a cluster visible in
+// the given PVS row, plus those that are always checked; each is listed once
+
 clipHandle_t SV_ClipHandleForEntity(const gentity_t* ent);
 
 void SV_SectorList_f();
@@ -277,6 +290,9 @@ void SV_Trace(trace_t* results, const vec3_t start, const vec3_t mins, const vec
 /*
 Ghoul2 Insert End
 */
+void SV_TraceBatch(traceQuery_t* queries, int count, int passEntityNum, int contentmask);
+// runs count traces with one shared entity gather, each result is what SV_Trace with
+// G2_NOCOLLIDE would have given for that query
 // mins and maxs are relative
 
 // if the entire move stays in a solid volume, trace.allsolid will be set,
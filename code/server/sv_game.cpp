@@ -533,6 +533,14 @@ static qboolean SV_G2API_GetBoltMatrix(
 		position, aframe_num, model_list, scale);
 }
 
+static qboolean SV_G2API_GetBoltMatrices(
+	CGhoul2Info_v& ghoul2, const int modelIndex, const int num_bolts, const int* bolt_indexes, mdxaBone_t* matrices,
+	const vec3_t angles, const vec3_t position, const int aframe_num, qhandle_t* model_list, const vec3_t scale)
+{
+	return re.G2API_GetBoltMatrices(ghoul2, modelIndex, num_bolts, bolt_indexes, matrices, angles,
+		position, aframe_num, model_list, scale);
+}
+
 static int SV_G2API_GetGhoul2ModelFlags(CGhoul2Info* ghlInfo)
 {
 	return re.G2API_GetGhoul2ModelFlags(ghlInfo);
@@ -866,6 +874,11 @@ static bool SV_WE_IsOutside(vec3_t pos)
 	return re.IsOutside(pos);
 }
 
+static void SV_WE_IsOutsideBatch(const int num_points, vec3_t* points, bool* outside)
+{
+	re.IsOutsideBatch(num_points, points, outside);
+}
+
 static float SV_WE_IsOutsideCausingPain(vec3_t pos)
 {
 	return re.IsOutsideCausingPain(pos);
@@ -1062,6 +1075,10 @@ import.WE_GetChanceOfSaberFizz = SV_WE_GetChanceOfSaberFizz;
 import.WE_IsShaking = SV_WE_IsShaking;
 import.WE_AddWeatherZone = SV_WE_AddWeatherZone;
 import.WE_SetTempGlobalFogColor = SV_WE_SetTempGlobalFogColor;
+import.WE_IsOutsideBatch = SV_WE_IsOutsideBatch;
+import.G2API_GetBoltMatrices = SV_G2API_GetBoltMatrices;
+import.FS_PrefetchFiles = FS_PrefetchFiles;
+import.FS_PrefetchWait = FS_PrefetchWait;
 
 #ifdef JK2_MODE
 	const char* gamename = "jospgame";
@@ -1100,7 +1117,7 @@ import.WE_SetTempGlobalFogColor = SV_WE_SetTempGlobalFogColor;
 	// use the current msec count for a random seed
 	Z_TagFree(TAG_G_ALLOC);
 	ge->Init(sv_mapname->string, sv_spawntarget->string, sv_mapChecksum->integer, CM_EntityString(), sv.time,
-		com_frameTime, Com_Milliseconds(), e_saved_game_just_loaded, qbLoadTransition);
+		CL_CmdStreamSeed(com_frameTime), Com_Milliseconds(), e_saved_game_just_loaded, qbLoadTransition);
 
 	// clear all gentity pointers that might still be set from
 	// a previous level
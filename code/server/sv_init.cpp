@@ -408,6 +408,8 @@ void SV_Init()
 	sv_fps = Cvar_Get("sv_fps", "20", CVAR_TEMP);
 	sv_timeout = Cvar_Get("sv_timeout", "120", CVAR_TEMP);
 	sv_zombietime = Cvar_Get("sv_zombietime", "2", CVAR_TEMP);
+	sv_loopbackSnapshots = Cvar_Get("sv_loopbackSnapshots", "1", CVAR_TEMP);
+	sv_snapshotBuckets = Cvar_Get("sv_snapshotBuckets", "1", CVAR_TEMP);
 	Cvar_Get("nextmap", "", CVAR_TEMP);
 	sv_spawntarget = Cvar_Get("spawntarget", "", 0);
 
@@ -48,6 +48,8 @@ cvar_t* sv_mapname;
 cvar_t* sv_spawntarget;
 cvar_t* sv_mapChecksum;
 cvar_t* sv_serverid;
+cvar_t* sv_loopbackSnapshots; // hand snapshots to the local client without serializing them
+cvar_t* sv_snapshotBuckets; // 1 = only test entities in visible clusters, 2 = also verify against a full scan
 cvar_t* sv_testsave; // Run the savegame enumeration every game frame
 cvar_t* sv_compress_saved_games; // compress the saved games on the way out (only affect saver, loader can read both)
 
@@ -449,6 +451,25 @@ We will keep track of this here:
 
 */
 
+/*
+==================
+SV_EntityChecksum
+
+The game's entity checksum, the same one g_entityChecksum prints.  Used by
+command stream playback to find the first frame that doesn't match the
+recording.
+==================
+*/
+int SV_EntityChecksum()
+{
+	if (!com_sv_running || !com_sv_running->integer || !ge)
+	{
+		return 0;
+	}
+
+	return ge->EntityChecksum();
+}
+
 /*
 ==================
 SV_Frame
@@ -540,6 +561,7 @@ void SV_Frame(int msec, const float fraction_msec)
 	{
 		start_time = Sys_Milliseconds();
 	}
+	const int64_t start_usec = com_benchmark->integer ? Com_Microseconds() : 0;
 
 	// run the game simulation in chunks
 	while (sv.timeResidual >= frame_msec)
@@ -562,6 +584,10 @@ void SV_Frame(int msec, const float fraction_msec)
 	{
 		time_game = Sys_Milliseconds() - start_time;
 	}
+	if (com_benchmark->integer)
+	{
+		time_gameUsec = static_cast<int>(Com_Microseconds() - start_usec);
+	}
 
 	SG_TestSave();
 	// returns immediately if not active, used for fake-save-every-cycle to test (mainly) Icarus disk code
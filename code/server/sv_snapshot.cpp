@@ -172,6 +172,23 @@ static void SV_WriteSnapshotToClient(client_t* client, msg_t* msg)
 			oldframe = nullptr;
 			lastframe = 0;
 		}
+		// a loopback frame was never serialized, so the client has
+		// nothing in its parse buffers to delta against
+		else if (oldframe->loopback)
+		{
+			oldframe = nullptr;
+			lastframe = 0;
+		}
+	}
+
+	// the local client can read an active frame straight out of the
+	// snapshot ring, so only the header needs to go through the netchan
+	frame->messageNum = client->netchan.outgoingSequence;
+	frame->loopback = static_cast<qboolean>(sv_loopbackSnapshots->integer && client->state == CS_ACTIVE);
+	if (frame->loopback)
+	{
+		oldframe = nullptr;
+		lastframe = 0;
 	}
 
 	MSG_WriteByte(msg, svc_snapshot);
@@ -189,11 +206,21 @@ static void SV_WriteSnapshotToClient(client_t* client, msg_t* msg)
 	MSG_WriteByte(msg, lastframe); // what we are delta'ing from
 	MSG_WriteLong(msg, client->cmdNum); // we have executed up to here
 
-	const int snapFlags = client->droppedCommands << 1;
+	int snapFlags = client->droppedCommands << 1;
 	client->droppedCommands = qfalse;
 
+	if (frame->loopback)
+	{
+		snapFlags |= SNAPFLAG_LOOPBACK;
+	}
+
 	MSG_WriteByte(msg, snapFlags);
 
+	if (frame->loopback)
+	{
+		return;
+	}
+
 	// send over the areabits
 	MSG_WriteByte(msg, frame->areabytes);
 	MSG_WriteData(msg, frame->areabits, frame->areabytes);
@@ -212,6 +239,36 @@ static void SV_WriteSnapshotToClient(client_t* client, msg_t* msg)
 	SV_EmitPacketEntities(oldframe, frame, msg);
 }
 
+/*
+==================
+SV_GetLoopbackSnapshot
+
+Returns the frame that went out with the given message number if it
+was handed off in place and both it and its entities are still in
+their rings, otherwise nullptr.
+==================
+*/
+const clientSnapshot_t* SV_GetLoopbackSnapshot(const int messageNum)
+{
+	if (!svs.clients || svs.clients[0].state != CS_ACTIVE || !svs.snapshotEntities)
+	{
+		return nullptr;
+	}
+
+	const clientSnapshot_t* frame = &svs.clients[0].frames[messageNum & PACKET_MASK];
+	if (!frame->loopback || frame->messageNum != messageNum)
+	{
+		return nullptr;
+	}
+
+	if (svs.nextSnapshotEntities - frame->first_entity > svs.numSnapshotEntities)
+	{
+		return nullptr;
+	}
+
+	return frame;
+}
+
 /*
 ==================
 SV_UpdateServerCommandsToClient
@@ -365,185 +422,248 @@ qboolean SV_PlayerCanSeeEnt(const gentity_t* ent, const int sightLevel)
 	return qfalse;
 }
 
+static void SV_AddEntitiesVisibleFromPoint(vec3_t origin, clientSnapshot_t* frame,
+	snapshotEntityNumbers_t* eNums, qboolean portal, qboolean useBuckets);
+
 /*
 ===============
-SV_AddEntitiesVisibleFromPoint
+SV_AddEntityIfVisible
+
+Runs the full visibility test for one entity from a viewpoint and adds it
+(and anything seen through it, if it is a portal) to the snapshot.
 ===============
 */
-static void SV_AddEntitiesVisibleFromPoint(vec3_t origin, clientSnapshot_t* frame,
-	snapshotEntityNumbers_t* eNums, const qboolean portal)
+static void SV_AddEntityIfVisible(const int e, clientSnapshot_t* frame, snapshotEntityNumbers_t* eNums,
+	const int clientarea, const byte* clientpvs, const qboolean sightOn, const qboolean useBuckets)
 {
 	int i;
-	gentity_t* ent;
-	svEntity_t* svEnt;
-	int l;
-	int clientarea, clientcluster;
-	int leafnum;
-	const byte* clientpvs;
-	const byte* bitvector;
-#ifndef JK2_MODE
-	qboolean sightOn = qfalse;
-#endif
 
-	// during an error shutdown message we may need to transmit
-	// the shutdown message after the server has shutdown, so
-	// specfically check for it
-	if (!sv.state)
+	gentity_t* ent = SV_GentityNum(e);
+
+	if (!ent->inuse)
 	{
 		return;
 	}
 
-	leafnum = CM_PointLeafnum(origin);
-	clientarea = CM_LeafArea(leafnum);
-	clientcluster = CM_LeafCluster(leafnum);
+	if (ent->s.eFlags & EF_PERMANENT)
+	{
+		// he's permanent, so don't send him down!
+		return;
+	}
 
-	// calculate the visible areas
-	frame->areabytes = CM_WriteAreaBits(frame->areabits, clientarea);
+	if (ent->s.number != e)
+	{
+		Com_DPrintf("FIXING ENT->S.NUMBER!!!\n");
+		ent->s.number = e;
+	}
+
+	// never send entities that aren't linked in
+	if (!ent->linked)
+	{
+		return;
+	}
+
+	// entities can be flagged to explicitly not be sent to the client
+	if (ent->svFlags & SVF_NOCLIENT)
+	{
+		return;
+	}
 
-	clientpvs = CM_ClusterPVS(clientcluster);
+	svEntity_t* svEnt = SV_SvEntityForGentity(ent);
+
+	// don't double add an entity through portals
+	if (svEnt->snapshotCounter == sv.snapshotCounter)
+	{
+		return;
+	}
+
+	// broadcast entities are always sent, and so is the main player so we don't see noclip weirdness
+	if (ent->svFlags & SVF_BROADCAST || !e)
+	{
+		SV_AddEntToSnapshot(svEnt, ent, eNums);
+		return;
+	}
 
 #ifndef JK2_MODE
-	if (!portal)
+	if (ent->s.isPortalEnt)
 	{
-		//not if this if through a portal...???  James said to do this...
-		if ((frame->ps.forcePowersActive & (1 << FP_SEE)))
-		{
-			sightOn = qtrue;
-		}
+		//rww - portal entities are always sent as well
+		SV_AddEntToSnapshot(svEnt, ent, eNums);
+		return;
 	}
 #endif // !JK2_MODE
 
-	for (int e = 0; e < ge->num_entities; e++)
+#ifndef JK2_MODE
+	if (sightOn)
 	{
-		ent = SV_GentityNum(e);
-
-		if (!ent->inuse)
+		//force sight is on, sees through portals, so draw them always if in radius
+		if (SV_PlayerCanSeeEnt(ent, frame->ps.forcePowerLevel[FP_SEE]))
 		{
-			continue;
+			//entity is visible
+			SV_AddEntToSnapshot(svEnt, ent, eNums);
+			return;
 		}
+	}
+#endif // !JK2_MODE
 
-		if (ent->s.eFlags & EF_PERMANENT)
+	// ignore if not touching a PV leaf
+	// check area
+	if (!CM_AreasConnected(clientarea, svEnt->areanum))
+	{
+		// doors can legally straddle two areas, so
+		// we may need to check another one
+		if (!CM_AreasConnected(clientarea, svEnt->areanum2))
 		{
-			// he's permanent, so don't send him down!
-			continue;
+			return; // blocked by a door
 		}
+	}
+
+	const byte* bitvector = clientpvs;
+
+	// check individual leafs
+	if (!svEnt->numClusters)
+	{
+		return;
+	}
+	int l = 0;
 
-		if (ent->s.number != e)
+	for (i = 0; i < svEnt->numClusters; i++)
+	{
+		l = svEnt->clusternums[i];
+		if (bitvector[l >> 3] & (1 << (l & 7)))
 		{
-			Com_DPrintf("FIXING ENT->S.NUMBER!!!\n");
-			ent->s.number = e;
+			break;
 		}
+	}
 
-		// never send entities that aren't linked in
-		if (!ent->linked)
+	// if we haven't found it to be visible,
+	// check overflow clusters that coudln't be stored
+	if (i == svEnt->numClusters)
+	{
+		if (svEnt->lastCluster)
 		{
-			continue;
+			for (; l <= svEnt->lastCluster; l++)
+			{
+				if (bitvector[l >> 3] & (1 << (l & 7)))
+				{
+					break;
+				}
+			}
+			if (l == svEnt->lastCluster)
+			{
+				return; // not visible
+			}
 		}
-
-		// entities can be flagged to explicitly not be sent to the client
-		if (ent->svFlags & SVF_NOCLIENT)
+		else
 		{
-			continue;
+			return;
 		}
+	}
 
-		svEnt = SV_SvEntityForGentity(ent);
+	// add it
+	SV_AddEntToSnapshot(svEnt, ent, eNums);
 
-		// don't double add an entity through portals
-		if (svEnt->snapshotCounter == sv.snapshotCounter)
-		{
-			continue;
-		}
+	// if its a portal entity, add everything visible from its camera position
+	if (ent->svFlags & SVF_PORTAL)
+	{
+		SV_AddEntitiesVisibleFromPoint(ent->s.origin2, frame, eNums, qtrue, useBuckets);
+	}
+}
 
-		// broadcast entities are always sent, and so is the main player so we don't see noclip weirdness
-		if (ent->svFlags & SVF_BROADCAST || !e)
-		{
-			SV_AddEntToSnapshot(svEnt, ent, eNums);
-			continue;
-		}
+/*
+===============
+SV_AddEntitiesVisibleFromPoint
 
-#ifndef JK2_MODE
-		if (ent->s.isPortalEnt)
-		{
-			//rww - portal entities are always sent as well
-			SV_AddEntToSnapshot(svEnt, ent, eNums);
-			continue;
-		}
-#endif // !JK2_MODE
+With useBuckets, only the entities linked into clusters in the viewer's
+PVS (plus the loose list) are tested instead of every entity in the game.
+===============
+*/
+static void SV_AddEntitiesVisibleFromPoint(vec3_t origin, clientSnapshot_t* frame,
+	snapshotEntityNumbers_t* eNums, const qboolean portal, const qboolean useBuckets)
+{
+	qboolean sightOn = qfalse;
+
+	// during an error shutdown message we may need to transmit
+	// the shutdown message after the server has shutdown, so
+	// specfically check for it
+	if (!sv.state)
+	{
+		return;
+	}
+
+	const int leafnum = CM_PointLeafnum(origin);
+	const int clientarea = CM_LeafArea(leafnum);
+	const int clientcluster = CM_LeafCluster(leafnum);
+
+	// calculate the visible areas
+	frame->areabytes = CM_WriteAreaBits(frame->areabits, clientarea);
+
+	const byte* clientpvs = CM_ClusterPVS(clientcluster);
 
 #ifndef JK2_MODE
-		if (sightOn)
+	if (!portal)
+	{
+		//not if this if through a portal...???  James said to do this...
+		if ((frame->ps.forcePowersActive & (1 << FP_SEE)))
 		{
-			//force sight is on, sees through portals, so draw them always if in radius
-			if (SV_PlayerCanSeeEnt(ent, frame->ps.forcePowerLevel[FP_SEE]))
-			{
-				//entity is visible
-				SV_AddEntToSnapshot(svEnt, ent, eNums);
-				continue;
-			}
+			sightOn = qtrue;
 		}
+	}
 #endif // !JK2_MODE
 
-		// ignore if not touching a PV leaf
-		// check area
-		if (!CM_AreasConnected(clientarea, svEnt->areanum))
+	// force sight can pick up anything in range, so it has to see everything
+	if (useBuckets && !sightOn)
+	{
+		int candidates[MAX_GENTITIES];
+
+		SV_AddEntityIfVisible(0, frame, eNums, clientarea, clientpvs, sightOn, useBuckets);
+
+		const int numCandidates = SV_GatherVisibleEntities(clientpvs, candidates, MAX_GENTITIES);
+		for (int i = 0; i < numCandidates; i++)
 		{
-			// doors can legally straddle two areas, so
-			// we may need to check another one
-			if (!CM_AreasConnected(clientarea, svEnt->areanum2))
+			if (candidates[i] < ge->num_entities)
 			{
-				continue; // blocked by a door
+				SV_AddEntityIfVisible(candidates[i], frame, eNums, clientarea, clientpvs, sightOn, useBuckets);
 			}
 		}
+		return;
+	}
 
-		bitvector = clientpvs;
+	for (int e = 0; e < ge->num_entities; e++)
+	{
+		SV_AddEntityIfVisible(e, frame, eNums, clientarea, clientpvs, sightOn, useBuckets);
+	}
+}
 
-		// check individual leafs
-		if (!svEnt->numClusters)
-		{
-			continue;
-		}
-		l = 0;
+/*
+=============
+SV_VerifySnapshotBuckets
+
+Rebuilds the entity list with the full scan and reports any entity the
+cluster buckets added or missed.  Both lists must already be sorted.
+=============
+*/
+static void SV_VerifySnapshotBuckets(const snapshotEntityNumbers_t* buckets, const snapshotEntityNumbers_t* full)
+{
+	int b = 0, f = 0;
 
-		for (i = 0; i < svEnt->numClusters; i++)
+	while (b < buckets->numSnapshotEntities || f < full->numSnapshotEntities)
+	{
+		if (f == full->numSnapshotEntities
+			|| (b < buckets->numSnapshotEntities && buckets->snapshotEntities[b] < full->snapshotEntities[f]))
 		{
-			l = svEnt->clusternums[i];
-			if (bitvector[l >> 3] & (1 << (l & 7)))
-			{
-				break;
-			}
+			Com_Printf(S_COLOR_YELLOW "snapshot buckets: entity %i sent but not visible\n",
+				buckets->snapshotEntities[b++]);
 		}
-
-		// if we haven't found it to be visible,
-		// check overflow clusters that coudln't be stored
-		if (i == svEnt->numClusters)
+		else if (b == buckets->numSnapshotEntities || full->snapshotEntities[f] < buckets->snapshotEntities[b])
 		{
-			if (svEnt->lastCluster)
-			{
-				for (; l <= svEnt->lastCluster; l++)
-				{
-					if (bitvector[l >> 3] & (1 << (l & 7)))
-					{
-						break;
-					}
-				}
-				if (l == svEnt->lastCluster)
-				{
-					continue; // not visible
-				}
-			}
-			else
-			{
-				continue;
-			}
+			Com_Printf(S_COLOR_YELLOW "snapshot buckets: entity %i visible but not sent\n",
+				full->snapshotEntities[f++]);
 		}
-
-		// add it
-		SV_AddEntToSnapshot(svEnt, ent, eNums);
-
-		// if its a portal entity, add everything visible from its camera position
-		if (ent->svFlags & SVF_PORTAL)
+		else
 		{
-			SV_AddEntitiesVisibleFromPoint(ent->s.origin2, frame, eNums, qtrue);
+			b++;
+			f++;
 		}
 	}
 }
@@ -632,7 +752,12 @@ static clientSnapshot_t* SV_BuildClientSnapshot(client_t* client)
 
 	// add all the entities directly visible to the eye, which
 	// may include portal entities that merge other viewpoints
-	SV_AddEntitiesVisibleFromPoint(org, frame, &entityNumbers, qfalse);
+	const qboolean useBuckets = static_cast<qboolean>(sv_snapshotBuckets->integer != 0);
+	if (useBuckets)
+	{
+		SV_RefreshLooseEntities();
+	}
+	SV_AddEntitiesVisibleFromPoint(org, frame, &entityNumbers, qfalse, useBuckets);
 
 	// if there were portals visible, there may be out of order entities
 	// in the list which will need to be resorted for the delta compression
@@ -641,6 +766,20 @@ static clientSnapshot_t* SV_BuildClientSnapshot(client_t* client)
 	qsort(entityNumbers.snapshotEntities, entityNumbers.numSnapshotEntities,
 		sizeof(entityNumbers.snapshotEntities[0]), SV_QsortEntityNumbers);
 
+	if (sv_snapshotBuckets->integer == 2)
+	{
+		// check against the full scan and send what it found
+		static snapshotEntityNumbers_t bucketNumbers;
+
+		bucketNumbers = entityNumbers;
+		entityNumbers.numSnapshotEntities = 0;
+		sv.snapshotCounter++;
+		SV_AddEntitiesVisibleFromPoint(org, frame, &entityNumbers, qfalse, qfalse);
+		qsort(entityNumbers.snapshotEntities, entityNumbers.numSnapshotEntities,
+			sizeof(entityNumbers.snapshotEntities[0]), SV_QsortEntityNumbers);
+		SV_VerifySnapshotBuckets(&bucketNumbers, &entityNumbers);
+	}
+
 	// now that all viewpoint's areabits have been OR'd together, invert
 	// all of them to make it a mask vector, which is what the renderer wants
 	for (i = 0; i < MAX_MAP_AREA_BYTES / 4; i++)
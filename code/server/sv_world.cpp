@@ -145,6 +145,219 @@ worldSector_t* SV_CreateworldSector(const int depth, vec3_t mins, vec3_t maxs)
 	return anode;
 }
 
+/*
+===============================================================================
+
+CLUSTER BUCKETS
+
+Every linked entity is also threaded onto a chain for each PVS cluster it
+touches, so building a snapshot only has to look at the entities sitting in
+clusters the viewer can see.  Entities that can be sent from anywhere
+(broadcast and portal ents), and entities whose clusters overflowed
+clusternums, are kept on a separate loose list that is always checked.
+
+The chains are only used to find candidates; every candidate still goes
+through the full visibility test, so a stale link can never add anything.
+
+===============================================================================
+*/
+
+// link k of entity e is node e * MAX_ENT_CLUSTERS + k
+constexpr auto MAX_CLUSTER_LINKS = MAX_GENTITIES * MAX_ENT_CLUSTERS;
+
+static int sv_clusterHeads[MAX_MAP_LEAFS]; // first link in each cluster, -1 if empty
+static int sv_numClusterHeads;
+static int sv_clusterLinkNext[MAX_CLUSTER_LINKS];
+static int sv_clusterLinkPrev[MAX_CLUSTER_LINKS];
+static int sv_clusterLinkCluster[MAX_CLUSTER_LINKS];
+static int sv_numEntClusterLinks[MAX_GENTITIES];
+static qboolean sv_entClusterOverflow[MAX_GENTITIES];
+
+static int sv_looseEnts[MAX_GENTITIES];
+static int sv_looseIndex[MAX_GENTITIES]; // slot in sv_looseEnts, -1 if not loose
+static int sv_numLooseEnts;
+
+static int sv_candidateStamp[MAX_GENTITIES];
+static int sv_candidateCount;
+
+static void SV_ClearClusterBuckets()
+{
+	sv_numClusterHeads = cmg.numClusters;
+	if (sv_numClusterHeads > MAX_MAP_LEAFS)
+	{
+		sv_numClusterHeads = MAX_MAP_LEAFS;
+	}
+	memset(sv_clusterHeads, -1, sizeof(sv_clusterHeads[0]) * sv_numClusterHeads);
+	memset(sv_numEntClusterLinks, 0, sizeof(sv_numEntClusterLinks));
+	memset(sv_entClusterOverflow, 0, sizeof(sv_entClusterOverflow));
+	memset(sv_looseIndex, -1, sizeof(sv_looseIndex));
+	sv_numLooseEnts = 0;
+	memset(sv_candidateStamp, 0, sizeof(sv_candidateStamp));
+	sv_candidateCount = 0;
+}
+
+static void SV_SetLooseEntity(const int e, const bool loose)
+{
+	if (loose == (sv_looseIndex[e] != -1))
+	{
+		return;
+	}
+
+	if (loose)
+	{
+		sv_looseIndex[e] = sv_numLooseEnts;
+		sv_looseEnts[sv_numLooseEnts++] = e;
+		return;
+	}
+
+	const int slot = sv_looseIndex[e];
+	const int last = sv_looseEnts[--sv_numLooseEnts];
+	sv_looseEnts[slot] = last;
+	sv_looseIndex[last] = slot;
+	sv_looseIndex[e] = -1;
+}
+
+static bool SV_EntityWantsLooseList(const gentity_t* g_ent)
+{
+	if (sv_entClusterOverflow[g_ent->s.number] || g_ent->svFlags & SVF_BROADCAST)
+	{
+		return true;
+	}
+#ifndef JK2_MODE
+	if (g_ent->s.isPortalEnt)
+	{
+		return true;
+	}
+#endif // !JK2_MODE
+	return false;
+}
+
+static void SV_UnlinkClusterBuckets(const int e)
+{
+	const int first = e * MAX_ENT_CLUSTERS;
+	for (int link = first; link < first + sv_numEntClusterLinks[e]; link++)
+	{
+		const int next = sv_clusterLinkNext[link];
+		const int prev = sv_clusterLinkPrev[link];
+		if (prev == -1)
+		{
+			sv_clusterHeads[sv_clusterLinkCluster[link]] = next;
+		}
+		else
+		{
+			sv_clusterLinkNext[prev] = next;
+		}
+		if (next != -1)
+		{
+			sv_clusterLinkPrev[next] = prev;
+		}
+	}
+	sv_numEntClusterLinks[e] = 0;
+	sv_entClusterOverflow[e] = qfalse;
+	SV_SetLooseEntity(e, false);
+}
+
+static void SV_LinkClusterBuckets(const gentity_t* g_ent, const svEntity_t* ent, const qboolean overflow)
+{
+	const int e = g_ent->s.number;
+	const int first = e * MAX_ENT_CLUSTERS;
+
+	sv_entClusterOverflow[e] = overflow;
+	for (int i = 0; i < ent->numClusters; i++)
+	{
+		const int cluster = ent->clusternums[i];
+		if (cluster < 0 || cluster >= sv_numClusterHeads)
+		{
+			// not a cluster the PVS knows about, always check it
+			sv_entClusterOverflow[e] = qtrue;
+			continue;
+		}
+
+		const int link = first + sv_numEntClusterLinks[e]++;
+		sv_clusterLinkCluster[link] = cluster;
+		sv_clusterLinkPrev[link] = -1;
+		sv_clusterLinkNext[link] = sv_clusterHeads[cluster];
+		if (sv_clusterHeads[cluster] != -1)
+		{
+			sv_clusterLinkPrev[sv_clusterHeads[cluster]] = link;
+		}
+		sv_clusterHeads[cluster] = link;
+	}
+
+	SV_SetLooseEntity(e, SV_EntityWantsLooseList(g_ent));
+}
+
+/*
+===============
+SV_RefreshLooseEntities
+
+Game code flags entities for broadcast, or makes them portals, without
+relinking them (Q3_SetBroadcast, G_SetViewEntity...), so the flags of every
+entity are looked at again before each snapshot.  That is only a few flag
+tests per entity, the PVS work is what the buckets save.
+===============
+*/
+void SV_RefreshLooseEntities()
+{
+	for (int e = 0; e < ge->num_entities; e++)
+	{
+		const gentity_t* g_ent = SV_GentityNum(e);
+		SV_SetLooseEntity(e, g_ent->inuse && g_ent->linked && SV_EntityWantsLooseList(g_ent));
+	}
+
+	// anything past num_entities has been freed
+	for (int i = sv_numLooseEnts - 1; i >= 0; i--)
+	{
+		if (sv_looseEnts[i] >= ge->num_entities)
+		{
+			SV_SetLooseEntity(sv_looseEnts[i], false);
+		}
+	}
+}
+
+/*
+===============
+SV_GatherVisibleEntities
+
+Fills ents with every entity that is loose or linked into a cluster set in
+the given PVS row, each at most once.  Returns the count.
+===============
+*/
+int SV_GatherVisibleEntities(const byte* pvs, int* ents, const int maxEnts)
+{
+	int count = 0;
+
+	sv_candidateCount++;
+
+	for (int i = 0; i < sv_numLooseEnts && count < maxEnts; i++)
+	{
+		const int e = sv_looseEnts[i];
+		sv_candidateStamp[e] = sv_candidateCount;
+		ents[count++] = e;
+	}
+
+	for (int cluster = 0; cluster < sv_numClusterHeads && count < maxEnts; cluster++)
+	{
+		if (!(pvs[cluster >> 3] & (1 << (cluster & 7))))
+		{
+			continue;
+		}
+
+		for (int link = sv_clusterHeads[cluster]; link != -1 && count < maxEnts; link = sv_clusterLinkNext[link])
+		{
+			const int e = link / MAX_ENT_CLUSTERS;
+			if (sv_candidateStamp[e] == sv_candidateCount)
+			{
+				continue;
+			}
+			sv_candidateStamp[e] = sv_candidateCount;
+			ents[count++] = e;
+		}
+	}
+
+	return count;
+}
+
 /*
 ===============
 SV_ClearWorld
@@ -162,6 +375,8 @@ void SV_ClearWorld()
 	const clipHandle_t h = CM_InlineModel(0);
 	CM_ModelBounds(h, mins, maxs);
 	SV_CreateworldSector(0, mins, maxs);
+
+	SV_ClearClusterBuckets();
 }
 
 /*
@@ -182,6 +397,8 @@ void SV_UnlinkEntity(gentity_t* g_ent)
 
 	g_ent->linked = qfalse;
 
+	SV_UnlinkClusterBuckets(g_ent->s.number);
+
 	worldSector_t* ws = ent->worldSector;
 	if (!ws)
 	{
@@ -233,6 +450,11 @@ void SV_LinkEntity(gentity_t* g_ent)
 	{
 		SV_UnlinkEntity(g_ent); // unlink from old position
 	}
+	else
+	{
+		// a freed slot can be reused without ever being unlinked
+		SV_UnlinkClusterBuckets(g_ent->s.number);
+	}
 
 	// encode the size into the entityState_t for client prediction
 	if (g_ent->bmodel)
@@ -382,6 +604,8 @@ void SV_LinkEntity(gentity_t* g_ent)
 	ent->nextEntityInWorldSector = node->entities;
 	node->entities = ent;
 
+	SV_LinkClusterBuckets(g_ent, ent, static_cast<qboolean>(i != num_leafs));
+
 	g_ent->linked = qtrue;
 }
 
@@ -613,17 +837,15 @@ using moveclip_t = struct
 
 /*
 ====================
-SV_ClipMoveToEntities
+SV_ClipMoveToEntityList
 
 ====================
 */
-void SV_ClipMoveToEntities(moveclip_t* clip)
+static void SV_ClipMoveToEntityList(moveclip_t* clip, gentity_t* const* touchlist, const int num)
 {
-	gentity_t* touchlist[MAX_GENTITIES], * owner;
+	gentity_t* owner;
 	trace_t trace, oldTrace;
 
-	const int num = SV_AreaEntities(clip->boxmins, clip->boxmaxs, touchlist, MAX_GENTITIES);
-
 	if (clip->passEntityNum != ENTITYNUM_NONE)
 	{
 		owner = (SV_GentityNum(clip->passEntityNum))->owner;
@@ -860,22 +1082,65 @@ void SV_ClipMoveToEntities(moveclip_t* clip)
 }
 
 /*
-==================
-SV_Trace
+====================
+SV_ClipMoveToEntities
 
-Moves the given mins/maxs volume through the world from start to end.
-passEntityNum and entities owned by passEntityNum are explicitly not checked.
-==================
+====================
 */
+void SV_ClipMoveToEntities(moveclip_t* clip)
+{
+	gentity_t* touchlist[MAX_GENTITIES];
+
+	const int num = SV_AreaEntities(clip->boxmins, clip->boxmaxs, touchlist, MAX_GENTITIES);
+
+	SV_ClipMoveToEntityList(clip, touchlist, num);
+}
+
 /*
-Ghoul2 Insert Start
+====================
+SV_ClipMoveToGatheredEntities
+
+Same as SV_ClipMoveToEntities, but picks the entities out of a list that was
+gathered for a larger box.  The area tree is walked in a fixed order, so the
+filtered list comes out in the same order SV_AreaEntities would give.
+====================
 */
-void SV_Trace(trace_t* results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end,
-	const int passEntityNum, const int contentmask, const EG2_Collision eG2TraceType, const int useLod)
+static void SV_ClipMoveToGatheredEntities(moveclip_t* clip, gentity_t* const* gathered, const int numGathered)
+{
+	gentity_t* touchlist[MAX_GENTITIES];
+	int num = 0;
+
+	for (int i = 0; i < numGathered; i++)
+	{
+		gentity_t* check = gathered[i];
+
+		if (check->absmin[0] > clip->boxmaxs[0]
+			|| check->absmin[1] > clip->boxmaxs[1]
+			|| check->absmin[2] > clip->boxmaxs[2]
+			|| check->absmax[0] < clip->boxmins[0]
+			|| check->absmax[1] < clip->boxmins[1]
+			|| check->absmax[2] < clip->boxmins[2])
+		{
+			continue;
+		}
+		touchlist[num++] = check;
+	}
+
+	SV_ClipMoveToEntityList(clip, touchlist, num);
+}
+
+/*
+==================
+SV_TraceInternal
+
+Does the work for SV_Trace and SV_TraceBatch.  With a gathered list the
+entities are taken from it instead of asking the area tree again.
+==================
+*/
+static void SV_TraceInternal(trace_t* results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end,
+	const int passEntityNum, const int contentmask, const EG2_Collision eG2TraceType, const int useLod,
+	gentity_t* const* gathered, const int numGathered)
 {
-	/*
-	Ghoul2 Insert End
-	*/
 #ifdef _DEBUG
 	assert(
 		!Q_isnan(start[0]) && !Q_isnan(start[1]) && !Q_isnan(start[2]) && !Q_isnan(end[0]) && !Q_isnan(end[1]) && !
@@ -974,7 +1239,14 @@ void SV_Trace(trace_t* results, const vec3_t start, const vec3_t mins, const vec
 	}
 
 	// clip to other solid entities
-	SV_ClipMoveToEntities(&clip);
+	if (gathered)
+	{
+		SV_ClipMoveToGatheredEntities(&clip, gathered, numGathered);
+	}
+	else
+	{
+		SV_ClipMoveToEntities(&clip);
+	}
 
 	//scale the trace back down by the previous fraction
 	clip.trace.fraction *= world_frac;
@@ -988,6 +1260,85 @@ void SV_Trace(trace_t* results, const vec3_t start, const vec3_t mins, const vec
 	*/
 }
 
+/*
+==================
+SV_Trace
+
+Moves the given mins/maxs volume through the world from start to end.
+passEntityNum and entities owned by passEntityNum are explicitly not checked.
+==================
+*/
+/*
+Ghoul2 Insert Start
+*/
+void SV_Trace(trace_t* results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end,
+	const int passEntityNum, const int contentmask, const EG2_Collision eG2TraceType, const int useLod)
+{
+	/*
+	Ghoul2 Insert End
+	*/
+	SV_TraceInternal(results, start, mins, maxs, end, passEntityNum, contentmask, eG2TraceType, useLod, nullptr, 0);
+}
+
+/*
+==================
+SV_TraceBatch
+
+Traces a group of boxes that share a pass entity and content mask, such as
+all the effector probes of one ragdoll.  The entities near the whole group
+are gathered once, rather than walking the area tree for every trace.
+==================
+*/
+void SV_TraceBatch(traceQuery_t* queries, const int count, const int passEntityNum, const int contentmask)
+{
+	gentity_t* gathered[MAX_GENTITIES];
+	vec3_t batchMins, batchMaxs;
+	trace_t trace;
+
+	if (count <= 0)
+	{
+		return;
+	}
+
+	// bound every full move, which covers each world-shortened box SV_Trace would use
+	ClearBounds(batchMins, batchMaxs);
+	for (int i = 0; i < count; i++)
+	{
+		const traceQuery_t& q = queries[i];
+
+		for (int j = 0; j < 3; j++)
+		{
+			const float lo = (q.start[j] < q.end[j] ? q.start[j] : q.end[j]) + q.mins[j] - 1;
+			const float hi = (q.start[j] > q.end[j] ? q.start[j] : q.end[j]) + q.maxs[j] + 1;
+
+			if (lo < batchMins[j])
+			{
+				batchMins[j] = lo;
+			}
+			if (hi > batchMaxs[j])
+			{
+				batchMaxs[j] = hi;
+			}
+		}
+	}
+
+	const int numGathered = SV_AreaEntities(batchMins, batchMaxs, gathered, MAX_GENTITIES);
+
+	for (int i = 0; i < count; i++)
+	{
+		traceQuery_t& q = queries[i];
+
+		SV_TraceInternal(&trace, q.start, q.mins, q.maxs, q.end, passEntityNum, contentmask, G2_NOCOLLIDE, 0,
+			gathered, numGathered);
+
+		q.allsolid = trace.allsolid;
+		q.startsolid = trace.startsolid;
+		q.fraction = trace.fraction;
+		VectorCopy(trace.endpos, q.endpos);
+		q.entityNum = trace.entityNum;
+	}
+}
+
 /*
 =============
 SV_PointContents
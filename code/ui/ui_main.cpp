@@ -4213,7 +4213,8 @@ static void UI_DrawKeyBindStatus(rectDef_t* rect, float scale, vec4_t color, int
 #ifdef JK2_MODE
 		Text_Paint(rect->x, rect->y, scale, color, ui.SP_GetStringTextString("MENUS_WAITINGFORKEY"), 0, textStyle, iFontIndex);
 #else
-		Text_Paint(rect->x, rect->y, scale, color, SE_GetString("MENUS_WAITINGFORKEY"), 0, textStyle, iFontIndex);
+		static const int hWaitingForKey = SE_GetStringHandle("MENUS_WAITINGFORKEY");
+		Text_Paint(rect->x, rect->y, scale, color, SE_GetStringByHandle(hWaitingForKey), 0, textStyle, iFontIndex);
 #endif
 	}
 	else
@@ -4466,7 +4467,8 @@ int UI_OwnerDrawWidth(const int ownerDraw, const float scale)
 #ifdef JK2_MODE
 			s = ui.SP_GetStringTextString("MENUS_WAITINGFORKEY");
 #else
-			s = SE_GetString("MENUS_WAITINGFORKEY");
+			static const int hWaitingForKey = SE_GetStringHandle("MENUS_WAITINGFORKEY");
+			s = SE_GetStringByHandle(hWaitingForKey);
 #endif
 		}
 		else
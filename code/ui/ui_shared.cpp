@@ -6848,7 +6848,8 @@ static void BindingFromName(const char* cvar)
 #ifdef JK2_MODE
 				Q_strncpyz(sOR, ui.SP_GetStringTextString("MENUS3_KEYBIND_OR"), sizeof(sOR));
 #else
-				Q_strncpyz(sOR, SE_GetString("MENUS_KEYBIND_OR"), sizeof sOR);
+				static const int hOR = SE_GetStringHandle("MENUS_KEYBIND_OR");
+				Q_strncpyz(sOR, SE_GetStringByHandle(hOR), sizeof sOR);
 #endif
 
 				Com_sprintf(g_nameBind, sizeof g_nameBind, "%s %s %s", keyname[0], sOR, keyname[1]);
@@ -7371,8 +7372,10 @@ static void Item_YesNo_Paint(itemDef_t* item)
 	const char* psYes = ui.SP_GetStringTextString("MENUS0_YES");
 	const char* psNo = ui.SP_GetStringTextString("MENUS0_NO");
 #else
-	const char* psYes = SE_GetString("MENUS_YES");
-	const char* psNo = SE_GetString("MENUS_NO");
+	static const int hYes = SE_GetStringHandle("MENUS_YES");
+	static const int hNo = SE_GetStringHandle("MENUS_NO");
+	const char* psYes = SE_GetStringByHandle(hYes);
+	const char* psNo = SE_GetStringByHandle(hNo);
 #endif
 	const char* yesnovalue;
 
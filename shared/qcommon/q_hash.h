@@ -0,0 +1,61 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// q_hash.h -- FNV-1a, for hash tables and checksums that only have to be
+// cheap and well spread.  The 64-bit variant is for keys that name things on
+// disk, where a 32-bit collision would be a real risk.
+//
+// Pulled in by q_shared.h; kept on its own so headers the unit tests build
+// without the rest of q_shared.h can use it too.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+constexpr unsigned int FNV1A_INIT = 2166136261u;
+
+// mixes a whole value in as one step
+inline unsigned int Com_HashFNV1a(const unsigned int hash, const unsigned int value)
+{
+	return (hash ^ value) * 16777619u;
+}
+
+inline unsigned int Com_HashFNV1aBytes(unsigned int hash, const void* data, const size_t length)
+{
+	const auto bytes = static_cast<const unsigned char*>(data);
+	for (size_t i = 0; i < length; i++)
+	{
+		hash = Com_HashFNV1a(hash, bytes[i]);
+	}
+	return hash;
+}
+
+constexpr uint64_t FNV1A64_INIT = 14695981039346656037ull;
+
+inline uint64_t Com_HashFNV1a64Bytes(uint64_t hash, const void* data, const size_t length)
+{
+	const auto bytes = static_cast<const unsigned char*>(data);
+	for (size_t i = 0; i < length; i++)
+	{
+		hash = (hash ^ bytes[i]) * 1099511628211ull;
+	}
+	return hash;
+}
@@ -24,6 +24,12 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 
 #include "q_platform.h"
 
+// C++ modules built with Q_MATH_INLINE get the vector helpers marked below
+// from q_math_inline.h instead of q_math.c
+#if defined(Q_MATH_INLINE) && defined(__cplusplus)
+#define Q_MATH_USE_INLINE
+#endif
+
 #if defined(__cplusplus)
 extern "C" {
 #endif
@@ -145,16 +151,20 @@ extern "C" {
 	void ProjectPointOnPlane(vec3_t dst, const vec3_t p, const vec3_t normal);
 	qboolean G_FindClosestPointOnLineSegment(const vec3_t start, const vec3_t end, const vec3_t from, vec3_t result);
 	float G_PointDistFromLineSegment(const vec3_t start, const vec3_t end, const vec3_t from);
+#ifndef Q_MATH_USE_INLINE
 	void MatrixMultiply(float in1[3][3], float in2[3][3], float out[3][3]);
+#endif
 
 	///////////////////////////////////////////////////////////////////////////
 	//
 	//      BOUNDING BOX
 	//
 	///////////////////////////////////////////////////////////////////////////
+#ifndef Q_MATH_USE_INLINE
 	float RadiusFromBounds(const vec3_t mins, const vec3_t maxs);
 	void ClearBounds(vec3_t mins, vec3_t maxs);
 	void AddPointToBounds(const vec3_t v, vec3_t mins, vec3_t maxs);
+#endif
 
 	///////////////////////////////////////////////////////////////////////////
 	//
@@ -181,7 +191,9 @@ extern "C" {
 
 	void SetPlaneSignbits(cplane_t* out);
 	int	PlaneTypeForNormal(vec3_t normal);
+#ifndef Q_MATH_USE_INLINE
 	int BoxOnPlaneSide(vec3_t emins, vec3_t emaxs, const cplane_t* p);
+#endif
 
 	///////////////////////////////////////////////////////////////////////////
 	//
@@ -190,9 +202,11 @@ extern "C" {
 	///////////////////////////////////////////////////////////////////////////
 	extern matrix3_t axisDefault;
 
+#ifndef Q_MATH_USE_INLINE
 	void AxisClear(matrix3_t axis);
 	void AxisCopy(matrix3_t in, matrix3_t out);
 	void AnglesToAxis(const vec3_t angles, matrix3_t axis);
+#endif
 
 	///////////////////////////////////////////////////////////////////////////
 	//
@@ -210,6 +224,7 @@ extern "C" {
 #define VectorClear2M(dst) \
 	memset((dst), 0, sizeof((dst)[0]) * 2)
 
+#ifndef Q_MATH_USE_INLINE
 	void VectorAdd2(const vec2_t vec1, const vec2_t vec2, vec2_t vecOut);
 	void VectorSubtract2(const vec2_t vec1, const vec2_t vec2, vec2_t vecOut);
 	void VectorScale2(const vec2_t vecIn, float scale, vec2_t vecOut);
@@ -217,6 +232,7 @@ extern "C" {
 	void VectorSet2(vec2_t vec, float x, float y);
 	void VectorClear2(vec2_t vec);
 	void VectorCopy2(const vec2_t vecIn, vec2_t vecOut);
+#endif
 
 	///////////////////////////////////////////////////////////////////////////
 	//
@@ -236,6 +252,7 @@ extern "C" {
 #define VectorClearM(dst) \
 	memset((dst), 0, sizeof((dst)[0]) * 3)
 
+#ifndef Q_MATH_USE_INLINE
 	void VectorAdd(const vec3_t vec1, const vec3_t vec2, vec3_t vecOut);
 	void VectorSubtract(const vec3_t vec1, const vec3_t vec2, vec3_t vecOut);
 	void VectorScale(const vec3_t vecIn, float scale, vec3_t vecOut);
@@ -255,15 +272,16 @@ extern "C" {
 	void CrossProduct(const vec3_t vec1, const vec3_t vec2, vec3_t vecOut);
 	float DotProduct(const vec3_t vec1, const vec3_t vec2);
 	qboolean VectorCompare(const vec3_t vec1, const vec3_t vec2);
-	qboolean VectorCompare2(const vec3_t v1, const vec3_t v2);
-
-	void SnapVector(float* v);
 	float Distance(const vec3_t p1, const vec3_t p2);
 	float DistanceSquared(const vec3_t p1, const vec3_t p2);
 	float DistanceHorizontal(const vec3_t p1, const vec3_t p2);
 	float DistanceHorizontalSquared(const vec3_t p1, const vec3_t p2);
 	void MakeNormalVectors(const vec3_t forward, vec3_t right, vec3_t up);
 	void VectorRotate(const vec3_t in, matrix3_t matrix, vec3_t out);
+#endif
+	qboolean VectorCompare2(const vec3_t v1, const vec3_t v2);
+
+	void SnapVector(float* v);
 	void AngleVectors(const vec3_t angles, vec3_t forward, vec3_t right, vec3_t up);
 	void PerpendicularVector(vec3_t dst, const vec3_t src);
 	float DotProductNormalize(const vec3_t inVec1, const vec3_t inVec2);
@@ -279,18 +297,26 @@ extern "C" {
 	//      VEC4
 	//
 	///////////////////////////////////////////////////////////////////////////
+#ifndef Q_MATH_USE_INLINE
 	void VectorScale4(const vec4_t vecIn, float scale, vec4_t vecOut);
 	void VectorCopy4(const vec4_t vecIn, vec4_t vecOut);
 	void VectorSet4(vec4_t vec, float x, float y, float z, float w);
 	void VectorClear4(vec4_t vec);
+#endif
 
 	///////////////////////////////////////////////////////////////////////////
 	//
 	//      VEC5
 	//
 	///////////////////////////////////////////////////////////////////////////
+#ifndef Q_MATH_USE_INLINE
 	void VectorSet5(vec5_t vec, float x, float y, float z, float w, float u);
+#endif
 
 #if defined(__cplusplus)
 } // extern "C"
 #endif
+
+#ifdef Q_MATH_USE_INLINE
+#include "q_math_inline.h"
+#endif
@@ -0,0 +1,562 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// q_math_inline.h -- header-only versions of the q_math.c vector helpers
+//
+// Same names, arguments and arithmetic (operation for operation) as the
+// out-of-line functions in q_math.c, so the results are bit for bit the same
+// and the compiler is free to inline and vectorize them at the call site.
+// tests/qcommon/q_math_inline.cpp holds the two implementations against each
+// other.
+//
+// A C++ module opts in by adding Q_MATH_INLINE to its compile definitions;
+// q_math.h then drops the out-of-line declarations of these functions and
+// pulls the qm:: versions into the global namespace instead.  C files always
+// get the out-of-line ones.  On x87 builds (32 bit without SSE math) inlining
+// can keep intermediates at higher precision, so there the bit exactness only
+// holds when the module is compiled with -mfpmath=sse.
+
+#pragma once
+
+#include "q_math.h"
+
+#include <math.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define Q_MATH_SIMD
+#include <emmintrin.h>
+#endif
+
+namespace qm
+{
+	///////////////////////////////////////////////////////////////////////////
+	//
+	//      VEC2
+	//
+	///////////////////////////////////////////////////////////////////////////
+	inline void VectorAdd2(const vec2_t vec1, const vec2_t vec2, vec2_t vecOut)
+	{
+		vecOut[0] = vec1[0] + vec2[0];
+		vecOut[1] = vec1[1] + vec2[1];
+	}
+
+	inline void VectorSubtract2(const vec2_t vec1, const vec2_t vec2, vec2_t vecOut)
+	{
+		vecOut[0] = vec1[0] - vec2[0];
+		vecOut[1] = vec1[1] - vec2[1];
+	}
+
+	inline void VectorScale2(const vec2_t vecIn, const float scale, vec2_t vecOut)
+	{
+		vecOut[0] = vecIn[0] * scale;
+		vecOut[1] = vecIn[1] * scale;
+	}
+
+	inline void VectorMA2(const vec2_t vec1, const float scale, const vec2_t vec2, vec2_t vecOut)
+	{
+		vecOut[0] = vec1[0] + scale * vec2[0];
+		vecOut[1] = vec1[1] + scale * vec2[1];
+	}
+
+	inline void VectorSet2(vec2_t vec, const float x, const float y)
+	{
+		vec[0] = x; vec[1] = y;
+	}
+
+	inline void VectorClear2(vec2_t vec)
+	{
+		vec[0] = vec[1] = 0.0f;
+	}
+
+	inline void VectorCopy2(const vec2_t vecIn, vec2_t vecOut)
+	{
+		vecOut[0] = vecIn[0];
+		vecOut[1] = vecIn[1];
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	//
+	//      VEC3
+	//
+	///////////////////////////////////////////////////////////////////////////
+	inline void VectorAdd(const vec3_t vec1, const vec3_t vec2, vec3_t vecOut)
+	{
+		vecOut[0] = vec1[0] + vec2[0];
+		vecOut[1] = vec1[1] + vec2[1];
+		vecOut[2] = vec1[2] + vec2[2];
+	}
+
+	inline void VectorSubtract(const vec3_t vec1, const vec3_t vec2, vec3_t vecOut)
+	{
+		vecOut[0] = vec1[0] - vec2[0];
+		vecOut[1] = vec1[1] - vec2[1];
+		vecOut[2] = vec1[2] - vec2[2];
+	}
+
+	inline void VectorScale(const vec3_t vecIn, const float scale, vec3_t vecOut)
+	{
+		vecOut[0] = vecIn[0] * scale;
+		vecOut[1] = vecIn[1] * scale;
+		vecOut[2] = vecIn[2] * scale;
+	}
+
+	inline void VectorMA(const vec3_t vec1, const float scale, const vec3_t vec2, vec3_t vecOut)
+	{
+		vecOut[0] = vec1[0] + scale * vec2[0];
+		vecOut[1] = vec1[1] + scale * vec2[1];
+		vecOut[2] = vec1[2] + scale * vec2[2];
+	}
+
+	inline void VectorSet(vec3_t vec, const float x, const float y, const float z)
+	{
+		vec[0] = x; vec[1] = y; vec[2] = z;
+	}
+
+	inline void VectorClear(vec3_t vec)
+	{
+		vec[0] = vec[1] = vec[2] = 0.0f;
+	}
+
+	inline void VectorCopy(const vec3_t vecIn, vec3_t vecOut)
+	{
+		vecOut[0] = vecIn[0];
+		vecOut[1] = vecIn[1];
+		vecOut[2] = vecIn[2];
+	}
+
+	constexpr float DotProduct(const vec3_t vec1, const vec3_t vec2)
+	{
+		return vec1[0] * vec2[0] + vec1[1] * vec2[1] + vec1[2] * vec2[2];
+	}
+
+	constexpr float VectorLengthSquared(const vec3_t vec)
+	{
+		return vec[0] * vec[0] + vec[1] * vec[1] + vec[2] * vec[2];
+	}
+
+	inline float VectorLength(const vec3_t vec)
+	{
+		return (float)sqrt((double)(vec[0] * vec[0] + vec[1] * vec[1] + vec[2] * vec[2]));
+	}
+
+	inline float Distance(const vec3_t p1, const vec3_t p2)
+	{
+		vec3_t v;
+
+		VectorSubtract(p2, p1, v);
+		return VectorLength(v);
+	}
+
+	inline float DistanceSquared(const vec3_t p1, const vec3_t p2)
+	{
+		vec3_t v;
+
+		VectorSubtract(p2, p1, v);
+		return v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+	}
+
+	inline float DistanceHorizontal(const vec3_t p1, const vec3_t p2)
+	{
+		vec3_t v;
+
+		VectorSubtract(p2, p1, v);
+		return sqrtf(v[0] * v[0] + v[1] * v[1]);
+	}
+
+	inline float DistanceHorizontalSquared(const vec3_t p1, const vec3_t p2)
+	{
+		vec3_t v;
+
+		VectorSubtract(p2, p1, v);
+		return v[0] * v[0] + v[1] * v[1];
+	}
+
+	inline void VectorNormalizeFast(vec3_t vec)
+	{
+		const float ilength = Q_rsqrt(DotProduct(vec, vec));
+
+		vec[0] *= ilength;
+		vec[1] *= ilength;
+		vec[2] *= ilength;
+	}
+
+	inline float VectorNormalize(vec3_t vec)
+	{
+		float length = vec[0] * vec[0] + vec[1] * vec[1] + vec[2] * vec[2];
+		length = sqrtf(length);
+
+		if (length) {
+			const float ilength = 1 / length;
+			vec[0] *= ilength;
+			vec[1] *= ilength;
+			vec[2] *= ilength;
+		}
+
+		return length;
+	}
+
+	inline float VectorNormalize2(const vec3_t vec, vec3_t vecOut)
+	{
+		float length = vec[0] * vec[0] + vec[1] * vec[1] + vec[2] * vec[2];
+		length = sqrtf(length);
+
+		if (length) {
+			const float ilength = 1 / length;
+			vecOut[0] = vec[0] * ilength;
+			vecOut[1] = vec[1] * ilength;
+			vecOut[2] = vec[2] * ilength;
+		}
+		else
+			VectorClear(vecOut);
+
+		return length;
+	}
+
+	inline void VectorAdvance(const vec3_t veca, const float scale, const vec3_t vecb, vec3_t vecc)
+	{
+		vecc[0] = veca[0] + scale * (vecb[0] - veca[0]);
+		vecc[1] = veca[1] + scale * (vecb[1] - veca[1]);
+		vecc[2] = veca[2] + scale * (vecb[2] - veca[2]);
+	}
+
+	inline void VectorInc(vec3_t vec)
+	{
+		vec[0] += 1.0f; vec[1] += 1.0f; vec[2] += 1.0f;
+	}
+
+	inline void VectorDec(vec3_t vec)
+	{
+		vec[0] -= 1.0f; vec[1] -= 1.0f; vec[2] -= 1.0f;
+	}
+
+	inline void VectorInverse(vec3_t vec)
+	{
+		vec[0] = -vec[0]; vec[1] = -vec[1]; vec[2] = -vec[2];
+	}
+
+	inline void CrossProduct(const vec3_t vec1, const vec3_t vec2, vec3_t vecOut)
+	{
+		vecOut[0] = vec1[1] * vec2[2] - vec1[2] * vec2[1];
+		vecOut[1] = vec1[2] * vec2[0] - vec1[0] * vec2[2];
+		vecOut[2] = vec1[0] * vec2[1] - vec1[1] * vec2[0];
+	}
+
+	inline qboolean VectorCompare(const vec3_t vec1, const vec3_t vec2)
+	{
+		return (qboolean)(vec1[0] == vec2[0] && vec1[1] == vec2[1] && vec1[2] == vec2[2]);
+	}
+
+	inline void VectorRotate(const vec3_t in, matrix3_t matrix, vec3_t out)
+	{
+		out[0] = DotProduct(in, matrix[0]);
+		out[1] = DotProduct(in, matrix[1]);
+		out[2] = DotProduct(in, matrix[2]);
+	}
+
+	inline void MakeNormalVectors(const vec3_t forward, vec3_t right, vec3_t up)
+	{
+		// this rotate and negate guarantees a vector
+		// not colinear with the original
+		right[1] = -forward[0];
+		right[2] = forward[1];
+		right[0] = forward[2];
+
+		const float d = DotProduct(right, forward);
+		VectorMA(right, -d, forward, right);
+		VectorNormalize(right);
+		CrossProduct(right, forward, up);
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	//
+	//      VEC4
+	//
+	///////////////////////////////////////////////////////////////////////////
+	inline void VectorScale4(const vec4_t vecIn, const float scale, vec4_t vecOut)
+	{
+#ifdef Q_MATH_SIMD
+		_mm_storeu_ps(vecOut, _mm_mul_ps(_mm_loadu_ps(vecIn), _mm_set1_ps(scale)));
+#else
+		vecOut[0] = vecIn[0] * scale;
+		vecOut[1] = vecIn[1] * scale;
+		vecOut[2] = vecIn[2] * scale;
+		vecOut[3] = vecIn[3] * scale;
+#endif
+	}
+
+	inline void VectorCopy4(const vec4_t vecIn, vec4_t vecOut)
+	{
+#ifdef Q_MATH_SIMD
+		_mm_storeu_ps(vecOut, _mm_loadu_ps(vecIn));
+#else
+		vecOut[0] = vecIn[0];
+		vecOut[1] = vecIn[1];
+		vecOut[2] = vecIn[2];
+		vecOut[3] = vecIn[3];
+#endif
+	}
+
+	inline void VectorSet4(vec4_t vec, const float x, const float y, const float z, const float w)
+	{
+		vec[0] = x; vec[1] = y; vec[2] = z; vec[3] = w;
+	}
+
+	inline void VectorClear4(vec4_t vec)
+	{
+#ifdef Q_MATH_SIMD
+		_mm_storeu_ps(vec, _mm_setzero_ps());
+#else
+		vec[0] = vec[1] = vec[2] = vec[3] = 0;
+#endif
+	}
+
+	inline void VectorSet5(vec5_t vec, const float x, const float y, const float z, const float w, const float u)
+	{
+		vec[0] = x; vec[1] = y; vec[2] = z; vec[3] = w; vec[4] = u;
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	//
+	//      BOUNDING BOX
+	//
+	///////////////////////////////////////////////////////////////////////////
+	inline float RadiusFromBounds(const vec3_t mins, const vec3_t maxs)
+	{
+		vec3_t corner;
+
+		for (int i = 0; i < 3; i++) {
+			const float a = fabsf(mins[i]);
+			const float b = fabsf(maxs[i]);
+			corner[i] = a > b ? a : b;
+		}
+
+		return VectorLength(corner);
+	}
+
+	inline void ClearBounds(vec3_t mins, vec3_t maxs)
+	{
+		mins[0] = mins[1] = mins[2] = 100000;
+		maxs[0] = maxs[1] = maxs[2] = -100000;
+	}
+
+	inline void AddPointToBounds(const vec3_t v, vec3_t mins, vec3_t maxs)
+	{
+		for (int i = 0; i < 3; i++) {
+			if (v[i] < mins[i]) {
+				mins[i] = v[i];
+			}
+			if (v[i] > maxs[i]) {
+				maxs[i] = v[i];
+			}
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	//
+	//      PLANE
+	//
+	///////////////////////////////////////////////////////////////////////////
+#ifdef Q_MATH_SIMD
+	inline __m128 LoadVec3(const vec3_t v)
+	{
+		// vec3_t arrays are not padded, so never read a fourth float
+		return _mm_setr_ps(v[0], v[1], v[2], 0.0f);
+	}
+
+	// x + y + z, added in that order so it rounds like the scalar loops
+	inline float HorizontalSum3(const __m128 v)
+	{
+		const __m128 xy = _mm_add_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+		return _mm_cvtss_f32(_mm_add_ss(xy, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))));
+	}
+#endif
+
+	/*
+	==================
+	BoxOnPlaneSide
+
+	Returns 1, 2, or 1 + 2
+	==================
+	*/
+	inline int BoxOnPlaneSide(vec3_t emins, vec3_t emaxs, const cplane_t* p)
+	{
+		// fast axial cases
+		if (p->type < 3)
+		{
+			if (p->dist <= emins[p->type])
+				return 1;
+			if (p->dist >= emaxs[p->type])
+				return 2;
+			return 3;
+		}
+
+		// general case
+		float dist[2] = { 0, 0 };
+		if (p->signbits < 8) // >= 8: default case is original code (dist[0]=dist[1]=0)
+		{
+#ifdef Q_MATH_SIMD
+			// lane i of the mask is set when normal[i] is negative, which is when
+			// the maxs go to dist[1] and the mins to dist[0]
+			const __m128i bits = _mm_and_si128(_mm_set1_epi32(p->signbits), _mm_setr_epi32(1, 2, 4, 8));
+			const __m128 negative = _mm_castsi128_ps(_mm_cmpeq_epi32(bits, _mm_setr_epi32(1, 2, 4, 8)));
+			const __m128 normal = LoadVec3(p->normal);
+			const __m128 toMaxs = _mm_mul_ps(normal, LoadVec3(emaxs));
+			const __m128 toMins = _mm_mul_ps(normal, LoadVec3(emins));
+			const __m128 near0 = _mm_or_ps(_mm_and_ps(negative, toMins), _mm_andnot_ps(negative, toMaxs));
+			const __m128 near1 = _mm_or_ps(_mm_and_ps(negative, toMaxs), _mm_andnot_ps(negative, toMins));
+			// 0 + x is x apart from the sign of zero, which the compares below can't see
+			dist[0] = HorizontalSum3(near0);
+			dist[1] = HorizontalSum3(near1);
+#else
+			for (int i = 0; i < 3; i++)
+			{
+				const int b = p->signbits >> i & 1;
+				dist[b] += p->normal[i] * emaxs[i];
+				dist[!b] += p->normal[i] * emins[i];
+			}
+#endif
+		}
+
+		int sides = 0;
+		if (dist[0] >= p->dist)
+			sides = 1;
+		if (dist[1] < p->dist)
+			sides |= 2;
+
+		return sides;
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	//
+	//      AXIS
+	//
+	///////////////////////////////////////////////////////////////////////////
+	inline void AxisClear(matrix3_t axis)
+	{
+		axis[0][0] = 1;
+		axis[0][1] = 0;
+		axis[0][2] = 0;
+		axis[1][0] = 0;
+		axis[1][1] = 1;
+		axis[1][2] = 0;
+		axis[2][0] = 0;
+		axis[2][1] = 0;
+		axis[2][2] = 1;
+	}
+
+	inline void AxisCopy(matrix3_t in, matrix3_t out)
+	{
+		VectorCopy(in[0], out[0]);
+		VectorCopy(in[1], out[1]);
+		VectorCopy(in[2], out[2]);
+	}
+
+	inline void AnglesToAxis(const vec3_t angles, matrix3_t axis)
+	{
+		vec3_t right;
+
+		// angle vectors returns "right" instead of "y axis"
+		AngleVectors(angles, axis[0], right, axis[2]);
+		VectorSubtract(vec3_origin, right, axis[1]);
+	}
+
+	inline void MatrixMultiply(float in1[3][3], float in2[3][3], float out[3][3])
+	{
+#ifdef Q_MATH_SIMD
+		// each output row is the in2 rows weighted by that row of in1, summed
+		// first to last like the scalar expression
+		const __m128 row0 = LoadVec3(in2[0]);
+		const __m128 row1 = LoadVec3(in2[1]);
+		const __m128 row2 = LoadVec3(in2[2]);
+		alignas(16) float result[3][4];
+
+		for (int i = 0; i < 3; i++)
+		{
+			__m128 sum = _mm_mul_ps(_mm_set1_ps(in1[i][0]), row0);
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(in1[i][1]), row1));
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(in1[i][2]), row2));
+			_mm_store_ps(result[i], sum);
+		}
+		for (int i = 0; i < 3; i++)
+		{
+			out[i][0] = result[i][0];
+			out[i][1] = result[i][1];
+			out[i][2] = result[i][2];
+		}
+#else
+		for (int i = 0; i < 3; i++)
+		{
+			for (int j = 0; j < 3; j++)
+			{
+				out[i][j] = in1[i][0] * in2[0][j] + in1[i][1] * in2[1][j] + in1[i][2] * in2[2][j];
+			}
+		}
+#endif
+	}
+}
+
+#ifdef Q_MATH_USE_INLINE
+using qm::VectorAdd2;
+using qm::VectorSubtract2;
+using qm::VectorScale2;
+using qm::VectorMA2;
+using qm::VectorSet2;
+using qm::VectorClear2;
+using qm::VectorCopy2;
+using qm::VectorAdd;
+using qm::VectorSubtract;
+using qm::VectorScale;
+using qm::VectorMA;
+using qm::VectorSet;
+using qm::VectorClear;
+using qm::VectorCopy;
+using qm::DotProduct;
+using qm::VectorLengthSquared;
+using qm::VectorLength;
+using qm::Distance;
+using qm::DistanceSquared;
+using qm::DistanceHorizontal;
+using qm::DistanceHorizontalSquared;
+using qm::VectorNormalizeFast;
+using qm::VectorNormalize;
+using qm::VectorNormalize2;
+using qm::VectorAdvance;
+using qm::VectorInc;
+using qm::VectorDec;
+using qm::VectorInverse;
+using qm::CrossProduct;
+using qm::VectorCompare;
+using qm::VectorRotate;
+using qm::MakeNormalVectors;
+using qm::VectorScale4;
+using qm::VectorCopy4;
+using qm::VectorSet4;
+using qm::VectorClear4;
+using qm::VectorSet5;
+using qm::RadiusFromBounds;
+using qm::ClearBounds;
+using qm::AddPointToBounds;
+using qm::BoxOnPlaneSide;
+using qm::AxisClear;
+using qm::AxisCopy;
+using qm::AnglesToAxis;
+using qm::MatrixMultiply;
+#endif
@@ -614,3 +614,8 @@ extern PFNGLGETDEBUGMESSAGELOGARBPROC qglGetDebugMessageLogARB;
 extern PFNGLQUERYCOUNTERPROC qglQueryCounter;
 extern PFNGLGETQUERYOBJECTI64VPROC qglGetQueryObjecti64v;
 extern PFNGLGETQUERYOBJECTUI64VPROC qglGetQueryObjectui64v;
+
+// GL_ARB_get_program_binary
+extern PFNGLGETPROGRAMBINARYPROC qglGetProgramBinary;
+extern PFNGLPROGRAMBINARYPROC qglProgramBinary;
+extern PFNGLPROGRAMPARAMETERIPROC qglProgramParameteri;
@@ -1636,15 +1636,12 @@ static const void* RB_SetColor(const void* data) {
 
 /*
 =============
-RB_StretchPic
+RB_BeginStretchPic
+
+Common setup for RB_StretchPic and RB_StretchPicBatch
 =============
 */
-static const void* RB_StretchPic(const void* data) {
-	const stretchPicCommand_t* cmd;
-	shader_t* shader;
-
-	cmd = (const stretchPicCommand_t*)data;
-
+static void RB_BeginStretchPic(shader_t* shader) {
 	// FIXME: HUGE hack
 	if (!tr.renderFbo || backEnd.framePostProcessed)
 	{
@@ -1657,7 +1654,6 @@ static const void* RB_StretchPic(const void* data) {
 
 	RB_SetGL2D();
 
-	shader = cmd->shader;
 	if (shader != tess.shader) {
 		if (tess.numIndexes) {
 			RB_EndSurface();
@@ -1665,7 +1661,14 @@ static const void* RB_StretchPic(const void* data) {
 		backEnd.currentEntity = &backEnd.entity2D;
 		RB_BeginSurface(shader, 0, 0);
 	}
+}
 
+/*
+=============
+RB_AddStretchPicQuad
+=============
+*/
+static void RB_AddStretchPicQuad(float x, float y, float w, float h, float s1, float t1, float s2, float t2, const float* color) {
 	RB_CHECKOVERFLOW(4, 6);
 	int numVerts = tess.numVertexes;
 	int numIndexes = tess.numIndexes;
@@ -1680,42 +1683,78 @@ static const void* RB_StretchPic(const void* data) {
 	tess.indexes[numIndexes + 4] = numVerts + 0;
 	tess.indexes[numIndexes + 5] = numVerts + 1;
 
-	VectorCopy4(backEnd.color2D, tess.vertexColors[numVerts]);
-	VectorCopy4(backEnd.color2D, tess.vertexColors[numVerts + 1]);
-	VectorCopy4(backEnd.color2D, tess.vertexColors[numVerts + 2]);
-	VectorCopy4(backEnd.color2D, tess.vertexColors[numVerts + 3]);
+	VectorCopy4(color, tess.vertexColors[numVerts]);
+	VectorCopy4(color, tess.vertexColors[numVerts + 1]);
+	VectorCopy4(color, tess.vertexColors[numVerts + 2]);
+	VectorCopy4(color, tess.vertexColors[numVerts + 3]);
 
-	tess.xyz[numVerts][0] = cmd->x;
-	tess.xyz[numVerts][1] = cmd->y;
+	tess.xyz[numVerts][0] = x;
+	tess.xyz[numVerts][1] = y;
 	tess.xyz[numVerts][2] = 0;
 
-	tess.texCoords[numVerts][0][0] = cmd->s1;
-	tess.texCoords[numVerts][0][1] = cmd->t1;
+	tess.texCoords[numVerts][0][0] = s1;
+	tess.texCoords[numVerts][0][1] = t1;
 
-	tess.xyz[numVerts + 1][0] = cmd->x + cmd->w;
-	tess.xyz[numVerts + 1][1] = cmd->y;
+	tess.xyz[numVerts + 1][0] = x + w;
+	tess.xyz[numVerts + 1][1] = y;
 	tess.xyz[numVerts + 1][2] = 0;
 
-	tess.texCoords[numVerts + 1][0][0] = cmd->s2;
-	tess.texCoords[numVerts + 1][0][1] = cmd->t1;
+	tess.texCoords[numVerts + 1][0][0] = s2;
+	tess.texCoords[numVerts + 1][0][1] = t1;
 
-	tess.xyz[numVerts + 2][0] = cmd->x + cmd->w;
-	tess.xyz[numVerts + 2][1] = cmd->y + cmd->h;
+	tess.xyz[numVerts + 2][0] = x + w;
+	tess.xyz[numVerts + 2][1] = y + h;
 	tess.xyz[numVerts + 2][2] = 0;
 
-	tess.texCoords[numVerts + 2][0][0] = cmd->s2;
-	tess.texCoords[numVerts + 2][0][1] = cmd->t2;
+	tess.texCoords[numVerts + 2][0][0] = s2;
+	tess.texCoords[numVerts + 2][0][1] = t2;
 
-	tess.xyz[numVerts + 3][0] = cmd->x;
-	tess.xyz[numVerts + 3][1] = cmd->y + cmd->h;
+	tess.xyz[numVerts + 3][0] = x;
+	tess.xyz[numVerts + 3][1] = y + h;
 	tess.xyz[numVerts + 3][2] = 0;
 
-	tess.texCoords[numVerts + 3][0][0] = cmd->s1;
-	tess.texCoords[numVerts + 3][0][1] = cmd->t2;
+	tess.texCoords[numVerts + 3][0][0] = s1;
+	tess.texCoords[numVerts + 3][0][1] = t2;
+}
+
+/*
+=============
+RB_StretchPic
+=============
+*/
+static const void* RB_StretchPic(const void* data) {
+	const stretchPicCommand_t* cmd;
+
+	cmd = (const stretchPicCommand_t*)data;
+
+	RB_BeginStretchPic(cmd->shader);
+	RB_AddStretchPicQuad(cmd->x, cmd->y, cmd->w, cmd->h, cmd->s1, cmd->t1, cmd->s2, cmd->t2, backEnd.color2D);
 
 	return (const void*)(cmd + 1);
 }
 
+/*
+=============
+RB_StretchPicBatch
+=============
+*/
+static const void* RB_StretchPicBatch(const void* data) {
+	const stretchPicBatchCommand_t* cmd;
+	const stretchPicQuad_t* quads;
+
+	cmd = (const stretchPicBatchCommand_t*)data;
+	quads = (const stretchPicQuad_t*)(cmd + 1);
+
+	RB_BeginStretchPic(cmd->shader);
+	for (int i = 0; i < cmd->numQuads; i++)
+	{
+		const stretchPicQuad_t* quad = &quads[i];
+		RB_AddStretchPicQuad(quad->x, quad->y, quad->w, quad->h, quad->s1, quad->t1, quad->s2, quad->t2, quad->color);
+	}
+
+	return (const void*)(quads + cmd->numQuads);
+}
+
 /*
 =============
 RB_DrawRotatePic
@@ -3074,6 +3113,9 @@ void RB_ExecuteRenderCommands(const void* data) {
 		case RC_STRETCH_PIC:
 			data = RB_StretchPic(data);
 			break;
+		case RC_STRETCH_PIC_BATCH:
+			data = RB_StretchPicBatch(data);
+			break;
 		case RC_ROTATE_PIC:
 			data = RB_RotatePic(data);
 			break;
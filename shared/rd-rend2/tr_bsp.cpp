@@ -3328,6 +3328,7 @@ static void R_LoadWeatherZones(world_t* worldData, lump_t* brushesLump, lump_t*
 	sidesCount = sidesLump->filelen / sizeof(*sides);
 
 	tr.weatherSystem->weatherBrushType = WEATHER_BRUSHES_NONE;
+	tr.weatherSystem->numWeatherBrushes = 0;
 
 	for (int i = 0; i < brushesCount; i++, brushes++) {
 		dshader_t* currentShader = worldData->shaders + brushes->shaderNum;
@@ -3358,6 +3359,8 @@ static void R_LoadWeatherZones(world_t* worldData, lump_t* brushesLump, lump_t*
 
 		R_AddWeatherBrush((uint8_t)brushes->numSides, planes);
 	}
+
+	R_BuildWeatherBrushGrid();
 }
 
 /*
@@ -4266,6 +4269,7 @@ world_t* R_LoadBSP(const char* name, int* bspIndex)
 		&header->lumps[LUMP_DRAWVERTS],
 		&header->lumps[LUMP_DRAWINDEXES]);
 	R_LoadMarksurfaces(worldData, &header->lumps[LUMP_LEAFSURFACES]);
+	R_BuildMarkBVH(worldData);
 	R_LoadNodesAndLeafs(worldData, &header->lumps[LUMP_NODES], &header->lumps[LUMP_LEAFS]);
 	R_LoadSubmodels(worldData, worldIndex, &header->lumps[LUMP_MODELS]);
 	R_LoadVisibility(worldData, &header->lumps[LUMP_VISIBILITY]);
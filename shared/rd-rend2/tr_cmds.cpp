@@ -98,6 +98,11 @@ static void R_PerformanceCounters(void)
 			backEnd.pc.c_triangleCountBins[TRI_BIN_2000_2999],
 			backEnd.pc.c_triangleCountBins[TRI_BIN_3000_PLUS]);
 	}
+	else if (r_speeds->integer == 9)
+	{
+		ri.Printf(PRINT_ALL, "ghoul2 skeleton builds: %i bolt queries: %i cached: %i\n",
+			tr.pc.c_g2SkeletonBuilds, tr.pc.c_g2BoltQueries, tr.pc.c_g2BoltCacheHits);
+	}
 	else if (r_speeds->integer == 100)
 	{
 		gpuFrame_t* frame = backEndData->frames + (backEndData->realFrameNumber % MAX_FRAMES);
@@ -449,6 +454,30 @@ void RE_StretchPic(const float x, const float y, const float w, const float h, c
 	cmd->t2 = t2;
 }
 
+/*
+=============
+RE_StretchPicBatch
+
+Any number of quads sharing one shader as a single command, each with its own colour
+=============
+*/
+void RE_StretchPicBatch(const stretchPicQuad_t* quads, int numQuads, qhandle_t hShader)
+{
+	stretchPicBatchCommand_t* cmd;
+
+	if (!tr.registered || numQuads <= 0) {
+		return;
+	}
+	cmd = (stretchPicBatchCommand_t*)R_GetCommandBuffer(sizeof(*cmd) + numQuads * sizeof(stretchPicQuad_t));
+	if (!cmd) {
+		return;
+	}
+	cmd->commandId = RC_STRETCH_PIC_BATCH;
+	cmd->shader = R_GetShaderByHandle(hShader);
+	cmd->numQuads = numQuads;
+	memcpy(cmd + 1, quads, numQuads * sizeof(stretchPicQuad_t));
+}
+
 #define MODE_RED_CYAN	1
 #define MODE_RED_BLUE	2
 #define MODE_RED_GREEN	3
@@ -241,6 +241,11 @@ PFNGLQUERYCOUNTERPROC qglQueryCounter;
 PFNGLGETQUERYOBJECTI64VPROC qglGetQueryObjecti64v;
 PFNGLGETQUERYOBJECTUI64VPROC qglGetQueryObjectui64v;
 
+// GL_ARB_get_program_binary
+PFNGLGETPROGRAMBINARYPROC qglGetProgramBinary;
+PFNGLPROGRAMBINARYPROC qglProgramBinary;
+PFNGLPROGRAMPARAMETERIPROC qglProgramParameteri;
+
 static qboolean GLimp_HaveExtension(const char* ext)
 {
 	const char* ptr = Q_stristr(glConfigExt.originalExtensionString, ext);
@@ -679,6 +684,38 @@ void GLimp_InitExtensions()
 		ri.Printf(PRINT_ALL, result[loaded], extension);
 	}
 
+	// GL_ARB_get_program_binary
+	extension = "GL_ARB_get_program_binary";
+	glRefConfig.programBinary = qfalse;
+	if (GLimp_HaveExtension(extension))
+	{
+		qboolean loaded = qtrue;
+
+		if (r_glslCache->integer)
+		{
+			GLint numFormats = 0;
+
+			loaded = (qboolean)(loaded && GetGLFunction(qglGetProgramBinary, "glGetProgramBinary", qfalse));
+			loaded = (qboolean)(loaded && GetGLFunction(qglProgramBinary, "glProgramBinary", qfalse));
+			loaded = (qboolean)(loaded && GetGLFunction(qglProgramParameteri, "glProgramParameteri", qfalse));
+
+			// drivers may expose the extension without any format to save to
+			qglGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+			loaded = (qboolean)(loaded && numFormats > 0);
+		}
+		else
+		{
+			loaded = qfalse;
+		}
+
+		glRefConfig.programBinary = loaded;
+		ri.Printf(PRINT_ALL, result[loaded], extension);
+	}
+	else
+	{
+		ri.Printf(PRINT_ALL, result[2], extension);
+	}
+
 	// use float lightmaps?
 	glRefConfig.floatLightmap = (qboolean)(r_floatLightmap->integer && r_hdr->integer);
 
@@ -525,6 +525,10 @@ public:
 	}
 };
 
+// bumped whenever a bone cache is freed, so a new one allocated at the
+// same address can't be mistaken for it
+static int boneCacheEpoch;
+
 void RemoveBoneCache(CBoneCache* boneCache)
 {
 #ifdef _FULL_G2_LEAK_CHECKING
@@ -532,6 +536,27 @@ void RemoveBoneCache(CBoneCache* boneCache)
 #endif
 
 	delete boneCache;
+	boneCacheEpoch++;
+}
+
+/*
+==============
+G2_GetBoneCacheStamp
+identifies the current contents of a model's bone cache; the stamp changes
+every time the skeleton is rebuilt. returns false if there's no usable cache
+==============
+*/
+bool G2_GetBoneCacheStamp(const CGhoul2Info& ghoul2, const void** boneCache, int* touch, int* epoch)
+{
+	if (!ghoul2.mBoneCache || ghoul2.mBoneCache->mod != ghoul2.currentModel)
+	{
+		return false;
+	}
+
+	*boneCache = ghoul2.mBoneCache;
+	*touch = ghoul2.mBoneCache->mCurrentTouch;
+	*epoch = boneCacheEpoch;
+	return true;
 }
 
 #ifdef _G2_LISTEN_SERVER_OPT
@@ -3332,6 +3357,8 @@ void G2_ConstructGhoulSkeleton(
 	mdxaBone_t rootMatrix;
 	int model_list[256]{};
 
+	tr.pc.c_g2SkeletonBuilds++;
+
 	assert(ghoul2.size() <= ARRAY_LEN(model_list));
 	model_list[255] = 548;
 
@@ -642,6 +642,120 @@ GLenum ToGLShaderType(GPUShaderType type)
 	return 0;
 }
 
+/*
+=================
+Program binary cache
+
+With GL_ARB_get_program_binary available and r_glslCache set, every linked
+program is saved to glslcache/ and later loaded with glProgramBinary instead
+of being compiled and linked again. Entries are keyed by the driver's vendor,
+renderer and version strings and the complete source of every stage,
+including the generated header and permutation defines. Anything that
+doesn't match, or that the driver refuses, falls back to compiling.
+=================
+*/
+#define GLSL_CACHE_IDENT	(('B'<<24)+('P'<<16)+('L'<<8)+'G')
+#define GLSL_CACHE_VERSION	1
+
+typedef struct glslCacheHeader_s
+{
+	int			ident;
+	int			version;
+	uint64_t	key;
+	uint64_t	checksum;
+	GLenum		binaryFormat;
+	int			binaryLength;
+} glslCacheHeader_t;
+
+static int glslCacheHits;
+static int glslCacheMisses;
+
+static uint64_t GLSL_HashString(uint64_t hash, const char* string)
+{
+	// include the terminator so adjacent strings can't run together
+	return Com_HashFNV1a64Bytes(hash, string ? string : "", string ? strlen(string) + 1 : 1);
+}
+
+static void GLSL_CachePath(const char* name, uint64_t key, char* path, int pathSize)
+{
+	Com_sprintf(path, pathSize, "glslcache/%s_%08x%08x.bin",
+		name, (unsigned int)(key >> 32), (unsigned int)(key & 0xffffffff));
+}
+
+static bool GLSL_LoadProgramBinary(GLuint program, const char* name, uint64_t key)
+{
+	char path[MAX_QPATH];
+	byte* buffer = nullptr;
+
+	GLSL_CachePath(name, key, path, sizeof(path));
+	const long length = ri.FS_ReadFile(path, (void**)&buffer);
+	if (!buffer)
+	{
+		return false;
+	}
+
+	bool loaded = false;
+	const glslCacheHeader_t* header = (const glslCacheHeader_t*)buffer;
+	const byte* binary = buffer + sizeof(*header);
+	if (length < (long)sizeof(*header)
+		|| header->ident != GLSL_CACHE_IDENT
+		|| header->version != GLSL_CACHE_VERSION
+		|| header->key != key
+		|| header->binaryLength != length - (long)sizeof(*header)
+		|| header->checksum != Com_HashFNV1a64Bytes(FNV1A64_INIT, binary, header->binaryLength))
+	{
+		ri.Printf(PRINT_DEVELOPER, "...ignoring bad program binary '%s'\n", path);
+	}
+	else
+	{
+		qglProgramBinary(program, header->binaryFormat, binary, header->binaryLength);
+
+		GLint linked;
+		qglGetProgramiv(program, GL_LINK_STATUS, &linked);
+		loaded = (linked == GL_TRUE);
+		if (!loaded)
+		{
+			ri.Printf(PRINT_DEVELOPER, "...driver rejected program binary '%s'\n", path);
+		}
+	}
+
+	ri.FS_FreeFile(buffer);
+	return loaded;
+}
+
+static void GLSL_SaveProgramBinary(GLuint program, const char* name, uint64_t key)
+{
+	GLint binaryLength = 0;
+	qglGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+	if (binaryLength <= 0)
+	{
+		return;
+	}
+
+	std::vector<byte> buffer(sizeof(glslCacheHeader_t) + binaryLength);
+	glslCacheHeader_t* header = (glslCacheHeader_t*)buffer.data();
+	byte* binary = buffer.data() + sizeof(*header);
+
+	GLsizei written = 0;
+	GLenum binaryFormat = 0;
+	qglGetProgramBinary(program, binaryLength, &written, &binaryFormat, binary);
+	if (written <= 0)
+	{
+		return;
+	}
+
+	header->ident = GLSL_CACHE_IDENT;
+	header->version = GLSL_CACHE_VERSION;
+	header->key = key;
+	header->checksum = Com_HashFNV1a64Bytes(FNV1A64_INIT, binary, written);
+	header->binaryFormat = binaryFormat;
+	header->binaryLength = written;
+
+	char path[MAX_QPATH];
+	GLSL_CachePath(name, key, path, sizeof(path));
+	ri.FS_WriteFile(path, buffer.data(), sizeof(*header) + written);
+}
+
 class ShaderProgramBuilder
 {
 public:
@@ -662,6 +776,8 @@ private:
 	static const size_t MAX_SHADER_SOURCE_LEN = 16384;
 
 	void ReleaseShaders();
+	bool CompileShaders();
+	uint64_t CacheKey() const;
 
 	const char* name;
 	uint32_t attribs;
@@ -670,6 +786,12 @@ private:
 	GLuint shaderNames[GPUSHADER_TYPE_COUNT];
 	size_t numShaderNames;
 	std::string shaderSource;
+
+	// sources are kept until Build, which only compiles them when the
+	// program binary cache can't provide the linked program
+	GLenum stageTypes[GPUSHADER_TYPE_COUNT];
+	std::string stageSources[GPUSHADER_TYPE_COUNT];
+	size_t numStages;
 };
 
 ShaderProgramBuilder::ShaderProgramBuilder()
@@ -679,6 +801,8 @@ ShaderProgramBuilder::ShaderProgramBuilder()
 	, shaderNames()
 	, numShaderNames(0)
 	, shaderSource(MAX_SHADER_SOURCE_LEN, '\0')
+	, stageTypes()
+	, numStages(0)
 {
 }
 
@@ -700,6 +824,7 @@ void ShaderProgramBuilder::Start(
 	this->name = name;
 	this->attribs = attribs;
 	this->xfbVariables = xfbVariables;
+	this->numStages = 0;
 }
 
 bool ShaderProgramBuilder::AddShader(const GPUShaderDesc& shaderDesc, const char* extra)
@@ -745,26 +870,59 @@ bool ShaderProgramBuilder::AddShader(const GPUShaderDesc& shaderDesc, const char
 		return false;
 	}
 
-	const GLuint shader = GLSL_CompileGPUShader(
-		program,
-		shaderSource.c_str(),
-		sourceLen + headerLen,
-		apiShader);
-	if (shader == 0)
+	stageTypes[numStages] = apiShader;
+	stageSources[numStages].assign(shaderSource.c_str(), sourceLen + headerLen);
+	++numStages;
+
+	return true;
+}
+
+bool ShaderProgramBuilder::CompileShaders()
+{
+	for (size_t i = 0; i < numStages; ++i)
 	{
-		ri.Printf(
-			PRINT_ALL,
-			"ShaderProgramBuilder::AddShader: Unable to load \"%s\"\n",
-			name);
-		return false;
-	}
+		const GLuint shader = GLSL_CompileGPUShader(
+			program,
+			stageSources[i].c_str(),
+			stageSources[i].size(),
+			stageTypes[i]);
+		if (shader == 0)
+		{
+			ri.Printf(
+				PRINT_ALL,
+				"ShaderProgramBuilder::CompileShaders: Unable to load \"%s\"\n",
+				name);
+			return false;
+		}
 
-	qglAttachShader(program, shader);
-	shaderNames[numShaderNames++] = shader;
+		qglAttachShader(program, shader);
+		shaderNames[numShaderNames++] = shader;
+	}
 
 	return true;
 }
 
+uint64_t ShaderProgramBuilder::CacheKey() const
+{
+	uint64_t key = FNV1A64_INIT;
+	const int version = GLSL_CACHE_VERSION;
+
+	key = Com_HashFNV1a64Bytes(key, &version, sizeof(version));
+	key = GLSL_HashString(key, glConfig.vendor_string);
+	key = GLSL_HashString(key, glConfig.renderer_string);
+	key = GLSL_HashString(key, glConfig.version_string);
+	key = GLSL_HashString(key, name);
+	key = Com_HashFNV1a64Bytes(key, &attribs, sizeof(attribs));
+	key = Com_HashFNV1a64Bytes(key, &xfbVariables, sizeof(xfbVariables));
+	for (size_t i = 0; i < numStages; ++i)
+	{
+		key = Com_HashFNV1a64Bytes(key, &stageTypes[i], sizeof(stageTypes[i]));
+		key = GLSL_HashString(key, stageSources[i].c_str());
+	}
+
+	return key;
+}
+
 bool ShaderProgramBuilder::Build(shaderProgram_t* shaderProgram)
 {
 	const size_t nameBufferSize = strlen(name) + 1;
@@ -775,9 +933,33 @@ bool ShaderProgramBuilder::Build(shaderProgram_t* shaderProgram)
 	shaderProgram->attribs = attribs;
 	shaderProgram->xfbVariables = xfbVariables;
 
+	const bool useCache = glRefConfig.programBinary != qfalse;
+	const uint64_t key = useCache ? CacheKey() : 0;
+	if (useCache && GLSL_LoadProgramBinary(program, name, key))
+	{
+		++glslCacheHits;
+		program = 0;
+		return true;
+	}
+
+	if (!CompileShaders())
+	{
+		return false;
+	}
+
 	GLSL_BindShaderInterface(shaderProgram);
+	if (useCache)
+	{
+		qglProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
 	GLSL_LinkProgram(shaderProgram->program);
 
+	if (useCache)
+	{
+		++glslCacheMisses;
+		GLSL_SaveProgramBinary(program, name, key);
+	}
+
 	ReleaseShaders();
 	program = 0;
 
@@ -2354,6 +2536,9 @@ void GLSL_LoadGPUShaders()
 
 	int startTime = ri.Milliseconds();
 
+	glslCacheHits = 0;
+	glslCacheMisses = 0;
+
 	Allocator allocator(512 * 1024);
 	ShaderProgramBuilder builder;
 
@@ -2384,6 +2569,11 @@ void GLSL_LoadGPUShaders()
 	ri.Printf(PRINT_ALL, "loaded %i GLSL shaders (%i gen %i light %i etc) in %5.2f seconds\n",
 		numGenShaders + numLightShaders + numEtcShaders, numGenShaders, numLightShaders,
 		numEtcShaders, (ri.Milliseconds() - startTime) / 1000.0);
+	if (glRefConfig.programBinary)
+	{
+		ri.Printf(PRINT_ALL, "program binary cache: %i loaded, %i compiled\n",
+			glslCacheHits, glslCacheMisses);
+	}
 }
 
 void GLSL_ShutdownGPUShaders(void)
@@ -28,6 +28,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #include "qcommon/qcommon.h"
 #include "rd-common/tr_public.h"
 #include "rd-common/tr_common.h"
+#include "rd-common/tr_font_batch.h"
 #include "tr_allocator.h"
 #include "tr_extratypes.h"
 #include "tr_extramath.h"
@@ -254,6 +255,7 @@ extern cvar_t* r_printShaders;
 extern cvar_t* r_saveFontData;
 
 extern cvar_t* r_marksOnTriangleMeshes;
+extern cvar_t* r_markBVH;
 
 extern cvar_t* r_aviMotionJpegQuality;
 extern cvar_t* r_screenshotJpegQuality;
@@ -1744,6 +1746,19 @@ typedef struct srfG2GoreSurface_s
 } srfG2GoreSurface_t;
 #endif
 
+// Static bounding volume hierarchy over the triangles of a world surface,
+// used by R_MarkFragments to skip triangles that can't receive a mark.
+// Children split the triangle range in index order, so walking them left
+// to right visits triangles in the same order as the surface itself.
+typedef struct markBvhNode_s
+{
+	vec3_t	mins;
+	vec3_t	maxs;
+	int		firstTriangle;
+	int		numTriangles;
+	int		children;			// index of the left child, the right one follows; -1 for leaves
+} markBvhNode_t;
+
 // srfBspSurface_t covers SF_GRID, SF_TRIANGLES, SF_POLY, and SF_VBO_MESH
 typedef struct srfBspSurface_s
 {
@@ -1998,6 +2013,10 @@ typedef struct {
 	int* marksurfaces;
 	int* viewSurfaces;
 
+	int			numMarkBvhNodes;
+	markBvhNode_t* markBvhNodes;
+	int* surfacesMarkBvh;		// root node per surface, -1 if it isn't worth one
+
 	int			numfogs;
 	fog_t* fogs;
 	const fog_t* globalFog;
@@ -2203,6 +2222,10 @@ typedef struct {
 	int		c_leafs;
 	int		c_dlightSurfaces;
 	int		c_dlightSurfacesCulled;
+
+	int		c_g2SkeletonBuilds;
+	int		c_g2BoltQueries;
+	int		c_g2BoltCacheHits;
 } frontEndCounters_t;
 
 #define	FOG_TABLE_SIZE		256
@@ -2307,6 +2330,7 @@ typedef struct {
 
 	qboolean debugContext;
 	qboolean timerQuery;
+	qboolean programBinary;
 
 	qboolean floatLightmap;
 } glRefConfig_t;
@@ -2741,6 +2765,9 @@ extern  cvar_t* r_mergeMultidraws;
 extern  cvar_t* r_mergeLeafSurfaces;
 
 extern	cvar_t* r_externalGLSL;
+extern	cvar_t* r_glslCache;
+extern	cvar_t* r_shaderIndex;
+extern	cvar_t* r_g2BoltCache;
 
 extern  cvar_t* r_hdr;
 extern  cvar_t* r_floatLightmap;
@@ -3189,6 +3216,7 @@ MARKERS, POLYGON PROJECTION ON WORLD POLYGONS
 */
 
 int R_MarkFragments(int numPoints, const vec3_t* points, const vec3_t projection, const int max_points, vec3_t point_buffer, const int max_fragments, markFragment_t* fragment_buffer);
+void R_BuildMarkBVH(world_t* worldData);
 
 /*
 ============================================================
@@ -3531,6 +3559,13 @@ typedef struct rotatePicCommand_s {
 	float	a;
 } rotatePicCommand_t;
 
+typedef struct stretchPicBatchCommand_s {
+	int		commandId;
+	shader_t* shader;
+	int		numQuads;
+	// followed by numQuads stretchPicQuad_t
+} stretchPicBatchCommand_t;
+
 #ifdef REND2_SP
 typedef struct scissorCommand_s {
 	int	commandId;
@@ -3609,6 +3644,7 @@ typedef enum {
 	RC_END_OF_LIST,
 	RC_SET_COLOR,
 	RC_STRETCH_PIC,
+	RC_STRETCH_PIC_BATCH,
 	RC_ROTATE_PIC,
 	RC_ROTATE_PIC2,
 	RC_DRAW_SURFS,
@@ -3718,6 +3754,7 @@ void R_EndTimedBlockCmd(qhandle_t timerHandle);
 
 void RE_SetColor(const float* rgba);
 void RE_StretchPic(const float x, const float y, const float w, const float h, const float s1, const float t1, const float s2, const float t2, const qhandle_t hShader);
+void RE_StretchPicBatch(const stretchPicQuad_t* quads, int numQuads, qhandle_t hShader);
 void RE_RotatePic(const float x, const float y, const float w, const float h, const float s1, const float t1, const float s2, const float t2, const float a, const qhandle_t hShader);
 void RE_RotatePic2(const float x, const float y, const float w, const float h, const float s1, const float t1, const float s2, const float t2, const float a, const qhandle_t hShader);
 #ifdef REND2_SP
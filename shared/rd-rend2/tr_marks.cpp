@@ -133,7 +133,7 @@ R_BoxSurfaces_r
 
 =================
 */
-void R_BoxSurfaces_r(const mnode_t* node, vec3_t mins, vec3_t maxs, surfaceType_t** list, const int listsize, int* listlength, vec3_t dir)
+void R_BoxSurfaces_r(const mnode_t* node, vec3_t mins, vec3_t maxs, surfaceType_t** list, int* surfaceNums, const int listsize, int* listlength, vec3_t dir)
 {
 	int			s, c;
 	msurface_t* surf;
@@ -149,7 +149,7 @@ void R_BoxSurfaces_r(const mnode_t* node, vec3_t mins, vec3_t maxs, surfaceType_
 			node = node->children[1];
 		}
 		else {
-			R_BoxSurfaces_r(node->children[0], mins, maxs, list, listsize, listlength, dir);
+			R_BoxSurfaces_r(node->children[0], mins, maxs, list, surfaceNums, listsize, listlength, dir);
 			node = node->children[1];
 		}
 	}
@@ -189,6 +189,7 @@ void R_BoxSurfaces_r(const mnode_t* node, vec3_t mins, vec3_t maxs, surfaceType_
 		if (*surfViewCount != tr.viewCount) {
 			*surfViewCount = tr.viewCount;
 			list[*listlength] = surf->data;
+			surfaceNums[*listlength] = *mark;
 			(*listlength)++;
 		}
 		mark++;
@@ -251,29 +252,364 @@ void R_AddMarkFragments(int num_clip_points, vec3_t clip_points[2][MAX_VERTS_ON_
 
 /*
 =================
-R_MarkFragments
+R_MarkTriangleCount
 
+Triangles R_MarkFragments considers on a surface, grids are
+triangulated two triangles per quad
 =================
 */
-int R_MarkFragments(int numPoints, const vec3_t* points, const vec3_t projection, const int max_points, vec3_t point_buffer, const int max_fragments, markFragment_t* fragment_buffer)
+static int R_MarkTriangleCount(const surfaceType_t* surface)
 {
-	int				numsurfaces, numplanes;
-	int				i, j, k, m, n;
-	surfaceType_t* surfaces[64];
-	vec3_t			mins, maxs;
-	int				returned_fragments;
+	const srfBspSurface_t* surf = (const srfBspSurface_t*)surface;
+
+	switch (*surface)
+	{
+	case SF_GRID:
+		return (surf->width - 1) * (surf->height - 1) * 2;
+	case SF_FACE:
+	case SF_TRIANGLES:
+		return surf->numIndexes / 3;
+	default:
+		return 0;
+	}
+}
+
+/*
+=================
+R_MarkTriangle
+
+Gets the projected triangle t of a surface. For grid triangles normalCheck
+is the facing threshold of that half of the quad
+=================
+*/
+static void R_MarkTriangle(const surfaceType_t* surface, const int t, vec3_t points[3], double* normalCheck)
+{
+	const srfBspSurface_t* surf = (const srfBspSurface_t*)surface;
+
+	if (*surface == SF_GRID)
+	{
+		const int quad = t >> 1;
+		const srfVert_t* dv = surf->verts + (quad / (surf->width - 1)) * surf->width + quad % (surf->width - 1);
+		const srfVert_t* v[3];
+
+		// We triangulate the grid and chop all triangles within
+		// the bounding planes of the to be projected polygon.
+		// LOD is not taken into account, not such a big deal though.
+		//
+		// To avoid issues when LOD applied to "hollow curves" (like
+		// the ones around many jump pads) the vertices can be offset
+		// by MARKER_OFFSET along the vertex normal, so all triangles
+		// will still fit together.
+		if (!(t & 1))
+		{
+			v[0] = &dv[0];
+			v[1] = &dv[surf->width];
+			v[2] = &dv[1];
+			*normalCheck = -0.1;
+		}
+		else
+		{
+			v[0] = &dv[1];
+			v[1] = &dv[surf->width];
+			v[2] = &dv[surf->width + 1];
+			*normalCheck = -0.05;
+		}
+
+		for (int j = 0; j < 3; j++)
+		{
+			VectorCopy(v[j]->xyz, points[j]);
+			VectorMA(points[j], MARKER_OFFSET, v[j]->normal, points[j]);
+		}
+		return;
+	}
+
+	const glIndex_t* tri = surf->indexes + t * 3;
+	for (int j = 0; j < 3; j++)
+	{
+		const srfVert_t* v = &surf->verts[tri[j]];
+		VectorMA(v->xyz, MARKER_OFFSET, *surface == SF_FACE ? surf->cullPlane.normal : v->normal, points[j]);
+	}
+	*normalCheck = 0.0;
+}
+
+/*
+=================
+R_BuildMarkBVH
+
+Builds the triangle hierarchy of every world surface big enough to
+benefit from one. Called once the surfaces are final, after stitching
+=================
+*/
+#define MARK_BVH_LEAF_TRIANGLES	8
+
+static int R_CountMarkBVHNodes(const int numTriangles)
+{
+	if (numTriangles <= MARK_BVH_LEAF_TRIANGLES)
+	{
+		return 1;
+	}
+	return 1 + R_CountMarkBVHNodes(numTriangles / 2) + R_CountMarkBVHNodes(numTriangles - numTriangles / 2);
+}
+
+static void R_BuildMarkBVHNode(world_t* worldData, const surfaceType_t* surface, const int nodeNum, const int firstTriangle, const int numTriangles)
+{
+	markBvhNode_t* node = &worldData->markBvhNodes[nodeNum];
+
+	node->firstTriangle = firstTriangle;
+	node->numTriangles = numTriangles;
+	node->children = -1;
+	ClearBounds(node->mins, node->maxs);
+
+	if (numTriangles <= MARK_BVH_LEAF_TRIANGLES)
+	{
+		for (int t = firstTriangle; t < firstTriangle + numTriangles; t++)
+		{
+			vec3_t points[3];
+			double normalCheck;
+
+			R_MarkTriangle(surface, t, points, &normalCheck);
+			for (int j = 0; j < 3; j++)
+			{
+				AddPointToBounds(points[j], node->mins, node->maxs);
+			}
+		}
+		return;
+	}
+
+	const int left = worldData->numMarkBvhNodes;
+	worldData->numMarkBvhNodes += 2;
+	node->children = left;
+
+	R_BuildMarkBVHNode(worldData, surface, left, firstTriangle, numTriangles / 2);
+	R_BuildMarkBVHNode(worldData, surface, left + 1, firstTriangle + numTriangles / 2, numTriangles - numTriangles / 2);
+
+	node = &worldData->markBvhNodes[nodeNum];
+	AddPointToBounds(worldData->markBvhNodes[left].mins, node->mins, node->maxs);
+	AddPointToBounds(worldData->markBvhNodes[left].maxs, node->mins, node->maxs);
+	AddPointToBounds(worldData->markBvhNodes[left + 1].mins, node->mins, node->maxs);
+	AddPointToBounds(worldData->markBvhNodes[left + 1].maxs, node->mins, node->maxs);
+}
+
+void R_BuildMarkBVH(world_t* worldData)
+{
+	int numNodes = 0;
+
+	worldData->surfacesMarkBvh = (int*)Hunk_Alloc(worldData->numsurfaces * sizeof(int), h_low);
+	for (int i = 0; i < worldData->numsurfaces; i++)
+	{
+		const int numTriangles = R_MarkTriangleCount(worldData->surfaces[i].data);
+
+		worldData->surfacesMarkBvh[i] = -1;
+		if (numTriangles > MARK_BVH_LEAF_TRIANGLES)
+		{
+			numNodes += R_CountMarkBVHNodes(numTriangles);
+		}
+	}
+
+	worldData->numMarkBvhNodes = 0;
+	worldData->markBvhNodes = nullptr;
+	if (!numNodes)
+	{
+		return;
+	}
+
+	worldData->markBvhNodes = (markBvhNode_t*)Hunk_Alloc(numNodes * sizeof(markBvhNode_t), h_low);
+	for (int i = 0; i < worldData->numsurfaces; i++)
+	{
+		const surfaceType_t* surface = worldData->surfaces[i].data;
+		const int numTriangles = R_MarkTriangleCount(surface);
+
+		if (numTriangles > MARK_BVH_LEAF_TRIANGLES)
+		{
+			worldData->surfacesMarkBvh[i] = worldData->numMarkBvhNodes++;
+			R_BuildMarkBVHNode(worldData, surface, worldData->surfacesMarkBvh[i], 0, numTriangles);
+		}
+	}
+
+	ri.Printf(PRINT_DEVELOPER, "...built mark BVH, %i nodes\n", worldData->numMarkBvhNodes);
+}
+
+/*
+=================
+R_MarkBoxBehindPlanes
+
+True if the box lies entirely behind one of the clipping planes. The
+clipper keeps anything within 0.5 units of a plane, so only boxes clearly
+behind it are skipped; the extra margin absorbs the rounding of the
+clipped points
+=================
+*/
+#define MARK_CLIP_EPSILON	0.5f
+#define MARK_REJECT_EPSILON	(MARK_CLIP_EPSILON - 0.25f)
+
+static qboolean R_MarkBoxBehindPlanes(const vec3_t mins, const vec3_t maxs, const int numplanes, const vec3_t* normals, const float* dists)
+{
+	for (int i = 0; i < numplanes; i++)
+	{
+		const float d = (normals[i][0] > 0.0f ? maxs[0] : mins[0]) * normals[i][0]
+			+ (normals[i][1] > 0.0f ? maxs[1] : mins[1]) * normals[i][1]
+			+ (normals[i][2] > 0.0f ? maxs[2] : mins[2]) * normals[i][2];
+
+		if (d - dists[i] < MARK_REJECT_EPSILON)
+		{
+			return qtrue;
+		}
+	}
+	return qfalse;
+}
+
+/*
+=================
+R_MarkTriangles
+
+Projects the triangles [firstTriangle, firstTriangle + numTriangles) of a
+surface. When reject is set the batch is first tested against the clipping
+planes in structure-of-arrays form, and triangles that lie entirely behind
+any plane never reach the clipper
+=================
+*/
+typedef struct markClip_s
+{
+	int				numplanes;
+	vec3_t* normals;
+	float* dists;
+	vec3_t			projectionDir;
+	vec3_t			mins;
+	vec3_t			maxs;
+	int				max_points;
+	vec3_t* point_buffer;
+	int				max_fragments;
+	markFragment_t* fragment_buffer;
 	int				returned_points;
+	int				returned_fragments;
+} markClip_t;
+
+static qboolean R_MarkTriangles(markClip_t* clip, const surfaceType_t* surface, const int firstTriangle, const int numTriangles, const qboolean reject)
+{
+	vec3_t			points[MARK_BVH_LEAF_TRIANGLES][3];
+	double			normalChecks[MARK_BVH_LEAF_TRIANGLES];
+	float			x[3][MARK_BVH_LEAF_TRIANGLES], y[3][MARK_BVH_LEAF_TRIANGLES], z[3][MARK_BVH_LEAF_TRIANGLES];
+	int				rejected[MARK_BVH_LEAF_TRIANGLES];
+	vec3_t			clip_points[2][MAX_VERTS_ON_POLY];
+
+	for (int first = firstTriangle; first < firstTriangle + numTriangles; first += MARK_BVH_LEAF_TRIANGLES)
+	{
+		const int count = MIN(MARK_BVH_LEAF_TRIANGLES, firstTriangle + numTriangles - first);
+
+		for (int t = 0; t < count; t++)
+		{
+			R_MarkTriangle(surface, first + t, points[t], &normalChecks[t]);
+			for (int j = 0; j < 3; j++)
+			{
+				x[j][t] = points[t][j][0];
+				y[j][t] = points[t][j][1];
+				z[j][t] = points[t][j][2];
+			}
+			rejected[t] = 0;
+		}
+
+		if (reject)
+		{
+			for (int i = 0; i < clip->numplanes; i++)
+			{
+				const float nx = clip->normals[i][0], ny = clip->normals[i][1], nz = clip->normals[i][2];
+				const float d = clip->dists[i] + MARK_REJECT_EPSILON;
+
+				for (int t = 0; t < count; t++)
+				{
+					const float d0 = x[0][t] * nx + y[0][t] * ny + z[0][t] * nz;
+					const float d1 = x[1][t] * nx + y[1][t] * ny + z[1][t] * nz;
+					const float d2 = x[2][t] * nx + y[2][t] * ny + z[2][t] * nz;
+
+					rejected[t] |= (d0 < d) & (d1 < d) & (d2 < d);
+				}
+			}
+		}
+
+		for (int t = 0; t < count; t++)
+		{
+			if (rejected[t])
+			{
+				continue;
+			}
+
+			if (*surface == SF_GRID)
+			{
+				// check the normal of this triangle
+				vec3_t v1, v2, normal;
+
+				VectorSubtract(points[t][0], points[t][1], v1);
+				VectorSubtract(points[t][2], points[t][1], v2);
+				CrossProduct(v1, v2, normal);
+				VectorNormalizeFast(normal);
+				if (DotProduct(normal, clip->projectionDir) >= normalChecks[t]) {
+					continue;
+				}
+			}
+
+			// add the fragments of this triangle
+			VectorCopy(points[t][0], clip_points[0][0]);
+			VectorCopy(points[t][1], clip_points[0][1]);
+			VectorCopy(points[t][2], clip_points[0][2]);
+			R_AddMarkFragments(3, clip_points,
+				clip->numplanes, clip->normals, clip->dists,
+				clip->max_points, clip->point_buffer[0],
+				clip->max_fragments, clip->fragment_buffer,
+				&clip->returned_points, &clip->returned_fragments, clip->mins, clip->maxs);
+
+			if (clip->returned_fragments == clip->max_fragments) {
+				return qfalse;	// not enough space for more fragments
+			}
+		}
+	}
+	return qtrue;
+}
+
+/*
+=================
+R_MarkSurfaceBVH
+
+Walks the hierarchy of a surface left to right, so the surviving triangles
+are clipped in the same order as a plain loop over the surface
+=================
+*/
+static qboolean R_MarkSurfaceBVH(markClip_t* clip, const surfaceType_t* surface, const int nodeNum)
+{
+	const markBvhNode_t* node = &tr.world->markBvhNodes[nodeNum];
+
+	if (R_MarkBoxBehindPlanes(node->mins, node->maxs, clip->numplanes, clip->normals, clip->dists))
+	{
+		return qtrue;
+	}
+
+	if (node->children == -1)
+	{
+		return R_MarkTriangles(clip, surface, node->firstTriangle, node->numTriangles, qtrue);
+	}
+
+	if (!R_MarkSurfaceBVH(clip, surface, node->children))
+	{
+		return qfalse;
+	}
+	return R_MarkSurfaceBVH(clip, surface, node->children + 1);
+}
+
+/*
+=================
+R_MarkFragmentsInternal
+
+=================
+*/
+static int R_MarkFragmentsInternal(int numPoints, const vec3_t* points, const vec3_t projection, const int max_points, vec3_t point_buffer, const int max_fragments, markFragment_t* fragment_buffer, const qboolean useBvh)
+{
+	int				numsurfaces;
+	int				i;
+	surfaceType_t* surfaces[64];
+	int				surfaceNums[64];
 	vec3_t			normals[MAX_VERTS_ON_POLY + 2];
 	float			dists[MAX_VERTS_ON_POLY + 2];
-	vec3_t			clip_points[2][MAX_VERTS_ON_POLY];
-	int				num_clip_points;
-	float* v;
-	srfBspSurface_t* cv;
-	glIndex_t* tri;
-	srfVert_t* dv;
-	vec3_t			normal;
-	vec3_t			projectionDir;
 	vec3_t			v1, v2;
+	markClip_t		clip;
 
 	if (numPoints <= 0) {
 		return 0;
@@ -283,18 +619,18 @@ int R_MarkFragments(int numPoints, const vec3_t* points, const vec3_t projection
 	tr.viewCount++;
 
 	//
-	VectorNormalize2(projection, projectionDir);
+	VectorNormalize2(projection, clip.projectionDir);
 	// find all the brushes that are to be considered
-	ClearBounds(mins, maxs);
+	ClearBounds(clip.mins, clip.maxs);
 	for (i = 0; i < numPoints; i++) {
 		vec3_t	temp;
 
-		AddPointToBounds(points[i], mins, maxs);
+		AddPointToBounds(points[i], clip.mins, clip.maxs);
 		VectorAdd(points[i], projection, temp);
-		AddPointToBounds(temp, mins, maxs);
+		AddPointToBounds(temp, clip.mins, clip.maxs);
 		// make sure we get all the leafs (also the one(s) in front of the hit surface)
-		VectorMA(points[i], -20, projectionDir, temp);
-		AddPointToBounds(temp, mins, maxs);
+		VectorMA(points[i], -20, clip.projectionDir, temp);
+		AddPointToBounds(temp, clip.mins, clip.maxs);
 	}
 
 	if (numPoints > MAX_VERTS_ON_POLY) numPoints = MAX_VERTS_ON_POLY;
@@ -308,150 +644,89 @@ int R_MarkFragments(int numPoints, const vec3_t* points, const vec3_t projection
 		dists[i] = DotProduct(normals[i], points[i]);
 	}
 	// add near and far clipping planes for projection
-	VectorCopy(projectionDir, normals[numPoints]);
+	VectorCopy(clip.projectionDir, normals[numPoints]);
 	dists[numPoints] = DotProduct(normals[numPoints], points[0]) - 32;
-	VectorCopy(projectionDir, normals[numPoints + 1]);
+	VectorCopy(clip.projectionDir, normals[numPoints + 1]);
 	VectorInverse(normals[numPoints + 1]);
 	dists[numPoints + 1] = DotProduct(normals[numPoints + 1], points[0]) - 20;
-	numplanes = numPoints + 2;
+
+	clip.numplanes = numPoints + 2;
+	clip.normals = normals;
+	clip.dists = dists;
+	clip.max_points = max_points;
+	clip.point_buffer = (vec3_t*)point_buffer;
+	clip.max_fragments = max_fragments;
+	clip.fragment_buffer = fragment_buffer;
+	clip.returned_points = 0;
+	clip.returned_fragments = 0;
 
 	numsurfaces = 0;
-	R_BoxSurfaces_r(tr.world->nodes, mins, maxs, surfaces, 64, &numsurfaces, projectionDir);
+	R_BoxSurfaces_r(tr.world->nodes, clip.mins, clip.maxs, surfaces, surfaceNums, 64, &numsurfaces, clip.projectionDir);
 	//assert(numsurfaces <= 64);
 	//assert(numsurfaces != 64);
 
-	returned_points = 0;
-	returned_fragments = 0;
-
 	for (i = 0; i < numsurfaces; i++) {
-		if (*surfaces[i] == SF_GRID) {
-			cv = (srfBspSurface_t*)surfaces[i];
-			for (m = 0; m < cv->height - 1; m++) {
-				for (n = 0; n < cv->width - 1; n++) {
-					// We triangulate the grid and chop all triangles within
-					// the bounding planes of the to be projected polygon.
-					// LOD is not taken into account, not such a big deal though.
-					//
-					// It's probably much nicer to chop the grid itself and deal
-					// with this grid as a normal SF_GRID surface so LOD will
-					// be applied. However the LOD of that chopped grid must
-					// be synced with the LOD of the original curve.
-					// One way to do this; the chopped grid shares vertices with
-					// the original curve. When LOD is applied to the original
-					// curve the unused vertices are flagged. Now the chopped curve
-					// should skip the flagged vertices. This still leaves the
-					// problems with the vertices at the chopped grid edges.
-					//
-					// To avoid issues when LOD applied to "hollow curves" (like
-					// the ones around many jump pads) we now just add a 2 unit
-					// offset to the triangle vertices.
-					// The offset is added in the vertex normal vector direction
-					// so all triangles will still fit together.
-					// The 2 unit offset should avoid pretty much all LOD problems.
-
-					num_clip_points = 3;
-
-					dv = cv->verts + m * cv->width + n;
-
-					VectorCopy(dv[0].xyz, clip_points[0][0]);
-					VectorMA(clip_points[0][0], MARKER_OFFSET, dv[0].normal, clip_points[0][0]);
-					VectorCopy(dv[cv->width].xyz, clip_points[0][1]);
-					VectorMA(clip_points[0][1], MARKER_OFFSET, dv[cv->width].normal, clip_points[0][1]);
-					VectorCopy(dv[1].xyz, clip_points[0][2]);
-					VectorMA(clip_points[0][2], MARKER_OFFSET, dv[1].normal, clip_points[0][2]);
-					// check the normal of this triangle
-					VectorSubtract(clip_points[0][0], clip_points[0][1], v1);
-					VectorSubtract(clip_points[0][2], clip_points[0][1], v2);
-					CrossProduct(v1, v2, normal);
-					VectorNormalizeFast(normal);
-					if (DotProduct(normal, projectionDir) < -0.1) {
-						// add the fragments of this triangle
-						R_AddMarkFragments(num_clip_points, clip_points,
-							numplanes, normals, dists,
-							max_points, point_buffer,
-							max_fragments, fragment_buffer,
-							&returned_points, &returned_fragments, mins, maxs);
-
-						if (returned_fragments == max_fragments) {
-							return returned_fragments;	// not enough space for more fragments
-						}
-					}
-
-					VectorCopy(dv[1].xyz, clip_points[0][0]);
-					VectorMA(clip_points[0][0], MARKER_OFFSET, dv[1].normal, clip_points[0][0]);
-					VectorCopy(dv[cv->width].xyz, clip_points[0][1]);
-					VectorMA(clip_points[0][1], MARKER_OFFSET, dv[cv->width].normal, clip_points[0][1]);
-					VectorCopy(dv[cv->width + 1].xyz, clip_points[0][2]);
-					VectorMA(clip_points[0][2], MARKER_OFFSET, dv[cv->width + 1].normal, clip_points[0][2]);
-					// check the normal of this triangle
-					VectorSubtract(clip_points[0][0], clip_points[0][1], v1);
-					VectorSubtract(clip_points[0][2], clip_points[0][1], v2);
-					CrossProduct(v1, v2, normal);
-					VectorNormalizeFast(normal);
-					if (DotProduct(normal, projectionDir) < -0.05) {
-						// add the fragments of this triangle
-						R_AddMarkFragments(num_clip_points, clip_points,
-							numplanes, normals, dists,
-							max_points, point_buffer,
-							max_fragments, fragment_buffer,
-							&returned_points, &returned_fragments, mins, maxs);
-
-						if (returned_fragments == max_fragments) {
-							return returned_fragments;	// not enough space for more fragments
-						}
-					}
-				}
+		if (*surfaces[i] == SF_FACE) {
+			// check the normal of this face
+			if (DotProduct(((srfBspSurface_t*)surfaces[i])->cullPlane.normal, clip.projectionDir) > -0.5) {
+				continue;
 			}
 		}
-		else if (*surfaces[i] == SF_FACE) {
-			srfBspSurface_t* surf = (srfBspSurface_t*)surfaces[i];
-
-			// check the normal of this face
-			if (DotProduct(surf->cullPlane.normal, projectionDir) > -0.5) {
+		else if (*surfaces[i] == SF_TRIANGLES) {
+			if (!r_marksOnTriangleMeshes->integer) {
 				continue;
 			}
+		}
+		else if (*surfaces[i] != SF_GRID) {
+			continue;
+		}
 
-			for (k = 0, tri = surf->indexes; k < surf->numIndexes; k += 3, tri += 3)
-			{
-				for (j = 0; j < 3; j++)
-				{
-					v = surf->verts[tri[j]].xyz;
-					VectorMA(v, MARKER_OFFSET, surf->cullPlane.normal, clip_points[0][j]);
-				}
+		qboolean more;
+		if (useBvh && tr.world->surfacesMarkBvh && tr.world->surfacesMarkBvh[surfaceNums[i]] != -1) {
+			more = R_MarkSurfaceBVH(&clip, surfaces[i], tr.world->surfacesMarkBvh[surfaceNums[i]]);
+		}
+		else {
+			more = R_MarkTriangles(&clip, surfaces[i], 0, R_MarkTriangleCount(surfaces[i]), useBvh);
+		}
 
-				// add the fragments of this face
-				R_AddMarkFragments(3, clip_points,
-					numplanes, normals, dists,
-					max_points, point_buffer,
-					max_fragments, fragment_buffer,
-					&returned_points, &returned_fragments, mins, maxs);
-				if (returned_fragments == max_fragments) {
-					return returned_fragments;	// not enough space for more fragments
-				}
-			}
+		if (!more) {
+			break;	// not enough space for more fragments
 		}
-		else if (*surfaces[i] == SF_TRIANGLES && r_marksOnTriangleMeshes->integer) {
-			srfBspSurface_t* surf = (srfBspSurface_t*)surfaces[i];
+	}
+	return clip.returned_fragments;
+}
 
-			for (k = 0, tri = surf->indexes; k < surf->numIndexes; k += 3, tri += 3)
-			{
-				for (j = 0; j < 3; j++)
-				{
-					v = surf->verts[tri[j]].xyz;
-					VectorMA(v, MARKER_OFFSET, surf->verts[tri[j]].normal, clip_points[0][j]);
-				}
+/*
+=================
+R_MarkFragments
 
-				// add the fragments of this face
-				R_AddMarkFragments(3, clip_points,
-					numplanes, normals, dists,
-					max_points, point_buffer,
-					max_fragments, fragment_buffer, &returned_points, &returned_fragments, mins, maxs);
-				if (returned_fragments == max_fragments)
-				{
-					return returned_fragments;	// not enough space for more fragments
-				}
-			}
-		}
+r_markBVH 2 runs the plain clipper as well and reports any difference
+=================
+*/
+int R_MarkFragments(int numPoints, const vec3_t* points, const vec3_t projection, const int max_points, vec3_t point_buffer, const int max_fragments, markFragment_t* fragment_buffer)
+{
+	if (r_markBVH->integer != 2)
+	{
+		return R_MarkFragmentsInternal(numPoints, points, projection, max_points, point_buffer, max_fragments, fragment_buffer, (qboolean)(r_markBVH->integer != 0));
 	}
-	return returned_fragments;
-}
\ No newline at end of file
+
+	std::vector<float> refPoints(max_points * 3);
+	std::vector<markFragment_t> refFragments(max_fragments);
+
+	const int numFragments = R_MarkFragmentsInternal(numPoints, points, projection, max_points, point_buffer, max_fragments, fragment_buffer, qtrue);
+	const int numRefFragments = R_MarkFragmentsInternal(numPoints, points, projection, max_points, refPoints.data(), max_fragments, refFragments.data(), qfalse);
+
+	qboolean same = (qboolean)(numFragments == numRefFragments);
+	for (int i = 0; same && i < numFragments; i++)
+	{
+		same = (qboolean)(fragment_buffer[i].firstPoint == refFragments[i].firstPoint
+			&& fragment_buffer[i].numPoints == refFragments[i].numPoints
+			&& !memcmp(point_buffer + fragment_buffer[i].firstPoint * 3, &refPoints[refFragments[i].firstPoint * 3], fragment_buffer[i].numPoints * sizeof(vec3_t)));
+	}
+
+	if (!same)
+	{
+		ri.Printf(PRINT_WARNING, "R_MarkFragments: BVH returned %i fragments, plain clipping %i (or the points differ)\n", numFragments, numRefFragments);
+	}
+	return numFragments;
+}
@@ -3648,6 +3648,12 @@ static void FixRenderCommandList(int newShader) {
 					curCmd = (const void*)(sp_cmd + 1);
 					break;
 				}
+				case RC_STRETCH_PIC_BATCH:
+				{
+					const stretchPicBatchCommand_t* sp_cmd = (const stretchPicBatchCommand_t*)curCmd;
+					curCmd = (const void*)((const stretchPicQuad_t*)(sp_cmd + 1) + sp_cmd->numQuads);
+					break;
+				}
 				case RC_ROTATE_PIC:
 				case RC_ROTATE_PIC2:
 				{
@@ -4312,6 +4318,10 @@ static const char* FindShaderInShaderText(const char* shadername) {
 			if (!Q_stricmp(token, shadername))
 				return p;
 		}
+
+		// every shader name in the text is in the table, so
+		// there's no need to scan the whole text again
+		return NULL;
 	}
 
 	p = s_shaderText;
@@ -4950,6 +4960,129 @@ void	R_ShaderList_f(void) {
 	ri.Printf(PRINT_ALL, "------------------\n");
 }
 
+/*
+====================
+Shader text index
+
+The combined, compressed shader text is saved to cache/shadertext.idx
+together with the offset and hash of every shader name in it, so later
+starts can skip loading, validating and tokenizing each shader file.
+The index is keyed by the checksums of the loaded paks and the list of
+shader files; loose shader files also contribute their length and
+contents, so editing one outside of a pak rebuilds the index.
+=====================
+*/
+#define SHADERTEXT_INDEX_IDENT		(('X'<<24)+('D'<<16)+('I'<<8)+'S')
+#define SHADERTEXT_INDEX_VERSION	1
+#define SHADERTEXT_INDEX_FILE		"cache/shadertext.idx"
+
+typedef struct shaderTextIndexHeader_s
+{
+	int			ident;
+	int			version;
+	uint64_t	key;
+	int			numEntries;
+	int			textLength;
+} shaderTextIndexHeader_t;
+
+typedef struct shaderTextEntry_s
+{
+	int			offset;			// into s_shaderText, at the shader name
+	int			hash;			// generateHashValue of the name, MAX_SHADERTEXT_HASH
+} shaderTextEntry_t;
+
+static void R_SetupShaderTextHash(const shaderTextEntry_t* entries, const int numEntries)
+{
+	int sizes[MAX_SHADERTEXT_HASH] = { 0 };
+
+	for (int i = 0; i < numEntries; i++)
+	{
+		sizes[entries[i].hash]++;
+	}
+
+	char* hashMem = (char*)Hunk_Alloc((numEntries + MAX_SHADERTEXT_HASH) * sizeof(char*), h_low);
+	for (int i = 0; i < MAX_SHADERTEXT_HASH; i++)
+	{
+		shaderTextHashTable[i] = (char**)hashMem;
+		hashMem += (sizes[i] + 1) * sizeof(char*);
+		sizes[i] = 0;
+	}
+
+	// entries are in text order, which is the order the old scan filled the buckets in
+	for (int i = 0; i < numEntries; i++)
+	{
+		const int hash = entries[i].hash;
+		shaderTextHashTable[hash][sizes[hash]++] = s_shaderText + entries[i].offset;
+	}
+}
+
+static qboolean R_LoadShaderTextIndex(const uint64_t key)
+{
+	byte* buffer = nullptr;
+	const long length = ri.FS_ReadFile(SHADERTEXT_INDEX_FILE, (void**)&buffer);
+	if (!buffer)
+	{
+		return qfalse;
+	}
+
+	const shaderTextIndexHeader_t* header = (const shaderTextIndexHeader_t*)buffer;
+	const shaderTextEntry_t* entries = (const shaderTextEntry_t*)(header + 1);
+	const char* text = (const char*)(entries + (length >= (long)sizeof(*header) ? header->numEntries : 0));
+
+	if (length < (long)sizeof(*header)
+		|| header->ident != SHADERTEXT_INDEX_IDENT
+		|| header->version != SHADERTEXT_INDEX_VERSION
+		|| header->key != key
+		|| header->numEntries < 0
+		|| header->textLength < 0
+		|| length != (long)(sizeof(*header) + header->numEntries * sizeof(*entries) + header->textLength + 1)
+		|| text[header->textLength] != '\0')
+	{
+		ri.FS_FreeFile(buffer);
+		return qfalse;
+	}
+
+	for (int i = 0; i < header->numEntries; i++)
+	{
+		if (entries[i].offset < 0 || entries[i].offset >= header->textLength
+			|| entries[i].hash < 0 || entries[i].hash >= MAX_SHADERTEXT_HASH)
+		{
+			ri.FS_FreeFile(buffer);
+			return qfalse;
+		}
+	}
+
+	s_shaderText = (char*)Hunk_Alloc(header->textLength + 1, h_low);
+	Com_Memcpy(s_shaderText, text, header->textLength + 1);
+	R_SetupShaderTextHash(entries, header->numEntries);
+
+	ri.FS_FreeFile(buffer);
+	return qtrue;
+}
+
+static void R_SaveShaderTextIndex(const uint64_t key, const std::vector<shaderTextEntry_t>& entries)
+{
+	shaderTextIndexHeader_t header;
+	header.ident = SHADERTEXT_INDEX_IDENT;
+	header.version = SHADERTEXT_INDEX_VERSION;
+	header.key = key;
+	header.numEntries = (int)entries.size();
+	header.textLength = (int)strlen(s_shaderText);
+
+	std::vector<byte> buffer(sizeof(header) + entries.size() * sizeof(shaderTextEntry_t) + header.textLength + 1);
+	byte* out = buffer.data();
+	Com_Memcpy(out, &header, sizeof(header));
+	out += sizeof(header);
+	if (!entries.empty())
+	{
+		Com_Memcpy(out, entries.data(), entries.size() * sizeof(shaderTextEntry_t));
+		out += entries.size() * sizeof(shaderTextEntry_t);
+	}
+	Com_Memcpy(out, s_shaderText, header.textLength + 1);
+
+	ri.FS_WriteFile(SHADERTEXT_INDEX_FILE, buffer.data(), (int)buffer.size());
+}
+
 /*
 ====================
 ScanAndLoadShaderFiles
@@ -4966,12 +5099,14 @@ static void ScanAndLoadShaderFiles()
 	const char* p;
 	int numShaderFiles;
 	int i;
-	char* oldp, * token, * hashMem, * textEnd;
-	int shaderTextHashTableSizes[MAX_SHADERTEXT_HASH], hash, size;
+	char* oldp, * token, * textEnd;
 	char shader_name[MAX_QPATH];
 	int shaderLine;
+	char(*filenames)[MAX_QPATH];
 
 	long sum = 0, summand;
+	const int startTime = ri.Milliseconds();
+
 	// scan for shader files
 	shader_files = ri.FS_ListFiles("shaders", ".shader", &numShaderFiles);
 
@@ -4985,15 +5120,23 @@ static void ScanAndLoadShaderFiles()
 		numShaderFiles = MAX_SHADER_FILES;
 	}
 
-	// load and parse shader files
+	filenames = (char(*)[MAX_QPATH])R_Malloc(numShaderFiles * MAX_QPATH, TAG_TEMP_WORKSPACE, qfalse);
+
+	// find the files to load and build the index key from them
+	uint64_t key = FNV1A64_INIT;
+	const int indexVersion = SHADERTEXT_INDEX_VERSION;
+	const uint64_t pakHash = ri.FS_LoadedPakHash();
+
+	key = Com_HashFNV1a64Bytes(key, &indexVersion, sizeof(indexVersion));
+	key = Com_HashFNV1a64Bytes(key, &pakHash, sizeof(pakHash));
 	for (i = 0; i < numShaderFiles; i++)
 	{
-		char filename[MAX_QPATH];
+		char* filename = filenames[i];
 
 		// look for a .mtr file first
 		{
 			char* ext;
-			Com_sprintf(filename, sizeof(filename), "shaders/%s", shader_files[i]);
+			Com_sprintf(filename, MAX_QPATH, "shaders/%s", shader_files[i]);
 			if ((ext = strrchr(filename, '.')))
 			{
 				strcpy(ext, ".mtr");
@@ -5001,10 +5144,38 @@ static void ScanAndLoadShaderFiles()
 
 			if (ri.FS_ReadFile(filename, NULL) <= 0)
 			{
-				Com_sprintf(filename, sizeof(filename), "shaders/%s", shader_files[i]);
+				Com_sprintf(filename, MAX_QPATH, "shaders/%s", shader_files[i]);
 			}
 		}
 
+		key = Com_HashFNV1a64Bytes(key, filename, strlen(filename) + 1);
+		if (r_shaderIndex->integer && ri.FS_FileIsInPAK(filename) != 1)
+		{
+			void* buffer = nullptr;
+			const long length = ri.FS_ReadFile(filename, &buffer);
+
+			key = Com_HashFNV1a64Bytes(key, &length, sizeof(length));
+			if (buffer)
+			{
+				key = Com_HashFNV1a64Bytes(key, buffer, length);
+				ri.FS_FreeFile(buffer);
+			}
+		}
+	}
+
+	if (r_shaderIndex->integer && R_LoadShaderTextIndex(key))
+	{
+		R_Free(filenames);
+		ri.FS_FreeFileList(shader_files);
+		ri.Printf(PRINT_ALL, "...loaded shader text index in %i msec\n", ri.Milliseconds() - startTime);
+		return;
+	}
+
+	// load and parse shader files
+	for (i = 0; i < numShaderFiles; i++)
+	{
+		const char* filename = filenames[i];
+
 		ri.Printf(PRINT_DEVELOPER, "...loading '%s'\n", filename);
 		summand = ri.FS_ReadFile(filename, (void**)&buffers[i]);
 
@@ -5089,40 +5260,15 @@ static void ScanAndLoadShaderFiles()
 	COM_Compress(s_shaderText);
 
 	// free up memory
+	R_Free(filenames);
 	ri.FS_FreeFileList(shader_files);
 
-	Com_Memset(shaderTextHashTableSizes, 0, sizeof(shaderTextHashTableSizes));
-	size = 0;
+	std::vector<shaderTextEntry_t> entries;
 
 #ifdef REND2_SP
 	COM_BeginParseSession();
 #endif
 
-	p = s_shaderText;
-	// look for shader names
-	while (1) {
-		token = COM_ParseExt(&p, qtrue);
-		if (token[0] == 0) {
-			break;
-		}
-
-		hash = generateHashValue(token, MAX_SHADERTEXT_HASH);
-		shaderTextHashTableSizes[hash]++;
-		size++;
-		SkipBracedSection(&p, 0);
-	}
-
-	size += MAX_SHADERTEXT_HASH;
-
-	hashMem = (char*)Hunk_Alloc(size * sizeof(char*), h_low);
-
-	for (i = 0; i < MAX_SHADERTEXT_HASH; i++) {
-		shaderTextHashTable[i] = (char**)hashMem;
-		hashMem = ((char*)hashMem) + ((shaderTextHashTableSizes[i] + 1) * sizeof(char*));
-	}
-
-	Com_Memset(shaderTextHashTableSizes, 0, sizeof(shaderTextHashTableSizes));
-
 	p = s_shaderText;
 	// look for shader names
 	while (1) {
@@ -5132,8 +5278,10 @@ static void ScanAndLoadShaderFiles()
 			break;
 		}
 
-		hash = generateHashValue(token, MAX_SHADERTEXT_HASH);
-		shaderTextHashTable[hash][shaderTextHashTableSizes[hash]++] = oldp;
+		shaderTextEntry_t entry;
+		entry.offset = (int)(oldp - s_shaderText);
+		entry.hash = (int)generateHashValue(token, MAX_SHADERTEXT_HASH);
+		entries.push_back(entry);
 
 		SkipBracedSection(&p, 0);
 	}
@@ -5142,7 +5290,14 @@ static void ScanAndLoadShaderFiles()
 	COM_EndParseSession();
 #endif
 
-	return;
+	R_SetupShaderTextHash(entries.data(), (int)entries.size());
+
+	if (r_shaderIndex->integer)
+	{
+		R_SaveShaderTextIndex(key, entries);
+	}
+
+	ri.Printf(PRINT_ALL, "...scanned %i shader files in %i msec\n", numShaderFiles, ri.Milliseconds() - startTime);
 }
 
 shader_t* R_CreateShaderFromTextureBundle(
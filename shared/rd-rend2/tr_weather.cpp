@@ -1195,6 +1195,128 @@ static bool IsInsideBrush(const weatherBrushes_t* Brush, const vec3_t pos)
 		&& pos[0] < maxs[0] && pos[1] < maxs[1] && pos[2] < maxs[2]);
 }
 
+void R_BuildWeatherBrushGrid()
+{
+	weatherBrushGrid_t* grid = &tr.weatherSystem->weatherBrushGrid;
+	const int numBrushes = tr.weatherSystem->numWeatherBrushes;
+	int lo[MAX_WEATHER_ZONES * 2][3], hi[MAX_WEATHER_ZONES * 2][3];
+
+	grid->valid = false;
+	CurrentWeatherBrushIndex = -1;
+	if (numBrushes == 0)
+	{
+		return;
+	}
+
+	ClearBounds(grid->mins, grid->maxs);
+	for (int i = 0; i < numBrushes; i++)
+	{
+		const weatherBrushes_t* brush = &tr.weatherSystem->weatherBrushes[i];
+		const vec3_t mins = { -brush->planes[0][3], -brush->planes[2][3], -brush->planes[4][3] };
+		const vec3_t maxs = { brush->planes[1][3], brush->planes[3][3], brush->planes[5][3] };
+
+		AddPointToBounds(mins, grid->mins, grid->maxs);
+		AddPointToBounds(maxs, grid->mins, grid->maxs);
+	}
+
+	// roughly cubic cells, with the longest axis split WEATHER_GRID_MAX_DIM times
+	vec3_t extents;
+	VectorSubtract(grid->maxs, grid->mins, extents);
+	const float cellSize = MAX(MAX(extents[0], extents[1]), MAX(extents[2], 1.0f)) / WEATHER_GRID_MAX_DIM;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		grid->dims[axis] = Com_Clampi(1, WEATHER_GRID_MAX_DIM, (int)ceilf(extents[axis] / cellSize));
+		grid->invCellSize[axis] = extents[axis] > 0.0f ? grid->dims[axis] / extents[axis] : 0.0f;
+	}
+
+	// count the brushes overlapping each cell
+	const int numCells = grid->dims[0] * grid->dims[1] * grid->dims[2];
+	memset(grid->cellStart, 0, sizeof(grid->cellStart));
+	for (int i = 0; i < numBrushes; i++)
+	{
+		const weatherBrushes_t* brush = &tr.weatherSystem->weatherBrushes[i];
+		const vec3_t mins = { -brush->planes[0][3], -brush->planes[2][3], -brush->planes[4][3] };
+		const vec3_t maxs = { brush->planes[1][3], brush->planes[3][3], brush->planes[5][3] };
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			lo[i][axis] = Com_Clampi(0, grid->dims[axis] - 1, (int)floorf((mins[axis] - grid->mins[axis]) * grid->invCellSize[axis]));
+			hi[i][axis] = Com_Clampi(0, grid->dims[axis] - 1, (int)floorf((maxs[axis] - grid->mins[axis]) * grid->invCellSize[axis]));
+		}
+
+		for (int z = lo[i][2]; z <= hi[i][2]; z++)
+			for (int y = lo[i][1]; y <= hi[i][1]; y++)
+				for (int x = lo[i][0]; x <= hi[i][0]; x++)
+					grid->cellStart[(z * grid->dims[1] + y) * grid->dims[0] + x + 1]++;
+	}
+
+	for (int cell = 0; cell < numCells; cell++)
+	{
+		grid->cellStart[cell + 1] += grid->cellStart[cell];
+	}
+	if (grid->cellStart[numCells] > WEATHER_GRID_MAX_REFS)
+	{
+		ri.Printf(PRINT_DEVELOPER, "Weather brush grid overflow (%i references), using linear search\n", grid->cellStart[numCells]);
+		return;
+	}
+
+	// fill the cells, keeping the brushes in map order
+	static int fill[WEATHER_GRID_MAX_CELLS];
+	memcpy(fill, grid->cellStart, numCells * sizeof(int));
+	for (int i = 0; i < numBrushes; i++)
+	{
+		for (int z = lo[i][2]; z <= hi[i][2]; z++)
+			for (int y = lo[i][1]; y <= hi[i][1]; y++)
+				for (int x = lo[i][0]; x <= hi[i][0]; x++)
+					grid->cellBrushes[fill[(z * grid->dims[1] + y) * grid->dims[0] + x]++] = (uint8_t)i;
+	}
+
+	grid->valid = true;
+	ri.Printf(PRINT_DEVELOPER, "Weather brush grid: %i brushes, %ix%ix%i cells, %i references\n",
+		numBrushes, grid->dims[0], grid->dims[1], grid->dims[2], grid->cellStart[numCells]);
+}
+
+// returns the index of a weather brush containing pos, or -1
+static int R_FindWeatherBrush(const vec3_t pos)
+{
+	const weatherBrushGrid_t* grid = &tr.weatherSystem->weatherBrushGrid;
+
+	if (!grid->valid)
+	{
+		for (int i = 0; i < tr.weatherSystem->numWeatherBrushes; i++)
+		{
+			if (IsInsideBrush(&tr.weatherSystem->weatherBrushes[i], pos))
+			{
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	// the brushes are open boxes, so nothing contains a point on or beyond the grid bounds
+	if (pos[0] <= grid->mins[0] || pos[1] <= grid->mins[1] || pos[2] <= grid->mins[2]
+		|| pos[0] >= grid->maxs[0] || pos[1] >= grid->maxs[1] || pos[2] >= grid->maxs[2])
+	{
+		return -1;
+	}
+
+	int cell[3];
+	for (int axis = 0; axis < 3; axis++)
+	{
+		cell[axis] = Com_Clampi(0, grid->dims[axis] - 1, (int)floorf((pos[axis] - grid->mins[axis]) * grid->invCellSize[axis]));
+	}
+
+	const int cellNum = (cell[2] * grid->dims[1] + cell[1]) * grid->dims[0] + cell[0];
+	for (int i = grid->cellStart[cellNum]; i < grid->cellStart[cellNum + 1]; i++)
+	{
+		if (IsInsideBrush(&tr.weatherSystem->weatherBrushes[grid->cellBrushes[i]], pos))
+		{
+			return grid->cellBrushes[i];
+		}
+	}
+	return -1;
+}
+
 bool R_IsOutside(vec3_t pos)
 {
 	if (!tr.weatherSystem)
@@ -1211,20 +1333,105 @@ bool R_IsOutside(vec3_t pos)
 		}
 	}
 
-	// check all weather brushes
-	for (int i = 0; i < tr.weatherSystem->numWeatherBrushes; i++)
+	CurrentWeatherBrushIndex = R_FindWeatherBrush(pos);
+	if (CurrentWeatherBrushIndex != -1)
+	{
+		return (tr.weatherSystem->weatherBrushType == WEATHER_BRUSHES_OUTSIDE);
+	}
+	return (tr.weatherSystem->weatherBrushType != WEATHER_BRUSHES_OUTSIDE);
+}
+
+/*
+===============
+R_IsOutsideBatch
+
+Classifies numPoints points at once, for callers that would otherwise
+call R_IsOutside once per entity
+===============
+*/
+void R_IsOutsideBatch(int numPoints, vec3_t* points, bool* outside)
+{
+	if (!tr.weatherSystem)
 	{
-		const weatherBrushes_t* WeatherBrush = &tr.weatherSystem->weatherBrushes[i];
+		for (int i = 0; i < numPoints; i++)
+		{
+			outside[i] = false;
+		}
+		return;
+	}
+
+	const bool insideIsOutside = (tr.weatherSystem->weatherBrushType == WEATHER_BRUSHES_OUTSIDE);
+	int lastBrush = CurrentWeatherBrushIndex;
 
-		if (IsInsideBrush(WeatherBrush, pos))
+	for (int i = 0; i < numPoints; i++)
+	{
+		// neighbouring points usually share a brush
+		if (lastBrush < 0 || lastBrush >= tr.weatherSystem->numWeatherBrushes
+			|| !IsInsideBrush(&tr.weatherSystem->weatherBrushes[lastBrush], points[i]))
 		{
-			CurrentWeatherBrushIndex = i;
-			return (tr.weatherSystem->weatherBrushType == WEATHER_BRUSHES_OUTSIDE);
+			lastBrush = R_FindWeatherBrush(points[i]);
 		}
+		outside[i] = (lastBrush != -1) ? insideIsOutside : !insideIsOutside;
 	}
+}
 
-	CurrentWeatherBrushIndex = -1;
-	return (tr.weatherSystem->weatherBrushType != WEATHER_BRUSHES_OUTSIDE);
+/*
+===============
+R_WeatherBench_f
+
+weatherbench [frames] [queries]
+Times R_IsOutside on random points inside the world bounds, once with
+the brush grid and once with the linear search
+===============
+*/
+void R_WeatherBench_f(void)
+{
+	if (!tr.world || !tr.weatherSystem)
+	{
+		ri.Printf(PRINT_ALL, "weatherbench: no map loaded\n");
+		return;
+	}
+
+	const int frames = ri.Cmd_Argc() > 1 ? MAX(1, atoi(ri.Cmd_Argv(1))) : 100;
+	const int queries = ri.Cmd_Argc() > 2 ? MAX(1, atoi(ri.Cmd_Argv(2))) : 10000;
+
+	std::vector<float> points(queries * 3);
+	std::vector<bool> results[2];
+	const mnode_t* root = tr.world->nodes;
+	for (int i = 0; i < queries; i++)
+	{
+		for (int axis = 0; axis < 3; axis++)
+		{
+			points[i * 3 + axis] = flrand(root->mins[axis], root->maxs[axis]);
+		}
+	}
+
+	weatherBrushGrid_t* grid = &tr.weatherSystem->weatherBrushGrid;
+	const bool gridValid = grid->valid;
+	for (int pass = 0; pass < 2; pass++)
+	{
+		grid->valid = gridValid && pass == 0;
+		results[pass].resize(queries);
+
+		const int start = ri.Milliseconds();
+		for (int frame = 0; frame < frames; frame++)
+		{
+			for (int i = 0; i < queries; i++)
+			{
+				results[pass][i] = R_IsOutside(&points[i * 3]);
+			}
+		}
+		const int msec = ri.Milliseconds() - start;
+
+		ri.Printf(PRINT_ALL, "%s: %i queries x %i frames in %i msec (%.3f msec/frame)\n",
+			pass == 0 ? "grid" : "linear", queries, frames, msec, (float)msec / frames);
+	}
+	grid->valid = gridValid;
+
+	if (results[0] != results[1])
+	{
+		ri.Printf(PRINT_WARNING, "weatherbench: grid and linear search disagree\n");
+	}
 }
 
 bool R_IsShaking(vec3_t pos)
@@ -25,6 +25,10 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #define MAX_WINDOBJECTS 10
 #define MAX_WEATHER_ZONES 100
 
+#define WEATHER_GRID_MAX_DIM 16
+#define WEATHER_GRID_MAX_CELLS (WEATHER_GRID_MAX_DIM * WEATHER_GRID_MAX_DIM * WEATHER_GRID_MAX_DIM)
+#define WEATHER_GRID_MAX_REFS 32768
+
 enum weatherType_t
 {
 	WEATHER_RAIN,
@@ -79,6 +83,19 @@ struct weatherBrushes_t
 	vec4_t	planes[64];
 };
 
+// Uniform grid over the bounds of all weather brushes. Each cell lists the
+// brushes overlapping it, so a point query only tests those.
+struct weatherBrushGrid_t
+{
+	bool	valid;
+	vec3_t	mins;
+	vec3_t	maxs;
+	vec3_t	invCellSize;
+	int		dims[3];
+	int		cellStart[WEATHER_GRID_MAX_CELLS + 1];
+	uint8_t	cellBrushes[WEATHER_GRID_MAX_REFS]; // brush index, MAX_WEATHER_ZONES * 2 fits
+};
+
 enum weatherBrushType_t
 {
 	WEATHER_BRUSHES_NONE,
@@ -94,6 +111,7 @@ struct weatherSystem_t
 	windObject_t windSlots[MAX_WINDOBJECTS];
 	weatherBrushes_t weatherBrushes[MAX_WEATHER_ZONES * 2];
 	weatherBrushType_t weatherBrushType = WEATHER_BRUSHES_NONE;
+	weatherBrushGrid_t weatherBrushGrid;
 
 	int activeWeatherTypes = 0;
 	int activeWindObjects = 0;
@@ -116,12 +134,14 @@ void R_InitWeatherSystem();
 void R_InitWeatherForMap();
 void R_AddWeatherSurfaces();
 void R_AddWeatherBrush(uint8_t numplanes, vec4_t* planes);
+void R_BuildWeatherBrushGrid();
 void R_LoadWeatherImages();
 void R_ShutdownWeatherSystem();
 void RB_SurfaceWeather(srfWeather_t* surf);
 bool R_IsOutside(vec3_t pos);
 bool R_IsShaking(vec3_t pos);
 float R_IsOutsideCausingPain(vec3_t pos);
+void R_IsOutsideBatch(int numPoints, vec3_t* points, bool* outside);
 float R_GetChanceOfSaberFizz();
 bool R_GetWindVector(vec3_t windVector, vec3_t atPoint); // doesn't work?
 bool R_GetWindGusting(vec3_t atPoint); // doesn't work
@@ -130,3 +150,4 @@ void RE_WorldEffectCommand(const char* cmd);
 void R_WorldEffect_f(void);
 void R_WeatherEffect_f(void);
 void R_SetWeatherEffect_f(void);
+void R_WeatherBench_f(void);
@@ -0,0 +1,118 @@
+// Times the out-of-line q_math.c vector helpers against the q_math_inline.h
+// versions over the same data.  Not a unit test; run QMathBench by hand.
+//
+//	QMathBench [iterations]
+
+#include "qcommon/q_math_inline.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+	const int numItems = 4096;
+
+	struct Data
+	{
+		std::vector< float > a, b, out;
+		std::vector< float > scale;
+		std::vector< cplane_t > planes;
+
+		Data() : a( numItems * 3 ), b( numItems * 3 ), out( numItems * 3 ), scale( numItems ), planes( numItems )
+		{
+			std::mt19937 rng( 1 );
+			std::uniform_real_distribution< float > pos( -4096.0f, 4096.0f );
+			std::uniform_real_distribution< float > unit( -1.0f, 1.0f );
+
+			for( int i = 0; i < numItems * 3; i++ )
+			{
+				a[i] = pos( rng );
+				b[i] = a[i] + unit( rng ) * 256.0f;
+			}
+			for( int i = 0; i < numItems; i++ )
+			{
+				scale[i] = unit( rng );
+
+				cplane_t& plane = planes[i];
+				plane.normal[0] = unit( rng );
+				plane.normal[1] = unit( rng );
+				plane.normal[2] = unit( rng );
+				::VectorNormalize( plane.normal );
+				plane.dist = pos( rng );
+				plane.type = PLANE_NON_AXIAL;
+				SetPlaneSignbits( &plane );
+			}
+		}
+
+		float* A( int i ) { return &a[i * 3]; }
+		float* B( int i ) { return &b[i * 3]; }
+		float* Out( int i ) { return &out[i * 3]; }
+	};
+
+	volatile float floatSink;
+	volatile int intSink;
+
+	template< typename Body >
+	double timeLoop( const int iterations, Body body )
+	{
+		const auto start = std::chrono::steady_clock::now();
+		for( int n = 0; n < iterations; n++ )
+		{
+			body();
+		}
+		const std::chrono::duration< double, std::nano > elapsed = std::chrono::steady_clock::now() - start;
+		return elapsed.count() / ( static_cast< double >( iterations ) * numItems );
+	}
+
+	void report( const char* name, const double outOfLine, const double inlined )
+	{
+		std::printf( "%-20s %8.2f %8.2f %7.2fx\n", name, outOfLine, inlined, outOfLine / inlined );
+	}
+}
+
+int main( int argc, char** argv )
+{
+	const int iterations = argc > 1 ? std::atoi( argv[1] ) : 2000;
+	Data d;
+
+	std::printf( "%-20s %8s %8s %8s  (ns per call, %i x %i calls)\n", "", "q_math.c", "inline", "speedup", iterations, numItems );
+
+	report( "VectorMA",
+		timeLoop( iterations, [&d]() { for( int i = 0; i < numItems; i++ ) ::VectorMA( d.A( i ), d.scale[i], d.B( i ), d.Out( i ) ); } ),
+		timeLoop( iterations, [&d]() { for( int i = 0; i < numItems; i++ ) qm::VectorMA( d.A( i ), d.scale[i], d.B( i ), d.Out( i ) ); } ) );
+
+	report( "VectorSubtract",
+		timeLoop( iterations, [&d]() { for( int i = 0; i < numItems; i++ ) ::VectorSubtract( d.A( i ), d.B( i ), d.Out( i ) ); } ),
+		timeLoop( iterations, [&d]() { for( int i = 0; i < numItems; i++ ) qm::VectorSubtract( d.A( i ), d.B( i ), d.Out( i ) ); } ) );
+
+	report( "DotProduct",
+		timeLoop( iterations, [&d]() { float sum = 0; for( int i = 0; i < numItems; i++ ) sum += ::DotProduct( d.A( i ), d.B( i ) ); floatSink = sum; } ),
+		timeLoop( iterations, [&d]() { float sum = 0; for( int i = 0; i < numItems; i++ ) sum += qm::DotProduct( d.A( i ), d.B( i ) ); floatSink = sum; } ) );
+
+	report( "DistanceSquared",
+		timeLoop( iterations, [&d]() { float sum = 0; for( int i = 0; i < numItems; i++ ) sum += ::DistanceSquared( d.A( i ), d.B( i ) ); floatSink = sum; } ),
+		timeLoop( iterations, [&d]() { float sum = 0; for( int i = 0; i < numItems; i++ ) sum += qm::DistanceSquared( d.A( i ), d.B( i ) ); floatSink = sum; } ) );
+
+	report( "VectorNormalize2",
+		timeLoop( iterations, [&d]() { for( int i = 0; i < numItems; i++ ) ::VectorNormalize2( d.A( i ), d.Out( i ) ); } ),
+		timeLoop( iterations, [&d]() { for( int i = 0; i < numItems; i++ ) qm::VectorNormalize2( d.A( i ), d.Out( i ) ); } ) );
+
+	report( "BoxOnPlaneSide",
+		timeLoop( iterations, [&d]() { int sides = 0; for( int i = 0; i < numItems; i++ ) sides += ::BoxOnPlaneSide( d.A( i ), d.B( i ), &d.planes[i] ); intSink = sides; } ),
+		timeLoop( iterations, [&d]() { int sides = 0; for( int i = 0; i < numItems; i++ ) sides += qm::BoxOnPlaneSide( d.A( i ), d.B( i ), &d.planes[i] ); intSink = sides; } ) );
+
+	report( "MatrixMultiply",
+		timeLoop( iterations, [&d]() {
+			for( int i = 0; i + 3 <= numItems; i++ )
+				::MatrixMultiply( reinterpret_cast< float( * )[3] >( d.A( i ) ), reinterpret_cast< float( * )[3] >( d.B( i ) ), reinterpret_cast< float( * )[3] >( d.Out( i ) ) );
+		} ),
+		timeLoop( iterations, [&d]() {
+			for( int i = 0; i + 3 <= numItems; i++ )
+				qm::MatrixMultiply( reinterpret_cast< float( * )[3] >( d.A( i ) ), reinterpret_cast< float( * )[3] >( d.B( i ) ), reinterpret_cast< float( * )[3] >( d.Out( i ) ) );
+		} ) );
+
+	return 0;
+}
@@ -0,0 +1,143 @@
+#include "client/cl_cin_kernels.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+	// the codebook loops from cl_cin.cpp as they were before the kernels
+	unsigned int referencePixel( const roqYUVTables_t& tables, const long y, const long u, const long v )
+	{
+		const long yy = tables.YY[y];
+
+		long r = ( yy + tables.VR[v] ) >> 6;
+		long g = ( yy + tables.UG[u] + tables.VG[v] ) >> 6;
+		long b = ( yy + tables.UB[u] ) >> 6;
+
+		r = r < 0 ? 0 : r > 255 ? 255 : r;
+		g = g < 0 ? 0 : g > 255 ? 255 : g;
+		b = b < 0 ? 0 : b > 255 ? 255 : b;
+
+		const unsigned char rgba[4] = { static_cast< unsigned char >( r ), static_cast< unsigned char >( g ), static_cast< unsigned char >( b ), 255 };
+		unsigned int pixel;
+		std::memcpy( &pixel, rgba, sizeof( pixel ) );
+		return pixel;
+	}
+
+	void referenceExpand( const unsigned int* vq2, const unsigned char* input, const int numHalves, unsigned int* c, unsigned int* d )
+	{
+		for( int i = 0; i < numHalves; i++ )
+		{
+			const unsigned int* a = vq2 + *input++ * 4;
+			const unsigned int* b = vq2 + *input++ * 4;
+			for( int j = 0; j < 2; j++ )
+			{
+				*c++ = a[0]; *d++ = a[0]; *d++ = a[0];
+				*c++ = a[1]; *d++ = a[1]; *d++ = a[1];
+				*c++ = b[0]; *d++ = b[0]; *d++ = b[0];
+				*c++ = b[1]; *d++ = b[1]; *d++ = b[1];
+				*d++ = a[0]; *d++ = a[0];
+				*d++ = a[1]; *d++ = a[1];
+				*d++ = b[0]; *d++ = b[0];
+				*d++ = b[1]; *d++ = b[1];
+				a += 2; b += 2;
+			}
+		}
+	}
+
+	struct Codebook
+	{
+		std::vector< unsigned char > cells2;	// 256 cells of y0 y1 y2 y3 cr cb
+		std::vector< unsigned char > cells4;	// 256 cells of 4 indices
+
+		explicit Codebook( unsigned seed ) : cells2( 256 * 6 ), cells4( 256 * 4 )
+		{
+			std::mt19937 rng( seed );
+			for( unsigned char& b : cells2 )
+			{
+				b = static_cast< unsigned char >( rng() );
+			}
+			for( unsigned char& b : cells4 )
+			{
+				b = static_cast< unsigned char >( rng() );
+			}
+		}
+	};
+}
+
+BOOST_AUTO_TEST_SUITE( cin_kernels )
+
+BOOST_AUTO_TEST_CASE( scalar_matches_original )
+{
+	roqYUVTables_t tables;
+	ROQ_GenYUVTables( tables );
+
+	// every luma against every chroma pair
+	std::vector< unsigned char > cells( 256 * 6 );
+	std::vector< unsigned char > vq2( 256 * 16 );
+	for( int cr = 0; cr < 256; cr++ )
+	{
+		for( int cb = 0; cb < 256; cb++ )
+		{
+			for( int y = 0; y < 4; y++ )
+			{
+				cells[cb * 6 + y] = static_cast< unsigned char >( ( cr + cb * 4 + y ) & 255 );
+			}
+			cells[cb * 6 + 4] = static_cast< unsigned char >( cr );
+			cells[cb * 6 + 5] = static_cast< unsigned char >( cb );
+		}
+		roqKernelsScalar.decodeCells2( tables, cells.data(), 256, vq2.data() );
+
+		for( int i = 0; i < 256 * 4; i++ )
+		{
+			unsigned int pixel;
+			std::memcpy( &pixel, &vq2[i * 4], sizeof( pixel ) );
+			BOOST_REQUIRE_EQUAL( pixel, referencePixel( tables, cells[i / 4 * 6 + i % 4], cr, i / 4 ) );
+		}
+	}
+
+	Codebook book( 1 );
+	std::vector< unsigned int > expected4( 256 * 16 ), expected8( 256 * 64 );
+	std::vector< unsigned char > actual4( 256 * 64 ), actual8( 256 * 256 );
+	roqKernelsScalar.decodeCells2( tables, book.cells2.data(), 256, vq2.data() );
+	referenceExpand( reinterpret_cast< const unsigned int* >( vq2.data() ), book.cells4.data(), 512, expected4.data(), expected8.data() );
+	roqKernelsScalar.expandCells4( vq2.data(), book.cells4.data(), 256, actual4.data(), actual8.data() );
+	BOOST_CHECK( std::memcmp( expected4.data(), actual4.data(), actual4.size() ) == 0 );
+	BOOST_CHECK( std::memcmp( expected8.data(), actual8.data(), actual8.size() ) == 0 );
+}
+
+#ifdef ROQ_SIMD_KERNELS
+
+BOOST_AUTO_TEST_CASE( sse2_matches_scalar )
+{
+	roqYUVTables_t tables;
+	ROQ_GenYUVTables( tables );
+
+	for( unsigned seed = 1; seed <= 64; seed++ )
+	{
+		Codebook book( seed );
+
+		// odd counts, like a codebook chunk that only replaces part of the book
+		const int numCells2 = seed == 1 ? 256 : static_cast< int >( seed * 37 % 256 ) + 1;
+		const int numCells4 = seed == 1 ? 256 : static_cast< int >( seed * 53 % 256 ) + 1;
+
+		std::vector< unsigned char > expected2( 256 * 16, 0xcd ), actual2( 256 * 16, 0xcd );
+		roqKernelsScalar.decodeCells2( tables, book.cells2.data(), numCells2, expected2.data() );
+		roqKernelsSSE2.decodeCells2( tables, book.cells2.data(), numCells2, actual2.data() );
+		BOOST_REQUIRE( std::memcmp( expected2.data(), actual2.data(), expected2.size() ) == 0 );
+
+		std::vector< unsigned char > expected4( 256 * 64, 0xcd ), actual4( 256 * 64, 0xcd );
+		std::vector< unsigned char > expected8( 256 * 256, 0xcd ), actual8( 256 * 256, 0xcd );
+		roqKernelsScalar.expandCells4( expected2.data(), book.cells4.data(), numCells4, expected4.data(), expected8.data() );
+		roqKernelsSSE2.expandCells4( expected2.data(), book.cells4.data(), numCells4, actual4.data(), actual8.data() );
+		BOOST_REQUIRE( std::memcmp( expected4.data(), actual4.data(), expected4.size() ) == 0 );
+		BOOST_REQUIRE( std::memcmp( expected8.data(), actual8.data(), expected8.size() ) == 0 );
+	}
+}
+
+#endif // ROQ_SIMD_KERNELS
+
+BOOST_AUTO_TEST_SUITE_END() // cin_kernels
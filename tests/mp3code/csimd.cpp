@@ -0,0 +1,119 @@
+#include "mp3code/csimd.h"
+
+#include <cmath>
+#include <cstring>
+#include <random>
+
+#include <boost/test/unit_test.hpp>
+
+#ifdef MP3_SIMD_KERNELS
+
+namespace
+{
+	// gencoef() from csbt.c
+	void genDctCoefs()
+	{
+		float* coef32 = dct_coef_addr();
+		const double pi = 4.0 * std::atan( 1.0 );
+		int n = 16;
+		int k = 0;
+		for( int i = 0; i < 5; i++, n = n / 2 )
+		{
+			for( int p = 0; p < n; p++, k++ )
+			{
+				const double t = ( pi / ( 4 * n ) ) * ( 2 * p + 1 );
+				coef32[k] = static_cast< float >( 0.50 / std::cos( t ) );
+			}
+		}
+	}
+
+	struct Fixture
+	{
+		std::mt19937 rng{ 1 };
+
+		Fixture()
+		{
+			genDctCoefs();
+			mp3_simd_init( 1 );
+		}
+
+		~Fixture()
+		{
+			mp3_simd_init( 0 );
+		}
+
+		// subband samples and window buffers in the range real streams use, with
+		// the occasional big value so the pcm clamp gets exercised too
+		void fill( float* v, const int count, const float range )
+		{
+			std::uniform_real_distribution< float > dist( -range, range );
+			for( int i = 0; i < count; i++ )
+			{
+				v[i] = dist( rng );
+			}
+			v[rng() % count] *= 64.0f;
+		}
+	};
+}
+
+BOOST_FIXTURE_TEST_SUITE( mp3_simd, Fixture )
+
+BOOST_AUTO_TEST_CASE( fdct32_matches_c )
+{
+	for( int n = 0; n < 2000; n++ )
+	{
+		float x[64 + 1];
+		fill( x, 64 + 1, 8192.0f );
+
+		float expected[32], actual[32];
+		fdct32( x, expected );
+		fdct32_sse2( x, actual );
+		BOOST_REQUIRE( std::memcmp( expected, actual, sizeof( expected ) ) == 0 );
+
+		fdct32_dual( x + n % 2, expected );
+		fdct32_dual_sse2( x + n % 2, actual );
+		BOOST_REQUIRE( std::memcmp( expected, actual, sizeof( expected ) ) == 0 );
+
+		fdct32_dual_mono( x, expected );
+		fdct32_dual_mono_sse2( x, actual );
+		BOOST_REQUIRE( std::memcmp( expected, actual, sizeof( expected ) ) == 0 );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( window_matches_c )
+{
+	float vbuf[512];
+	for( int n = 0; n < 500; n++ )
+	{
+		fill( vbuf, 512, n % 2 ? 32768.0f : 2048.0f );
+
+		for( int vb_ptr = 0; vb_ptr < 512; vb_ptr += 32 )
+		{
+			short expected[64], actual[64];
+			std::memset( expected, 0x55, sizeof( expected ) );
+			std::memset( actual, 0x55, sizeof( actual ) );
+
+			window( vbuf, vb_ptr, expected );
+			window_sse2( vbuf, vb_ptr, actual );
+			BOOST_REQUIRE( std::memcmp( expected, actual, sizeof( expected ) ) == 0 );
+
+			window_dual( vbuf, vb_ptr, expected + 1 );
+			window_dual_sse2( vbuf, vb_ptr, actual + 1 );
+			BOOST_REQUIRE( std::memcmp( expected, actual, sizeof( expected ) ) == 0 );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( dispatch )
+{
+	BOOST_CHECK( sbt_window == window_sse2 );
+	BOOST_CHECK_EQUAL( mp3_simd_init( 0 ), "scalar" );
+	BOOST_CHECK( sbt_window == window );
+	BOOST_CHECK( sbt_fdct32 == fdct32 );
+	BOOST_CHECK_EQUAL( mp3_simd_init( 1 ), "SSE2" );
+	BOOST_CHECK( sbt_fdct32_dual_mono == fdct32_dual_mono_sse2 );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // mp3_simd
+
+#endif // MP3_SIMD_KERNELS
@@ -0,0 +1,270 @@
+#include "qcommon/cm_planehash.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+	struct Plane
+	{
+		float plane[4];
+		int signbits;
+	};
+
+	const int maxPlanes = 8192;
+	const double triEpsilon = 0.1;
+
+	// a hashed and a linear plane list, fed the same lookups as cm_patch.cpp
+	struct Planes
+	{
+		std::vector< Plane > linear;
+		std::vector< Plane > hashed;
+		CPlaneHash< Plane, maxPlanes > hash;
+
+		Planes()
+		{
+			linear.reserve( maxPlanes );
+			hashed.reserve( maxPlanes );
+			hash.Clear();
+		}
+
+		void add( const float plane[4] )
+		{
+			Plane p{ { plane[0], plane[1], plane[2], plane[3] }, 0 };
+			linear.push_back( p );
+			hashed.push_back( p );
+			hash.Add( hashed.data(), static_cast< int >( hashed.size() ) - 1 );
+		}
+
+		int findPlane2( const float plane[4] )
+		{
+			int linearFlipped = 0, hashFlipped = 0;
+			const int expected = CM_FindPlaneLinear( linear.data(), static_cast< int >( linear.size() ), plane, &linearFlipped );
+			const int actual = hash.Find( hashed.data(), plane, &hashFlipped );
+
+			BOOST_REQUIRE_EQUAL( expected, actual );
+			if( expected != -1 )
+			{
+				BOOST_REQUIRE_EQUAL( linearFlipped, hashFlipped );
+				return expected;
+			}
+			add( plane );
+			return static_cast< int >( linear.size() ) - 1;
+		}
+
+		int findPlane( const float* p1, const float* p2, const float* p3 )
+		{
+			float plane[4];
+			if( !planeFromPoints( plane, p1, p2, p3 ) )
+			{
+				return -1;
+			}
+
+			const int expected = CM_FindTriPlaneLinear( linear.data(), static_cast< int >( linear.size() ), plane, p1, p2, p3, triEpsilon );
+			const int actual = hash.FindTri( hashed.data(), static_cast< int >( hashed.size() ), plane, p1, p2, p3, triEpsilon );
+
+			BOOST_REQUIRE_EQUAL( expected, actual );
+			if( expected != -1 )
+			{
+				return expected;
+			}
+			add( plane );
+			return static_cast< int >( linear.size() ) - 1;
+		}
+
+		// CM_PlaneFromPoints
+		static bool planeFromPoints( float plane[4], const float* a, const float* b, const float* c )
+		{
+			const float d1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+			const float d2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+			plane[0] = d2[1] * d1[2] - d2[2] * d1[1];
+			plane[1] = d2[2] * d1[0] - d2[0] * d1[2];
+			plane[2] = d2[0] * d1[1] - d2[1] * d1[0];
+
+			const float length = std::sqrt( plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2] );
+			if( !length )
+			{
+				return false;
+			}
+			const float ilength = 1.0f / length;
+			plane[0] *= ilength;
+			plane[1] *= ilength;
+			plane[2] *= ilength;
+			plane[3] = a[0] * plane[0] + a[1] * plane[1] + a[2] * plane[2];
+			return true;
+		}
+	};
+
+	// a bumpy, partly flat grid somewhere in the map, like a subdivided patch
+	std::vector< float > makeGrid( std::mt19937& rng, const int width, const int height )
+	{
+		std::uniform_real_distribution< float > origin( -4096.0f, 4096.0f );
+		std::uniform_real_distribution< float > spacing( 4.0f, 32.0f );
+		std::uniform_real_distribution< float > bump( 0.0f, 24.0f );
+
+		const float ox = origin( rng ), oy = origin( rng ), oz = origin( rng );
+		const float step = spacing( rng );
+		const float amplitude = rng() % 3 ? bump( rng ) : 0.0f;
+
+		std::vector< float > points( width * height * 3 );
+		for( int i = 0; i < width; i++ )
+		{
+			for( int j = 0; j < height; j++ )
+			{
+				float* p = &points[( i * height + j ) * 3];
+				p[0] = ox + i * step;
+				p[1] = oy + j * step;
+				p[2] = oz + amplitude * std::sin( i * 0.4f ) * std::cos( j * 0.3f );
+			}
+		}
+		return points;
+	}
+}
+
+BOOST_AUTO_TEST_SUITE( cm_planehash )
+
+BOOST_AUTO_TEST_CASE( hash_matches_linear_scan )
+{
+	std::mt19937 rng( 1 );
+
+	for( int n = 0; n < 24; n++ )
+	{
+		const int width = 3 + static_cast< int >( rng() % 14 );
+		const int height = 3 + static_cast< int >( rng() % 14 );
+		const std::vector< float > grid = makeGrid( rng, width, height );
+		const auto point = [&]( int i, int j ) { return &grid[( i * height + j ) * 3]; };
+
+		Planes planes;
+
+		for( int i = 0; i < width - 1; i++ )
+		{
+			for( int j = 0; j < height - 1; j++ )
+			{
+				// the two triangles of each grid cell
+				const int tri0 = planes.findPlane( point( i, j ), point( i + 1, j ), point( i + 1, j + 1 ) );
+				planes.findPlane( point( i + 1, j + 1 ), point( i, j + 1 ), point( i, j ) );
+
+				// an edge plane standing up from a triangle, like CM_EdgePlaneNum
+				if( tri0 != -1 )
+				{
+					const float* p1 = point( i, j );
+					const float* normal = planes.linear[tri0].plane;
+					const float up[3] = { p1[0] + 4 * normal[0], p1[1] + 4 * normal[1], p1[2] + 4 * normal[2] };
+					planes.findPlane( p1, point( i + 1, j ), up );
+					planes.findPlane( point( i + 1, j ), p1, up );
+				}
+			}
+		}
+
+		// axial bevels and slightly perturbed copies of existing planes, like the bevels
+		// CM_AddFacetBevels feeds CM_FindPlane2
+		std::uniform_real_distribution< float > jitter( -0.0003f, 0.0003f );
+		std::uniform_real_distribution< float > distJitter( -0.05f, 0.05f );
+		const size_t existing = planes.linear.size();
+		for( size_t k = 0; k < existing; k++ )
+		{
+			const Plane source = planes.linear[k];
+			float plane[4];
+			for( int i = 0; i < 3; i++ )
+			{
+				plane[i] = source.plane[i] + jitter( rng );
+			}
+			plane[3] = source.plane[3] + distJitter( rng );
+			planes.findPlane2( plane );
+
+			const float inverse[4] = { -plane[0], -plane[1], -plane[2], -plane[3] };
+			planes.findPlane2( inverse );
+
+			const float axial[4] = { k % 3 == 0 ? 1.0f : 0.0f, k % 3 == 1 ? 1.0f : 0.0f, k % 3 == 2 ? 1.0f : 0.0f, source.plane[3] };
+			planes.findPlane2( axial );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( leaning_triangles_match_linear_scan )
+{
+	std::mt19937 rng( 2 );
+	std::uniform_real_distribution< float > unit( -1.0f, 1.0f );
+	std::uniform_real_distribution< float > origin( -4096.0f, 4096.0f );
+	std::uniform_real_distribution< float > size( 2.0f, 48.0f );
+	std::uniform_real_distribution< float > lean( -0.099f, 0.099f );
+
+	Planes planes;
+
+	// a few hundred planes on a handful of normals, so neighbouring buckets are busy
+	std::vector< std::vector< float > > normals;
+	for( int n = 0; n < 8; n++ )
+	{
+		float normal[3] = { unit( rng ), unit( rng ), unit( rng ) };
+		const float length = std::sqrt( normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2] );
+		normals.push_back( { normal[0] / length, normal[1] / length, normal[2] / length } );
+	}
+	for( int n = 0; n < 400; n++ )
+	{
+		const std::vector< float >& normal = normals[n % normals.size()];
+		float plane[4] = { normal[0] + unit( rng ) * 0.05f, normal[1] + unit( rng ) * 0.05f, normal[2] + unit( rng ) * 0.05f, 0.0f };
+		const float length = std::sqrt( plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2] );
+		for( int i = 0; i < 3; i++ )
+		{
+			plane[i] /= length;
+		}
+		plane[3] = origin( rng ) * 0.1f;
+		planes.add( plane );
+	}
+
+	// triangles whose corners sit just inside the tolerance of an existing plane,
+	// so their own normal leans away from it by as much as the bound allows
+	for( int n = 0; n < 20000; n++ )
+	{
+		const Plane source = planes.linear[rng() % 400];
+		const float* normal = source.plane;
+
+		// two directions in the plane
+		float t1[3] = { normal[1], -normal[0], 0.0f };
+		if( std::fabs( normal[2] ) > 0.9f )
+		{
+			t1[0] = 0.0f;
+			t1[1] = normal[2];
+			t1[2] = -normal[1];
+		}
+		const float t1Length = std::sqrt( t1[0] * t1[0] + t1[1] * t1[1] + t1[2] * t1[2] );
+		for( int i = 0; i < 3; i++ )
+		{
+			t1[i] /= t1Length;
+		}
+		const float t2[3] = {
+			normal[1] * t1[2] - normal[2] * t1[1],
+			normal[2] * t1[0] - normal[0] * t1[2],
+			normal[0] * t1[1] - normal[1] * t1[0]
+		};
+
+		const float s = size( rng );
+		const float corners[3][2] = { { 0.0f, 0.0f }, { s, unit( rng ) * s * 0.5f }, { unit( rng ) * s * 0.5f, s } };
+		const float u0 = origin( rng ), v0 = origin( rng );
+		float points[3][3];
+		for( int k = 0; k < 3; k++ )
+		{
+			const float offset = source.plane[3] + lean( rng );
+			for( int i = 0; i < 3; i++ )
+			{
+				points[k][i] = normal[i] * offset + t1[i] * ( u0 + corners[k][0] ) + t2[i] * ( v0 + corners[k][1] );
+			}
+		}
+
+		// query without adding, so the plane list stays the same size
+		float plane[4];
+		if( !Planes::planeFromPoints( plane, points[0], points[1], points[2] ) )
+		{
+			continue;
+		}
+		const int count = static_cast< int >( planes.linear.size() );
+		BOOST_REQUIRE_EQUAL(
+			CM_FindTriPlaneLinear( planes.linear.data(), count, plane, points[0], points[1], points[2], triEpsilon ),
+			planes.hash.FindTri( planes.hashed.data(), count, plane, points[0], points[1], points[2], triEpsilon ) );
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END() // cm_planehash
@@ -0,0 +1,201 @@
+#include "qcommon/q_math_inline.h"
+
+#include <cmath>
+#include <cstring>
+#include <random>
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+	const int numSamples = 2000;
+
+	struct Inputs
+	{
+		std::mt19937 rng;
+		std::uniform_real_distribution< float > pos{ -8192.0f, 8192.0f };
+		std::uniform_real_distribution< float > unit{ -1.0f, 1.0f };
+
+		explicit Inputs( unsigned seed ) : rng( seed ) {}
+
+		void vec( float* v, int count )
+		{
+			for( int i = 0; i < count; i++ )
+			{
+				v[i] = pos( rng );
+			}
+		}
+
+		void dir( vec3_t v )
+		{
+			for( int i = 0; i < 3; i++ )
+			{
+				v[i] = unit( rng );
+			}
+		}
+
+		float scalar()
+		{
+			return unit( rng ) * 16.0f;
+		}
+	};
+
+	// bit for bit, so -0 vs 0 and NaN payloads count as differences too
+	bool same( const float* a, const float* b, int count )
+	{
+		return std::memcmp( a, b, count * sizeof( float ) ) == 0;
+	}
+
+	bool same( float a, float b )
+	{
+		return same( &a, &b, 1 );
+	}
+}
+
+BOOST_AUTO_TEST_SUITE( q_math_inline )
+
+BOOST_AUTO_TEST_CASE( vec3 )
+{
+	Inputs in( 1 );
+	for( int n = 0; n < numSamples; n++ )
+	{
+		vec3_t a, b, expected, actual;
+		in.vec( a, 3 );
+		in.vec( b, 3 );
+		const float s = in.scalar();
+
+		::VectorAdd( a, b, expected ); qm::VectorAdd( a, b, actual );
+		BOOST_CHECK( same( expected, actual, 3 ) );
+		::VectorSubtract( a, b, expected ); qm::VectorSubtract( a, b, actual );
+		BOOST_CHECK( same( expected, actual, 3 ) );
+		::VectorScale( a, s, expected ); qm::VectorScale( a, s, actual );
+		BOOST_CHECK( same( expected, actual, 3 ) );
+		::VectorMA( a, s, b, expected ); qm::VectorMA( a, s, b, actual );
+		BOOST_CHECK( same( expected, actual, 3 ) );
+		::VectorAdvance( a, s, b, expected ); qm::VectorAdvance( a, s, b, actual );
+		BOOST_CHECK( same( expected, actual, 3 ) );
+		::CrossProduct( a, b, expected ); qm::CrossProduct( a, b, actual );
+		BOOST_CHECK( same( expected, actual, 3 ) );
+
+		BOOST_CHECK( same( ::DotProduct( a, b ), qm::DotProduct( a, b ) ) );
+		BOOST_CHECK( same( ::VectorLength( a ), qm::VectorLength( a ) ) );
+		BOOST_CHECK( same( ::VectorLengthSquared( a ), qm::VectorLengthSquared( a ) ) );
+		BOOST_CHECK( same( ::Distance( a, b ), qm::Distance( a, b ) ) );
+		BOOST_CHECK( same( ::DistanceSquared( a, b ), qm::DistanceSquared( a, b ) ) );
+		BOOST_CHECK( same( ::DistanceHorizontal( a, b ), qm::DistanceHorizontal( a, b ) ) );
+		BOOST_CHECK( same( ::DistanceHorizontalSquared( a, b ), qm::DistanceHorizontalSquared( a, b ) ) );
+
+		std::memcpy( expected, a, sizeof( vec3_t ) );
+		std::memcpy( actual, a, sizeof( vec3_t ) );
+		BOOST_CHECK( same( ::VectorNormalize( expected ), qm::VectorNormalize( actual ) ) );
+		BOOST_CHECK( same( expected, actual, 3 ) );
+
+		vec3_t expected2, actual2;
+		BOOST_CHECK( same( ::VectorNormalize2( a, expected2 ), qm::VectorNormalize2( a, actual2 ) ) );
+		BOOST_CHECK( same( expected2, actual2, 3 ) );
+
+		std::memcpy( expected, a, sizeof( vec3_t ) );
+		std::memcpy( actual, a, sizeof( vec3_t ) );
+		::VectorNormalizeFast( expected ); qm::VectorNormalizeFast( actual );
+		BOOST_CHECK( same( expected, actual, 3 ) );
+
+		vec3_t expected3;
+		vec3_t actual3;
+		in.dir( a );
+		::VectorNormalize( a );
+		::MakeNormalVectors( a, expected2, expected3 ); qm::MakeNormalVectors( a, actual2, actual3 );
+		BOOST_CHECK( same( expected2, actual2, 3 ) );
+		BOOST_CHECK( same( expected3, actual3, 3 ) );
+	}
+
+	vec3_t zero = { 0, 0, 0 }, expected = { 1, 1, 1 }, actual = { 1, 1, 1 };
+	BOOST_CHECK( same( ::VectorNormalize2( zero, expected ), qm::VectorNormalize2( zero, actual ) ) );
+	BOOST_CHECK( same( expected, actual, 3 ) );
+}
+
+BOOST_AUTO_TEST_CASE( vec4 )
+{
+	Inputs in( 2 );
+	for( int n = 0; n < numSamples; n++ )
+	{
+		vec4_t a, expected, actual;
+		in.vec( a, 4 );
+		const float s = in.scalar();
+
+		::VectorScale4( a, s, expected ); qm::VectorScale4( a, s, actual );
+		BOOST_CHECK( same( expected, actual, 4 ) );
+		::VectorCopy4( a, expected ); qm::VectorCopy4( a, actual );
+		BOOST_CHECK( same( expected, actual, 4 ) );
+		::VectorClear4( expected ); qm::VectorClear4( actual );
+		BOOST_CHECK( same( expected, actual, 4 ) );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( bounds_and_planes )
+{
+	Inputs in( 3 );
+	for( int n = 0; n < numSamples; n++ )
+	{
+		vec3_t mins, maxs, point;
+		in.vec( mins, 3 );
+		in.vec( point, 3 );
+		for( int i = 0; i < 3; i++ )
+		{
+			maxs[i] = mins[i] + std::fabs( in.scalar() ) * 64.0f;
+		}
+		BOOST_CHECK( same( ::RadiusFromBounds( mins, maxs ), qm::RadiusFromBounds( mins, maxs ) ) );
+
+		vec3_t expectedMins, expectedMaxs, actualMins, actualMaxs;
+		std::memcpy( expectedMins, mins, sizeof( vec3_t ) );
+		std::memcpy( expectedMaxs, maxs, sizeof( vec3_t ) );
+		std::memcpy( actualMins, mins, sizeof( vec3_t ) );
+		std::memcpy( actualMaxs, maxs, sizeof( vec3_t ) );
+		::AddPointToBounds( point, expectedMins, expectedMaxs ); qm::AddPointToBounds( point, actualMins, actualMaxs );
+		BOOST_CHECK( same( expectedMins, actualMins, 3 ) );
+		BOOST_CHECK( same( expectedMaxs, actualMaxs, 3 ) );
+
+		cplane_t plane{};
+		in.dir( plane.normal );
+		::VectorNormalize( plane.normal );
+		// mostly planes through the box, so all three answers show up
+		plane.dist = ::DotProduct( point, plane.normal ) * 0.01f + ::DotProduct( mins, plane.normal );
+		plane.type = static_cast< byte >( n % 4 == 0 ? n / 4 % 3 : PLANE_NON_AXIAL );
+		SetPlaneSignbits( &plane );
+		BOOST_CHECK_EQUAL( ::BoxOnPlaneSide( mins, maxs, &plane ), qm::BoxOnPlaneSide( mins, maxs, &plane ) );
+
+		// on the plane exactly
+		plane.type = PLANE_NON_AXIAL;
+		plane.dist = ::DotProduct( mins, plane.normal );
+		BOOST_CHECK_EQUAL( ::BoxOnPlaneSide( mins, mins, &plane ), qm::BoxOnPlaneSide( mins, mins, &plane ) );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( axis_and_matrix )
+{
+	Inputs in( 4 );
+	for( int n = 0; n < numSamples; n++ )
+	{
+		vec3_t angles;
+		for( int i = 0; i < 3; i++ )
+		{
+			angles[i] = in.scalar() * 22.5f;
+		}
+
+		matrix3_t expected, actual;
+		::AnglesToAxis( angles, expected ); qm::AnglesToAxis( angles, actual );
+		BOOST_CHECK( same( expected[0], actual[0], 9 ) );
+
+		float a[3][3], b[3][3], expectedProduct[3][3], actualProduct[3][3];
+		in.vec( a[0], 9 );
+		in.vec( b[0], 9 );
+		::MatrixMultiply( a, b, expectedProduct ); qm::MatrixMultiply( a, b, actualProduct );
+		BOOST_CHECK( same( expectedProduct[0], actualProduct[0], 9 ) );
+
+		vec3_t v, expectedRotated, actualRotated;
+		in.vec( v, 3 );
+		::VectorRotate( v, expected, expectedRotated ); qm::VectorRotate( v, actual, actualRotated );
+		BOOST_CHECK( same( expectedRotated, actualRotated, 3 ) );
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END() // q_math_inline
@@ -0,0 +1,159 @@
+#include "rd-common/tr_font_batch.h"
+
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+	struct Batch
+	{
+		int hShader;
+		std::vector< stretchPicQuad_t > quads;
+	};
+
+	std::vector< Batch > batchLayout( const fontLayout_t& layout, float ox, float oy, const float* rgba, const float( *colourTable )[4] )
+	{
+		std::vector< Batch > batches;
+		R_Font_BatchLayout( layout, ox, oy, rgba, colourTable,
+			[&batches]( int hShader, const stretchPicQuad_t* quads, int numQuads )
+			{
+				batches.push_back( Batch{ hShader, std::vector< stretchPicQuad_t >( quads, quads + numQuads ) } );
+			} );
+		return batches;
+	}
+
+	fontGlyphQuad_t glyph( float x, int hShader, int iColour = -1 )
+	{
+		return fontGlyphQuad_t{ x, 2.0f, 8.0f, 10.0f, 0.0f, 0.25f, 0.5f, 0.75f, hShader, iColour };
+	}
+
+	const fontLayoutKey_t key{ 1, 1.0f, -1, 0 };
+}
+
+BOOST_AUTO_TEST_SUITE( font_batch )
+
+BOOST_AUTO_TEST_CASE( one_batch_per_shader_run )
+{
+	fontLayout_t layout{};
+	for( int hShader : { 5, 5, 7, 7, 7, 5 } )
+	{
+		layout.glyphs.push_back( glyph( static_cast< float >( layout.glyphs.size() ) * 8.0f, hShader ) );
+	}
+
+	const std::vector< Batch > batches = batchLayout( layout, 100.0f, 50.0f, nullptr, nullptr );
+	BOOST_REQUIRE_EQUAL( batches.size(), 3u );
+	BOOST_CHECK_EQUAL( batches[0].hShader, 5 );
+	BOOST_CHECK_EQUAL( batches[0].quads.size(), 2u );
+	BOOST_CHECK_EQUAL( batches[1].hShader, 7 );
+	BOOST_CHECK_EQUAL( batches[1].quads.size(), 3u );
+	BOOST_CHECK_EQUAL( batches[2].hShader, 5 );
+	BOOST_CHECK_EQUAL( batches[2].quads.size(), 1u );
+
+	const stretchPicQuad_t& quad = batches[1].quads[0];
+	BOOST_CHECK_EQUAL( quad.x, 116.0f );
+	BOOST_CHECK_EQUAL( quad.y, 52.0f );
+	BOOST_CHECK_EQUAL( quad.w, 8.0f );
+	BOOST_CHECK_EQUAL( quad.h, 10.0f );
+	BOOST_CHECK_EQUAL( quad.t2, 0.75f );
+	// NULL colour is white, like RE_SetColor( NULL )
+	BOOST_CHECK_EQUAL( quad.color[0], 1.0f );
+	BOOST_CHECK_EQUAL( quad.color[3], 1.0f );
+}
+
+BOOST_AUTO_TEST_CASE( long_runs_are_split )
+{
+	fontLayout_t layout{};
+	for( int i = 0; i < MAX_STRETCHPIC_BATCH * 2 + 10; i++ )
+	{
+		layout.glyphs.push_back( glyph( static_cast< float >( i ), 3 ) );
+	}
+
+	const std::vector< Batch > batches = batchLayout( layout, 0.0f, 0.0f, nullptr, nullptr );
+	BOOST_REQUIRE_EQUAL( batches.size(), 3u );
+	BOOST_CHECK_EQUAL( batches[0].quads.size(), static_cast< size_t >( MAX_STRETCHPIC_BATCH ) );
+	BOOST_CHECK_EQUAL( batches[1].quads.size(), static_cast< size_t >( MAX_STRETCHPIC_BATCH ) );
+	BOOST_CHECK_EQUAL( batches[2].quads.size(), 10u );
+	BOOST_CHECK_EQUAL( batches[2].quads[9].x, static_cast< float >( MAX_STRETCHPIC_BATCH * 2 + 9 ) );
+}
+
+BOOST_AUTO_TEST_CASE( colour_codes )
+{
+	const float colourTable[2][4] = { { 0.0f, 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f, 1.0f } };
+	const float rgba[4] = { 0.5f, 0.5f, 0.5f, 0.25f };
+
+	fontLayout_t layout{};
+	layout.glyphs.push_back( glyph( 0.0f, 1 ) );
+	layout.glyphs.push_back( glyph( 8.0f, 1, 1 ) );
+
+	std::vector< Batch > batches = batchLayout( layout, 0.0f, 0.0f, rgba, colourTable );
+	BOOST_REQUIRE_EQUAL( batches.size(), 1u );
+	BOOST_CHECK_EQUAL( batches[0].quads[0].color[0], 0.5f );
+	BOOST_CHECK_EQUAL( batches[0].quads[0].color[3], 0.25f );
+	// code colour, caller's alpha
+	BOOST_CHECK_EQUAL( batches[0].quads[1].color[0], 1.0f );
+	BOOST_CHECK_EQUAL( batches[0].quads[1].color[1], 0.0f );
+	BOOST_CHECK_EQUAL( batches[0].quads[1].color[3], 0.25f );
+
+	// drop shadows ignore colour codes
+	batches = batchLayout( layout, 0.0f, 0.0f, rgba, nullptr );
+	BOOST_CHECK_EQUAL( batches[0].quads[1].color[0], 0.5f );
+}
+
+BOOST_AUTO_TEST_CASE( cache_lookup )
+{
+	CFontLayoutCache cache;
+	bool bFound;
+
+	fontLayout_t& layout = cache.Lookup( "^3Health", key, bFound );
+	BOOST_CHECK( !bFound );
+	BOOST_CHECK( !layout.bHasGlyphs );
+	BOOST_CHECK_EQUAL( layout.iStrLenPixels, -1 );
+	layout.glyphs.push_back( glyph( 0.0f, 1, 3 ) );
+	layout.bHasGlyphs = true;
+	layout.iStrLenPixels = 42;
+
+	const fontLayout_t& again = cache.Lookup( "^3Health", key, bFound );
+	BOOST_CHECK( bFound );
+	BOOST_CHECK_EQUAL( &again, &layout );
+	BOOST_CHECK_EQUAL( again.iStrLenPixels, 42 );
+	BOOST_CHECK_EQUAL( again.glyphs.size(), 1u );
+
+	fontLayoutKey_t other = key;
+	other.fScale = 0.5f;
+	cache.Lookup( "^3Health", other, bFound );
+	BOOST_CHECK( !bFound );
+	other = key;
+	other.iMaxPixelWidth = 64;
+	cache.Lookup( "^3Health", other, bFound );
+	BOOST_CHECK( !bFound );
+	other = key;
+	other.iLanguage = 3;
+	cache.Lookup( "^3Health", other, bFound );
+	BOOST_CHECK( !bFound );
+	cache.Lookup( "^3Armor", key, bFound );
+	BOOST_CHECK( !bFound );
+
+	cache.Lookup( "^3Health", key, bFound );
+	cache.Clear();
+	cache.Lookup( "^3Health", key, bFound );
+	BOOST_CHECK( !bFound );
+}
+
+BOOST_AUTO_TEST_CASE( long_text_is_not_cached )
+{
+	CFontLayoutCache cache;
+	bool bFound;
+
+	const std::string text( CFontLayoutCache::iMAX_CACHED_TEXT + 1, 'x' );
+	fontLayout_t& layout = cache.Lookup( text.c_str(), key, bFound );
+	BOOST_CHECK( !bFound );
+	BOOST_CHECK_EQUAL( layout.strText, text );
+	layout.bHasGlyphs = true;
+
+	cache.Lookup( text.c_str(), key, bFound );
+	BOOST_CHECK( !bFound );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // font_batch
@@ -0,0 +1,112 @@
+#include "rd-common/tr_ragstep.h"
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+	// stands in for the file static solver arrays in G2_bones.cpp, which hold whichever
+	// ragdoll was set up last
+	struct Solver
+	{
+		int owner = -1;
+		int setups = 0;
+		int solves = 0;
+	};
+
+	struct Ragdoll
+	{
+		int id;
+		int stepClock;
+		bool hasEntity;
+		int refreshes;
+	};
+
+	// the same order of operations as G2_RagDoll, checking that every read of the
+	// solver state sees this ragdoll's data
+	void update( Solver& solver, Ragdoll& rag, const int curTime, const int stepTime )
+	{
+		const int steps = G2_RagStepCount( rag.stepClock, curTime, stepTime );
+		const int iters = 2 * steps;
+
+		if( G2_RagNeedsSetup( iters, rag.hasEntity ) )
+		{
+			solver.owner = rag.id;
+			solver.setups++;
+		}
+		for( int i = 0; i < iters; i++ )
+		{
+			BOOST_REQUIRE_EQUAL( solver.owner, rag.id );
+			solver.solves++;
+		}
+		if( rag.hasEntity )
+		{
+			BOOST_REQUIRE_EQUAL( solver.owner, rag.id );
+			rag.refreshes++;
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE( ragstep )
+
+BOOST_AUTO_TEST_CASE( steps_follow_real_time )
+{
+	int clock = 0;
+
+	// the first update runs one step
+	BOOST_CHECK_EQUAL( G2_RagStepCount( clock, 1000, 16 ), 1 );
+	BOOST_CHECK_EQUAL( clock, 1000 );
+
+	// 8ms frames step every other update
+	BOOST_CHECK_EQUAL( G2_RagStepCount( clock, 1008, 16 ), 0 );
+	BOOST_CHECK_EQUAL( G2_RagStepCount( clock, 1016, 16 ), 1 );
+
+	// 40ms frames carry the remainder over
+	BOOST_CHECK_EQUAL( G2_RagStepCount( clock, 1056, 16 ), 2 );
+	BOOST_CHECK_EQUAL( clock, 1048 );
+
+	// a hitch is capped and the lost time dropped
+	BOOST_CHECK_EQUAL( G2_RagStepCount( clock, 2000, 16 ), MAX_RAG_STEPS );
+	BOOST_CHECK_EQUAL( clock, 2000 );
+
+	// the clock going backwards restarts it
+	BOOST_CHECK_EQUAL( G2_RagStepCount( clock, 500, 16 ), 1 );
+	BOOST_CHECK_EQUAL( clock, 500 );
+
+	// a step time of 0 settles once per update
+	BOOST_CHECK_EQUAL( G2_RagStepCount( clock, 500, 0 ), 1 );
+	BOOST_CHECK_EQUAL( clock, 500 );
+}
+
+BOOST_AUTO_TEST_CASE( zero_step_frame_sets_up_its_own_ragdoll )
+{
+	Solver solver;
+	Ragdoll fast{ 0, 0, true, 0 };
+	Ragdoll slow{ 1, 0, true, 0 };
+
+	// both ragdolls update every 8ms, slow steps every 32ms so most of its updates
+	// have no step due and come right after fast has been solved
+	for( int time = 1000; time < 2000; time += 8 )
+	{
+		update( solver, fast, time, 8 );
+		update( solver, slow, time, 32 );
+	}
+
+	BOOST_CHECK_EQUAL( fast.refreshes, 125 );
+	BOOST_CHECK_EQUAL( slow.refreshes, 125 );
+	BOOST_CHECK_EQUAL( solver.setups, 250 );
+	BOOST_CHECK_EQUAL( solver.solves, 2 * ( 125 + 32 ) );
+}
+
+BOOST_AUTO_TEST_CASE( zero_step_frame_without_entity_skips_setup )
+{
+	Solver solver;
+	Ragdoll rag{ 0, 0, false, 0 };
+
+	update( solver, rag, 1000, 16 );
+	update( solver, rag, 1008, 16 );
+
+	BOOST_CHECK_EQUAL( solver.setups, 1 );
+	BOOST_CHECK_EQUAL( rag.refreshes, 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // ragstep
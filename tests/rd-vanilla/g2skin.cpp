@@ -0,0 +1,113 @@
+#include "rd-vanilla/tr_g2skin.h"
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#ifdef G2_SIMD_SKINNING
+
+namespace
+{
+	const int numBones = 24;
+
+	// rotation-ish 3x4 matrices with model sized translations, like a real skeleton
+	std::vector< float > makeBones( std::mt19937& rng )
+	{
+		std::uniform_real_distribution< float > unit( -1.0f, 1.0f );
+		std::uniform_real_distribution< float > pos( -64.0f, 64.0f );
+
+		std::vector< float > bones( numBones * 12 );
+		for( int b = 0; b < numBones; b++ )
+		{
+			for( int r = 0; r < 3; r++ )
+			{
+				for( int c = 0; c < 3; c++ )
+				{
+					bones[b * 12 + r * 4 + c] = unit( rng );
+				}
+				bones[b * 12 + r * 4 + 3] = pos( rng );
+			}
+		}
+		return bones;
+	}
+
+	g2SkinVert_t makeVert( std::mt19937& rng )
+	{
+		std::uniform_real_distribution< float > unit( -1.0f, 1.0f );
+		std::uniform_real_distribution< float > pos( -128.0f, 128.0f );
+
+		g2SkinVert_t vert;
+		std::memset( &vert, 0, sizeof( vert ) );
+		for( int i = 0; i < 3; i++ )
+		{
+			vert.xyz[i] = pos( rng );
+			vert.normal[i] = unit( rng );
+		}
+		vert.xyz[3] = 1.0f;
+
+		const int numWeights = static_cast< int >( rng() % 4 ) + 1;
+		float packed[3];
+		float left = 1.0f;
+		for( int i = 0; i < numWeights - 1; i++ )
+		{
+			packed[i] = left * std::uniform_real_distribution< float >( 0.0f, 0.7f )( rng );
+			left -= packed[i];
+		}
+		G2Skin_SetWeights( vert, numWeights, packed );
+		for( int i = 0; i < 4; i++ )
+		{
+			vert.bones[i] = static_cast< unsigned char >( rng() % numBones );
+		}
+		return vert;
+	}
+
+	// the SIMD kernel blends the matrices before transforming, so it rounds differently
+	void checkClose( const float* expected, const float* actual, const float scale )
+	{
+		for( int i = 0; i < 3; i++ )
+		{
+			BOOST_REQUIRE_SMALL( expected[i] - actual[i], scale * 1e-5f );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE( g2skin )
+
+BOOST_AUTO_TEST_CASE( simd_matches_scalar )
+{
+	std::mt19937 rng( 1 );
+
+	for( int n = 0; n < 32; n++ )
+	{
+		const std::vector< float > bones = makeBones( rng );
+		const float* bonePtrs[numBones];
+		for( int b = 0; b < numBones; b++ )
+		{
+			bonePtrs[b] = &bones[b * 12];
+		}
+
+		// offset by one float so the kernel sees vertices that aren't 16 byte aligned
+		std::vector< float > storage( ( sizeof( g2SkinVert_t ) / sizeof( float ) ) * 64 + 1 );
+		g2SkinVert_t* verts = reinterpret_cast< g2SkinVert_t* >( storage.data() + n % 2 );
+
+		for( int v = 0; v < 63; v++ )
+		{
+			verts[v] = makeVert( rng );
+
+			float expectedXyz[3], expectedNormal[3];
+			float actualXyz[3], actualNormal[3];
+			G2Skin_VertScalar( verts[v], bonePtrs, expectedXyz, expectedNormal );
+			G2Skin_VertSIMD( verts[v], bonePtrs, actualXyz, actualNormal );
+
+			checkClose( expectedNormal, actualNormal, 4.0f );
+			checkClose( expectedXyz, actualXyz, 512.0f );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END() // g2skin
+
+#endif // G2_SIMD_SKINNING
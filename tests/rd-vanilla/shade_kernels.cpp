@@ -0,0 +1,160 @@
+#include "rd-vanilla/tr_shade_kernels.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#ifdef SHADE_SIMD_KERNELS
+
+namespace
+{
+	// odd so every kernel also runs its scalar tail
+	const int numVerts = 1003;
+
+	struct TessData
+	{
+		std::vector< float > xyz;
+		std::vector< float > normal;
+		std::vector< float > st;
+		std::vector< unsigned char > colors;
+
+		explicit TessData( unsigned seed )
+			: xyz( numVerts * 4 )
+			, normal( numVerts * 4 )
+			, st( numVerts * 2 )
+			, colors( numVerts * 4 )
+		{
+			std::mt19937 rng( seed );
+			std::uniform_real_distribution< float > pos( -2048.0f, 2048.0f );
+			std::uniform_real_distribution< float > unit( -1.0f, 1.0f );
+			std::uniform_real_distribution< float > tc( -4.0f, 4.0f );
+
+			for( int i = 0; i < numVerts; i++ )
+			{
+				float n[3] = { unit( rng ), unit( rng ), unit( rng ) };
+				const float len = std::sqrt( n[0] * n[0] + n[1] * n[1] + n[2] * n[2] ) + 1e-3f;
+				for( int j = 0; j < 3; j++ )
+				{
+					xyz[i * 4 + j] = pos( rng );
+					normal[i * 4 + j] = n[j] / len;
+				}
+				xyz[i * 4 + 3] = 1.0f;
+				normal[i * 4 + 3] = 0.0f;
+				st[i * 2 + 0] = tc( rng );
+				st[i * 2 + 1] = tc( rng );
+				colors[i * 4 + 0] = static_cast< unsigned char >( rng() );
+				colors[i * 4 + 1] = static_cast< unsigned char >( rng() );
+				colors[i * 4 + 2] = static_cast< unsigned char >( rng() );
+				colors[i * 4 + 3] = static_cast< unsigned char >( rng() );
+			}
+		}
+	};
+
+	template< typename T >
+	void checkSame( const std::vector< T >& expected, const std::vector< T >& actual )
+	{
+		BOOST_REQUIRE_EQUAL( expected.size(), actual.size() );
+		BOOST_CHECK( std::memcmp( expected.data(), actual.data(), expected.size() * sizeof( T ) ) == 0 );
+	}
+
+	// runs the same call on the scalar and SSE2 kernel sets and compares every byte of output
+	template< typename Call >
+	void checkKernel( unsigned seed, Call call )
+	{
+		TessData expected( seed );
+		TessData actual( seed );
+		call( shadeKernelsScalar, expected );
+		call( shadeKernelsSSE2, actual );
+		checkSame( expected.xyz, actual.xyz );
+		checkSame( expected.st, actual.st );
+		checkSame( expected.colors, actual.colors );
+	}
+}
+
+BOOST_AUTO_TEST_SUITE( rd_vanilla )
+
+BOOST_AUTO_TEST_SUITE( shade_kernels )
+
+BOOST_AUTO_TEST_CASE( deforms )
+{
+	checkKernel( 1, []( const shadeKernels_t& k, TessData& d ) {
+		k.addScaledNormals( d.xyz.data(), d.normal.data(), numVerts, 3.25f );
+	} );
+
+	checkKernel( 2, []( const shadeKernels_t& k, TessData& d ) {
+		const float offset[3] = { 1.5f, -7.0f, 0.125f };
+		k.addOffset( d.xyz.data(), numVerts, offset );
+	} );
+
+	std::vector< float > table( 1024 );
+	for( int i = 0; i < 1024; i++ )
+	{
+		table[i] = std::sin( i * 2.0f * 3.14159265f / 1024 );
+	}
+	checkKernel( 3, [&table]( const shadeKernels_t& k, TessData& d ) {
+		shadeWaveParms_t wave;
+		wave.table = table.data();
+		wave.tableSize = 1024;
+		wave.tableMask = 1023;
+		wave.base = 0.5f;
+		wave.amplitude = 4.0f;
+		wave.phase = 0.25f;
+		wave.frequency = 1.7f;
+		wave.spread = 0.01f;
+		wave.time = 123.456f;
+		k.deformWave( d.xyz.data(), d.normal.data(), numVerts, wave );
+	} );
+
+	checkKernel( 4, []( const shadeKernels_t& k, TessData& d ) {
+		const float origin[3] = { 100.0f, -200.0f, 50.0f };
+		k.disintegrateDeform( d.xyz.data(), d.normal.data(), numVerts, origin, 1500.0f );
+	} );
+}
+
+BOOST_AUTO_TEST_CASE( tex_coords )
+{
+	checkKernel( 5, []( const shadeKernels_t& k, TessData& d ) {
+		k.scrollTexCoords( d.st.data(), numVerts, 0.3f, -0.7f );
+	} );
+
+	checkKernel( 6, []( const shadeKernels_t& k, TessData& d ) {
+		k.scaleTexCoords( d.st.data(), numVerts, 2.5f, -0.5f );
+	} );
+
+	checkKernel( 7, []( const shadeKernels_t& k, TessData& d ) {
+		const float matrix[2][2] = { { 0.8f, 0.6f }, { -0.6f, 0.8f } };
+		const float translate[2] = { 0.1f, 0.7f };
+		k.transformTexCoords( d.st.data(), numVerts, matrix, translate );
+	} );
+
+	checkKernel( 8, []( const shadeKernels_t& k, TessData& d ) {
+		const float viewOrigin[3] = { 30.0f, 40.0f, -500.0f };
+		k.environmentTexCoords( d.st.data(), d.xyz.data(), d.normal.data(), numVerts, viewOrigin );
+	} );
+
+	checkKernel( 9, []( const shadeKernels_t& k, TessData& d ) {
+		const float lightDir[3] = { 0.0f, 0.6f, 0.8f };
+		k.environmentTexCoordsDir( d.st.data(), d.normal.data(), numVerts, lightDir );
+	} );
+}
+
+BOOST_AUTO_TEST_CASE( diffuse_color )
+{
+	checkKernel( 10, []( const shadeKernels_t& k, TessData& d ) {
+		shadeLightParms_t light = {
+			{ 40.0f, 50.0f, 60.0f },
+			{ 200.0f, 300.0f, 150.0f },
+			{ 0.48f, 0.6f, 0.64f },
+			0x7f3c3228
+		};
+		k.diffuseColor( d.colors.data(), d.normal.data(), numVerts, light );
+	} );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // shade_kernels
+
+BOOST_AUTO_TEST_SUITE_END() // rd_vanilla
+
+#endif // SHADE_SIMD_KERNELS